@@ -0,0 +1,104 @@
+/******************************************************************************
+  * @file           : alert_client.h
+  * @brief          : Direct Wi-Fi alert publisher (ISM43362, persistent TCP)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __ALERT_CLIENT_H
+#define __ALERT_CLIENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Network settings. Override with -D in the build; an empty SSID keeps
+ * the client off (and the Wi-Fi module untouched), so boards without an
+ * access point behave exactly as before.
+ */
+#ifndef ALERT_WIFI_SSID
+#define ALERT_WIFI_SSID         ""
+#endif
+#ifndef ALERT_WIFI_PASSWORD
+#define ALERT_WIFI_PASSWORD     ""
+#endif
+#ifndef ALERT_SERVER_IP
+#define ALERT_SERVER_IP         192, 168, 1, 100
+#endif
+#ifndef ALERT_SERVER_PORT
+#define ALERT_SERVER_PORT       5028
+#endif
+
+#define ALERT_QUEUE_LEN         8
+#define ALERT_BACKOFF_MIN_MS    500
+#define ALERT_BACKOFF_MAX_MS    30000
+#define ALERT_ACK_TIMEOUT_MS    2000
+#define ALERT_HEARTBEAT_MS      30000   /* keeps NAT/TCP state alive, detects a dead link */
+
+/*
+ * Wire format, one fixed 16-byte frame per publish (little endian):
+ *
+ *   byte 0      ALERT_FRAME_MAGIC
+ *   byte 1      AlertType_t
+ *   byte 2..3   sequence number
+ *   byte 4..7   HAL_GetTick() when the alert was raised
+ *   byte 8..9   value0 (peak |a| in 0.01 m/s^2, 0 if n/a)
+ *   byte 10..11 value1 (peak |w| in 0.1 dps, 0 if n/a)
+ *   byte 12..15 event time, TIM2 microseconds (timestamp.h), 0 if n/a
+ *
+ * The server answers each frame with { ALERT_ACK_MAGIC, type, seq lo,
+ * seq hi }. A frame stays queued until its ack arrives, so a retry after
+ * a lost ack can deliver it twice; the server drops repeats by seq.
+ */
+#define ALERT_FRAME_MAGIC       0xA1
+#define ALERT_ACK_MAGIC         0xA2
+#define ALERT_FRAME_SIZE        16
+#define ALERT_ACK_SIZE          4
+
+typedef enum {
+    ALERT_FALL = 1,
+    ALERT_MANUAL,
+    ALERT_RESET,
+    ALERT_ARMED,
+    ALERT_DISARMED,
+    ALERT_HEARTBEAT
+} AlertType_t;
+
+typedef enum {
+    ALERT_OFF = 0,          // no SSID configured
+    ALERT_DOWN,             // module not initialised / crashed
+    ALERT_NO_AP,            // module up, not joined
+    ALERT_NO_SOCKET,        // joined, TCP connection closed
+    ALERT_READY,            // connected, nothing in flight
+    ALERT_WAIT_ACK          // head frame sent, waiting for its ack
+} AlertState_t;
+
+typedef struct {
+    uint32_t published;
+    uint32_t acked;
+    uint32_t sends;             // including retries
+    uint32_t dropped;           // frames given up while the queue was full (lowest priority first)
+    uint32_t reconnects;        // TCP connections opened
+    uint32_t failures;          // failed AT steps (each one backs off)
+    uint32_t last_latency_ms;   // publish -> ack
+    uint32_t max_latency_ms;
+} AlertStats_t;
+
+/* Opens the Wi-Fi bus and queues the module reset; never waits for it. */
+int  AlertClient_Init(void);
+
+/* Main loop: collects finished AT steps and queues the next one. */
+void AlertClient_Poll(void);
+
+/* Queues a pre-formatted frame; never touches the module. */
+void AlertClient_Publish(AlertType_t type, int16_t value0, int16_t value1, uint32_t event_us);
+
+AlertState_t AlertClient_GetState(void);
+void         AlertClient_GetStats(AlertStats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ALERT_CLIENT_H */
@@ -0,0 +1,57 @@
+/******************************************************************************
+  * @file           : alert_trace.h
+  * @brief          : Time-to-alarm tracing, from the trigger sample to the sentinel on the wire
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __ALERT_TRACE_H
+#define __ALERT_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define ALERT_SENTINEL          "___SEND_TELEGRAM_ALERT___"     /* gateway.py TRIGGER_PHRASE */
+#define ALERT_TRACE_TAG         "ALERT_TRACE"                   /* gateway.py TRACE_TAG */
+
+typedef enum {
+    ALERT_TRACE_CRASH = 0,      // impact with a loud noise
+    ALERT_TRACE_DELAYED,        // loud noise early in the stillness check
+    ALERT_TRACE_STILL,          // no recovery in the stillness window
+    ALERT_TRACE_MANUAL          // three presses
+} AlertTraceKind_t;
+
+/* timestamp.h microseconds, one alert from trigger to the UART */
+typedef struct {
+    uint32_t id;                // counts alerts since boot
+    uint8_t  kind;              // AlertTraceKind_t
+    uint32_t trigger_us;        // DRDY of the sample that left NORMAL (the press for manual)
+    uint32_t confirm_us;        // DRDY of the sample that confirmed
+    uint32_t decided_us;        // the FSM step returned
+    uint32_t queued_us;         // sentinel in the UART TX ring
+    uint32_t sent_us;           // its last character handed to the USART
+} AlertTrace_t;
+
+/*
+ * Queues "\r\n" ALERT_SENTINEL "\r\n" with a UART mark and starts a
+ * trace; the caller prints the rest of its banner after it. Returns 0 if
+ * the ring had no room (the trace is then not reported).
+ */
+int  AlertTrace_Sentinel(AlertTraceKind_t kind, uint32_t trigger_us, uint32_t confirm_us, uint32_t decided_us);
+
+/*
+ * Housekeeping: once the sentinel is out, prints
+ * "ALERT_TRACE id=.. kind=.. trigger=.. confirm=.. decided=.. queued=.. sent=..".
+ * gateway.py pairs it with the sentinel it has just seen.
+ */
+void AlertTrace_Poll(void);
+
+/* Last completed trace; 0 if none yet */
+int  AlertTrace_GetLast(AlertTrace_t *t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ALERT_TRACE_H */
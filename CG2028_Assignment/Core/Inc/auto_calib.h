@@ -0,0 +1,44 @@
+/******************************************************************************
+  * @file           : auto_calib.h
+  * @brief          : Guided on-device threshold calibration (Drop/Tumble/Recovery)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __AUTO_CALIB_H
+#define __AUTO_CALIB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Streaming statistics: min/max plus one P-square quantile marker set */
+typedef struct {
+    float    min;
+    float    max;
+    uint32_t count;
+    float    p;             // quantile being tracked, 0..1
+    float    q[5];          // marker heights
+    float    n[5];          // marker positions
+    float    np[5];         // desired positions
+    float    dn[5];         // desired position increments
+} CalStats_t;
+
+void  CalStats_Init(CalStats_t *s, float p);
+void  CalStats_Add(CalStats_t *s, float x);
+float CalStats_Quantile(const CalStats_t *s);
+
+#define AUTO_CALIB_HOLD_MS      3000    /* hold the button this long to enter calibration */
+
+void AutoCalib_Start(void);
+int  AutoCalib_IsActive(void);
+void AutoCalib_Step(float total_accel, float total_gyro);
+
+/* Beeps the calibration has asked for since the last call, 0 if none. Played by the UI task. */
+uint32_t AutoCalib_TakeBeeps(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AUTO_CALIB_H */
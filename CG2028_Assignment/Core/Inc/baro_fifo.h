@@ -0,0 +1,46 @@
+/******************************************************************************
+  * @file           : baro_fifo.h
+  * @brief          : LPS22HB pressure stream through its FIFO, batched on I2C2
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __BARO_FIFO_H
+#define __BARO_FIFO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define BARO_FIFO_DEPTH         32      /* LPS22HB FIFO slots, 5 bytes each */
+#define BARO_SLOT_BYTES         5       /* pressure (3) + temperature (2) */
+#define BARO_BATCH_MS           320     /* 24 samples at 75 Hz, FIFO full after 427 ms */
+
+typedef struct {
+    uint32_t batches;
+    uint32_t samples;
+    uint32_t overruns;          // FIFO filled up and lost samples
+    uint32_t errors;            // I2C jobs that failed
+    uint32_t skipped;           // bursts cut short to keep the IMU slot free
+    uint32_t bus_us;            // wire time of all batches
+} BaroFifoStats_t;
+
+/* WHO_AM_I check, then 75 Hz with the LPF at ODR/20 and the FIFO in stream mode */
+int  BaroFifo_Init(void);
+
+/*
+ * slot_ms = time left before the next IMU sample is due. About every
+ * BARO_BATCH_MS this reads the FIFO level and then all stored samples as
+ * sensor-priority I2C jobs (only if they end inside the slot) and feeds
+ * them to the height-drop estimator. Results arrive via I2cBus_Poll().
+ */
+void BaroFifo_Poll(uint32_t slot_ms);
+
+uint32_t BaroFifo_BusUsPerSecond(void);    // expected I2C wire time per second of data
+void BaroFifo_GetStats(BaroFifoStats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BARO_FIFO_H */
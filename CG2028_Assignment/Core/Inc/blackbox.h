@@ -0,0 +1,135 @@
+/******************************************************************************
+  * @file           : blackbox.h
+  * @brief          : Black-box event recorder (append-only log on the QSPI NOR)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __BLACKBOX_H
+#define __BLACKBOX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define BB_PRE_SAMPLES          50      /* raw samples kept before a trigger (1 s at 20 ms) */
+#define BB_POST_SAMPLES         100     /* raw samples recorded after it (2 s) */
+#define BB_STAGE_SIZE           4096    /* RAM staging ring between the loop and the flash */
+#define BB_CODEC_BLOCK          50      /* imu_codec block length inside window records */
+
+#define BB_SECTOR_MAGIC         0xB1AC0B0CUL
+#define BB_RECORD_MAGIC         0xB10C
+#define BB_COMMIT_MARK          0x00C0FFEEUL
+
+/* One raw sample, as pushed by the sampling loop (16 bytes) */
+typedef struct {
+    int16_t  accel_mg[3];
+    int16_t  gyro_dps[3];
+    uint16_t sound;         // ADC peak-to-peak, clipped to 16 bits
+    uint8_t  state;         // FallState_t at the time of the sample
+    uint8_t  sound_dt;      // sound window centre after the IMU sample, 0.1 ms (255 = 25.5 ms or more)
+} BlackBoxSample_t;
+
+typedef enum {
+    BB_REC_BOOT = 1,        // payload: uint32_t RCC->CSR reset flags
+    BB_REC_EVENT,           // payload: BlackBoxEvent_t
+    BB_REC_PRE_WINDOW,      // payload: BlackBoxSample_t[], oldest first
+    BB_REC_POST_WINDOW,     // payload: BlackBoxSample_t[BB_POST_SAMPLES]
+    BB_REC_PRE_WINDOW_Z,    // same samples as imu_codec blocks (Rice, order 1)
+    BB_REC_POST_WINDOW_Z,
+    BB_REC_WINDOW_TIMES     // payload: BlackBoxTimes_t + uint16_t dt_us[n - 1], after each window
+} BlackBoxRecordType_t;
+
+typedef enum {
+    BB_EVT_TRIGGER = 1,     // NORMAL -> FALLING
+    BB_EVT_TIMEOUT,
+    BB_EVT_SILENT_FALL,
+    BB_EVT_CONFIRMED,
+    BB_EVT_RECOVERED,
+    BB_EVT_MANUAL,
+    BB_EVT_RESET
+} BlackBoxEventCode_t;
+
+#define BB_TRIG_IMPACT          0x01
+#define BB_TRIG_FREEFALL        0x02
+#define BB_TRIG_ROTATION        0x04
+#define BB_TRIG_LOUD            0x08
+#define BB_TRIG_HEIGHT          0x10    // barometric height drop (height_drop.c)
+
+typedef struct {
+    uint8_t  code;          // BlackBoxEventCode_t
+    uint8_t  trigger;       // BB_TRIG_* seen so far
+    int16_t  posture_dd;    // posture change since the trigger, deci-degrees
+    float    rotation_deg;  // fused attitude change during the event
+    float    total_accel;   // m/s^2 at the time of the event
+    float    total_gyro;    // dps
+    uint32_t t_us;          // timestamp.h time of the sample that raised the event
+} BlackBoxEvent_t;
+
+/*
+ * Sample times of the window record just before it. The samples stay one
+ * imu_codec sample each, so their timestamps travel separately: the first
+ * one in full, then the gaps (BB_DT_CLIPPED if 65535 us or more).
+ */
+#define BB_DT_CLIPPED           0xFFFF
+
+typedef struct {
+    uint8_t  window;        // BB_REC_PRE_WINDOW or BB_REC_POST_WINDOW
+    uint8_t  reserved;
+    uint16_t n;             // samples in the window
+    uint32_t t_first_us;
+} BlackBoxTimes_t;
+
+/*
+ * Flash layout. Every 4 KB sector starts with a sector header, followed by
+ * records packed back to back, each payload padded with 0xFF to a
+ * multiple of 4 bytes. Records never cross a sector. crc and
+ * commit are left erased (0xFF) by the first program and written last, so
+ * a record only counts once commit == BB_COMMIT_MARK.
+ */
+typedef struct {
+    uint32_t magic;         // BB_SECTOR_MAGIC
+    uint32_t sector_seq;    // +1 each time the write head opens a sector
+    uint32_t first_rec_seq;
+    uint32_t check;         // ~sector_seq
+} BlackBoxSectorHeader_t;
+
+typedef struct {
+    uint16_t magic;         // BB_RECORD_MAGIC
+    uint8_t  type;          // BlackBoxRecordType_t
+    uint8_t  reserved;
+    uint16_t len;           // payload bytes
+    uint16_t len_check;     // ~len, rejects a torn header
+    uint32_t seq;
+    uint32_t tick;          // HAL_GetTick() when the record was queued
+    uint32_t crc;           // CRC-32 of the padded payload
+    uint32_t commit;        // BB_COMMIT_MARK
+} BlackBoxRecordHeader_t;
+
+typedef struct {
+    uint32_t head_addr;     // next flash byte to be written
+    uint32_t sector_seq;
+    uint32_t next_rec_seq;
+    uint32_t records;       // committed this boot
+    uint32_t dropped;       // staging ring full
+    uint32_t erases;
+    uint32_t errors;
+    uint32_t stage_used;    // bytes waiting in RAM
+    uint32_t win_raw_bytes; // sample windows before / after imu_codec
+    uint32_t win_enc_bytes;
+    uint32_t win_cycles;    // DWT cycles spent encoding them
+    uint32_t windows;
+} BlackBoxStats_t;
+
+int  BlackBox_Init(void);
+void BlackBox_Poll(void);
+void BlackBox_PushSample(const BlackBoxSample_t *s, uint32_t t_us);
+void BlackBox_Trigger(const BlackBoxEvent_t *ev);
+void BlackBox_LogEvent(const BlackBoxEvent_t *ev);
+void BlackBox_GetStats(BlackBoxStats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLACKBOX_H */
@@ -0,0 +1,76 @@
+/******************************************************************************
+  * @file           : config_store.h
+  * @brief          : Versioned detector configuration in internal flash (A/B pages + CRC)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __CONFIG_STORE_H
+#define __CONFIG_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define CONFIG_MAGIC            0xC0F16028UL
+#define CONFIG_VERSION          3      /* 2: magnetometer calibration added, 3: margin over the floor */
+
+/* Detector thresholds (runtime-tunable, e.g. by auto-calibration) */
+typedef struct {
+    float accel_high;       // m/s^2, impact
+    float accel_low;        // m/s^2, freefall
+    float gyro;             // dps, rotation
+    float recovery_dev;     // m/s^2, |total_accel - 9.8| that counts as getting up
+} FallThresholds_t;
+
+/* LIS3MDL hard/soft-iron calibration: cal = soft * (raw - offset) */
+typedef struct {
+    int16_t  offset[3];             // hard iron, raw LSB
+    int16_t  soft_q14[9];           // soft iron, row-major, 16384 = 1.0
+    uint32_t valid;                 // 0 until a calibration has been learned
+    uint32_t reserved;
+} MagCalibration_t;
+
+/*
+ * One flash record. Read in place through Config_Get() (no RAM copy,
+ * except for a version-1 record upgraded at boot).
+ * Size must stay a multiple of 8 bytes (double-word programming).
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    uint32_t sequence;              // higher = newer; picks the active A/B page
+
+    FallThresholds_t thresholds;
+    uint32_t sample_period_ms;      // sensor gate (was delay_ms = 20)
+    uint32_t falling_timeout_ms;    // FALLING -> NORMAL without evidence (1500)
+    uint32_t stillness_window_ms;   // STILLNESS_CHECK -> CONFIRMED (5000)
+    uint32_t late_sound_window_ms;  // loud noise still counts this long into stillness (2000)
+    int32_t  loud_margin_db;        // loud = this far above the noise floor (replaces +600)
+    uint32_t reserved;              // pads the record to whole double-words
+    MagCalibration_t mag;           // version 2
+
+    uint32_t crc;                   // CRC-32 of everything above
+} ConfigRecord_t;
+
+typedef enum {
+    CONFIG_IDLE = 0,
+    CONFIG_ERASING,
+    CONFIG_PROGRAMMING,
+    CONFIG_ERROR
+} ConfigWriteState_t;
+
+void                  Config_Init(void);
+const ConfigRecord_t *Config_Get(void);
+int                   Config_Save(const ConfigRecord_t *next);
+void                  Config_Poll(void);
+ConfigWriteState_t    Config_GetWriteState(void);
+uint32_t              Config_Crc32(const void *data, uint32_t len);
+uint32_t              Config_Crc32Update(uint32_t crc, const void *data, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CONFIG_STORE_H */
@@ -0,0 +1,46 @@
+/******************************************************************************
+  * @file           : es_wifi_io.h
+  * @brief          : SPI3 bus IO for the Inventek ISM43362 (es_wifi driver back end)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __ES_WIFI_IO_H
+#define __ES_WIFI_IO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * The five blocking functions handed to ES_WIFI_RegisterBusIO(). Lengths are in
+ * bytes; Send/Receive return the byte count or a negative
+ * ES_WIFI_ERROR_* code.
+ */
+int8_t  WifiIo_Init(uint16_t mode);         // ES_WIFI_INIT or ES_WIFI_RESET
+int8_t  WifiIo_DeInit(void);
+void    WifiIo_Delay(uint32_t ms);
+int16_t WifiIo_Send(uint8_t *data, uint16_t len, uint32_t timeout);
+int16_t WifiIo_Receive(uint8_t *data, uint16_t len, uint32_t timeout);
+
+/*
+ * Non-blocking transport for wifi_async.c. Start* return 0 once the DMA
+ * is running (lengths in bytes, even); completion and DRDY rising edges
+ * are reported through WifiAsync_OnEvent() from interrupt context.
+ * host/wifi_sim.c provides these on Linux.
+ */
+int      WifiIo_Open(void);                 // bus + DMA + DRDY interrupt, no reset
+void     WifiIo_Select(int on);             // nCS, including the module's setup time
+int      WifiIo_DataReady(void);            // DRDY level
+void     WifiIo_HoldReset(int on);
+int      WifiIo_StartTx(const uint8_t *data, uint16_t len);
+int      WifiIo_StartRx(uint8_t *data, uint16_t len);
+void     WifiIo_Abort(void);
+uint32_t WifiIo_Lock(void);                 // masks the transport interrupts
+void     WifiIo_Unlock(uint32_t key);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ES_WIFI_IO_H */
@@ -0,0 +1,94 @@
+/******************************************************************************
+  * @file           : fall_detect.h
+  * @brief          : Portable detection kernels: moving average, magnitude, fall FSM step
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __FALL_DETECT_H
+#define __FALL_DETECT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <math.h>
+#include <stdint.h>
+#include "config_store.h"
+
+/*
+ * The per-sample arithmetic of Detect_Sample() with no HAL, UART or
+ * sensor calls, so host/kernel_bench.c can time the same code the board
+ * runs. main.c gathers the inputs, calls FallDetect_Step() and turns
+ * the returned event into banners, black-box records and the
+ * fusion / height / heading start and stop calls.
+ */
+
+typedef enum {
+    STATE_NORMAL = 0,
+    STATE_FALLING,
+    STATE_STILLNESS_CHECK,
+    STATE_CONFIRMED
+} FallState_t;
+
+/* Evidence latched since the trigger; same bits as BB_TRIG_* in blackbox.h */
+#define FALL_SEEN_IMPACT        0x01
+#define FALL_SEEN_FREEFALL      0x02
+#define FALL_SEEN_ROTATION      0x04
+#define FALL_SEEN_LOUD          0x08
+#define FALL_SEEN_HEIGHT        0x10
+
+#define FALL_ROTATION_DEG       45.0f   /* integrated attitude change during the event */
+#define FALL_POSTURE_LYING      600     /* 60.0 deg away from pre-fall posture = still lying */
+#define FALL_MAG_ROTATION       450     /* 45.0 deg between the pre-event and current field vector */
+#define FALL_COUNTDOWN_S        5       /* seconds announced in STILLNESS_CHECK */
+
+typedef enum {
+    FALL_EV_NONE = 0,
+    FALL_EV_TRIGGER,            // NORMAL -> FALLING
+    FALL_EV_CRASH,              // FALLING -> CONFIRMED, impact with a loud noise
+    FALL_EV_SILENT_FALL,        // FALLING -> STILLNESS_CHECK
+    FALL_EV_TIMEOUT,            // FALLING -> NORMAL, not enough evidence
+    FALL_EV_DELAYED_CRASH,      // STILLNESS_CHECK -> CONFIRMED, loud noise in the late window
+    FALL_EV_RECOVERED,          // STILLNESS_CHECK -> NORMAL
+    FALL_EV_STILL               // STILLNESS_CHECK -> CONFIRMED, no recovery
+} FallEvent_t;
+
+typedef struct {
+    FallState_t state;
+    uint32_t    state_us;       // sample time the state was entered
+    uint32_t    trigger_us;     // sample time of the last NORMAL -> FALLING
+    int         last_second;    // countdown second last announced, -1 none
+    uint8_t     seen;           // FALL_SEEN_*
+} FallDetect_t;
+
+/* One sample as the FSM sees it; the sensor modules are read by the caller */
+typedef struct {
+    uint32_t sample_us;
+    float    total_accel;       // m/s^2, filtered
+    float    total_gyro;        // dps
+    float    rotation_deg;      // Fusion_GetEventRotation()
+    int32_t  mag_rotation;      // MagHeading_GetEventRotation(), 0.1 deg
+    int32_t  posture_delta;     // Posture_GetDelta(), 0.1 deg
+    uint8_t  loud;              // NoiseFloor_IsLoud() on the sample's envelope
+    uint8_t  height_drop;       // HeightDrop_Seen()
+} FallInput_t;
+
+int mov_avg_C(int N, int* accel_buff);
+
+static inline float FallDetect_Magnitude(float x, float y, float z)
+{
+    return sqrtf(x * x + y * y + z * z);
+}
+
+void        FallDetect_Init(FallDetect_t *d);
+/*
+ * Advances the FSM by one sample. *countdown is set to the STILLNESS_CHECK
+ * second to announce before any transition banner (-1 for none).
+ */
+FallEvent_t FallDetect_Step(FallDetect_t *d, const FallInput_t *in,
+                            const ConfigRecord_t *cfg, int *countdown);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FALL_DETECT_H */
@@ -0,0 +1,65 @@
+/******************************************************************************
+  * @file           : fmt.h
+  * @brief          : Append-style integer / fixed-point text formatting, no printf
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __FMT_H
+#define __FMT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define FMT_MAX_DECIMALS        6       /* Fmt_Fixed / Fmt_Float */
+
+/*
+ * A writer appends to either a flat buffer (Fmt_Init, NUL-terminated by
+ * Fmt_End) or the free part of a ring (Fmt_InitRing, used by uart_tx.c to
+ * format straight into the TX ring). Positions are free-running and masked
+ * only to address buf, the same way as spsc_ring.h.
+ *
+ * Nothing is ever written past end: what does not fit is counted in lost
+ * and the text is cut there.
+ */
+typedef struct {
+    char     *buf;
+    uint32_t  mask;             // 0xFFFFFFFF for a flat buffer, ring size - 1 for a ring
+    uint32_t  start;
+    uint32_t  pos;              // next character
+    uint32_t  end;              // first position that may not be written
+    uint32_t  lost;             // characters cut off
+} Fmt_t;
+
+/* cap includes the terminating NUL */
+void        Fmt_Init(Fmt_t *f, char *buf, uint32_t cap);
+/* Writes ring[pos & (size - 1)] for pos in [head, end); size a power of two */
+void        Fmt_InitRing(Fmt_t *f, char *ring, uint32_t size, uint32_t head, uint32_t end);
+/* Flat buffer only: terminates it and returns it */
+const char *Fmt_End(Fmt_t *f);
+uint32_t    Fmt_Len(const Fmt_t *f);
+
+void Fmt_Char(Fmt_t *f, char c);
+void Fmt_Str(Fmt_t *f, const char *s);
+void Fmt_StrPad(Fmt_t *f, const char *s, int width);            // "%-*s": left-aligned, spaces after
+
+void Fmt_Uint(Fmt_t *f, uint32_t v);                            // "%lu"
+void Fmt_UintPad(Fmt_t *f, uint32_t v, int width, char pad);    // "%05lu" (pad '0') or "%5lu" (pad ' ')
+void Fmt_Int(Fmt_t *f, int32_t v);                              // "%ld"
+void Fmt_Hex(Fmt_t *f, uint32_t v, int digits);                 // "%0*lx", at least digits
+
+/* v / 10^decimals with exactly that many decimals: (-1234, 2) -> "-12.34" */
+void Fmt_Fixed(Fmt_t *f, int32_t v, int decimals);
+
+/*
+ * "%.*f", digit for digit (round to nearest, ties to even, on the exact
+ * binary value), for |v| < 2^32; larger magnitudes saturate.
+ */
+void Fmt_Float(Fmt_t *f, float v, int decimals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FMT_H */
@@ -0,0 +1,34 @@
+/******************************************************************************
+  * @file           : fusion.h
+  * @brief          : 6-axis Mahony attitude filter for the fall window
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __FUSION_H
+#define __FUSION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define FUSION_KP              1.0f     /* accel correction gain */
+#define FUSION_KI              0.0f     /* no bias integration over a few-second window */
+#define FUSION_ACCEL_GATE      0.3f     /* skip accel correction when |a| is >30% off 1 g */
+
+void     Fusion_Start(float ax, float ay, float az);
+void     Fusion_Stop(void);
+int      Fusion_IsRunning(void);
+void     Fusion_Update(float gx_dps, float gy_dps, float gz_dps,
+                       float ax, float ay, float az, float dt);
+
+void     Fusion_GetQuaternion(float q_out[4]);
+float    Fusion_GetEventRotation(void);
+uint32_t Fusion_GetLastCycles(void);
+uint32_t Fusion_GetMaxCycles(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FUSION_H */
@@ -0,0 +1,49 @@
+/******************************************************************************
+  * @file           : height_drop.h
+  * @brief          : Barometric height-drop estimator (fixed point)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __HEIGHT_DROP_H
+#define __HEIGHT_DROP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Input is raw LPS22HB pressure (24-bit, 4096 LSB/hPa); heights are in mm. */
+#define HEIGHT_ODR_HZ           75      /* sample rate the filter constants assume */
+#define HEIGHT_SCALE_MM         8434000 /* scale height R*T/(M*g) at 15 C: dh = -H * dP / P */
+#define HEIGHT_LPF_SHIFT        3       /* height low-pass, tau 8 samples (~110 ms) */
+#define HEIGHT_DECIMATE         8       /* samples per history entry (~107 ms) */
+#define HEIGHT_HISTORY          32      /* history entries (~3.4 s) */
+#define HEIGHT_RATE_SPAN        6       /* history entries (~640 ms) in the least-squares speed */
+#define HEIGHT_PRE_EVENT_MS     1000    /* reference height: this long before the trigger */
+#define HEIGHT_PRE_MOVE_MM      150     /* height change over the second before the reference: stairs, lift */
+#define HEIGHT_DROP_MM          600     /* standing -> floor is ~800 mm, sitting down ~450 mm */
+#define HEIGHT_SETTLED_MM_S     250     /* speed counted as still; sensor noise alone gives ~100 mm/s */
+#define HEIGHT_HOLD_MS          200     /* drop must stay down and settled this long */
+
+void    HeightDrop_Init(void);
+
+/* One sample, or a burst of LPS22HB FIFO slots (5 bytes each, pressure first)
+ * whose last sample was taken at tick_last */
+void    HeightDrop_AddSample(int32_t raw, uint32_t tick);
+void    HeightDrop_FeedFifo(const uint8_t *fifo, uint32_t n, uint32_t tick_last);
+
+/* Event window: the FSM trigger opens it, NORMAL closes it */
+void    HeightDrop_StartEvent(uint32_t tick);
+void    HeightDrop_StopEvent(void);
+int     HeightDrop_Seen(void);
+
+int32_t HeightDrop_GetDropMm(void);         // largest drop since the trigger
+int32_t HeightDrop_GetHeightMm(void);       // filtered, relative to the first sample
+int32_t HeightDrop_GetRateMmS(void);        // vertical speed, negative = going down
+uint32_t HeightDrop_GetSamples(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HEIGHT_DROP_H */
@@ -0,0 +1,101 @@
+/******************************************************************************
+  * @file           : i2c_bus.h
+  * @brief          : I2C2 transaction scheduler (DMA jobs, priority classes)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __I2C_BUS_H
+#define __I2C_BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define I2C_BUS_QUEUE_LEN       8
+#define I2C_BUS_IRQ_PRIORITY    12      /* I2C2 EV/ER and both DMA channels, never nested */
+
+/*
+ * Fastest SCL the firmware may use. The bus actually runs at the lowest
+ * of this and the limit of every device on it (table in i2c_bus.c), so
+ * Fast-mode Plus only switches on for a board whose parts all allow it.
+ */
+#ifndef I2C_BUS_MAX_KHZ
+#define I2C_BUS_MAX_KHZ         1000
+#endif
+
+/* Lower value runs first; each device has a fixed class */
+typedef enum {
+    I2C_PRIO_IMU = 0,           // LSM6DSL samples
+    I2C_PRIO_SENSOR,            // other sensors
+    I2C_PRIO_BACKGROUND,        // NFC tag, anything that can wait
+    I2C_PRIO_COUNT
+} I2cPrio_t;
+
+typedef enum {
+    I2C_OK = 0,
+    I2C_NACK,                   // device did not answer (busy EEPROM, absent)
+    I2C_BUS_ERROR,              // arbitration / bus error, bus recovered
+    I2C_TIMEOUT,                // deadline passed, bus recovered
+    I2C_QUEUE_FULL
+} I2cResult_t;
+
+/* Runs from I2cBus_Poll() in the main loop, never from the interrupt */
+typedef void (*I2cDone_t)(I2cResult_t res, void *ctx);
+
+typedef struct {
+    uint8_t   addr;             // 8-bit bus address, as the BSP uses
+    uint8_t   write;
+    uint8_t   reg_size;         // 1 or 2 register address bytes
+    uint16_t  reg;
+    uint8_t  *data;             // must stay valid until the callback
+    uint16_t  len;
+    uint16_t  timeout_ms;       // 0: from the length and bus speed
+    I2cDone_t done;
+    void     *ctx;
+} I2cJob_t;
+
+typedef struct {
+    const char *name;
+    uint8_t  addr;
+    uint8_t  prio;
+    uint32_t jobs;
+    uint32_t nacks;
+    uint32_t errors;
+    uint32_t timeouts;
+    uint32_t max_wait_us;       // queued -> started
+    uint32_t max_xfer_us;       // started -> completed
+    uint32_t total_xfer_us;
+} I2cDevStats_t;
+
+typedef struct {
+    uint32_t khz;
+    uint32_t jobs;
+    uint32_t recoveries;
+    uint32_t queue_full;
+    uint32_t max_queued;
+} I2cBusStats_t;
+
+/* Idempotent; the BSP's I2Cx_Init() lands here */
+int  I2cBus_Init(void);
+void I2cBus_DeInit(void);
+
+/* Asynchronous: queued by device priority, started from the previous job's interrupt */
+int  I2cBus_Submit(const I2cJob_t *job);
+void I2cBus_Poll(void);
+uint32_t I2cBus_Pending(void);
+
+/* Blocking wrappers used by the BSP drivers: queue the job, wait for it */
+I2cResult_t I2cBus_Transfer(uint8_t addr, uint16_t reg, uint8_t reg_size,
+                            uint8_t *data, uint16_t len, int write);
+I2cResult_t I2cBus_Probe(uint8_t addr, uint32_t trials);
+
+uint32_t I2cBus_ByteUs(void);              // wire time of one byte at the current speed
+int  I2cBus_GetDeviceStats(int index, I2cDevStats_t *st);    // 0 past the last device
+void I2cBus_GetStats(I2cBusStats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __I2C_BUS_H */
@@ -0,0 +1,89 @@
+/******************************************************************************
+  * @file           : imu_codec.h
+  * @brief          : Delta / zig-zag / varint-or-Rice codec for IMU sample streams
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __IMU_CODEC_H
+#define __IMU_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Stream = sequence of self-contained blocks (random access per block):
+ *
+ *   byte 0     IMU_CODEC_MAGIC
+ *   byte 1     flags: IMU_CODEC_RICE, IMU_CODEC_ORDER2
+ *   byte 2..3  sample count (LE), >= 1
+ *   byte 4..5  total block length in bytes, header included (LE)
+ *   byte 6..21 first sample, raw int16 LE x IMU_CODEC_CHANNELS
+ *   ...        residuals of samples 1..n-1, channel-interleaved:
+ *              varint: zig-zag LEB128, 1..3 bytes each
+ *              Rice:   MSB-first bit stream, padded to a byte at block end
+ *
+ * Prediction is per channel, modulo 2^16: order 1 predicts the previous
+ * sample, order 2 predicts prev + (prev - prev2). Rice k adapts per
+ * channel from a running mean of the zig-zag values (reset every block).
+ */
+#define IMU_CODEC_CHANNELS      8       /* ax ay az gx gy gz sound state|sound_dt */
+#define IMU_CODEC_MAGIC         0xC5
+#define IMU_CODEC_RICE          0x01
+#define IMU_CODEC_ORDER2        0x02
+#define IMU_CODEC_HDR_SIZE      (6 + 2 * IMU_CODEC_CHANNELS)
+
+#define IMU_CODEC_RICE_ESCAPE   16      /* unary run that switches to a raw 16-bit value */
+#define IMU_CODEC_RICE_A_INIT   4
+#define IMU_CODEC_RICE_N_MAX    32      /* halve the running mean at this count */
+#define IMU_CODEC_MAX_SAMPLE    (4 * IMU_CODEC_CHANNELS)   /* worst-case encoded bytes */
+#define IMU_CODEC_MAX_BLOCK     2000    /* samples; keeps the block length field < 64 KB */
+
+typedef struct {
+    uint8_t  *out;                  // caller-owned output buffer
+    uint32_t cap;
+    uint32_t len;
+    int      overflow;
+
+    uint8_t  flags;
+    uint16_t block_samples;         // samples per block before a reset
+    uint32_t block_start;           // offset of the open block's header
+    uint16_t block_n;               // samples in the open block (0 = none open)
+
+    uint32_t acc;                   // Rice bit accumulator (MSB first)
+    uint32_t nbits;
+
+    int16_t  prev[IMU_CODEC_CHANNELS];
+    int16_t  delta[IMU_CODEC_CHANNELS];
+    uint32_t rice_a[IMU_CODEC_CHANNELS];
+    uint32_t rice_n[IMU_CODEC_CHANNELS];
+} ImuEncoder_t;
+
+void     ImuCodec_InitEncoder(ImuEncoder_t *e, uint8_t *out, uint32_t cap,
+                              uint8_t flags, uint16_t block_samples);
+int      ImuCodec_Encode(ImuEncoder_t *e, const int16_t s[IMU_CODEC_CHANNELS]);
+uint32_t ImuCodec_Finish(ImuEncoder_t *e);
+
+static inline uint16_t ImuCodec_ZigZag(int16_t v)
+{
+    return (uint16_t)(((uint16_t)v << 1) ^ (uint16_t)(v >> 15));
+}
+
+static inline int16_t ImuCodec_UnZigZag(uint16_t u)
+{
+    return (int16_t)((u >> 1) ^ (uint16_t)-(int16_t)(u & 1));
+}
+
+static inline uint32_t ImuCodec_RiceK(uint32_t a, uint32_t n)
+{
+    uint32_t k = 0;
+    while ((n << k) < a && k < 16) k++;
+    return k;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IMU_CODEC_H */
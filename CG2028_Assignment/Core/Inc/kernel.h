@@ -0,0 +1,79 @@
+/******************************************************************************
+  * @file           : kernel.h
+  * @brief          : Minimal preemptive kernel (fixed priorities, PendSV switch, queues)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __KERNEL_H
+#define __KERNEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define KERNEL_MAX_THREADS      4       /* including the idle thread */
+#define KERNEL_IRQ_PRIORITY     15      /* PendSV and SVC: below every interrupt */
+#define KERNEL_TICKLESS_MIN_US  2000    /* idle stops SysTick only for gaps longer than this */
+#define KERNEL_LOAD_WINDOW_US   1000000 /* CPU usage is measured over this window */
+#define KERNEL_FOREVER          0xFFFFFFFFUL
+
+/*
+ * Every thread stack is carved from one arena in RAM2 (SRAM2). DMA reaches
+ * it: the blocking I2cBus_Transfer() hands its caller's stack buffer to
+ * I2C2 DMA and waits, so that buffer stays live until the transfer ends.
+ */
+#define KERNEL_STACK_ARENA_BYTES    12288
+#define KERNEL_IDLE_STACK_WORDS     128
+
+typedef void (*KernelEntry_t)(void *arg);
+
+/*
+ * Fixed-size message queue. Send never blocks and works from interrupts;
+ * one thread at a time may block in receive.
+ */
+typedef struct {
+    uint8_t  *buf;
+    uint16_t  msg_size;
+    uint16_t  len;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+    volatile int8_t   waiter;       // thread blocked in Kernel_QueueReceive, -1 = none
+    uint32_t  sent;
+    uint32_t  dropped;              // sends to a full queue
+    uint32_t  max_fill;
+} KernelQueue_t;
+
+typedef struct {
+    const char *name;
+    uint8_t  prio;
+    uint16_t cpu_permille;          // over the last KERNEL_LOAD_WINDOW_US
+    uint32_t stack_bytes;
+    uint32_t stack_used;            // high-water mark, from the fill pattern
+    uint32_t switches;              // times switched in
+} KernelThreadStats_t;
+
+/* Before any other call; sets up the idle thread and the TIM2 wake-up alarm */
+void Kernel_Init(void);
+
+/* 0 is the highest priority, each thread has its own. Returns the id, -1 if full or out of stack space. */
+int  Kernel_CreateThread(const char *name, KernelEntry_t entry, void *arg, uint8_t prio, uint32_t stack_words);
+
+/* Runs the highest-priority thread; never returns. main()'s stack then serves interrupts only. */
+void Kernel_Start(void);
+
+/* Thread context only */
+void Kernel_SleepUntil(uint32_t t_us);          // timestamp.h time
+void Kernel_Sleep(uint32_t us);
+
+void Kernel_QueueInit(KernelQueue_t *q, void *buf, uint16_t msg_size, uint16_t len);
+int  Kernel_QueueSend(KernelQueue_t *q, const void *msg);                  // thread or interrupt; 0 if full
+int  Kernel_QueueReceive(KernelQueue_t *q, void *msg, uint32_t timeout_us); // 0 on timeout
+
+int  Kernel_GetThreadStats(int id, KernelThreadStats_t *st);   // 0 past the last thread
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __KERNEL_H */
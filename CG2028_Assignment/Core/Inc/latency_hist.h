@@ -0,0 +1,47 @@
+/******************************************************************************
+  * @file           : latency_hist.h
+  * @brief          : Log2 histograms of microsecond latencies / jitter
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __LATENCY_HIST_H
+#define __LATENCY_HIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fmt.h"
+
+/*
+ * Bin 0 counts 0 us, bin k (1..LAT_HIST_BINS-2) counts [2^(k-1), 2^k) us,
+ * the last bin everything from 2^(LAT_HIST_BINS-2) us (~16 ms) up.
+ */
+#define LAT_HIST_BINS           16
+
+typedef struct {
+    uint32_t bins[LAT_HIST_BINS];
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+} LatencyHist_t;
+
+void     LatencyHist_Reset(LatencyHist_t *h);
+void     LatencyHist_Add(LatencyHist_t *h, uint32_t us);
+uint32_t LatencyHist_Mean(const LatencyHist_t *h);
+
+/* Smallest value with at least pct percent of the samples at or below it (bin upper edge) */
+uint32_t LatencyHist_Percentile(const LatencyHist_t *h, uint32_t pct);
+
+/* "name: n .., min .., mean .., p99 <= .., max .. us" */
+void     LatencyHist_Format(const LatencyHist_t *h, const char *name, Fmt_t *f);
+
+/* "  bins: .." up to the last non-empty bin, a separate line so each stays short on the UART */
+void     LatencyHist_FormatBins(const LatencyHist_t *h, Fmt_t *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LATENCY_HIST_H */
@@ -0,0 +1,49 @@
+/******************************************************************************
+  * @file           : loop_monitor.h
+  * @brief          : Sample-loop interval and deadline-miss monitor
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __LOOP_MONITOR_H
+#define __LOOP_MONITOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fall_detect.h"
+#include "latency_hist.h"
+#include "fmt.h"
+
+#define LOOP_MON_STATES         (STATE_CONFIRMED + 1)
+#define LOOP_MON_LINES          3       /* lines of LoopMonitor_Format() */
+
+typedef struct {
+    LatencyHist_t stretch;                  // interval beyond its nominal period, 0 if on time or early
+    uint32_t last_us;                       // previous sample
+    uint32_t period_us;                     // nominal period of the interval in progress, 0 before the first sample
+    uint32_t slack_us;                      // stretch allowed before a deadline counts as missed
+    uint32_t min_interval_us;
+    uint32_t max_interval_us;
+    uint32_t samples[LOOP_MON_STATES];      // intervals, by the FSM state at their end
+    uint32_t misses[LOOP_MON_STATES];       // of those, stretched past slack_us
+    uint32_t worst_us[LOOP_MON_STATES];     // largest stretch
+} LoopMonitor_t;
+
+void LoopMonitor_Init(LoopMonitor_t *m, uint32_t slack_us);
+
+/*
+ * Once per sample, at its start (timestamp.h us). The interval since the
+ * previous call is checked against the period that call passed;
+ * next_period_us is the one the loop has just scheduled.
+ */
+void LoopMonitor_Sample(LoopMonitor_t *m, uint32_t now_us, uint32_t next_period_us, FallState_t state);
+
+/* Line n (0 .. LOOP_MON_LINES-1) of the summary: stretch histogram, its bins, misses per state */
+void LoopMonitor_Format(const LoopMonitor_t *m, int n, Fmt_t *f);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LOOP_MONITOR_H */
@@ -0,0 +1,56 @@
+/******************************************************************************
+  * @file           : mag_heading.h
+  * @brief          : LIS3MDL rotation channel with hard/soft-iron calibration (fixed point)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __MAG_HEADING_H
+#define __MAG_HEADING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "config_store.h"
+
+/* Angles in deci-degrees like posture.h; field values in raw LSB (6842 LSB/gauss at +-4 gauss). */
+#define MAG_ODR_HZ              40      /* LIS3MDL output rate, above the read rate */
+#define MAG_READ_EVERY          2       /* IMU samples per magnetometer read (25 Hz at 20 ms) */
+#define MAG_HISTORY             16      /* calibrated vectors kept (~640 ms at 25 Hz) */
+#define MAG_PRE_EVENT_MS        500     /* reference field: this long before the trigger */
+#define MAG_CAL_MIN_SPAN        3000    /* per-axis min..max before a calibration counts (~0.45 gauss) */
+#define MAG_CAL_SAVE_LSB        300     /* offset change worth a flash write */
+#define MAG_CAL_SAVE_Q14        820     /* scale change worth a flash write (5 %) */
+#define MAG_CAL_SAVE_MIN_MS     600000  /* at most one calibration write per 10 min */
+
+typedef struct {
+    uint32_t samples;
+    uint32_t errors;            // I2C jobs that failed
+    uint32_t busy;              // read due while the previous one was still queued
+    uint32_t saves;             // calibrations written to the config store
+} MagHeadingStats_t;
+
+/* WHO_AM_I check, then 40 Hz continuous, +-4 gauss, BDU; loads the stored calibration */
+int  MagHeading_Init(void);
+
+/* Called with every IMU sample: every MAG_READ_EVERY-th call queues one
+ * sensor-priority I2C job for OUT_X..OUT_Z; the result is applied from I2cBus_Poll() */
+void MagHeading_Sample(void);
+
+/* Main loop: writes a newly learned calibration to the config store when idle */
+void MagHeading_Poll(void);
+
+/* Event window: the FSM trigger opens it, NORMAL closes it */
+void MagHeading_StartEvent(uint32_t tick);
+void MagHeading_StopEvent(void);
+
+int32_t MagHeading_GetEventRotation(void);     // largest angle from the reference field, 0 if uncalibrated
+int     MagHeading_IsCalibrated(void);
+const MagCalibration_t *MagHeading_GetCalibration(void);
+void    MagHeading_GetStats(MagHeadingStats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MAG_HEADING_H */
@@ -46,7 +46,9 @@ extern "C" {
 
 /* Exported macro ------------------------------------------------------------*/
 /* USER CODE BEGIN EM */
-
+/* Hot code executed from SRAM2 (.ramfunc in the linker scripts): no flash wait
+   states. noinline keeps LTO from folding it back into a caller in flash. */
+#define RAMFUNC                 __attribute__((section(".ramfunc"), noinline))
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
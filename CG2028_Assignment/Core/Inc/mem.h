@@ -0,0 +1,96 @@
+/******************************************************************************
+  * @file           : mem.h
+  * @brief          : Static memory: bump arenas and fixed-block object pools, no heap
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __MEM_H
+#define __MEM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define MEM_MAX_REGIONS         8       /* arenas + pools listed by Mem_GetStats */
+#define MEM_ALIGN               8       /* every arena allocation and pool block */
+
+/*
+ * Arena: one static buffer handed out front to back. Allocation is a
+ * pointer bump; memory only comes back in bulk, through a mark taken
+ * earlier (scratch) or never (buffers carved once at init).
+ */
+typedef struct {
+    const char *name;
+    uint8_t  *base;
+    uint32_t  size;
+    uint32_t  used;
+    uint32_t  peak;
+    uint32_t  fails;
+} MemArena_t;
+
+/*
+ * Pool: count blocks of one type with a free list threaded through the
+ * free blocks themselves. Alloc and free are O(1) and safe between an
+ * interrupt or thread and another thread (the list is updated with
+ * interrupts masked for a few instructions).
+ */
+typedef struct {
+    const char *name;
+    uint8_t  *blocks;
+    uint32_t  block_size;
+    uint32_t  count;
+    void     *free_list;
+    uint32_t  in_use;
+    uint32_t  peak;
+    uint32_t  fails;
+} MemPool_t;
+
+typedef struct {
+    const char *name;
+    uint8_t  is_pool;
+    uint32_t size;              // bytes (arena) or blocks (pool)
+    uint32_t block_size;        // pool only
+    uint32_t used;              // bytes or blocks now
+    uint32_t peak;
+    uint32_t fails;             // requests that did not fit
+} MemStats_t;
+
+#define MEM_ROUND(n)            (((n) + MEM_ALIGN - 1) & ~(uint32_t)(MEM_ALIGN - 1))
+
+/* Storage sized at compile time; pass the object to MemArena_Init / MemPool_Init once */
+#define MEM_ARENA(name, bytes) \
+    static uint8_t name##_storage[MEM_ROUND(bytes)] __attribute__((aligned(MEM_ALIGN))); \
+    static MemArena_t name = { #name, name##_storage, MEM_ROUND(bytes), 0, 0, 0 }
+
+/* Same, with the storage in a linker section (".ram2": SRAM2, not initialised at startup) */
+#define MEM_ARENA_IN(name, bytes, sect) \
+    static uint8_t name##_storage[MEM_ROUND(bytes)] __attribute__((section(sect), aligned(MEM_ALIGN))); \
+    static MemArena_t name = { #name, name##_storage, MEM_ROUND(bytes), 0, 0, 0 }
+
+#define MEM_POOL(name, type, n) \
+    static uint8_t name##_storage[(n) * MEM_ROUND(sizeof(type) > sizeof(void *) ? sizeof(type) : sizeof(void *))] \
+        __attribute__((aligned(MEM_ALIGN))); \
+    static MemPool_t name = { #name, name##_storage, \
+        MEM_ROUND(sizeof(type) > sizeof(void *) ? sizeof(type) : sizeof(void *)), (n), NULL, 0, 0, 0 }
+
+/* Resets the region and lists it in Mem_GetStats */
+void  MemArena_Init(MemArena_t *a);
+void  MemPool_Init(MemPool_t *p);
+
+/* MEM_ALIGN-aligned; NULL (and counted) if it does not fit */
+void    *MemArena_Alloc(MemArena_t *a, uint32_t size);
+uint32_t MemArena_Mark(const MemArena_t *a);
+void     MemArena_Release(MemArena_t *a, uint32_t mark);     // frees everything allocated since the mark
+
+void *MemPool_Alloc(MemPool_t *p);                          // NULL (and counted) when all blocks are out
+int   MemPool_Free(MemPool_t *p, void *block);              // 0 for a pointer that is not one of its blocks
+
+int   Mem_GetStats(int n, MemStats_t *st);                  // 0 past the last region
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MEM_H */
@@ -0,0 +1,72 @@
+/******************************************************************************
+  * @file           : nfc_status.h
+  * @brief          : Tap-to-read status record and log mailbox on the ST25DV tag
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __NFC_STATUS_H
+#define __NFC_STATUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define NFC_EVENTS_SHOWN        5       /* history lines in the record */
+#define NFC_AREA_SIZE           256     /* user EEPROM bytes owned by the record (CC + NDEF) */
+#define NFC_WRITE_MAX           16      /* bytes per EEPROM write transaction */
+#define NFC_BLOCK_WRITE_MS      5       /* tag programming time per 4-byte block */
+#define NFC_REFRESH_MS          600000  /* rewrite supply / uptime this often if nothing else changed */
+#define NFC_MB_POLL_MS          200     /* mailbox check period */
+#define NFC_MB_CHUNK            64      /* log bytes per mailbox reply */
+
+/*
+ * Mailbox protocol (fast transfer mode, one message each way). The phone
+ * writes a request, the firmware answers in the mailbox:
+ *
+ *   'I'                      -> 'I', head_addr(4), next_rec_seq(4), sector_seq(4)
+ *   'R' addr(4) len(1)       -> 'R', addr(4), len(1), len bytes of QSPI flash
+ *   anything else            -> 'E', first request byte
+ *
+ * Multi-byte fields are little endian. The log layout is the one in
+ * blackbox.h, so a phone app walks it from the head backwards with 'R'.
+ */
+#define NFC_MB_INFO             'I'
+#define NFC_MB_READ             'R'
+#define NFC_MB_ERROR            'E'
+#define NFC_MB_REQ_MAX          8
+
+typedef struct {
+    uint32_t renders;           // record rebuilt in RAM
+    uint32_t writes;            // EEPROM write transactions
+    uint32_t bytes_written;
+    uint32_t bytes_clean;       // rendered bytes that matched the tag and were skipped
+    uint32_t nacks;             // tag busy (RF session or programming)
+    uint32_t errors;
+    uint32_t mb_requests;
+    uint32_t mb_bytes;          // log bytes sent through the mailbox
+} NfcStatusStats_t;
+
+int  NfcStatus_Init(void);
+
+/*
+ * slot_ms = time left before the next IMU sample is due. Each call queues
+ * at most one background I2C job, and only if it finishes inside the slot;
+ * its result is applied from I2cBus_Poll(). Timing per transfer is in the
+ * bus scheduler's device stats (I2cBus_GetDeviceStats).
+ */
+void NfcStatus_Poll(uint32_t slot_ms);
+
+/* RAM-only updates; the tag is rewritten later by NfcStatus_Poll() */
+void NfcStatus_SetArmed(int armed);
+void NfcStatus_SetSupply(uint32_t mv);
+void NfcStatus_LogEvent(uint8_t code);     // BlackBoxEventCode_t
+
+int  NfcStatus_IsPresent(void);
+void NfcStatus_GetStats(NfcStatusStats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NFC_STATUS_H */
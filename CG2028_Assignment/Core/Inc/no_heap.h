@@ -0,0 +1,17 @@
+/******************************************************************************
+  * @file           : no_heap.h
+  * @brief          : Compile-time ban on the newlib heap in sampling / detection sources
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Include LAST, after every system header (stdlib.h itself names these
+ * functions). Any later use of them is then a compile error; mem.h has
+ * the static replacements. makefile.targets repeats the check on the
+ * objects at link time, which also catches calls from assembly.
+ */
+#ifndef __NO_HEAP_H
+#define __NO_HEAP_H
+
+#pragma GCC poison malloc calloc realloc free _sbrk
+
+#endif /* __NO_HEAP_H */
@@ -0,0 +1,36 @@
+/******************************************************************************
+  * @file           : noise_floor.h
+  * @brief          : Adaptive background-noise (sound floor) estimator
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __NOISE_FLOOR_H
+#define __NOISE_FLOOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Levels are in dB re 1 ADC LSB, stored as Q8 (256 = 1 dB). 12-bit ADC -> 0..72 dB. */
+#define NOISE_BINS                80       /* 1 dB per histogram bin */
+#define NOISE_DECAY_SHIFT         9        /* weight grows by 1/512 per sample: ~10 s memory at 50 Hz */
+#define NOISE_FLOOR_QUANTILE      50       /* percent: the noise floor, typical background */
+#define NOISE_LOUD_MARGIN_DB      15       /* default: loud = this many dB above the floor */
+#define NOISE_MIN_THRESHOLD_DB    40       /* never call anything under ~100 LSB p2p loud */
+
+void     NoiseFloor_Init(void);
+void     NoiseFloor_Update(uint32_t envelope);
+int      NoiseFloor_IsLoud(uint32_t envelope);
+void     NoiseFloor_SetMarginDb(int32_t margin_db);
+
+int32_t  NoiseFloor_ToDb(uint32_t envelope);
+int32_t  NoiseFloor_GetQuantileDb(uint32_t percent);
+int32_t  NoiseFloor_GetFloorDb(void);
+int32_t  NoiseFloor_GetThresholdDb(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NOISE_FLOOR_H */
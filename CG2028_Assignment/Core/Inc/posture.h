@@ -0,0 +1,34 @@
+/******************************************************************************
+  * @file           : posture.h
+  * @brief          : Gravity-vector posture / tilt estimation (fixed point)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __POSTURE_H
+#define __POSTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* All angles are returned in deci-degrees (0.1 deg), e.g. 900 = 90.0 deg. */
+#define POSTURE_LPF_SHIFT        4      /* gravity low-pass: alpha = 1/16 per sample */
+
+void    Posture_Init(void);
+void    Posture_Update(const int16_t accel_mg[3]);
+void    Posture_CaptureReference(void);
+
+int32_t Posture_GetPitch(void);
+int32_t Posture_GetRoll(void);
+int32_t Posture_GetDelta(void);
+
+int32_t Posture_Atan2(int32_t y, int32_t x);
+int32_t Posture_Asin(int32_t num, int32_t den);
+uint32_t Posture_Isqrt(uint64_t v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __POSTURE_H */
@@ -0,0 +1,62 @@
+/******************************************************************************
+  * @file           : qspi_flash.h
+  * @brief          : MX25R6435F quad-SPI NOR driver (OCTOSPI1, interrupt driven)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __QSPI_FLASH_H
+#define __QSPI_FLASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define QSPI_FLASH_SIZE         0x800000UL      /* 8 MB */
+#define QSPI_SECTOR_SIZE        0x1000UL        /* 4 KB erase unit */
+#define QSPI_PAGE_SIZE          0x100UL         /* 256 B program unit */
+
+typedef enum {
+    QSPI_IDLE = 0,          // memory-mapped or ready to map
+    QSPI_PROGRAMMING,       // data phase running under IRQ
+    QSPI_WAIT_READY,        // auto-polling WIP after program/erase
+    QSPI_ERROR
+} QspiState_t;
+
+/* Throughput counters: bytes/s = bytes * SystemCoreClock / cycles */
+typedef struct {
+    uint32_t read_bytes;        // copied out by QspiFlash_Read()
+    uint64_t read_cycles;
+    uint32_t prog_bytes;
+    uint64_t prog_cycles;       // command issue to WIP clear
+    uint32_t erases;
+    uint64_t erase_cycles;
+    uint32_t map_acquires;
+    uint32_t to_mapped;         // mode switches
+    uint32_t to_indirect;
+    uint32_t deferred;          // program/erase refused while a pointer was leased
+} QspiStats_t;
+
+/* Boot-time blocking bring-up (reset, quad enable); leaves the chip memory-mapped. */
+int  QspiFlash_Init(void);
+
+/* Zero-copy reads from the 0x90000000 window. NULL while program/erase runs. */
+const uint8_t *QspiFlash_MapAcquire(uint32_t addr);
+void QspiFlash_MapRelease(void);
+int  QspiFlash_Read(uint32_t addr, void *dst, uint32_t len);
+int  QspiFlash_IsMapped(void);
+
+/* Non-blocking: each call only starts the operation; completion comes from the IRQ. */
+int  QspiFlash_StartProgram(uint32_t addr, const void *src, uint32_t len);
+int  QspiFlash_StartErase(uint32_t sector_addr);
+
+int         QspiFlash_IsBusy(void);
+QspiState_t QspiFlash_GetState(void);
+void        QspiFlash_ClearError(void);
+void        QspiFlash_GetStats(QspiStats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __QSPI_FLASH_H */
@@ -0,0 +1,75 @@
+/******************************************************************************
+  * @file           : sched.h
+  * @brief          : Cooperative run-to-completion task scheduler (timer wheel + event queues)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __SCHED_H
+#define __SCHED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define SCHED_MAX_TASKS         8
+#define SCHED_TICK_US           1000    /* timer wheel resolution; periods are whole ticks */
+#define SCHED_WHEEL_SLOTS       64      /* power of two; longer periods go round the wheel */
+#define SCHED_QUEUE_LEN         8       /* events per task, power of two */
+#define SCHED_IDLE_FOREVER      0xFFFFFFFFUL
+
+/* Event code of a periodic release; any other code is the poster's own */
+#define SCHED_EV_TIMER          0
+
+/* Runs to completion; one call per periodic release or posted event */
+typedef void (*SchedTask_t)(uint8_t ev);
+
+/* Free-running microsecond clock (timestamp.h on the board, a simulated one on the host) */
+typedef uint32_t (*SchedClock_t)(void);
+
+/* Nothing to run for about idle_us (SCHED_IDLE_FOREVER: no timer armed); may sleep, must return */
+typedef void (*SchedIdle_t)(uint32_t idle_us);
+
+typedef struct {
+    const char *name;
+    uint32_t period_ms;         // 0: event-driven only
+    uint32_t deadline_us;       // release (or post) -> finished
+    uint32_t releases;          // timer expiries
+    uint32_t runs;
+    uint32_t overruns;          // released again before the previous release had run
+    uint32_t misses;            // finished later than deadline_us
+    uint32_t dropped;           // events lost to a full queue
+    uint32_t max_queued;        // most events waiting at once
+    uint32_t max_late_us;       // release -> start
+    uint32_t max_exec_us;
+    uint64_t total_exec_us;
+} SchedStats_t;
+
+void Sched_Init(SchedClock_t now_us, SchedIdle_t idle);
+
+/* Registration order is priority order, highest first. Returns the task id, -1 if full. */
+int  Sched_AddTask(const char *name, SchedTask_t fn, uint32_t period_ms, uint32_t deadline_us);
+
+/* Next release one new period after the last one (0 stops the timer); callable from the task itself */
+void Sched_SetPeriod(int id, uint32_t period_ms);
+
+/* Lock-free, callable from an interrupt; one producer context per task. 0 if the queue is full. */
+int  Sched_Post(int id, uint8_t ev);
+
+/* Runs the most urgent ready task and returns 1, or calls the idle hook once and returns 0 */
+int  Sched_RunOnce(void);
+void Sched_Run(void);
+
+/* Anything released or posted but not run yet (for an idle hook that checks with interrupts off) */
+int  Sched_Ready(void);
+
+/* Time until the next release of task id (SCHED_IDLE_FOREVER if it has no timer) */
+uint32_t Sched_UntilUs(int id);
+
+int  Sched_GetStats(int id, SchedStats_t *st);      // 0 past the last task
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SCHED_H */
@@ -0,0 +1,107 @@
+/******************************************************************************
+  * @file           : spsc_ring.h
+  * @brief          : Lock-free single-producer / single-consumer ring, generated per record type
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * SPSC_RING(Name, type, cap) defines Name_t, a ring of cap records (power
+ * of two), and static inline Name_Init / Name_Push / Name_Pop /
+ * Name_PopBatch / Name_Count. Exactly one context pushes (an ISR, a
+ * thread) and exactly one pops; neither needs a lock or masks interrupts.
+ *
+ * Indexes are free-running uint32_t, masked only to address the buffer,
+ * so full and empty never look alike. The producer writes the record,
+ * then publishes head with a release store; the consumer reads head with
+ * an acquire load before touching the record, and hands the slot back
+ * the same way through tail. On Cortex-M4 GCC turns these into DMBs
+ * around plain loads and stores; on the host they order real threads.
+ *
+ * Each side keeps a cached copy of the other side's index and only
+ * reloads it when that copy is not enough: the producer when the ring
+ * looks full or at a new high-water mark, the consumer when fewer records
+ * are known than it asked for.
+ * With SPSC_LINE set to the cache line size the two sides' fields sit on
+ * separate lines and a push rarely touches the consumer's line. The M4
+ * has no data cache, so on the target SPSC_LINE is 4 and costs no RAM.
+ */
+#ifndef __SPSC_RING_H
+#define __SPSC_RING_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef SPSC_LINE
+#if defined(__arm__)
+#define SPSC_LINE               4
+#else
+#define SPSC_LINE               64
+#endif
+#endif
+
+#define SPSC_LOAD_ACQUIRE(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SPSC_STORE_RELEASE(p, v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+#define SPSC_RING(Name, type, cap)                                                      \
+    _Static_assert((cap) >= 2 && ((cap) & ((cap) - 1)) == 0, #Name ": capacity must be a power of two"); \
+    typedef struct {                                                                    \
+        /* producer side */                                                             \
+        uint32_t head __attribute__((aligned(SPSC_LINE)));                              \
+        uint32_t tail_cache;                                                            \
+        uint32_t high_water;        /* most records queued at once, seen at push */     \
+        uint32_t overflows;         /* pushes refused because the ring was full */      \
+        /* consumer side */                                                             \
+        uint32_t tail __attribute__((aligned(SPSC_LINE)));                              \
+        uint32_t head_cache;                                                            \
+        type buf[cap] __attribute__((aligned(SPSC_LINE)));                              \
+    } Name##_t;                                                                         \
+                                                                                        \
+    static inline void Name##_Init(Name##_t *r)                                         \
+    {                                                                                   \
+        memset(r, 0, sizeof(*r));                                                       \
+    }                                                                                   \
+                                                                                        \
+    /* Producer only. 0 (and counted) if the ring is full. */                           \
+    static inline int Name##_Push(Name##_t *r, const type *item)                        \
+    {                                                                                   \
+        uint32_t head = r->head;                                                        \
+        if (head - r->tail_cache >= (cap)) {                                            \
+            r->tail_cache = SPSC_LOAD_ACQUIRE(&r->tail);                                \
+            if (head - r->tail_cache >= (cap)) {                                        \
+                r->overflows++;                                                         \
+                return 0;                                                               \
+            }                                                                           \
+        }                                                                               \
+        r->buf[head & ((cap) - 1)] = *item;                                             \
+        SPSC_STORE_RELEASE(&r->head, head + 1);                                         \
+        if (head + 1 - r->tail_cache > r->high_water) {                                 \
+            r->tail_cache = SPSC_LOAD_ACQUIRE(&r->tail);                                \
+            if (head + 1 - r->tail_cache > r->high_water)                               \
+                r->high_water = head + 1 - r->tail_cache;                               \
+        }                                                                               \
+        return 1;                                                                       \
+    }                                                                                   \
+                                                                                        \
+    /* Consumer only. Up to max records into out, oldest first; returns how many. */    \
+    static inline uint32_t Name##_PopBatch(Name##_t *r, type *out, uint32_t max)        \
+    {                                                                                   \
+        uint32_t tail = r->tail;                                                        \
+        if (r->head_cache - tail < max) r->head_cache = SPSC_LOAD_ACQUIRE(&r->head);    \
+        uint32_t n = r->head_cache - tail;                                              \
+        if (n > max) n = max;                                                           \
+        for (uint32_t k = 0; k < n; k++) out[k] = r->buf[(tail + k) & ((cap) - 1)];     \
+        if (n) SPSC_STORE_RELEASE(&r->tail, tail + n);                                  \
+        return n;                                                                       \
+    }                                                                                   \
+                                                                                        \
+    static inline int Name##_Pop(Name##_t *r, type *out)                                \
+    {                                                                                   \
+        return (int)Name##_PopBatch(r, out, 1);                                         \
+    }                                                                                   \
+                                                                                        \
+    /* Records queued: a snapshot, the other side may be moving */                      \
+    static inline uint32_t Name##_Count(Name##_t *r)                                    \
+    {                                                                                   \
+        return SPSC_LOAD_ACQUIRE(&r->head) - SPSC_LOAD_ACQUIRE(&r->tail);               \
+    }
+
+#endif /* __SPSC_RING_H */
@@ -0,0 +1,53 @@
+/******************************************************************************
+  * @file           : timestamp.h
+  * @brief          : Free-running 1 MHz TIM2 timestamps and sensor DRDY capture
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __TIMESTAMP_H
+#define __TIMESTAMP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define TIMESTAMP_HZ            1000000 /* TIM2 count rate: 1 us per count, wraps after ~71.6 min */
+#define TIMESTAMP_DRDY_PRIORITY 2       /* EXTI15_10: keeps the DRDY capture ahead of the bus IRQs */
+#define TIMESTAMP_DRDY_STALE_US 100000  /* no DRDY edge for this long: fall back to the read time */
+#define TIMESTAMP_ALARM_PRIORITY 3      /* TIM2 compare: kernel wake-ups, after DRDY and the bus */
+
+/*
+ * All timestamps are uint32_t microseconds from TIM2. Compare them only
+ * through unsigned differences (b - a), which stay correct across the
+ * wrap for intervals up to ~71 min.
+ */
+typedef struct {
+    uint32_t drdy_edges;        // LSM6DSL INT1 pulses seen
+    uint32_t drdy_stale;        // samples timed from the read because no edge was recent
+} TimestampStats_t;
+
+/* TIM2 as a 32-bit up-counter at TIMESTAMP_HZ from whatever PCLK1 is */
+int      Timestamp_Init(void);
+uint32_t Timestamp_Now(void);
+
+/* LSM6DSL accel data-ready on INT1 (pulsed) -> PD11 EXTI, rising edge */
+int      Timestamp_ImuDrdyInit(void);
+void     Timestamp_OnImuDrdy(void);         // from HAL_GPIO_EXTI_Callback
+
+/* When the sample read from read_us on was taken: its DRDY edge, or read_us if none is recent */
+uint32_t Timestamp_ImuSampleTime(uint32_t read_us);
+
+void     Timestamp_GetStats(TimestampStats_t *st);
+
+/* One-shot alarm on TIM2 channel 1: fn runs in the TIM2 interrupt at at_us (at once if already past) */
+typedef void (*TimestampAlarm_t)(void);
+void     Timestamp_AlarmInit(TimestampAlarm_t fn);
+void     Timestamp_SetAlarm(uint32_t at_us);
+void     Timestamp_CancelAlarm(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIMESTAMP_H */
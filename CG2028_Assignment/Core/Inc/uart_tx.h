@@ -0,0 +1,59 @@
+/******************************************************************************
+  * @file           : uart_tx.h
+  * @brief          : Interrupt-driven USART1 console output from a lock-free TX ring
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __UART_TX_H
+#define __UART_TX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "fmt.h"
+
+#define UART_TX_RING_BYTES      2048    /* ~180 ms of 115200 baud: the biggest banner plus status lines */
+#define UART_TX_IRQ_PRIORITY    13      /* USART1 TXE: after the sensors, buses and kernel wake-ups */
+
+typedef struct {
+    uint32_t bytes;             // handed to the USART
+    uint32_t high_water;        // most bytes queued at once
+    uint32_t dropped;           // cut off because the ring was full
+} UartTxStats_t;
+
+/* After HAL_UART_Init(&huart1): USART1 interrupt on, ring empty */
+void UartTx_Init(void);
+
+/*
+ * Formatting straight into the ring: Begin hands out a writer over the
+ * free space, Commit queues what was written and starts the interrupt.
+ * Only one context writes (the app thread, or main() before the kernel
+ * starts); what does not fit is dropped and counted, the caller never
+ * waits for the UART.
+ */
+void UartTx_Begin(Fmt_t *f);
+void UartTx_Commit(Fmt_t *f);
+
+/* Begin + one string + Commit */
+void UartTx_Write(const char *s);
+
+/*
+ * UartTx_Write that also stamps when the last character of s is handed to
+ * the USART (Timestamp_Now() in the interrupt). One mark at a time: a new
+ * one replaces a pending one. Returns 0 if s was dropped.
+ */
+int  UartTx_WriteMarked(const char *s);
+/* 1 once the marked text has gone out, with its time; the mark is then free */
+int  UartTx_TakeMark(uint32_t *sent_us);
+
+void UartTx_GetStats(UartTxStats_t *st);
+
+/* USART1_IRQHandler */
+void UartTx_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UART_TX_H */
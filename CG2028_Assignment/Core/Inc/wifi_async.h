@@ -0,0 +1,88 @@
+/******************************************************************************
+  * @file           : wifi_async.h
+  * @brief          : Non-blocking AT command pipeline for the ISM43362 (SPI3 DMA)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __WIFI_ASYNC_H
+#define __WIFI_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define WIFI_QUEUE_LEN      8       /* commands queued, running or awaiting their callback */
+#define WIFI_TX_MAX         80      /* AT text + '\r' + S3 payload (C2 takes a 64-char key) */
+#define WIFI_RESP_MAX       128     /* response bytes kept for the callback */
+#define WIFI_RX_CHUNK       32      /* bytes per DMA read while DRDY is high */
+#define WIFI_RING_SIZE      256     /* RX ring, a multiple of WIFI_RX_CHUNK */
+#define WIFI_RESET_HOLD_MS  10      /* RST low time before the module reboots */
+
+/* Submit flags */
+#define WIFI_F_CHAIN        0x01    /* skip (with the same result) if the previous command failed */
+
+typedef enum {
+    WIFI_OK = 0,
+    WIFI_ERROR,             // module answered ERROR
+    WIFI_TIMEOUT,           // no DRDY / no terminator before the deadline
+    WIFI_BUS_ERROR          // SPI or DMA error
+} WifiResult_t;
+
+/* Transport events, raised from interrupt context by the bus layer */
+typedef enum {
+    WIFI_EVT_DRDY = 0,      // DRDY rising edge
+    WIFI_EVT_TX_DONE,
+    WIFI_EVT_RX_DONE,
+    WIFI_EVT_BUS_ERROR
+} WifiEvent_t;
+
+/*
+ * Called from WifiAsync_Poll() (main loop context) once per command.
+ * `resp` is the payload between the leading "\r\n" and "\r\nOK\r\n> ",
+ * truncated to WIFI_RESP_MAX; it is only valid during the call.
+ */
+typedef void (*WifiDone_t)(WifiResult_t res, const uint8_t *resp, uint16_t len, void *ctx);
+
+typedef struct {
+    uint32_t commands;          // completed, any result
+    uint32_t errors;            // WIFI_ERROR
+    uint32_t timeouts;
+    uint32_t bus_errors;
+    uint32_t skipped;           // chained commands not run
+    uint32_t rx_bytes;          // clocked in, including 0x15 filler
+    uint32_t last_ms;           // start -> terminator of the last command
+    uint32_t max_ms;
+    uint32_t max_queued;
+} WifiAsyncStats_t;
+
+/* Opens the bus (SPI3 + DMA + DRDY interrupt); does not reset the module. */
+int  WifiAsync_Init(void);
+
+/*
+ * Queues "cmd\r" followed by `data` (S3 payload, may be NULL) and returns
+ * at once; 0 if the queue is full or the command does not fit. Commands
+ * run strictly in order, back to back from interrupt context.
+ */
+int  WifiAsync_Submit(const char *cmd, const uint8_t *data, uint16_t data_len,
+                      uint32_t timeout_ms, uint8_t flags, WifiDone_t done, void *ctx);
+
+/* Queues a hardware reset; completes when the boot prompt has been read. */
+int  WifiAsync_SubmitReset(uint32_t timeout_ms, uint8_t flags, WifiDone_t done, void *ctx);
+
+/* Main loop: fires deadlines and runs the completion callbacks. */
+void WifiAsync_Poll(void);
+
+/* Interrupt side: DRDY EXTI and SPI3 DMA completion/error callbacks. */
+void WifiAsync_OnEvent(WifiEvent_t ev);
+
+/* Commands not yet called back (queued + running + completed). */
+uint32_t WifiAsync_Pending(void);
+
+void WifiAsync_GetStats(WifiAsyncStats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WIFI_ASYNC_H */
@@ -0,0 +1,409 @@
+/******************************************************************************
+  * @file           : alert_client.c
+  * @brief          : Direct Wi-Fi alert publisher (ISM43362, persistent TCP)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Replaces the serial sentinel -> gateway.py -> HTTP hop for alerts: the
+ * board keeps one TCP connection to the alert server open through the
+ * on-board Inventek module and pushes a 16-byte binary frame per event
+ * (layout in alert_client.h).
+ *
+ *   - Frames are formatted when the event is raised (AlertClient_Publish)
+ *     and sit in a small queue, so sending is a single S3 transfer.
+ *   - One frame is in flight at a time; it leaves the queue only when the
+ *     server acks its sequence number.
+ *   - A full queue gives up a heartbeat first, then the oldest state
+ *     change; a fall or manual alarm is only ever displaced by another.
+ *   - Every failed step (init, join, connect, send, ack timeout) waits a
+ *     backoff that doubles from ALERT_BACKOFF_MIN_MS to _MAX_MS and resets
+ *     on the next ack. A module that stops answering is re-initialised,
+ *     a lost AP is re-joined, otherwise only the socket is reopened.
+ *
+ * All module traffic goes through wifi_async.c: each step (reset, join,
+ * connect, send, ack read) is queued as one chain of AT commands and runs
+ * from the SPI3 DMA / DRDY interrupts while the main loop keeps sampling.
+ * AlertClient_Poll() only collects the step's result and queues the next
+ * one. Socket 0, S2 and R1/R2 are set once per connection, so a frame is
+ * a single S3 and each ack poll a single R0.
+ *
+ * Builds on Linux against host/wifi_sim.c + host/wifi_mock.c for testing
+ * (host/alert_test.c), and against recorded AT transcripts (host/replay_test.c).
+ */
+#include "main.h"
+#include "alert_client.h"
+#include "wifi_async.h"
+#include "fmt.h"
+
+#include "string.h"
+
+#define ALERT_RESET_TIMEOUT_MS  2000    /* RST pulse + boot prompt */
+#define ALERT_JOIN_TIMEOUT_MS   10000   /* C0 can take seconds on a busy AP */
+#define ALERT_IO_TIMEOUT_MS     1000
+#define ALERT_SEND_TIMEOUT_MS   200     /* module-side S2 */
+#define ALERT_READ_WAIT_MS      50      /* module-side R2, per R0 */
+
+#define ALERT_SEC_OPEN          0       /* es_wifi.h ES_WIFI_SEC_OPEN */
+#define ALERT_SEC_WPA_WPA2      4       /* es_wifi.h ES_WIFI_SEC_WPA_WPA2 */
+
+// One step = one chain of AT commands; On_Step() gets the result of the last
+typedef enum {
+    STEP_INIT = 0,
+    STEP_JOIN,
+    STEP_CLOSE,
+    STEP_CONNECT,
+    STEP_CHECK_AP,
+    STEP_SEND,
+    STEP_READ
+} Step_t;
+
+static const uint8_t server_ip[4] = { ALERT_SERVER_IP };
+
+static AlertState_t state = ALERT_OFF;
+static int busy = 0;                // a step is queued on the Wi-Fi engine
+static int socket_open = 0;
+static uint32_t backoff_ms = ALERT_BACKOFF_MIN_MS;
+static uint32_t retry_at = 0;
+
+// Formatted once at init
+static char cmd_ssid[40];
+static char cmd_pass[72];
+static char cmd_sec[8];
+static char cmd_ip[24];
+static char cmd_port[12];
+static char cmd_send[12];
+static char cmd_read_len[8];
+static char cmd_send_wait[12];
+static char cmd_read_wait[12];
+
+// Pre-formatted frames, oldest at q_head
+static uint8_t  queue[ALERT_QUEUE_LEN][ALERT_FRAME_SIZE];
+static uint32_t queue_tick[ALERT_QUEUE_LEN];
+static uint32_t q_head = 0;
+static uint32_t q_count = 0;
+static uint16_t next_seq = 0;
+
+static uint32_t sent_at = 0;
+static uint32_t last_tx = 0;
+static uint8_t  ack_buf[ALERT_ACK_SIZE];
+static uint16_t ack_len = 0;
+
+static AlertStats_t stats;
+
+// ======================= QUEUE =========================
+
+static void Put16(uint8_t *p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static void Put32(uint8_t *p, uint32_t v) { Put16(p, (uint16_t)v); Put16(p + 2, (uint16_t)(v >> 16)); }
+
+// What a full queue gives up first: heartbeats, then state changes; alarms last
+static int Frame_Priority(uint8_t type)
+{
+    if (type == ALERT_HEARTBEAT) return 0;
+    if (type == ALERT_FALL || type == ALERT_MANUAL) return 2;
+    return 1;
+}
+
+// Full queue: removes the oldest lowest-priority frame that is not in flight,
+// unless every such frame outranks the new one. Returns 0 if the new one is dropped.
+static int Make_Room(AlertType_t type)
+{
+    uint32_t first = (state == ALERT_WAIT_ACK || (state == ALERT_READY && busy)) ? 1 : 0;
+    uint32_t victim = first;
+    for (uint32_t k = first + 1; k < q_count; k++) {
+        if (Frame_Priority(queue[(q_head + k) % ALERT_QUEUE_LEN][1]) <
+            Frame_Priority(queue[(q_head + victim) % ALERT_QUEUE_LEN][1])) victim = k;
+    }
+    stats.dropped++;
+    if (victim >= q_count ||
+        Frame_Priority(queue[(q_head + victim) % ALERT_QUEUE_LEN][1]) > Frame_Priority((uint8_t)type)) return 0;
+
+    // Close the gap: the frames behind the victim move up one slot
+    for (uint32_t k = victim; k + 1 < q_count; k++) {
+        uint32_t to = (q_head + k) % ALERT_QUEUE_LEN, from = (q_head + k + 1) % ALERT_QUEUE_LEN;
+        memcpy(queue[to], queue[from], ALERT_FRAME_SIZE);
+        queue_tick[to] = queue_tick[from];
+    }
+    q_count--;
+    return 1;
+}
+
+static void Enqueue(AlertType_t type, int16_t value0, int16_t value1, uint32_t event_us, uint32_t now)
+{
+    if (q_count == ALERT_QUEUE_LEN && !Make_Room(type)) return;
+
+    uint32_t slot = (q_head + q_count) % ALERT_QUEUE_LEN;
+    uint8_t *f = queue[slot];
+    f[0] = ALERT_FRAME_MAGIC;
+    f[1] = (uint8_t)type;
+    Put16(f + 2, next_seq++);
+    Put32(f + 4, now);
+    Put16(f + 8, (uint16_t)value0);
+    Put16(f + 10, (uint16_t)value1);
+    Put32(f + 12, event_us);
+    queue_tick[slot] = now;
+    q_count++;
+}
+
+// ======================= LINK STATE =========================
+
+static int Retry_Due(uint32_t now)
+{
+    return (int32_t)(now - retry_at) >= 0;
+}
+
+// A step failed: fall back to `to` and wait out the backoff
+static void Step_Failed(AlertState_t to, uint32_t now)
+{
+    if (to == ALERT_DOWN) socket_open = 0;
+    // A heartbeat is only worth sending on a live link; real alerts stay queued
+    if (q_count && queue[q_head][1] == ALERT_HEARTBEAT) {
+        q_head = (q_head + 1) % ALERT_QUEUE_LEN;
+        q_count--;
+    }
+    state = to;
+    stats.failures++;
+    retry_at = now + backoff_ms;
+    backoff_ms = (backoff_ms * 2 > ALERT_BACKOFF_MAX_MS) ? ALERT_BACKOFF_MAX_MS : backoff_ms * 2;
+}
+
+static void Handle_Ack(uint32_t now)
+{
+    const uint8_t *f = queue[q_head];
+    if (ack_buf[0] != ALERT_ACK_MAGIC || ack_buf[2] != f[2] || ack_buf[3] != f[3]) return;
+
+    stats.acked++;
+    stats.last_latency_ms = now - queue_tick[q_head];
+    if (stats.last_latency_ms > stats.max_latency_ms) stats.max_latency_ms = stats.last_latency_ms;
+
+    q_head = (q_head + 1) % ALERT_QUEUE_LEN;
+    q_count--;
+    backoff_ms = ALERT_BACKOFF_MIN_MS;
+    state = ALERT_READY;
+}
+
+// ======================= AT STEPS =========================
+
+static void On_Step(WifiResult_t res, const uint8_t *resp, uint16_t len, void *ctx);
+
+// Queues the commands as one chain: the first failure skips the rest
+static int Submit_Step(Step_t step, uint32_t timeout_ms, const char *const *cmds, int n)
+{
+    if (WifiAsync_Pending() + (uint32_t)n > WIFI_QUEUE_LEN) return 0;
+    for (int i = 0; i < n; i++) {
+        WifiAsync_Submit(cmds[i], NULL, 0, timeout_ms, i ? WIFI_F_CHAIN : 0,
+                         (i == n - 1) ? On_Step : NULL, (void *)(uintptr_t)step);
+    }
+    busy = 1;
+    return 1;
+}
+
+static void On_Step(WifiResult_t res, const uint8_t *resp, uint16_t len, void *ctx)
+{
+    Step_t step = (Step_t)(uintptr_t)ctx;
+    uint32_t now = HAL_GetTick();
+
+    busy = 0;
+    // No answer at all: the module is gone or wedged, start over with a reset
+    if (res == WIFI_TIMEOUT || res == WIFI_BUS_ERROR) {
+        Step_Failed(ALERT_DOWN, now);
+        return;
+    }
+
+    switch (step) {
+    case STEP_INIT:
+        if (res == WIFI_OK) state = ALERT_NO_AP;
+        else Step_Failed(ALERT_DOWN, now);
+        return;
+
+    case STEP_JOIN:
+        if (res == WIFI_OK) state = ALERT_NO_SOCKET;
+        else Step_Failed(ALERT_NO_AP, now);
+        return;
+
+    case STEP_CLOSE:
+        socket_open = 0;                        // connect follows on the next poll
+        return;
+
+    case STEP_CONNECT: {
+        if (res == WIFI_OK) {
+            socket_open = 1;
+            stats.reconnects++;
+            last_tx = now;
+            state = ALERT_READY;
+            return;
+        }
+        // Still joined? Decides between reopening the socket and re-joining
+        static const char *const cs[] = { "CS" };
+        if (!Submit_Step(STEP_CHECK_AP, ALERT_IO_TIMEOUT_MS, cs, 1)) Step_Failed(ALERT_NO_SOCKET, now);
+        return;
+    }
+
+    case STEP_CHECK_AP:
+        Step_Failed((res == WIFI_OK && len > 0 && resp[0] == '1') ? ALERT_NO_SOCKET : ALERT_NO_AP, now);
+        return;
+
+    case STEP_SEND:
+        // The module reports a failed socket write as "-1"
+        if (res != WIFI_OK || (len >= 2 && resp[0] == '-' && resp[1] == '1')) {
+            Step_Failed(ALERT_NO_SOCKET, now);
+            return;
+        }
+        sent_at = last_tx = now;
+        ack_len = 0;
+        state = ALERT_WAIT_ACK;
+        return;
+
+    case STEP_READ:
+        if (res != WIFI_OK) {
+            Step_Failed(ALERT_NO_SOCKET, now);
+            return;
+        }
+        if (len > ALERT_ACK_SIZE - ack_len) len = ALERT_ACK_SIZE - ack_len;
+        memcpy(ack_buf + ack_len, resp, len);
+        ack_len += len;
+        if (ack_len == ALERT_ACK_SIZE) {
+            Handle_Ack(now);
+            ack_len = 0;
+        }
+        return;
+    }
+}
+
+// ======================= PUBLIC API =========================
+
+// "key=text" / "key=number" into one of the command buffers
+static void Cmd_Text(char *cmd, uint32_t cap, const char *key, const char *text)
+{
+    Fmt_t f;
+    Fmt_Init(&f, cmd, cap);
+    Fmt_Str(&f, key);
+    Fmt_Str(&f, text);
+    Fmt_End(&f);
+}
+
+static void Cmd_Num(char *cmd, uint32_t cap, const char *key, uint32_t v, int width)
+{
+    Fmt_t f;
+    Fmt_Init(&f, cmd, cap);
+    Fmt_Str(&f, key);
+    Fmt_UintPad(&f, v, width, '0');
+    Fmt_End(&f);
+}
+
+int AlertClient_Init(void)
+{
+    memset(&stats, 0, sizeof(stats));
+    if (ALERT_WIFI_SSID[0] == '\0') {
+        state = ALERT_OFF;
+        return 0;
+    }
+
+    Cmd_Text(cmd_ssid, sizeof(cmd_ssid), "C1=", ALERT_WIFI_SSID);
+    Cmd_Text(cmd_pass, sizeof(cmd_pass), "C2=", ALERT_WIFI_PASSWORD);
+    Cmd_Num(cmd_sec, sizeof(cmd_sec), "C3=", ALERT_WIFI_PASSWORD[0] ? ALERT_SEC_WPA_WPA2 : ALERT_SEC_OPEN, 0);
+    Fmt_t f;
+    Fmt_Init(&f, cmd_ip, sizeof(cmd_ip));
+    Fmt_Str(&f, "P3=");
+    for (int k = 0; k < 4; k++) {
+        if (k) Fmt_Char(&f, '.');
+        Fmt_Uint(&f, server_ip[k]);
+    }
+    Fmt_End(&f);
+    Cmd_Num(cmd_port, sizeof(cmd_port), "P4=", ALERT_SERVER_PORT, 0);
+    Cmd_Num(cmd_send, sizeof(cmd_send), "S3=", ALERT_FRAME_SIZE, 4);
+    Cmd_Num(cmd_send_wait, sizeof(cmd_send_wait), "S2=", ALERT_SEND_TIMEOUT_MS, 0);
+    Cmd_Num(cmd_read_len, sizeof(cmd_read_len), "R1=", ALERT_ACK_SIZE, 0);
+    Cmd_Num(cmd_read_wait, sizeof(cmd_read_wait), "R2=", ALERT_READ_WAIT_MS, 0);
+
+    state = ALERT_DOWN;
+    busy = 0;
+    socket_open = 0;
+    retry_at = HAL_GetTick();
+    if (!WifiAsync_Init()) return 0;
+
+    // Queue the module reset; it completes in the background
+    AlertClient_Poll();
+    return 1;
+}
+
+void AlertClient_Poll(void)
+{
+    if (state == ALERT_OFF) return;
+
+    WifiAsync_Poll();                           // runs On_Step() for finished steps
+    if (busy) return;
+
+    uint32_t now = HAL_GetTick();
+    switch (state) {
+    case ALERT_OFF:
+        return;
+
+    case ALERT_DOWN: {
+        static const char *const info[] = { "I?" };
+        if (!Retry_Due(now)) return;
+        if (WifiAsync_Pending() + 2 > WIFI_QUEUE_LEN) return;
+        WifiAsync_SubmitReset(ALERT_RESET_TIMEOUT_MS, 0, NULL, NULL);
+        Submit_Step(STEP_INIT, ALERT_IO_TIMEOUT_MS, info, 1);
+        return;
+    }
+
+    case ALERT_NO_AP: {
+        const char *join[] = { cmd_ssid, cmd_pass, cmd_sec, "C0" };
+        if (!Retry_Due(now)) return;
+        Submit_Step(STEP_JOIN, ALERT_JOIN_TIMEOUT_MS, join, 4);
+        return;
+    }
+
+    case ALERT_NO_SOCKET: {
+        // Close the dead connection first so the module frees socket 0
+        static const char *const close[] = { "P0=0", "P6=0" };
+        const char *open[] = { "P0=0", "P1=0", cmd_ip, cmd_port,
+                               cmd_send_wait, cmd_read_len, cmd_read_wait, "P6=1" };
+        if (!Retry_Due(now)) return;
+        if (socket_open) Submit_Step(STEP_CLOSE, ALERT_IO_TIMEOUT_MS, close, 2);
+        else Submit_Step(STEP_CONNECT, ALERT_IO_TIMEOUT_MS, open, 8);
+        return;
+    }
+
+    case ALERT_READY:
+        if (q_count == 0) {
+            if (now - last_tx < ALERT_HEARTBEAT_MS) return;
+            Enqueue(ALERT_HEARTBEAT, 0, 0, 0, now);
+        }
+        // Socket, S2 and R1/R2 were set when the connection opened: one S3 per frame
+        if (WifiAsync_Submit(cmd_send, queue[q_head], ALERT_FRAME_SIZE,
+                             ALERT_SEND_TIMEOUT_MS + ALERT_IO_TIMEOUT_MS, 0,
+                             On_Step, (void *)(uintptr_t)STEP_SEND)) {
+            busy = 1;
+            stats.sends++;
+        }
+        return;
+
+    case ALERT_WAIT_ACK: {
+        static const char *const read[] = { "R0" };
+        if (now - sent_at > ALERT_ACK_TIMEOUT_MS) {
+            Step_Failed(ALERT_NO_SOCKET, now);
+            return;
+        }
+        Submit_Step(STEP_READ, ALERT_READ_WAIT_MS + ALERT_IO_TIMEOUT_MS, read, 1);
+        return;
+    }
+    }
+}
+
+void AlertClient_Publish(AlertType_t type, int16_t value0, int16_t value1, uint32_t event_us)
+{
+    if (state == ALERT_OFF) return;
+    stats.published++;
+    Enqueue(type, value0, value1, event_us, HAL_GetTick());
+}
+
+AlertState_t AlertClient_GetState(void)
+{
+    return state;
+}
+
+void AlertClient_GetStats(AlertStats_t *st)
+{
+    *st = stats;
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+  * @file           : alert_trace.c
+  * @brief          : Time-to-alarm tracing, from the trigger sample to the sentinel on the wire
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The sentinel gateway.py waits for is the first thing in every alarm
+ * banner. It goes into the TX ring on its own, with a mark, so the UART
+ * interrupt stamps the moment its last character leaves. The board-side
+ * stamps are then printed on one line for gateway.py to log next to its
+ * own receive and Telegram times; latency_report.py turns the log
+ * into per-stage distributions.
+ *
+ * Every stamp comes from TIM2, so the board stages are exact. The step
+ * from the UART to the gateway crosses two clocks and is estimated there.
+ */
+#include "alert_trace.h"
+#include "uart_tx.h"
+#include "timestamp.h"
+#include "fmt.h"
+#include "no_heap.h"
+
+static const char *const kind_names[] = { "crash", "delayed", "still", "manual" };
+
+static AlertTrace_t pending;        // waiting for the UART
+static AlertTrace_t last;
+static uint8_t pending_valid = 0;
+static uint8_t last_valid = 0;
+static uint32_t next_id = 1;
+
+int AlertTrace_Sentinel(AlertTraceKind_t kind, uint32_t trigger_us, uint32_t confirm_us, uint32_t decided_us)
+{
+    pending_valid = 0;
+    if (!UartTx_WriteMarked("\r\n" ALERT_SENTINEL "\r\n")) return 0;
+
+    pending.queued_us = Timestamp_Now();
+    pending.id = next_id++;
+    pending.kind = (uint8_t)kind;
+    pending.trigger_us = trigger_us;
+    pending.confirm_us = confirm_us;
+    pending.decided_us = decided_us;
+    pending.sent_us = 0;
+    pending_valid = 1;
+    return 1;
+}
+
+void AlertTrace_Poll(void)
+{
+    Fmt_t f;
+
+    if (!pending_valid || !UartTx_TakeMark(&pending.sent_us)) return;
+    pending_valid = 0;
+    last = pending;
+    last_valid = 1;
+
+    // Also while the alarm silences the console: the gateway needs it to close the trace
+    UartTx_Begin(&f);
+    Fmt_Str(&f, ALERT_TRACE_TAG " id=");
+    Fmt_Uint(&f, last.id);
+    Fmt_Str(&f, " kind=");
+    Fmt_Str(&f, kind_names[last.kind]);
+    Fmt_Str(&f, " trigger=");
+    Fmt_Uint(&f, last.trigger_us);
+    Fmt_Str(&f, " confirm=");
+    Fmt_Uint(&f, last.confirm_us);
+    Fmt_Str(&f, " decided=");
+    Fmt_Uint(&f, last.decided_us);
+    Fmt_Str(&f, " queued=");
+    Fmt_Uint(&f, last.queued_us);
+    Fmt_Str(&f, " sent=");
+    Fmt_Uint(&f, last.sent_us);
+    Fmt_Str(&f, "\r\n");
+    UartTx_Commit(&f);
+}
+
+int AlertTrace_GetLast(AlertTrace_t *t)
+{
+    if (!last_valid) return 0;
+    *t = last;
+    return 1;
+}
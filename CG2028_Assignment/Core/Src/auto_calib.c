@@ -0,0 +1,300 @@
+/******************************************************************************
+  * @file           : auto_calib.c
+  * @brief          : Guided on-device threshold calibration (Drop/Tumble/Recovery)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * On-board version of the calibration.c logger. Instead of reading [PEAKS]
+ * lines off Tera Term and editing main.c, the wearer holds the blue button
+ * for 3 s and follows the prompts (beep = start recording, double beep = stop):
+ *
+ *   STILL   : hold the board flat against your chest    -> resting deviation
+ *   DROP    : fall backward onto a bed                  -> ACCEL_THRESHOLD_HIGH / LOW
+ *   TUMBLE  : fall sideways onto the bed                -> GYRO_THRESHOLD
+ *   ROLL    : lie on your back and roll gently          -> rolling deviation (P95)
+ *   SIT-UP  : do a strict sit-up                        -> sit-up deviation
+ *
+ * Each phase feeds streaming min/max/P-square quantile trackers. No sample
+ * buffers are kept. The resulting thresholds are sanity-checked and handed
+ * to the config store, which persists them and switches them in once the
+ * flash write completes.
+ *
+ * The step runs inside the detect task, so it never waits on the buzzer:
+ * beeps are queued here and played out by the UI task's beeper.
+ */
+#include "main.h"
+#include "auto_calib.h"
+#include "config_store.h"
+#include "uart_tx.h"
+
+#include "string.h"
+#include <math.h>
+
+// ======================= P-SQUARE STREAMING STATS =========================
+
+void CalStats_Init(CalStats_t *s, float p)
+{
+    memset(s, 0, sizeof(*s));
+    s->p = p;
+    s->min = 1e9f;
+    s->max = -1e9f;
+}
+
+static float Parabolic(const CalStats_t *s, int i, float d)
+{
+    return s->q[i] + d / (s->n[i + 1] - s->n[i - 1]) *
+           ((s->n[i] - s->n[i - 1] + d) * (s->q[i + 1] - s->q[i]) / (s->n[i + 1] - s->n[i]) +
+            (s->n[i + 1] - s->n[i] - d) * (s->q[i] - s->q[i - 1]) / (s->n[i] - s->n[i - 1]));
+}
+
+void CalStats_Add(CalStats_t *s, float x)
+{
+    if (x < s->min) s->min = x;
+    if (x > s->max) s->max = x;
+
+    if (s->count < 5) {
+        s->q[s->count++] = x;
+        if (s->count == 5) {
+            for (int a = 1; a < 5; a++) {
+                for (int b = a; b > 0 && s->q[b] < s->q[b - 1]; b--) {
+                    float t = s->q[b]; s->q[b] = s->q[b - 1]; s->q[b - 1] = t;
+                }
+            }
+            float p = s->p;
+            for (int k = 0; k < 5; k++) s->n[k] = (float)(k + 1);
+            s->np[0] = 1.0f;  s->np[1] = 1.0f + 2.0f * p;  s->np[2] = 1.0f + 4.0f * p;
+            s->np[3] = 3.0f + 2.0f * p;  s->np[4] = 5.0f;
+            s->dn[0] = 0.0f;  s->dn[1] = p / 2.0f;  s->dn[2] = p;
+            s->dn[3] = (1.0f + p) / 2.0f;  s->dn[4] = 1.0f;
+        }
+        return;
+    }
+    s->count++;
+
+    int k;
+    if (x < s->q[0])       { s->q[0] = x; k = 0; }
+    else if (x >= s->q[4]) { s->q[4] = x; k = 3; }
+    else {
+        k = 0;
+        while (k < 3 && x >= s->q[k + 1]) k++;
+    }
+
+    for (int i = k + 1; i < 5; i++) s->n[i] += 1.0f;
+    for (int i = 0; i < 5; i++) s->np[i] += s->dn[i];
+
+    for (int i = 1; i < 4; i++) {
+        float d = s->np[i] - s->n[i];
+        if ((d >= 1.0f && s->n[i + 1] - s->n[i] > 1.0f) ||
+            (d <= -1.0f && s->n[i - 1] - s->n[i] < -1.0f)) {
+            float ds = (d > 0.0f) ? 1.0f : -1.0f;
+            float qp = Parabolic(s, i, ds);
+            if (s->q[i - 1] < qp && qp < s->q[i + 1]) {
+                s->q[i] = qp;
+            } else {
+                int j = i + (int)ds;
+                s->q[i] += ds * (s->q[j] - s->q[i]) / (s->n[j] - s->n[i]);
+            }
+            s->n[i] += ds;
+        }
+    }
+}
+
+float CalStats_Quantile(const CalStats_t *s)
+{
+    if (s->count == 0) return 0.0f;
+    if (s->count >= 5) return s->q[2];
+
+    // Fewer than five samples: exact quantile of what we have
+    float v[5];
+    for (uint32_t a = 0; a < s->count; a++) {
+        v[a] = s->q[a];
+        for (uint32_t b = a; b > 0 && v[b] < v[b - 1]; b--) {
+            float t = v[b]; v[b] = v[b - 1]; v[b - 1] = t;
+        }
+    }
+    return v[(uint32_t)(s->p * (float)(s->count - 1) + 0.5f)];
+}
+
+// ======================= GUIDED ROUTINE =========================
+
+typedef enum {
+    CAL_IDLE = 0,
+    CAL_STILL,
+    CAL_DROP,
+    CAL_TUMBLE,
+    CAL_ROLL,
+    CAL_SITUP,
+    CAL_FINISH
+} CalPhase_t;
+
+#define CAL_PREPARE_MS      4000
+
+static const char *phase_prompt[] = {
+    "",
+    "STILL: hold the board flat against your chest and stay still",
+    "DROP: hold the board flat against your chest, fall backward onto a bed",
+    "TUMBLE: hold the board flat against your chest, fall sideways onto the bed",
+    "ROLL: lie on your back and roll around gently",
+    "SIT-UP: from lying on your back, do a strict sit-up",
+};
+static const uint32_t phase_record_ms[] = { 0, 3000, 8000, 8000, 8000, 6000 };
+
+static CalPhase_t phase = CAL_IDLE;
+static int recording = 0;
+static uint32_t phase_start = 0;
+
+static CalStats_t still_dev;
+static CalStats_t drop_accel;
+static CalStats_t tumble_gyro;
+static CalStats_t roll_dev;
+static CalStats_t situp_dev;
+
+static uint32_t pending_beeps = 0;      // for AutoCalib_TakeBeeps()
+
+static void Cal_Beep(int beeps)
+{
+    pending_beeps = (uint32_t)beeps;
+}
+
+uint32_t AutoCalib_TakeBeeps(void)
+{
+    uint32_t n = pending_beeps;
+    pending_beeps = 0;
+    return n;
+}
+
+static void Enter_Phase(CalPhase_t next)
+{
+    phase = next;
+    recording = 0;
+    phase_start = HAL_GetTick();
+    if (phase < CAL_FINISH) {
+        Fmt_t f;
+        UartTx_Begin(&f);
+        Fmt_Str(&f, "\r\n[CAL] Step ");
+        Fmt_Uint(&f, (uint32_t)phase);
+        Fmt_Str(&f, "/5 - ");
+        Fmt_Str(&f, phase_prompt[phase]);
+        Fmt_Str(&f, "\r\n[CAL] Recording starts at the beep...\r\n");
+        UartTx_Commit(&f);
+    }
+}
+
+int AutoCalib_IsActive(void)
+{
+    return phase != CAL_IDLE;
+}
+
+void AutoCalib_Start(void)
+{
+    CalStats_Init(&still_dev, 0.95f);
+    CalStats_Init(&drop_accel, 0.5f);
+    CalStats_Init(&tumble_gyro, 0.5f);
+    CalStats_Init(&roll_dev, 0.95f);
+    CalStats_Init(&situp_dev, 0.95f);
+
+    UartTx_Write(
+        "\r\n=================================\r\n"
+        " AUTO CALIBRATION (hold 3s)\r\n"
+        " beep = start, double beep = stop\r\n"
+        "=================================\r\n");
+    Enter_Phase(CAL_STILL);
+}
+
+static void Finish(void)
+{
+    ConfigRecord_t cfg = *Config_Get();
+    FallThresholds_t th = cfg.thresholds;
+    int changed = 0;
+
+    // Impact: a bit below the landing peak, but well above walking (~1.5 g)
+    float high = 0.85f * drop_accel.max;
+    if (high > 15.0f && high < 80.0f) { th.accel_high = high; changed++; }
+
+    // Freefall: a bit above the lowest reading before impact
+    float low = drop_accel.min + 0.25f * (9.8f - drop_accel.min);
+    if (drop_accel.min < 8.0f && low > 1.0f && low < 8.0f) { th.accel_low = low; changed++; }
+
+    // Rotation: a bit below the tumble gyro peak
+    float gyro = 0.85f * tumble_gyro.max;
+    if (gyro > 100.0f && gyro < 2000.0f) { th.gyro = gyro; changed++; }
+
+    // Recovery: between rolling around (P95) and a real sit-up (max)
+    float roll = CalStats_Quantile(&roll_dev);
+    if (CalStats_Quantile(&still_dev) > roll) roll = CalStats_Quantile(&still_dev);
+    if (situp_dev.max > 1.2f * roll) {
+        float dev = 0.5f * (roll + situp_dev.max);
+        if (dev > 1.0f && dev < 9.0f) { th.recovery_dev = dev; changed++; }
+    }
+
+    Fmt_t f;
+    UartTx_Begin(&f);
+    Fmt_Str(&f, "\r\n[CAL] Drop max ");
+    Fmt_Float(&f, drop_accel.max, 2);
+    Fmt_Str(&f, " min ");
+    Fmt_Float(&f, drop_accel.min, 2);
+    Fmt_Str(&f, " | Tumble gyro max ");
+    Fmt_Float(&f, tumble_gyro.max, 2);
+    Fmt_Str(&f, "\r\n[CAL] Dev still P95 ");
+    Fmt_Float(&f, CalStats_Quantile(&still_dev), 2);
+    Fmt_Str(&f, " | roll P95 ");
+    Fmt_Float(&f, CalStats_Quantile(&roll_dev), 2);
+    Fmt_Str(&f, " | sit-up max ");
+    Fmt_Float(&f, situp_dev.max, 2);
+    Fmt_Str(&f, "\r\n[CAL] HIGH=");
+    Fmt_Float(&f, th.accel_high, 2);
+    Fmt_Str(&f, " LOW=");
+    Fmt_Float(&f, th.accel_low, 2);
+    Fmt_Str(&f, " GYRO=");
+    Fmt_Float(&f, th.gyro, 2);
+    Fmt_Str(&f, " RECOVERY=");
+    Fmt_Float(&f, th.recovery_dev, 2);
+    Fmt_Str(&f, " (");
+    Fmt_Uint(&f, (uint32_t)changed);
+    Fmt_Str(&f, "/4 updated)\r\n");
+    UartTx_Commit(&f);
+
+    if (changed) {
+        cfg.thresholds = th;
+        UartTx_Write(Config_Save(&cfg) ? "[CAL] Saving to flash.\r\n"
+                                       : "[CAL] Flash busy or FAILED - thresholds not saved.\r\n");
+    } else {
+        UartTx_Write("[CAL] No usable data - keeping previous thresholds.\r\n");
+    }
+    Cal_Beep(3);
+    phase = CAL_IDLE;
+}
+
+void AutoCalib_Step(float total_accel, float total_gyro)
+{
+    if (phase == CAL_IDLE) return;
+    if (phase == CAL_FINISH) {
+        Finish();
+        return;
+    }
+
+    uint32_t now = HAL_GetTick();
+    if (!recording) {
+        if (now - phase_start >= CAL_PREPARE_MS) {
+            Cal_Beep(1);
+            recording = 1;
+            phase_start = now;
+        }
+        return;
+    }
+
+    float dev = fabsf(total_accel - 9.8f);
+    switch (phase) {
+        case CAL_STILL:  CalStats_Add(&still_dev, dev);          break;
+        case CAL_DROP:   CalStats_Add(&drop_accel, total_accel); break;
+        case CAL_TUMBLE: CalStats_Add(&tumble_gyro, total_gyro); break;
+        case CAL_ROLL:   CalStats_Add(&roll_dev, dev);           break;
+        case CAL_SITUP:  CalStats_Add(&situp_dev, dev);          break;
+        default: break;
+    }
+
+    if (now - phase_start >= phase_record_ms[phase]) {
+        Cal_Beep(2);
+        Enter_Phase((CalPhase_t)(phase + 1));
+    }
+}
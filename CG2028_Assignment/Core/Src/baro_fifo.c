@@ -0,0 +1,172 @@
+/******************************************************************************
+  * @file           : baro_fifo.c
+  * @brief          : LPS22HB pressure stream through its FIFO, batched on I2C2
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The LPS22HB samples at its top rate (75 Hz) with the internal low-pass at
+ * ODR/20, and the FIFO in stream mode keeps the newest 32 samples. Instead
+ * of one register read per sample, the main loop collects the FIFO every
+ * BARO_BATCH_MS: one job reads FIFO_STATUS, a second reads all stored
+ * slots in one burst (the register address wraps from TEMP_OUT_H back to
+ * PRESS_OUT_XL while the FIFO is on). At 400 kHz that is ~9 ms of bus time
+ * per second, less than one IMU sample period.
+ *
+ * Both jobs are sensor-priority jobs in the I2C2 scheduler, so a queued
+ * IMU read still goes first, and like the NFC tag they are only queued if
+ * they end before the next IMU sample is due.
+ */
+#include "main.h"
+#include "baro_fifo.h"
+#include "height_drop.h"
+#include "i2c_bus.h"
+#include "../../Drivers/BSP/B-L4S5I-IOT01/stm32l4s5i_iot01.h"
+#include "../../Drivers/BSP/Components/lps22hb/lps22hb.h"
+
+#include "string.h"
+#include "no_heap.h"
+
+#define CTRL1_ODR_75HZ          0x50
+#define CTRL2_FIFO_EN           0x40
+#define CTRL2_IF_ADD_INC        0x10
+#define CTRL2_SWRESET           0x04
+#define FIFO_MODE_STREAM        0x40
+#define FIFO_STATUS_OVR         0x40
+#define FIFO_STATUS_FSS         0x3F
+
+#define STATUS_BYTES            4       /* address, register, address, FIFO_STATUS */
+
+typedef enum {
+    BARO_IDLE = 0,
+    BARO_STATUS,                // FIFO_STATUS read queued
+    BARO_LEVEL,                 // FIFO level known, burst waiting for a slot
+    BARO_DATA                   // FIFO burst read queued
+} BaroStep_t;
+
+static int present = 0;
+static BaroStep_t step = BARO_IDLE;
+static uint32_t last_batch = 0;
+static uint8_t fifo_status = 0;
+static uint8_t fifo_buf[BARO_FIFO_DEPTH * BARO_SLOT_BYTES];
+static uint32_t fifo_n = 0;
+
+static BaroFifoStats_t stats;
+
+// ======================= HELPERS =========================
+
+static int Write_Reg(uint8_t reg, uint8_t val)
+{
+    return I2cBus_Transfer(LPS22HB_I2C_ADDRESS, reg, 1, &val, 1, 1) == I2C_OK;
+}
+
+// Samples whose burst read (address, register, address + data) ends inside the slot
+static uint32_t Samples_That_Fit(uint32_t slot_ms)
+{
+    if (slot_ms <= 1) return 0;
+    uint32_t bytes = ((slot_ms - 1) * 1000) / I2cBus_ByteUs();
+    return bytes > 3 ? (bytes - 3) / BARO_SLOT_BYTES : 0;
+}
+
+static void On_Done(I2cResult_t res, void *ctx);
+
+static void Submit(BaroStep_t what, uint8_t reg, uint8_t *data, uint16_t len)
+{
+    I2cJob_t job = {0};
+    job.addr = LPS22HB_I2C_ADDRESS;
+    job.reg_size = 1;
+    job.reg = reg;
+    job.data = data;
+    job.len = len;
+    job.done = On_Done;
+
+    step = what;
+    if (I2cBus_Submit(&job)) stats.bus_us += (len + 3u) * I2cBus_ByteUs();
+    else step = (what == BARO_DATA) ? BARO_LEVEL : BARO_IDLE;
+}
+
+// From I2cBus_Poll(): FIFO level known, or burst done -> estimator
+static void On_Done(I2cResult_t res, void *ctx)
+{
+    BaroStep_t what = step;
+    step = BARO_IDLE;
+    if (res != I2C_OK) {
+        stats.errors++;
+        return;
+    }
+
+    if (what == BARO_STATUS) {
+        if (fifo_status & FIFO_STATUS_OVR) stats.overruns++;
+        fifo_n = fifo_status & FIFO_STATUS_FSS;
+        if (fifo_n > BARO_FIFO_DEPTH) fifo_n = BARO_FIFO_DEPTH;
+        if (fifo_n) step = BARO_LEVEL;
+    } else if (what == BARO_DATA) {
+        HeightDrop_FeedFifo(fifo_buf, fifo_n, HAL_GetTick());
+        stats.batches++;
+        stats.samples += fifo_n;
+    }
+}
+
+// ======================= PUBLIC API =========================
+
+int BaroFifo_Init(void)
+{
+    uint8_t id = 0;
+
+    memset(&stats, 0, sizeof(stats));
+    HeightDrop_Init();
+    present = 0;
+    step = BARO_IDLE;
+
+    if (I2cBus_Transfer(LPS22HB_I2C_ADDRESS, LPS22HB_WHO_AM_I_REG, 1, &id, 1, 0) != I2C_OK ||
+        id != LPS22HB_WHO_AM_I_VAL) return 0;
+
+    // Software reset clears the FIFO and any one-shot setup left by the BSP driver
+    Write_Reg(LPS22HB_CTRL_REG2, CTRL2_SWRESET | CTRL2_IF_ADD_INC);
+    HAL_Delay(1);
+
+    int ok = Write_Reg(LPS22HB_CTRL_REG1, CTRL1_ODR_75HZ | LPS22HB_LPFP_MASK |
+                                          LPS22HB_LPFP_CUTOFF_MASK | LPS22HB_BDU_MASK);
+    ok = ok && Write_Reg(LPS22HB_CTRL_FIFO_REG, FIFO_MODE_STREAM);
+    ok = ok && Write_Reg(LPS22HB_CTRL_REG2, CTRL2_FIFO_EN | CTRL2_IF_ADD_INC);
+    if (!ok) return 0;
+
+    last_batch = HAL_GetTick();
+    present = 1;
+    return 1;
+}
+
+void BaroFifo_Poll(uint32_t slot_ms)
+{
+    if (!present) return;
+
+    if (step == BARO_LEVEL) {
+        // Whatever does not fit before the IMU sample stays in the FIFO for the next batch
+        uint32_t fit = Samples_That_Fit(slot_ms);
+        if (fit == 0) return;
+        if (fifo_n > fit) {
+            fifo_n = fit;
+            stats.skipped++;
+        }
+        Submit(BARO_DATA, LPS22HB_PRESS_OUT_XL_REG, fifo_buf, (uint16_t)(fifo_n * BARO_SLOT_BYTES));
+        return;
+    }
+
+    uint32_t now = HAL_GetTick();
+    if (step != BARO_IDLE || now - last_batch < BARO_BATCH_MS) return;
+    if ((STATUS_BYTES * I2cBus_ByteUs()) / 1000 + 1 > slot_ms) return;
+    last_batch = now;
+    Submit(BARO_STATUS, LPS22HB_STATUS_FIFO_REG, &fifo_status, 1);
+}
+
+uint32_t BaroFifo_BusUsPerSecond(void)
+{
+    uint32_t data_bytes = HEIGHT_ODR_HZ * BARO_SLOT_BYTES;
+    // Per batch: the status job plus address, register and address of the burst
+    uint32_t batch_bytes = ((STATUS_BYTES + 3) * 1000 + BARO_BATCH_MS - 1) / BARO_BATCH_MS;
+    return (data_bytes + batch_bytes) * I2cBus_ByteUs();
+}
+
+void BaroFifo_GetStats(BaroFifoStats_t *st)
+{
+    *st = stats;
+}
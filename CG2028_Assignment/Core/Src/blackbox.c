@@ -0,0 +1,420 @@
+/******************************************************************************
+  * @file           : blackbox.c
+  * @brief          : Black-box event recorder (append-only log on the QSPI NOR)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The whole 8 MB MX25R6435F is one circular, append-only log. The write
+ * head walks the 2048 sectors in order and wraps around, so every sector
+ * is erased once per lap (wear levelling comes for free). The sector in
+ * front of the head is erased in the background, so when the head gets
+ * there it only has to program the sector header.
+ *
+ * The sampling loop never touches the flash. It copies records into a RAM
+ * staging ring (BlackBox_Trigger / BlackBox_LogEvent / BlackBox_PushSample)
+ * and BlackBox_Poll(), called once per loop pass, starts at most one
+ * flash operation: an erase, a sector header, one page-sized chunk
+ * (ending at a page or record boundary) or a commit word. The QSPI driver
+ * finishes it under interrupt.
+ *
+ * Power-fail safety: a record is programmed with its crc/commit words
+ * still erased, and those 8 bytes are programmed last. A record cut off
+ * by a reset has no commit mark and readers skip it. Each boot opens a
+ * fresh sector rather than appending after a possibly torn tail.
+ *
+ * Sample windows are run through imu_codec (Rice, order 1) before they
+ * are queued, which shrinks them ~4-5x. If a window does not compress
+ * it is stored raw under the plain record type. A BB_REC_WINDOW_TIMES
+ * record follows every window with the TIM2 microsecond time of each
+ * sample (first in full, then 16-bit gaps, ~2 bytes per sample).
+ */
+#include "main.h"
+#include "blackbox.h"
+#include "qspi_flash.h"
+#include "config_store.h"
+#include "imu_codec.h"
+
+#include "string.h"
+#include <stddef.h>
+
+#define BB_SECTORS              (QSPI_FLASH_SIZE / QSPI_SECTOR_SIZE)
+#define BB_HDR_SIZE             sizeof(BlackBoxRecordHeader_t)
+#define BB_PAD(n)               (((n) + 3u) & ~3u)      // keeps every header word aligned
+
+_Static_assert(sizeof(BlackBoxSample_t) == 2 * IMU_CODEC_CHANNELS, "BlackBoxSample_t is one imu_codec sample");
+_Static_assert(sizeof(BlackBoxRecordHeader_t) == 24, "BlackBoxRecordHeader_t layout");
+_Static_assert(BB_HDR_SIZE + BB_POST_SAMPLES * sizeof(BlackBoxSample_t) <=
+               QSPI_SECTOR_SIZE - sizeof(BlackBoxSectorHeader_t), "window record must fit a sector");
+
+static int enabled = 0;
+
+// RAM staging ring (producer: sampling loop, consumer: BlackBox_Poll)
+static uint8_t stage[BB_STAGE_SIZE];
+static uint32_t stage_head = 0;     // free-running byte counters
+static uint32_t stage_tail = 0;
+
+// Pre/post trigger windows
+static BlackBoxSample_t pre_ring[BB_PRE_SAMPLES];
+static uint32_t pre_time[BB_PRE_SAMPLES];
+static uint32_t pre_count = 0;
+static BlackBoxSample_t post_buf[BB_POST_SAMPLES];
+static uint32_t post_time[BB_POST_SAMPLES];
+static uint32_t post_count = 0;
+static int post_active = 0;
+
+// Flash write head
+static uint32_t head_addr = 0;
+static uint32_t sector_seq = 0;
+static uint32_t rec_seq = 0;
+static int head_erased = 0;         // sector under the head has been erased
+static int sector_open = 0;         // ... and its sector header is programmed
+static int next_erased = 0;         // sector after the head has been erased
+static int *erase_flag = NULL;      // head_erased / next_erased of the erase in flight
+
+// Record being moved to flash
+static uint32_t rec_left = 0;       // header + payload bytes still to program
+static uint32_t rec_hdr_addr = 0;
+static uint32_t rec_crc = 0;
+
+// Buffers handed to the QSPI driver; untouched until it is idle again
+static uint8_t page_buf[QSPI_PAGE_SIZE];
+static BlackBoxSectorHeader_t sector_hdr;
+static uint32_t commit_words[2];
+static int commit_pending = 0;
+
+static BlackBoxStats_t stats;
+
+static uint8_t codec_buf[BB_POST_SAMPLES * sizeof(BlackBoxSample_t)];
+static uint16_t dt_buf[BB_POST_SAMPLES];
+
+// ======================= STAGING RING =========================
+
+static uint32_t Stage_Free(void)
+{
+    return BB_STAGE_SIZE - (stage_head - stage_tail);
+}
+
+static void Stage_Write(const void *src, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)src;
+    uint32_t at = stage_head % BB_STAGE_SIZE;
+    uint32_t first = BB_STAGE_SIZE - at;
+    if (first > len) first = len;
+    memcpy(&stage[at], p, first);
+    memcpy(&stage[0], p + first, len - first);
+    stage_head += len;
+}
+
+static void Stage_Read(uint32_t offset, void *dst, uint32_t len)
+{
+    uint8_t *p = (uint8_t *)dst;
+    uint32_t at = (stage_tail + offset) % BB_STAGE_SIZE;
+    uint32_t first = BB_STAGE_SIZE - at;
+    if (first > len) first = len;
+    memcpy(p, &stage[at], first);
+    memcpy(p + first, &stage[0], len - first);
+}
+
+// Queues one record from up to two payload pieces; all or nothing
+static void Stage_Record(uint8_t type, const void *a, uint32_t a_len, const void *b, uint32_t b_len)
+{
+    if (!enabled) return;
+
+    uint32_t len = a_len + b_len;
+    if (Stage_Free() < BB_HDR_SIZE + BB_PAD(len)) {
+        stats.dropped++;
+        return;
+    }
+
+    BlackBoxRecordHeader_t hdr;
+    memset(&hdr, 0xFF, sizeof(hdr));       // crc/commit stay erased
+    hdr.magic = BB_RECORD_MAGIC;
+    hdr.type = type;
+    hdr.len = (uint16_t)len;
+    hdr.len_check = (uint16_t)~len;
+    hdr.seq = rec_seq++;
+    hdr.tick = HAL_GetTick();
+
+    Stage_Write(&hdr, BB_HDR_SIZE);
+    if (a_len) Stage_Write(a, a_len);
+    if (b_len) Stage_Write(b, b_len);
+
+    static const uint8_t pad[3] = { 0xFF, 0xFF, 0xFF };
+    if (BB_PAD(len) != len) Stage_Write(pad, BB_PAD(len) - len);
+}
+
+// Encodes up to two runs of samples; falls back to the raw record if it does not shrink
+static void Stage_Window(uint8_t type_raw, uint8_t type_z,
+                         const BlackBoxSample_t *a, uint32_t a_n,
+                         const BlackBoxSample_t *b, uint32_t b_n)
+{
+    if (!enabled) return;
+
+    uint32_t raw = (a_n + b_n) * sizeof(BlackBoxSample_t);
+    uint32_t t0 = DWT->CYCCNT;
+
+    ImuEncoder_t enc;
+    ImuCodec_InitEncoder(&enc, codec_buf, raw < sizeof(codec_buf) ? raw : sizeof(codec_buf),
+                         IMU_CODEC_RICE, BB_CODEC_BLOCK);
+    for (uint32_t i = 0; i < a_n + b_n; i++) {
+        int16_t v[IMU_CODEC_CHANNELS];
+        memcpy(v, (i < a_n) ? &a[i] : &b[i - a_n], sizeof(v));
+        if (!ImuCodec_Encode(&enc, v)) break;
+    }
+    uint32_t len = ImuCodec_Finish(&enc);
+
+    stats.win_cycles += DWT->CYCCNT - t0;
+    stats.win_raw_bytes += raw;
+    stats.windows++;
+
+    if (len) {
+        stats.win_enc_bytes += len;
+        Stage_Record(type_z, codec_buf, len, NULL, 0);
+    } else {
+        stats.win_enc_bytes += raw;
+        Stage_Record(type_raw, a, a_n * sizeof(BlackBoxSample_t), b, b_n * sizeof(BlackBoxSample_t));
+    }
+}
+
+// Sample times of the window just staged: first one in full, then the gaps
+static void Stage_Times(uint8_t window, const uint32_t *a, uint32_t a_n, const uint32_t *b, uint32_t b_n)
+{
+    uint32_t n = a_n + b_n;
+    if (n == 0) return;
+
+    BlackBoxTimes_t hdr;
+    hdr.window = window;
+    hdr.reserved = 0;
+    hdr.n = (uint16_t)n;
+    hdr.t_first_us = a_n ? a[0] : b[0];
+
+    uint32_t prev = hdr.t_first_us;
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t t = (i < a_n) ? a[i] : b[i - a_n];
+        uint32_t dt = t - prev;
+        dt_buf[i - 1] = (uint16_t)(dt < BB_DT_CLIPPED ? dt : BB_DT_CLIPPED);
+        prev = t;
+    }
+    Stage_Record(BB_REC_WINDOW_TIMES, &hdr, sizeof(hdr), dt_buf, (n - 1) * sizeof(dt_buf[0]));
+}
+
+// ======================= PRODUCER API (sampling loop) =========================
+
+void BlackBox_PushSample(const BlackBoxSample_t *s, uint32_t t_us)
+{
+    pre_ring[pre_count % BB_PRE_SAMPLES] = *s;
+    pre_time[pre_count % BB_PRE_SAMPLES] = t_us;
+    pre_count++;
+
+    if (post_active) {
+        post_time[post_count] = t_us;
+        post_buf[post_count++] = *s;
+        if (post_count == BB_POST_SAMPLES) {
+            Stage_Window(BB_REC_POST_WINDOW, BB_REC_POST_WINDOW_Z, post_buf, BB_POST_SAMPLES, NULL, 0);
+            Stage_Times(BB_REC_POST_WINDOW, post_time, BB_POST_SAMPLES, NULL, 0);
+            post_active = 0;
+        }
+    }
+}
+
+void BlackBox_LogEvent(const BlackBoxEvent_t *ev)
+{
+    Stage_Record(BB_REC_EVENT, ev, sizeof(*ev), NULL, 0);
+}
+
+// Event record, then the pre-trigger window (oldest first), then arm the post window
+void BlackBox_Trigger(const BlackBoxEvent_t *ev)
+{
+    BlackBox_LogEvent(ev);
+
+    uint32_t n = (pre_count < BB_PRE_SAMPLES) ? pre_count : BB_PRE_SAMPLES;
+    uint32_t oldest = (pre_count - n) % BB_PRE_SAMPLES;
+    uint32_t first = BB_PRE_SAMPLES - oldest;
+    if (first > n) first = n;
+    Stage_Window(BB_REC_PRE_WINDOW, BB_REC_PRE_WINDOW_Z,
+                 &pre_ring[oldest], first, &pre_ring[0], n - first);
+    Stage_Times(BB_REC_PRE_WINDOW, &pre_time[oldest], first, &pre_time[0], n - first);
+
+    if (!post_active) {
+        post_active = 1;
+        post_count = 0;
+    }
+}
+
+// ======================= BOOT SCAN =========================
+
+static int Sector_Header_Valid(const BlackBoxSectorHeader_t *h)
+{
+    return h->magic == BB_SECTOR_MAGIC && h->check == ~h->sector_seq;
+}
+
+int BlackBox_Init(void)
+{
+    memset(&stats, 0, sizeof(stats));
+    enabled = QspiFlash_Init();
+    if (!enabled) return 0;
+
+    // Scan in place through the memory-mapped window (no RAM copies)
+    const uint8_t *nor = QspiFlash_MapAcquire(0);
+    if (nor == NULL) {
+        enabled = 0;
+        return 0;
+    }
+
+    // Newest sector = valid header with the highest sequence
+    int32_t last = -1;
+    uint32_t last_seq = 0;
+    for (uint32_t s = 0; s < BB_SECTORS; s++) {
+        const BlackBoxSectorHeader_t *h = (const BlackBoxSectorHeader_t *)(nor + s * QSPI_SECTOR_SIZE);
+        if (Sector_Header_Valid(h) && (last < 0 || h->sector_seq > last_seq)) {
+            last = (int32_t)s;
+            last_seq = h->sector_seq;
+            rec_seq = h->first_rec_seq;
+        }
+    }
+
+    // Walk that sector to continue the record sequence
+    if (last >= 0) {
+        uint32_t addr = (uint32_t)last * QSPI_SECTOR_SIZE + sizeof(BlackBoxSectorHeader_t);
+        uint32_t end = (uint32_t)(last + 1) * QSPI_SECTOR_SIZE;
+        while (addr + BB_HDR_SIZE <= end) {
+            const BlackBoxRecordHeader_t *h = (const BlackBoxRecordHeader_t *)(nor + addr);
+            if (h->magic != BB_RECORD_MAGIC || (h->len_check ^ h->len) != 0xFFFF) break;
+            rec_seq = h->seq + 1;
+            addr += BB_HDR_SIZE + BB_PAD(h->len);
+        }
+    }
+    QspiFlash_MapRelease();
+
+    // Start a fresh sector after the newest one
+    uint32_t s = (last < 0) ? 0 : ((uint32_t)last + 1) % BB_SECTORS;
+    head_addr = s * QSPI_SECTOR_SIZE;
+    sector_seq = (last < 0) ? 0 : last_seq + 1;
+    head_erased = 0;
+    sector_open = 0;
+    next_erased = 0;
+    erase_flag = NULL;
+
+    uint32_t reset_flags = RCC->CSR;
+    __HAL_RCC_CLEAR_RESET_FLAGS();
+    Stage_Record(BB_REC_BOOT, &reset_flags, sizeof(reset_flags), NULL, 0);
+    return 1;
+}
+
+// ======================= FLASH WRITER (main loop) =========================
+
+static void Advance_Sector(void)
+{
+    head_addr = (head_addr / QSPI_SECTOR_SIZE + 1) % BB_SECTORS * QSPI_SECTOR_SIZE;
+    head_erased = next_erased;
+    next_erased = 0;
+    sector_open = 0;
+    sector_seq++;
+}
+
+// Starts at most one flash operation per call; never waits for one to finish
+void BlackBox_Poll(void)
+{
+    if (!enabled || QspiFlash_IsBusy()) return;
+
+    // A failed operation is counted. A failed erase leaves its sector
+    // unerased, so it is started again before anything programs there.
+    if (QspiFlash_GetState() == QSPI_ERROR) {
+        stats.errors++;
+        if (erase_flag) *erase_flag = 0;
+        erase_flag = NULL;
+        QspiFlash_ClearError();
+        return;
+    }
+    erase_flag = NULL;
+
+    // commit_pending = words of {crc, commit} still to program. The pair is
+    // split when it would straddle a page (the program would wrap).
+    if (commit_pending) {
+        uint32_t first = 2 - commit_pending;
+        uint32_t addr = rec_hdr_addr + offsetof(BlackBoxRecordHeader_t, crc) + 4 * first;
+        uint32_t n = commit_pending;
+        if ((addr & (QSPI_PAGE_SIZE - 1)) + 4 * n > QSPI_PAGE_SIZE) n = 1;
+        if (QspiFlash_StartProgram(addr, &commit_words[first], 4 * n)) {
+            commit_pending -= n;
+            if (commit_pending == 0) stats.records++;
+        }
+        return;
+    }
+
+    if (!sector_open) {
+        if (!head_erased) {
+            if (QspiFlash_StartErase(head_addr)) { head_erased = 1; erase_flag = &head_erased; stats.erases++; }
+            return;
+        }
+        sector_hdr.magic = BB_SECTOR_MAGIC;
+        sector_hdr.sector_seq = sector_seq;
+        sector_hdr.first_rec_seq = rec_seq;
+        if (stage_head - stage_tail >= BB_HDR_SIZE) {
+            BlackBoxRecordHeader_t next;
+            Stage_Read(0, &next, sizeof(next));
+            sector_hdr.first_rec_seq = next.seq;
+        }
+        sector_hdr.check = ~sector_seq;
+        if (QspiFlash_StartProgram(head_addr, &sector_hdr, sizeof(sector_hdr))) {
+            sector_open = 1;
+            head_addr += sizeof(sector_hdr);
+        }
+        return;
+    }
+
+    // Keep the next sector erased ahead of the head
+    if (!next_erased) {
+        uint32_t next = (head_addr / QSPI_SECTOR_SIZE + 1) % BB_SECTORS * QSPI_SECTOR_SIZE;
+        if (QspiFlash_StartErase(next)) { next_erased = 1; erase_flag = &next_erased; stats.erases++; }
+        return;
+    }
+
+    if (rec_left == 0) {
+        if (stage_head - stage_tail < BB_HDR_SIZE) return;
+
+        BlackBoxRecordHeader_t hdr;
+        Stage_Read(0, &hdr, sizeof(hdr));
+        uint32_t total = BB_HDR_SIZE + BB_PAD(hdr.len);
+        uint32_t sector_end = (head_addr / QSPI_SECTOR_SIZE + 1) * QSPI_SECTOR_SIZE;
+        if (head_addr + total > sector_end) {
+            Advance_Sector();       // rest of this sector stays erased
+            return;
+        }
+        rec_left = total;
+        rec_hdr_addr = head_addr;
+        rec_crc = 0xFFFFFFFFUL;
+    }
+
+    // One chunk: up to the end of the page or the end of the record
+    uint32_t chunk = QSPI_PAGE_SIZE - (head_addr & (QSPI_PAGE_SIZE - 1));
+    if (chunk > rec_left) chunk = rec_left;
+    Stage_Read(0, page_buf, chunk);
+
+    if (!QspiFlash_StartProgram(head_addr, page_buf, chunk)) return;
+
+    // CRC over the padded payload part of this chunk (the header is not covered)
+    uint32_t done = head_addr - rec_hdr_addr;
+    if (done + chunk > BB_HDR_SIZE) {
+        uint32_t skip = (done < BB_HDR_SIZE) ? BB_HDR_SIZE - done : 0;
+        rec_crc = Config_Crc32Update(rec_crc, page_buf + skip, chunk - skip);
+    }
+
+    stage_tail += chunk;
+    head_addr += chunk;
+    rec_left -= chunk;
+    if (rec_left == 0) {
+        commit_words[0] = ~rec_crc;
+        commit_words[1] = BB_COMMIT_MARK;
+        commit_pending = 2;
+    }
+}
+
+void BlackBox_GetStats(BlackBoxStats_t *st)
+{
+    *st = stats;
+    st->head_addr = head_addr;
+    st->sector_seq = sector_seq;
+    st->next_rec_seq = rec_seq;
+    st->stage_used = stage_head - stage_tail;
+}
@@ -0,0 +1,267 @@
+/******************************************************************************
+  * @file           : config_store.c
+  * @brief          : Versioned detector configuration in internal flash (A/B pages + CRC)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Two 4 KB pages at the top of flash bank 2 are reserved in the linker
+ * script (CONFIG region, NOLOAD so reflashing the firmware keeps them).
+ * Each save goes to the page that is not active, with sequence + 1. At
+ * boot the page with a good magic/version/CRC and the highest sequence
+ * wins. If neither is valid, the built-in defaults (in .rodata) are used.
+ *
+ * Config_Get() returns a RAM copy of the active record, never a pointer
+ * into flash. Both pages sit in bank 2, and on the L4+ any read from a
+ * bank stalls while that bank erases a page (~22-25 ms, more than one
+ * sample period). The acquisition thread and the detector read the
+ * config every sample, so they must not touch bank 2 during a save. The
+ * copy is taken at boot and refreshed once the new page has been
+ * programmed and its CRC checked. A power cut mid-write leaves the old
+ * page active.
+ *
+ * Older records are still accepted. A version-1 record (written before the
+ * magnetometer calibration was added) is copied with the default
+ * calibration. A version-2 record keeps everything but loud_margin_db,
+ * which it measured from the busy level instead of the floor. The next
+ * save writes the record back at CONFIG_VERSION.
+ *
+ * Writes never block. Config_Save() stages the record and Config_Poll()
+ * (called from the main loop) starts the next erase or double-word
+ * program through the HAL _IT API. The code runs from bank 1 and the
+ * record is read from RAM, so the bank-2 erase stalls neither instruction
+ * fetch nor the sampling loop.
+ */
+#include "main.h"
+#include "config_store.h"
+
+#include "string.h"
+#include <stddef.h>
+
+extern uint8_t _config_page_a[];    // from STM32L4S5VITX_FLASH.ld / _RAM.ld
+extern uint8_t _config_page_b[];
+
+#define CONFIG_BANK             FLASH_BANK_2
+#define CONFIG_PAGE_OF(addr)    ((((uint32_t)(addr)) - (FLASH_BASE + FLASH_BANK_SIZE)) / FLASH_PAGE_SIZE)
+
+_Static_assert(sizeof(ConfigRecord_t) % 8 == 0, "ConfigRecord_t must be whole double-words");
+
+static const ConfigRecord_t config_defaults = {
+    .magic    = CONFIG_MAGIC,
+    .version  = CONFIG_VERSION,
+    .size     = sizeof(ConfigRecord_t),
+    .sequence = 0,
+    .thresholds = {
+        .accel_high   = 20.0f,
+        .accel_low    = 5.0f,
+        .gyro         = 400.0f,
+        .recovery_dev = 4.5f,
+    },
+    .sample_period_ms     = 20,
+    .falling_timeout_ms   = 1500,
+    .stillness_window_ms  = 5000,
+    .late_sound_window_ms = 2000,
+    .loud_margin_db       = 15,
+    .mag = {
+        .offset   = { 0, 0, 0 },
+        .soft_q14 = { 16384, 0, 0,  0, 16384, 0,  0, 0, 16384 },
+        .valid    = 0,
+    },
+    .crc = 0,
+};
+
+static ConfigRecord_t active;                   // what Config_Get() hands out; RAM, see the header
+static const uint8_t *active_page = NULL;       // flash page active was read from, if any
+
+// Write state machine
+static ConfigRecord_t staged;
+static uint32_t target_addr = 0;
+static uint32_t next_dword = 0;
+static volatile int op_busy = 0;
+static volatile int op_failed = 0;
+static ConfigWriteState_t write_state = CONFIG_IDLE;
+
+// ======================= CRC-32 (reflected 0xEDB88320, nibble table) =========================
+
+uint32_t Config_Crc32(const void *data, uint32_t len)
+{
+    return ~Config_Crc32Update(0xFFFFFFFFUL, data, len);
+}
+
+// Running form: start from 0xFFFFFFFF, feed chunks, invert the final value
+uint32_t Config_Crc32Update(uint32_t crc, const void *data, uint32_t len)
+{
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    const uint8_t *p = (const uint8_t *)data;
+
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return crc;
+}
+
+// Versions 2 and 3 share the layout; 2 measured loud_margin_db from the busy (P90) level
+static int Record_Valid(const ConfigRecord_t *r, uint16_t version)
+{
+    return r->magic == CONFIG_MAGIC &&
+           r->version == version &&
+           r->size == sizeof(ConfigRecord_t) &&
+           r->crc == Config_Crc32(r, offsetof(ConfigRecord_t, crc));
+}
+
+// Version 1 ended where the magnetometer calibration starts, CRC included
+#define CONFIG_V1_SIZE          (offsetof(ConfigRecord_t, mag) + 4)
+
+static int Record_Valid_V1(const ConfigRecord_t *r)
+{
+    uint32_t crc;
+    memcpy(&crc, (const uint8_t *)r + offsetof(ConfigRecord_t, mag), sizeof(crc));
+    return r->magic == CONFIG_MAGIC &&
+           r->version == 1 &&
+           r->size == CONFIG_V1_SIZE &&
+           crc == Config_Crc32(r, offsetof(ConfigRecord_t, mag));
+}
+
+// CONFIG_VERSION, 2, 1, or 0 for an erased / corrupt page
+static int Record_Version(const ConfigRecord_t *r)
+{
+    if (Record_Valid(r, CONFIG_VERSION)) return CONFIG_VERSION;
+    if (Record_Valid(r, 2)) return 2;
+    return Record_Valid_V1(r) ? 1 : 0;
+}
+
+// ======================= BOOT / READ PATH =========================
+
+void Config_Init(void)
+{
+    const ConfigRecord_t *a = (const ConfigRecord_t *)_config_page_a;
+    const ConfigRecord_t *b = (const ConfigRecord_t *)_config_page_b;
+    int a_ver = Record_Version(a);
+    int b_ver = Record_Version(b);
+
+    const ConfigRecord_t *src;
+    if (a_ver && b_ver) src = (b->sequence > a->sequence) ? b : a;
+    else if (a_ver)     src = a;
+    else if (b_ver)     src = b;
+    else                src = &config_defaults;
+
+    active_page = (src == &config_defaults) ? NULL : (const uint8_t *)src;
+    int ver = (src == a) ? a_ver : b_ver;
+    memcpy(&active, &config_defaults, sizeof(active));
+    if (active_page && ver < CONFIG_VERSION) {
+        memcpy(&active, src, (ver == 1) ? offsetof(ConfigRecord_t, mag) : sizeof(active));
+        active.loud_margin_db = config_defaults.loud_margin_db;    // its reference level moved
+        active.version = CONFIG_VERSION;
+        active.size = sizeof(ConfigRecord_t);
+        active.crc = Config_Crc32(&active, offsetof(ConfigRecord_t, crc));
+    } else if (active_page) {
+        memcpy(&active, src, sizeof(active));
+    }
+
+    HAL_NVIC_SetPriority(FLASH_IRQn, 15, 0);
+    HAL_NVIC_EnableIRQ(FLASH_IRQn);
+}
+
+const ConfigRecord_t *Config_Get(void)
+{
+    return &active;
+}
+
+ConfigWriteState_t Config_GetWriteState(void)
+{
+    return write_state;
+}
+
+// ======================= NON-BLOCKING WRITE PATH =========================
+
+int Config_Save(const ConfigRecord_t *next)
+{
+    if (write_state == CONFIG_ERASING || write_state == CONFIG_PROGRAMMING) return 0;
+
+    memcpy(&staged, next, sizeof(staged));
+    staged.magic = CONFIG_MAGIC;
+    staged.version = CONFIG_VERSION;
+    staged.size = sizeof(ConfigRecord_t);
+    staged.sequence = active.sequence + 1;
+    staged.crc = Config_Crc32(&staged, offsetof(ConfigRecord_t, crc));
+
+    target_addr = (active_page == _config_page_a) ? (uint32_t)_config_page_b
+                                                  : (uint32_t)_config_page_a;
+    next_dword = 0;
+    op_failed = 0;
+
+    FLASH_EraseInitTypeDef erase = {0};
+    erase.TypeErase = FLASH_TYPEERASE_PAGES;
+    erase.Banks = CONFIG_BANK;
+    erase.Page = CONFIG_PAGE_OF(target_addr);
+    erase.NbPages = 1;
+
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+    op_busy = 1;
+    if (HAL_FLASHEx_Erase_IT(&erase) != HAL_OK) {
+        op_busy = 0;
+        HAL_FLASH_Lock();
+        write_state = CONFIG_ERROR;
+        return 0;
+    }
+    write_state = CONFIG_ERASING;
+    return 1;
+}
+
+// Starts at most one flash operation per call; never waits for one to finish
+void Config_Poll(void)
+{
+    if (write_state != CONFIG_ERASING && write_state != CONFIG_PROGRAMMING) return;
+    if (op_busy) return;
+
+    if (op_failed) {
+        HAL_FLASH_Lock();
+        write_state = CONFIG_ERROR;
+        return;
+    }
+
+    const uint64_t *dw = (const uint64_t *)&staged;
+    uint32_t n_dwords = sizeof(staged) / 8;
+
+    if (next_dword < n_dwords) {
+        write_state = CONFIG_PROGRAMMING;
+        op_busy = 1;
+        if (HAL_FLASH_Program_IT(FLASH_TYPEPROGRAM_DOUBLEWORD, target_addr + 8 * next_dword, dw[next_dword]) != HAL_OK) {
+            op_busy = 0;
+            op_failed = 1;
+            return;
+        }
+        next_dword++;
+        return;
+    }
+
+    HAL_FLASH_Lock();
+    const ConfigRecord_t *written = (const ConfigRecord_t *)target_addr;
+    if (Record_Valid(written, CONFIG_VERSION)) {
+        // staged is what verified in flash; copying it keeps this path off bank 2. The
+        // acquisition thread only reads sample_period_ms, a single aligned word.
+        memcpy(&active, &staged, sizeof(active));
+        active_page = (const uint8_t *)written;
+        write_state = CONFIG_IDLE;
+    } else {
+        write_state = CONFIG_ERROR;
+    }
+}
+
+void HAL_FLASH_EndOfOperationCallback(uint32_t ReturnValue)
+{
+    (void)ReturnValue;
+    op_busy = 0;
+}
+
+void HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue)
+{
+    (void)ReturnValue;
+    op_failed = 1;
+    op_busy = 0;
+}
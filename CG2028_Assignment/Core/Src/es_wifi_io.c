@@ -0,0 +1,340 @@
+/******************************************************************************
+  * @file           : es_wifi_io.c
+  * @brief          : SPI3 bus IO for the Inventek ISM43362 (es_wifi driver back end)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * ISM43362 SPI protocol (Inventek AT-over-SPI):
+ *
+ *   - 16-bit frames, mode 0, MSB first, nCS on PE0 driven by software.
+ *   - DRDY (PE1) high = the module wants to talk or is ready to listen.
+ *   - Command: wait for DRDY, pull nCS low, clock out the bytes (an odd
+ *     length is padded with '\n'), and leave nCS low.
+ *   - Response: raise nCS (end of command), wait for DRDY to rise, pull
+ *     nCS low again and clock in words while DRDY stays high. Unused
+ *     bytes come back as 0x15, which the es_wifi parser strips.
+ *
+ * Two back ends share the bus set-up. The WifiIo_Init/Send/Receive set
+ * handed to the es_wifi driver blocks until each transfer is done. The
+ * WifiIo_Open/Start* set is the transport of wifi_async.c: SPI3 runs on
+ * DMA2 channel 1 (RX) and 2 (TX), and DRDY rising edges arrive on EXTI1.
+ * Completions are forwarded to WifiAsync_OnEvent(). All three interrupts
+ * share one priority so the engine is never re-entered.
+ *
+ * SPI3 is shared with the BLE and sub-GHz radios, so their chip selects
+ * are parked high.
+ */
+#include "main.h"
+#include "es_wifi_io.h"
+#include "wifi_async.h"
+#include "../../Drivers/BSP/Components/es_wifi/es_wifi.h"
+
+#include "string.h"
+
+SPI_HandleTypeDef hspi3;
+DMA_HandleTypeDef hdma_spi3_rx;
+DMA_HandleTypeDef hdma_spi3_tx;
+
+#define WIFI_IRQ_PRIORITY   13      /* SPI3, its DMA channels and EXTI1 */
+
+#define WIFI_CS_LOW()       HAL_GPIO_WritePin(ISM43362_SPI3_CSN_GPIO_Port, ISM43362_SPI3_CSN_Pin, GPIO_PIN_RESET)
+#define WIFI_CS_HIGH()      HAL_GPIO_WritePin(ISM43362_SPI3_CSN_GPIO_Port, ISM43362_SPI3_CSN_Pin, GPIO_PIN_SET)
+#define WIFI_DRDY()         (HAL_GPIO_ReadPin(ISM43362_DRDY_EXTI1_GPIO_Port, ISM43362_DRDY_EXTI1_Pin) == GPIO_PIN_SET)
+
+#define WIFI_BOOT_PROMPT    "\x15\x15\r\n> "
+
+// ======================= HELPERS =========================
+
+static void Delay_Us(uint32_t us)
+{
+    uint32_t start = DWT->CYCCNT;
+    uint32_t cycles = us * (SystemCoreClock / 1000000UL);
+    while (DWT->CYCCNT - start < cycles) { }
+}
+
+static int Wait_Drdy(int level, uint32_t timeout)
+{
+    uint32_t start = HAL_GetTick();
+    while (WIFI_DRDY() != level) {
+        if (HAL_GetTick() - start > timeout) return 0;
+    }
+    return 1;
+}
+
+static void Hard_Reset(void)
+{
+    HAL_GPIO_WritePin(ISM43362_RST_GPIO_Port, ISM43362_RST_Pin, GPIO_PIN_RESET);
+    HAL_Delay(10);
+    HAL_GPIO_WritePin(ISM43362_RST_GPIO_Port, ISM43362_RST_Pin, GPIO_PIN_SET);
+    HAL_Delay(500);
+}
+
+// After reset the module announces itself with the "> " prompt
+static int8_t Reset_And_Sync(void)
+{
+    Hard_Reset();
+    if (!Wait_Drdy(1, 1000)) return -1;
+
+    uint8_t prompt[16];
+    uint16_t n = 0;
+    WIFI_CS_LOW();
+    Delay_Us(15);
+    while (WIFI_DRDY() && n + 2u <= sizeof(prompt)) {
+        if (HAL_SPI_Receive(&hspi3, prompt + n, 1, 100) != HAL_OK) break;
+        n += 2;
+    }
+    WIFI_CS_HIGH();
+
+    if (n < sizeof(WIFI_BOOT_PROMPT) - 1) return -1;
+    for (uint16_t i = 0; i < sizeof(WIFI_BOOT_PROMPT) - 1; i++) {
+        if (prompt[i] != (uint8_t)WIFI_BOOT_PROMPT[i]) return -1;
+    }
+    return 0;
+}
+
+static void SPI3_MspInit(void)
+{
+    __HAL_RCC_SPI3_CLK_ENABLE();
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_GPIOD_CLK_ENABLE();
+    __HAL_RCC_GPIOE_CLK_ENABLE();
+
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    // Other SPI3 devices stay deselected
+    HAL_GPIO_WritePin(SPBTLE_RF_SPI3_CSN_GPIO_Port, SPBTLE_RF_SPI3_CSN_Pin, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(SPSGRF_915_SPI3_CSN_GPIO_Port, SPSGRF_915_SPI3_CSN_Pin, GPIO_PIN_SET);
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    GPIO_InitStruct.Pin = SPBTLE_RF_SPI3_CSN_Pin;
+    HAL_GPIO_Init(SPBTLE_RF_SPI3_CSN_GPIO_Port, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = SPSGRF_915_SPI3_CSN_Pin;
+    HAL_GPIO_Init(SPSGRF_915_SPI3_CSN_GPIO_Port, &GPIO_InitStruct);
+
+    // Module control: nCS idle high, BOOT0/WAKEUP low (run from flash, awake)
+    WIFI_CS_HIGH();
+    HAL_GPIO_WritePin(ISM43362_BOOT0_GPIO_Port, ISM43362_BOOT0_Pin, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(ISM43362_WAKEUP_GPIO_Port, ISM43362_WAKEUP_Pin, GPIO_PIN_RESET);
+    GPIO_InitStruct.Pin = ISM43362_SPI3_CSN_Pin | ISM43362_RST_Pin;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_MEDIUM;
+    HAL_GPIO_Init(GPIOE, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = ISM43362_BOOT0_Pin | ISM43362_WAKEUP_Pin;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+    HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+
+    // Rising edges only reach the CPU once WifiIo_Open() enables EXTI1
+    GPIO_InitStruct.Pin = ISM43362_DRDY_EXTI1_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(ISM43362_DRDY_EXTI1_GPIO_Port, &GPIO_InitStruct);
+
+    GPIO_InitStruct.Pin = INTERNAL_SPI3_SCK_Pin | INTERNAL_SPI3_MISO_Pin | INTERNAL_SPI3_MOSI_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_MEDIUM;
+    GPIO_InitStruct.Alternate = GPIO_AF6_SPI3;
+    HAL_GPIO_Init(GPIOC, &GPIO_InitStruct);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static int SPI3_Init(void)
+{
+    if (hspi3.State != HAL_SPI_STATE_RESET) return 0;
+    SPI3_MspInit();
+
+    hspi3.Instance = SPI3;
+    hspi3.Init.Mode = SPI_MODE_MASTER;
+    hspi3.Init.Direction = SPI_DIRECTION_2LINES;
+    hspi3.Init.DataSize = SPI_DATASIZE_16BIT;
+    hspi3.Init.CLKPolarity = SPI_POLARITY_LOW;
+    hspi3.Init.CLKPhase = SPI_PHASE_1EDGE;
+    hspi3.Init.NSS = SPI_NSS_SOFT;
+    hspi3.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_2;    // module max is 20 MHz
+    hspi3.Init.FirstBit = SPI_FIRSTBIT_MSB;
+    hspi3.Init.TIMode = SPI_TIMODE_DISABLE;
+    hspi3.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+    hspi3.Init.CRCPolynomial = 7;
+    hspi3.Init.CRCLength = SPI_CRC_LENGTH_DATASIZE;
+    hspi3.Init.NSSPMode = SPI_NSS_PULSE_DISABLE;
+    return HAL_SPI_Init(&hspi3) == HAL_OK ? 0 : -1;
+}
+
+static void SPI3_DmaInit(void)
+{
+    __HAL_RCC_DMAMUX1_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    hdma_spi3_rx.Instance = DMA2_Channel1;
+    hdma_spi3_rx.Init.Request = DMA_REQUEST_SPI3_RX;
+    hdma_spi3_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_spi3_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_spi3_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_spi3_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_spi3_rx.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_spi3_rx.Init.Mode = DMA_NORMAL;
+    hdma_spi3_rx.Init.Priority = DMA_PRIORITY_HIGH;
+    HAL_DMA_Init(&hdma_spi3_rx);
+    __HAL_LINKDMA(&hspi3, hdmarx, hdma_spi3_rx);
+
+    hdma_spi3_tx.Instance = DMA2_Channel2;
+    hdma_spi3_tx.Init = hdma_spi3_rx.Init;
+    hdma_spi3_tx.Init.Request = DMA_REQUEST_SPI3_TX;
+    hdma_spi3_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    HAL_DMA_Init(&hdma_spi3_tx);
+    __HAL_LINKDMA(&hspi3, hdmatx, hdma_spi3_tx);
+
+    HAL_NVIC_SetPriority(DMA2_Channel1_IRQn, WIFI_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Channel1_IRQn);
+    HAL_NVIC_SetPriority(DMA2_Channel2_IRQn, WIFI_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA2_Channel2_IRQn);
+    HAL_NVIC_SetPriority(SPI3_IRQn, WIFI_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(SPI3_IRQn);
+}
+
+// ======================= BUS IO (BLOCKING, es_wifi) =========================
+
+int8_t WifiIo_Init(uint16_t mode)
+{
+    if (mode == ES_WIFI_RESET) return Reset_And_Sync();
+    if (SPI3_Init() != 0) return -1;
+    return Reset_And_Sync();
+}
+
+int8_t WifiIo_DeInit(void)
+{
+    HAL_SPI_DeInit(&hspi3);
+    return 0;
+}
+
+void WifiIo_Delay(uint32_t ms)
+{
+    HAL_Delay(ms);
+}
+
+int16_t WifiIo_Send(uint8_t *data, uint16_t len, uint32_t timeout)
+{
+    if (!Wait_Drdy(1, timeout)) return ES_WIFI_ERROR_WAITING_DRDY_RISING;
+
+    WIFI_CS_LOW();
+    Delay_Us(15);
+    if (len > 1 && HAL_SPI_Transmit(&hspi3, data, len / 2, timeout) != HAL_OK) {
+        WIFI_CS_HIGH();
+        return ES_WIFI_ERROR_SPI_FAILED;
+    }
+    if (len & 1) {
+        uint8_t pad[2] = { data[len - 1], '\n' };
+        if (HAL_SPI_Transmit(&hspi3, pad, 1, timeout) != HAL_OK) {
+            WIFI_CS_HIGH();
+            return ES_WIFI_ERROR_SPI_FAILED;
+        }
+    }
+    return (int16_t)len;        // nCS stays low until the response is read
+}
+
+// len == 0 reads the whole response
+int16_t WifiIo_Receive(uint8_t *data, uint16_t len, uint32_t timeout)
+{
+    int16_t n = 0;
+
+    WIFI_CS_HIGH();
+    Delay_Us(3);
+    if (!Wait_Drdy(1, timeout)) return ES_WIFI_ERROR_WAITING_DRDY_FALLING;
+
+    WIFI_CS_LOW();
+    Delay_Us(15);
+    while (WIFI_DRDY() && (len == 0 || n < len)) {
+        if (HAL_SPI_Receive(&hspi3, data + n, 1, timeout) != HAL_OK) {
+            WIFI_CS_HIGH();
+            return ES_WIFI_ERROR_SPI_FAILED;
+        }
+        n += 2;
+        if (n >= ES_WIFI_DATA_SIZE) {
+            WIFI_CS_HIGH();
+            Hard_Reset();
+            return ES_WIFI_ERROR_STUFFING_FOREVER;
+        }
+    }
+    WIFI_CS_HIGH();
+    return n;
+}
+
+// ======================= TRANSPORT (DMA, wifi_async) =========================
+
+int WifiIo_Open(void)
+{
+    if (SPI3_Init() != 0) return -1;
+    SPI3_DmaInit();
+    __HAL_GPIO_EXTI_CLEAR_IT(ISM43362_DRDY_EXTI1_Pin);
+    HAL_NVIC_SetPriority(EXTI1_IRQn, WIFI_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(EXTI1_IRQn);
+    return 0;
+}
+
+void WifiIo_Select(int on)
+{
+    if (on) {
+        WIFI_CS_LOW();
+        Delay_Us(15);
+    } else {
+        WIFI_CS_HIGH();
+        Delay_Us(3);
+    }
+}
+
+int WifiIo_DataReady(void)
+{
+    return WIFI_DRDY();
+}
+
+void WifiIo_HoldReset(int on)
+{
+    HAL_GPIO_WritePin(ISM43362_RST_GPIO_Port, ISM43362_RST_Pin, on ? GPIO_PIN_RESET : GPIO_PIN_SET);
+}
+
+int WifiIo_StartTx(const uint8_t *data, uint16_t len)
+{
+    return HAL_SPI_Transmit_DMA(&hspi3, (uint8_t *)data, len / 2) == HAL_OK ? 0 : -1;
+}
+
+int WifiIo_StartRx(uint8_t *data, uint16_t len)
+{
+    // Full-duplex master: the buffer is clocked out as it fills, so send '\n'
+    memset(data, '\n', len);
+    return HAL_SPI_Receive_DMA(&hspi3, data, len / 2) == HAL_OK ? 0 : -1;
+}
+
+void WifiIo_Abort(void)
+{
+    HAL_SPI_Abort(&hspi3);
+}
+
+uint32_t WifiIo_Lock(void)
+{
+    uint32_t key = __get_PRIMASK();
+    __disable_irq();
+    return key;
+}
+
+void WifiIo_Unlock(uint32_t key)
+{
+    __set_PRIMASK(key);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi == &hspi3) WifiAsync_OnEvent(WIFI_EVT_TX_DONE);
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi == &hspi3) WifiAsync_OnEvent(WIFI_EVT_RX_DONE);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+    if (hspi == &hspi3) WifiAsync_OnEvent(WIFI_EVT_BUS_ERROR);
+}
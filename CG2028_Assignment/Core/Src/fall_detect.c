@@ -0,0 +1,114 @@
+/******************************************************************************
+  * @file           : fall_detect.c
+  * @brief          : Portable detection kernels: moving average, magnitude, fall FSM step
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The FSM only decides. Everything with a side effect (banners, black-box
+ * records, starting and stopping fusion, the height and heading events)
+ * stays in main.c and is keyed off the returned FallEvent_t, so the step
+ * can be replayed and timed on the host.
+ */
+#include "fall_detect.h"
+#include "main.h"
+
+// Same result as mov_avg.s for every N and input: 32-bit wrapping sum, SDIV by N
+int mov_avg_C(int N, int* accel_buff)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < N; i++) sum += (uint32_t)accel_buff[i];
+    return (int32_t)sum / N;
+}
+
+void FallDetect_Init(FallDetect_t *d)
+{
+    d->state = STATE_NORMAL;
+    d->state_us = 0;
+    d->trigger_us = 0;
+    d->last_second = -1;
+    d->seen = 0;
+}
+
+// Impact / freefall / rotation straight from the sample magnitudes
+static uint8_t Seen_Motion(const FallInput_t *in, const FallThresholds_t *th)
+{
+    uint8_t seen = 0;
+    if (in->total_accel > th->accel_high) seen |= FALL_SEEN_IMPACT;
+    if (in->total_accel < th->accel_low)  seen |= FALL_SEEN_FREEFALL;
+    if (in->total_gyro  > th->gyro)       seen |= FALL_SEEN_ROTATION;
+    return seen;
+}
+
+RAMFUNC FallEvent_t FallDetect_Step(FallDetect_t *d, const FallInput_t *in,
+                                    const ConfigRecord_t *cfg, int *countdown)
+{
+    *countdown = -1;
+
+    switch (d->state) {
+        case STATE_NORMAL:
+            d->seen = Seen_Motion(in, &cfg->thresholds);
+            if (d->seen) {
+                d->state = STATE_FALLING;
+                d->state_us = in->sample_us;
+                d->trigger_us = in->sample_us;
+                return FALL_EV_TRIGGER;
+            }
+            break;
+
+        case STATE_FALLING:
+            d->seen |= Seen_Motion(in, &cfg->thresholds);
+            if (in->rotation_deg > FALL_ROTATION_DEG) d->seen |= FALL_SEEN_ROTATION;
+            if (in->mag_rotation > FALL_MAG_ROTATION) d->seen |= FALL_SEEN_ROTATION;
+            if (in->loud)        d->seen |= FALL_SEEN_LOUD;
+            if (in->height_drop) d->seen |= FALL_SEEN_HEIGHT;
+
+            if ((d->seen & FALL_SEEN_IMPACT) &&
+                (d->seen & (FALL_SEEN_FREEFALL | FALL_SEEN_ROTATION | FALL_SEEN_HEIGHT))) {
+                if (d->seen & FALL_SEEN_LOUD) {
+                    d->state = STATE_CONFIRMED;
+                    return FALL_EV_CRASH;
+                }
+                d->state = STATE_STILLNESS_CHECK;
+                d->state_us = in->sample_us;
+                d->last_second = -1;
+                return FALL_EV_SILENT_FALL;
+            }
+            if ((in->sample_us - d->state_us) / 1000 > cfg->falling_timeout_ms) {
+                d->state = STATE_NORMAL;
+                return FALL_EV_TIMEOUT;
+            }
+            break;
+
+        case STATE_STILLNESS_CHECK: {
+            uint32_t elapsed_ms = (in->sample_us - d->state_us) / 1000;
+            int second = (int)(elapsed_ms / 1000);
+
+            if (second != d->last_second && second < FALL_COUNTDOWN_S) {
+                *countdown = second;
+                d->last_second = second;
+            }
+
+            if (elapsed_ms < cfg->late_sound_window_ms && in->loud) {
+                d->state = STATE_CONFIRMED;
+                return FALL_EV_DELAYED_CRASH;
+            }
+            if (elapsed_ms > cfg->late_sound_window_ms &&
+                fabsf(in->total_accel - 9.8f) > cfg->thresholds.recovery_dev &&
+                in->posture_delta < FALL_POSTURE_LYING) {
+                d->state = STATE_NORMAL;
+                d->last_second = -1;
+                return FALL_EV_RECOVERED;
+            }
+            if (elapsed_ms > cfg->stillness_window_ms) {
+                d->state = STATE_CONFIRMED;
+                d->last_second = -1;
+                return FALL_EV_STILL;
+            }
+            break;
+        }
+
+        case STATE_CONFIRMED:
+            break;
+    }
+    return FALL_EV_NONE;
+}
@@ -0,0 +1,215 @@
+/******************************************************************************
+  * @file           : fmt.c
+  * @brief          : Append-style integer / fixed-point text formatting, no printf
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * sprintf walks its format string at run time, goes through the reentrant
+ * stdio layer and, for %f, pulls in newlib's dtoa: double-precision soft
+ * float on an FPU that only does single, plus a heap for its big-number
+ * scratch. Every line the firmware prints is a fixed layout of integers,
+ * short strings and a few floats with two decimals, so each call site
+ * spells its layout out as a sequence of appends instead. An integer is
+ * one division per digit. A float is split, straight from its bits, into
+ * an integer part and a 64-bit binary fraction, and the decimals come
+ * from one 64x32-bit multiply: exact, no FPU or double math, and nothing
+ * else is linked.
+ *
+ * Portable: the host tests check it digit for digit against snprintf.
+ */
+#include "fmt.h"
+#include "no_heap.h"
+
+static const uint32_t pow10[FMT_MAX_DECIMALS + 1] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+
+static inline void Put(Fmt_t *f, char c)
+{
+    if (f->pos != f->end) f->buf[f->pos++ & f->mask] = c;
+    else f->lost++;
+}
+
+static void Put_Fill(Fmt_t *f, char c, int n)
+{
+    while (n-- > 0) Put(f, c);
+}
+
+// Decimal digits of v into the end of tmp[10]; returns how many
+static int Digits(uint32_t v, char *tmp)
+{
+    int n = 0;
+    do {
+        tmp[9 - n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    return n;
+}
+
+static void Put_Digits(Fmt_t *f, uint32_t v, int width, char pad)
+{
+    char tmp[10];
+    int n = Digits(v, tmp);
+    Put_Fill(f, pad, width - n);
+    for (int k = 10 - n; k < 10; k++) Put(f, tmp[k]);
+}
+
+static int Clamp_Decimals(int decimals)
+{
+    if (decimals < 0) return 0;
+    return decimals > FMT_MAX_DECIMALS ? FMT_MAX_DECIMALS : decimals;
+}
+
+// ======================= WRITERS =========================
+
+void Fmt_Init(Fmt_t *f, char *buf, uint32_t cap)
+{
+    f->buf = buf;
+    f->mask = 0xFFFFFFFFUL;
+    f->start = 0;
+    f->pos = 0;
+    f->end = cap ? cap - 1 : 0;
+    f->lost = 0;
+    if (cap) buf[0] = '\0';
+}
+
+void Fmt_InitRing(Fmt_t *f, char *ring, uint32_t size, uint32_t head, uint32_t end)
+{
+    f->buf = ring;
+    f->mask = size - 1;
+    f->start = head;
+    f->pos = head;
+    f->end = end;
+    f->lost = 0;
+}
+
+const char *Fmt_End(Fmt_t *f)
+{
+    if (f->mask == 0xFFFFFFFFUL && f->end) f->buf[f->pos] = '\0';
+    return f->buf;
+}
+
+uint32_t Fmt_Len(const Fmt_t *f)
+{
+    return f->pos - f->start;
+}
+
+// ======================= TEXT =========================
+
+void Fmt_Char(Fmt_t *f, char c)
+{
+    Put(f, c);
+}
+
+void Fmt_Str(Fmt_t *f, const char *s)
+{
+    while (*s) Put(f, *s++);
+}
+
+void Fmt_StrPad(Fmt_t *f, const char *s, int width)
+{
+    while (*s) {
+        Put(f, *s++);
+        width--;
+    }
+    Put_Fill(f, ' ', width);
+}
+
+// ======================= NUMBERS =========================
+
+void Fmt_Uint(Fmt_t *f, uint32_t v)
+{
+    Put_Digits(f, v, 0, ' ');
+}
+
+void Fmt_UintPad(Fmt_t *f, uint32_t v, int width, char pad)
+{
+    Put_Digits(f, v, width, pad);
+}
+
+void Fmt_Int(Fmt_t *f, int32_t v)
+{
+    if (v < 0) {
+        Put(f, '-');
+        Put_Digits(f, 0u - (uint32_t)v, 0, ' ');
+    } else {
+        Put_Digits(f, (uint32_t)v, 0, ' ');
+    }
+}
+
+void Fmt_Hex(Fmt_t *f, uint32_t v, int digits)
+{
+    static const char hex[] = "0123456789abcdef";
+    int n = 1;
+    while (n < 8 && (v >> (4 * n))) n++;
+    Put_Fill(f, '0', digits - n);
+    while (n-- > 0) Put(f, hex[(v >> (4 * n)) & 0xF]);
+}
+
+void Fmt_Fixed(Fmt_t *f, int32_t v, int decimals)
+{
+    decimals = Clamp_Decimals(decimals);
+    uint32_t m = v < 0 ? 0u - (uint32_t)v : (uint32_t)v;
+    if (v < 0) Put(f, '-');
+    Put_Digits(f, m / pow10[decimals], 0, ' ');
+    if (decimals) {
+        Put(f, '.');
+        Put_Digits(f, m % pow10[decimals], decimals, '0');
+    }
+}
+
+void Fmt_Float(Fmt_t *f, float v, int decimals)
+{
+    union { float f; uint32_t u; } bits = { v };
+    uint32_t exp = (bits.u >> 23) & 0xFF;
+    uint32_t mant = bits.u & 0x7FFFFF;
+
+    decimals = Clamp_Decimals(decimals);
+    if (exp == 0xFF && mant) {
+        Fmt_Str(f, "nan");
+        return;
+    }
+    // The sign bit, like printf: -0.001 prints as "-0.00"
+    if (bits.u >> 31) Put(f, '-');
+    if (exp == 0xFF) {
+        Fmt_Str(f, "inf");
+        return;
+    }
+
+    // |v| = mant * 2^e exactly; split into ip and a 64-bit binary fraction
+    if (exp) mant |= 0x800000;
+    else exp = 1;
+    int e = (int)exp - 150;
+    uint32_t ip;
+    uint64_t frac;
+    if (e >= 0) {
+        ip = e <= 8 ? mant << e : 0xFFFFFFFFUL;
+        frac = 0;
+    } else if (e > -64) {
+        ip = e > -32 ? mant >> -e : 0;
+        frac = (uint64_t)mant << (64 + e);
+    } else {
+        ip = 0;
+        frac = -e - 64 < 32 ? (uint64_t)(mant >> (-e - 64)) : 0;
+    }
+
+    // frac * 10^decimals as 96 bits: the top word is the decimal digits, the rest decides the rounding
+    uint32_t scale = pow10[decimals];
+    uint64_t lo = (frac & 0xFFFFFFFFUL) * scale;
+    uint64_t hi = (frac >> 32) * scale + (lo >> 32);
+    uint32_t fp = (uint32_t)(hi >> 32);
+    uint64_t rest = (hi << 32) | (lo & 0xFFFFFFFFUL);
+
+    // Nearest, ties to even: what printf does with the exact binary value
+    const uint64_t half = 1ULL << 63;
+    if (rest > half || (rest == half && ((decimals ? fp : ip) & 1))) {
+        if (++fp == scale) {
+            fp = 0;
+            if (ip != 0xFFFFFFFFUL) ip++;
+        }
+    }
+
+    Put_Digits(f, ip, 0, ' ');
+    if (decimals) {
+        Put(f, '.');
+        Put_Digits(f, fp, decimals, '0');
+    }
+}
@@ -0,0 +1,157 @@
+/******************************************************************************
+  * @file           : fusion.c
+  * @brief          : 6-axis Mahony attitude filter for the fall window
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Integrates the gyro into a quaternion and nudges it towards the accel's
+ * gravity direction (Mahony complementary filter). Written for the M4's
+ * single-precision FPU: float literals only, sqrtf maps to VSQRT.F32.
+ *
+ * The filter is only started when the FSM leaves NORMAL, so it costs
+ * nothing while the wearer is just walking around. The quaternion at
+ * Fusion_Start() is kept so the total rotation over the event can be read
+ * back as a detector feature.
+ */
+#include "main.h"
+#include "fusion.h"
+#include <math.h>
+#include "no_heap.h"
+
+#define DEG_TO_RAD  0.017453293f
+#define RAD_TO_DEG  57.29578f
+
+static float q[4] = {1.0f, 0.0f, 0.0f, 0.0f};      // w, x, y, z (body -> earth)
+static float q_start[4] = {1.0f, 0.0f, 0.0f, 0.0f};
+static float integral_err[3] = {0.0f, 0.0f, 0.0f};
+static int running = 0;
+
+static uint32_t last_cycles = 0;
+static uint32_t max_cycles = 0;
+
+static void CycleCounter_Enable(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+// Seed the attitude from gravity alone (yaw is unobservable, so it starts at 0)
+void Fusion_Start(float ax, float ay, float az)
+{
+    CycleCounter_Enable();
+
+    float norm = sqrtf(ax * ax + ay * ay + az * az);
+    if (norm < 1e-6f) {
+        q[0] = 1.0f; q[1] = 0.0f; q[2] = 0.0f; q[3] = 0.0f;
+    } else {
+        float roll  = atan2f(ay, az);
+        float pitch = atan2f(-ax, sqrtf(ay * ay + az * az));
+        float cr = cosf(roll * 0.5f),  sr = sinf(roll * 0.5f);
+        float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+        q[0] = cr * cp;
+        q[1] = sr * cp;
+        q[2] = cr * sp;
+        q[3] = -sr * sp;
+    }
+
+    for (int k = 0; k < 4; k++) q_start[k] = q[k];
+    integral_err[0] = integral_err[1] = integral_err[2] = 0.0f;
+    max_cycles = 0;
+    running = 1;
+}
+
+void Fusion_Stop(void)
+{
+    running = 0;
+}
+
+int Fusion_IsRunning(void)
+{
+    return running;
+}
+
+void Fusion_Update(float gx_dps, float gy_dps, float gz_dps,
+                   float ax, float ay, float az, float dt)
+{
+    if (!running) return;
+
+    uint32_t t0 = DWT->CYCCNT;
+
+    float gx = gx_dps * DEG_TO_RAD;
+    float gy = gy_dps * DEG_TO_RAD;
+    float gz = gz_dps * DEG_TO_RAD;
+
+    float q0 = q[0], q1 = q[1], q2 = q[2], q3 = q[3];
+
+    // Accel correction, skipped during impact/freefall when |a| is not gravity
+    float a_norm2 = ax * ax + ay * ay + az * az;
+    if (a_norm2 > 1e-6f) {
+        float a_norm = sqrtf(a_norm2);
+        float v_half_x = q1 * q3 - q0 * q2;
+        float v_half_y = q0 * q1 + q2 * q3;
+        float v_half_z = q0 * q0 - 0.5f + q3 * q3;
+        float g_ref = 9.8f;
+        if (fabsf(a_norm - g_ref) < FUSION_ACCEL_GATE * g_ref) {
+            float inv = 1.0f / a_norm;
+            ax *= inv; ay *= inv; az *= inv;
+
+            // Error is cross product of measured and estimated gravity
+            float ex = ay * v_half_z - az * v_half_y;
+            float ey = az * v_half_x - ax * v_half_z;
+            float ez = ax * v_half_y - ay * v_half_x;
+
+            if (FUSION_KI > 0.0f) {
+                integral_err[0] += 2.0f * FUSION_KI * ex * dt;
+                integral_err[1] += 2.0f * FUSION_KI * ey * dt;
+                integral_err[2] += 2.0f * FUSION_KI * ez * dt;
+                gx += integral_err[0];
+                gy += integral_err[1];
+                gz += integral_err[2];
+            }
+            gx += 2.0f * FUSION_KP * ex;
+            gy += 2.0f * FUSION_KP * ey;
+            gz += 2.0f * FUSION_KP * ez;
+        }
+    }
+
+    // q += 0.5 * q (x) (0, g) * dt
+    float h = 0.5f * dt;
+    gx *= h; gy *= h; gz *= h;
+    q[0] = q0 + (-q1 * gx - q2 * gy - q3 * gz);
+    q[1] = q1 + ( q0 * gx + q2 * gz - q3 * gy);
+    q[2] = q2 + ( q0 * gy - q1 * gz + q3 * gx);
+    q[3] = q3 + ( q0 * gz + q1 * gy - q2 * gx);
+
+    float inv_n = 1.0f / sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    q[0] *= inv_n; q[1] *= inv_n; q[2] *= inv_n; q[3] *= inv_n;
+
+    last_cycles = DWT->CYCCNT - t0;
+    if (last_cycles > max_cycles) max_cycles = last_cycles;
+}
+
+void Fusion_GetQuaternion(float q_out[4])
+{
+    for (int k = 0; k < 4; k++) q_out[k] = q[k];
+}
+
+// Rotation (deg) between the attitude at Fusion_Start() and now: 2*atan2(|v|, |w|) of q_start* (x) q
+float Fusion_GetEventRotation(void)
+{
+    float w =  q_start[0] * q[0] + q_start[1] * q[1] + q_start[2] * q[2] + q_start[3] * q[3];
+    float x =  q_start[0] * q[1] - q_start[1] * q[0] - q_start[2] * q[3] + q_start[3] * q[2];
+    float y =  q_start[0] * q[2] + q_start[1] * q[3] - q_start[2] * q[0] - q_start[3] * q[1];
+    float z =  q_start[0] * q[3] - q_start[1] * q[2] + q_start[2] * q[1] - q_start[3] * q[0];
+
+    float v = sqrtf(x * x + y * y + z * z);
+    return 2.0f * atan2f(v, fabsf(w)) * RAD_TO_DEG;
+}
+
+uint32_t Fusion_GetLastCycles(void)
+{
+    return last_cycles;
+}
+
+uint32_t Fusion_GetMaxCycles(void)
+{
+    return max_cycles;
+}
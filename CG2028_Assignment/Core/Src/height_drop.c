@@ -0,0 +1,202 @@
+/******************************************************************************
+  * @file           : height_drop.c
+  * @brief          : Barometric height-drop estimator (fixed point)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * A fall takes the waist from ~1 m to the floor, about 0.1 hPa of
+ * pressure, while the LPS22HB resolves 1/4096 hPa (~2 mm) with ~6 cm RMS
+ * noise. Each sample becomes a height relative to the first one,
+ * dh = -H * dP / P, and goes through a one-pole low-pass in Q4 mm. Every
+ * HEIGHT_DECIMATE samples the filtered height and its time go into a
+ * history ring; the vertical speed is the least-squares slope over the
+ * last HEIGHT_RATE_SPAN entries.
+ *
+ * The FSM trigger usually comes at the impact, i.e. after most of the
+ * drop, so the reference is the history entry from HEIGHT_PRE_EVENT_MS
+ * before the trigger. The drop counts once it stays past HEIGHT_DROP_MM
+ * with the speed back near zero for HEIGHT_HOLD_MS: lying on the floor,
+ * not a door-slam pressure pulse. Someone who was already moving
+ * vertically at the reference (stairs, a lift) gets no height evidence.
+ *
+ * Samples arrive in FIFO bursts a few hundred ms late; every sample keeps
+ * its own timestamp, so the late arrival only delays the decision.
+ */
+#include "height_drop.h"
+#include "no_heap.h"
+
+#define SAMPLE_MS_Q8    ((1000u << 8) / HEIGHT_ODR_HZ)
+
+typedef struct {
+    uint32_t tick;
+    int32_t  h_mm;
+} HeightEntry_t;
+
+static int32_t p_ref = 0;           // raw pressure of the first sample = height 0
+static int32_t h_q4 = 0;            // filtered height, Q4 mm
+static uint32_t n_samples = 0;
+
+static HeightEntry_t history[HEIGHT_HISTORY];
+static uint32_t n_entries = 0;      // total pushed; newest at (n_entries - 1) % HEIGHT_HISTORY
+static int32_t rate_mm_s = 0;
+
+// Event window
+static int event_open = 0;
+static uint32_t event_tick = 0;
+static int32_t ref_mm = 0;
+static int ref_valid = 0;
+static int ref_moving = 0;          // already going up/down before the event: stairs, lift
+static int32_t max_drop_mm = 0;
+static int holding = 0;
+static uint32_t hold_since = 0;
+static int seen = 0;
+
+// ======================= HELPERS =========================
+
+static const HeightEntry_t *Entry(uint32_t back)
+{
+    return &history[(n_entries - 1 - back) % HEIGHT_HISTORY];
+}
+
+static int32_t Abs(int32_t v) { return v < 0 ? -v : v; }
+
+// Newest entry taken at or before tick, else the oldest one kept (needs n_entries > 0)
+static const HeightEntry_t *Entry_At(uint32_t tick)
+{
+    uint32_t kept = n_entries < HEIGHT_HISTORY ? n_entries : HEIGHT_HISTORY;
+    for (uint32_t b = 0; b < kept; b++) {
+        if ((int32_t)(Entry(b)->tick - tick) <= 0) return Entry(b);
+    }
+    return Entry(kept - 1);
+}
+
+static void Push_Entry(uint32_t tick)
+{
+    HeightEntry_t *e = &history[n_entries % HEIGHT_HISTORY];
+    e->tick = tick;
+    e->h_mm = h_q4 >> 4;
+    n_entries++;
+
+    // Centred sums (scaled by the span) keep the slope exact in integers
+    if (n_entries >= HEIGHT_RATE_SPAN) {
+        int64_t sxy = 0, sxx = 0;
+        int32_t t0 = (int32_t)Entry(HEIGHT_RATE_SPAN - 1)->tick;
+        int64_t st = 0, sh = 0;
+        for (uint32_t b = 0; b < HEIGHT_RATE_SPAN; b++) {
+            st += (int32_t)Entry(b)->tick - t0;
+            sh += Entry(b)->h_mm;
+        }
+        for (uint32_t b = 0; b < HEIGHT_RATE_SPAN; b++) {
+            int64_t dt = ((int64_t)((int32_t)Entry(b)->tick - t0)) * HEIGHT_RATE_SPAN - st;
+            int64_t dh = (int64_t)Entry(b)->h_mm * HEIGHT_RATE_SPAN - sh;
+            sxy += dt * dh;
+            sxx += dt * dt;
+        }
+        if (sxx) rate_mm_s = (int32_t)(sxy * 1000 / sxx);
+    }
+}
+
+static void Check_Event(uint32_t tick)
+{
+    if (!event_open || seen) return;
+    if (!ref_valid) {
+        ref_mm = Entry_At(event_tick - HEIGHT_PRE_EVENT_MS)->h_mm;
+        ref_moving = Abs(Entry_At(event_tick - 2 * HEIGHT_PRE_EVENT_MS)->h_mm - ref_mm) > HEIGHT_PRE_MOVE_MM;
+        ref_valid = 1;
+    }
+
+    int32_t drop = ref_mm - (h_q4 >> 4);
+    if (drop > max_drop_mm) max_drop_mm = drop;
+
+    if (!ref_moving && drop >= HEIGHT_DROP_MM && Abs(rate_mm_s) <= HEIGHT_SETTLED_MM_S) {
+        if (!holding) {
+            holding = 1;
+            hold_since = tick;
+        } else if (tick - hold_since >= HEIGHT_HOLD_MS) {
+            seen = 1;
+        }
+    } else {
+        holding = 0;
+    }
+}
+
+// ======================= PUBLIC API =========================
+
+void HeightDrop_Init(void)
+{
+    p_ref = 0;
+    h_q4 = 0;
+    n_samples = 0;
+    n_entries = 0;
+    rate_mm_s = 0;
+    HeightDrop_StopEvent();
+}
+
+void HeightDrop_AddSample(int32_t raw, uint32_t tick)
+{
+    if (raw <= 0) return;               // no pressure: sensor not converted yet
+    if (n_samples == 0) p_ref = raw;
+
+    int32_t h_mm = (int32_t)(-(int64_t)(raw - p_ref) * HEIGHT_SCALE_MM / p_ref);
+    if (n_samples == 0) h_q4 = h_mm * 16;
+    else h_q4 += (h_mm * 16 - h_q4) >> HEIGHT_LPF_SHIFT;
+    n_samples++;
+
+    if (n_samples % HEIGHT_DECIMATE == 0) {
+        Push_Entry(tick);
+        Check_Event(tick);
+    }
+}
+
+void HeightDrop_FeedFifo(const uint8_t *fifo, uint32_t n, uint32_t tick_last)
+{
+    for (uint32_t k = 0; k < n; k++) {
+        const uint8_t *s = fifo + 5 * k;
+        int32_t raw = (int32_t)((uint32_t)s[0] | ((uint32_t)s[1] << 8) | ((uint32_t)s[2] << 16));
+        if (raw & 0x800000) raw -= 0x1000000;          // 24-bit two's complement
+        uint32_t age_ms = (uint32_t)(((n - 1 - k) * SAMPLE_MS_Q8) >> 8);
+        HeightDrop_AddSample(raw, tick_last - age_ms);
+    }
+}
+
+void HeightDrop_StartEvent(uint32_t tick)
+{
+    event_open = 1;
+    event_tick = tick;
+    ref_valid = 0;                      // looked up on the next history entry
+    max_drop_mm = 0;
+    holding = 0;
+    seen = 0;
+}
+
+void HeightDrop_StopEvent(void)
+{
+    event_open = 0;
+    holding = 0;
+    seen = 0;
+}
+
+int HeightDrop_Seen(void)
+{
+    return seen;
+}
+
+int32_t HeightDrop_GetDropMm(void)
+{
+    return max_drop_mm;
+}
+
+int32_t HeightDrop_GetHeightMm(void)
+{
+    return h_q4 >> 4;
+}
+
+int32_t HeightDrop_GetRateMmS(void)
+{
+    return rate_mm_s;
+}
+
+uint32_t HeightDrop_GetSamples(void)
+{
+    return n_samples;
+}
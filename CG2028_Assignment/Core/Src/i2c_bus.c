@@ -0,0 +1,568 @@
+/******************************************************************************
+  * @file           : i2c_bus.c
+  * @brief          : I2C2 transaction scheduler (DMA jobs, priority classes)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Every device on I2C2 (LSM6DSL, LIS3MDL, LPS22HB, HTS221, ST25DV, ...)
+ * goes through one queue of register read/write jobs. Each job runs as a
+ * HAL Mem_Read/Mem_Write DMA transfer; its completion interrupt starts the
+ * next job straight away, picking the highest priority class first (the
+ * IMU before other sensors before the NFC tag), oldest first within a
+ * class. A transfer on the wire is never cut short, so an IMU read waits
+ * at most for the one job already running.
+ *
+ * Callers either queue a job with a callback (I2cBus_Submit, the callback
+ * runs from I2cBus_Poll in the main loop) or block on it (I2cBus_Transfer,
+ * what the BSP sensor drivers use through stm32l4s5i_iot01.c).
+ *
+ * Bus errors and timeouts no longer DeInit/MspInit/Init the whole bus:
+ * clearing PE resets the I2C state machine in a few cycles, and a slave
+ * holding SDA low is released with nine SCL pulses and a STOP. A NACK is
+ * an answer (busy EEPROM, absent device) and needs no recovery at all.
+ *
+ * The I2C kernel clock is HSI16 rather than PCLK1 (4 MHz MSI here), which
+ * gives the reference-manual timings for 100 kHz, 400 kHz and 1 MHz
+ * (Fast-mode Plus) independently of the core clock. The speed is the
+ * lowest limit among the devices below.
+ */
+#include "main.h"
+#include "i2c_bus.h"
+
+#include "string.h"
+#include "no_heap.h"
+
+#define I2C_SCL_PIN             GPIO_PIN_10
+#define I2C_SDA_PIN             GPIO_PIN_11
+#define I2C_GPIO_PORT           GPIOB
+
+// TIMINGR for a 16 MHz kernel clock (RM0432, I2C timing examples)
+#define I2C_TIMING_100K         0x30420F13UL
+#define I2C_TIMING_400K         0x10320309UL
+#define I2C_TIMING_1M           0x00200204UL
+
+#define RUN_NONE                (-1)
+#define RUN_PROBE               (-2)    // blocking address probe owns the bus
+
+typedef struct {
+    uint8_t     addr;
+    const char *name;
+    uint8_t     prio;
+    uint16_t    max_khz;
+} I2cDevice_t;
+
+// Every part on the B-L4S5I-IOT01A I2C2 bus, used or not: they all see the clock
+static const I2cDevice_t devices[] = {
+    { 0xD4, "LSM6DSL",  I2C_PRIO_IMU,        400  },
+    { 0x3C, "LIS3MDL",  I2C_PRIO_SENSOR,     400  },
+    { 0xBA, "LPS22HB",  I2C_PRIO_SENSOR,     400  },
+    { 0xBE, "HTS221",   I2C_PRIO_SENSOR,     400  },
+    { 0x52, "VL53L0X",  I2C_PRIO_SENSOR,     400  },
+    { 0x40, "STSAFE",   I2C_PRIO_SENSOR,     1000 },
+    { 0xA6, "ST25DV",   I2C_PRIO_BACKGROUND, 1000 },     // user memory, dynamic registers, mailbox
+    { 0xAE, "ST25DV-S", I2C_PRIO_BACKGROUND, 1000 },     // system configuration
+    { 0x00, "other",    I2C_PRIO_SENSOR,     1000 },     // must stay last
+};
+#define N_DEVICES               (sizeof(devices) / sizeof(devices[0]))
+
+typedef enum {
+    SLOT_FREE = 0,
+    SLOT_QUEUED,
+    SLOT_RUNNING,
+    SLOT_DONE
+} SlotState_t;
+
+typedef struct {
+    I2cJob_t job;
+    uint8_t  dev;
+    uint8_t  prio;
+    uint8_t  sync;              // I2cBus_Transfer() is spinning on it
+    volatile uint8_t state;     // SlotState_t
+    I2cResult_t result;
+    uint32_t seq;
+    uint32_t t_queued;          // DWT
+    uint32_t t_start;
+    uint32_t deadline;          // HAL tick
+} Slot_t;
+
+extern I2C_HandleTypeDef hI2cHandler;   // owned by the BSP (stm32l4s5i_iot01.c)
+DMA_HandleTypeDef hdma_i2c2_rx;
+DMA_HandleTypeDef hdma_i2c2_tx;
+
+static int initialised = 0;
+static uint32_t bus_khz = 0;
+static Slot_t slots[I2C_BUS_QUEUE_LEN];
+static volatile int running = RUN_NONE;
+static uint32_t submit_seq = 0;
+
+// Finished async jobs, in completion order (producer: IRQ, consumer: I2cBus_Poll)
+static volatile uint8_t done_fifo[I2C_BUS_QUEUE_LEN];
+static volatile uint32_t done_head = 0;
+static uint32_t done_tail = 0;
+
+static I2cDevStats_t dev_stats[N_DEVICES];
+static I2cBusStats_t stats;
+
+// ======================= HELPERS =========================
+
+static uint32_t Lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static void Unlock(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+static uint32_t Us(uint32_t cycles)
+{
+    return (uint32_t)((uint64_t)cycles * 1000000u / SystemCoreClock);
+}
+
+static uint8_t Find_Device(uint8_t addr)
+{
+    for (uint32_t k = 0; k < N_DEVICES - 1; k++) {
+        if (devices[k].addr == addr) return (uint8_t)k;
+    }
+    return N_DEVICES - 1;
+}
+
+static uint32_t Queued(void)
+{
+    uint32_t n = 0;
+    for (int k = 0; k < I2C_BUS_QUEUE_LEN; k++) {
+        if (slots[k].state != SLOT_FREE) n++;
+    }
+    return n;
+}
+
+// ======================= BUS RECOVERY =========================
+
+static void Delay_Half_Bit(void)
+{
+    uint32_t t0 = DWT->CYCCNT;
+    uint32_t wait = SystemCoreClock / 200000u + 1;     // 5 us, a 100 kHz half period
+    while (DWT->CYCCNT - t0 < wait) { }
+}
+
+// A slave stopped mid-byte keeps SDA low: clock it out and finish with a STOP
+static void Unstick_Bus(void)
+{
+    GPIO_InitTypeDef gpio = {0};
+    gpio.Pin = I2C_SCL_PIN | I2C_SDA_PIN;
+    gpio.Mode = GPIO_MODE_OUTPUT_OD;
+    gpio.Pull = GPIO_PULLUP;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SCL_PIN | I2C_SDA_PIN, GPIO_PIN_SET);
+    HAL_GPIO_Init(I2C_GPIO_PORT, &gpio);
+
+    for (int k = 0; k < 9 && HAL_GPIO_ReadPin(I2C_GPIO_PORT, I2C_SDA_PIN) == GPIO_PIN_RESET; k++) {
+        HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SCL_PIN, GPIO_PIN_RESET);
+        Delay_Half_Bit();
+        HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SCL_PIN, GPIO_PIN_SET);
+        Delay_Half_Bit();
+    }
+    HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SCL_PIN, GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SDA_PIN, GPIO_PIN_RESET);
+    Delay_Half_Bit();
+    HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SCL_PIN, GPIO_PIN_SET);
+    Delay_Half_Bit();
+    HAL_GPIO_WritePin(I2C_GPIO_PORT, I2C_SDA_PIN, GPIO_PIN_SET);        // STOP
+    Delay_Half_Bit();
+
+    gpio.Mode = GPIO_MODE_AF_OD;
+    gpio.Alternate = GPIO_AF4_I2C2;
+    HAL_GPIO_Init(I2C_GPIO_PORT, &gpio);
+}
+
+// Stops the DMA, resets the I2C state machine with PE and hands the handle back as READY
+static void Recover(void)
+{
+    I2C_TypeDef *i2c = hI2cHandler.Instance;
+
+    HAL_DMA_Abort(&hdma_i2c2_rx);
+    HAL_DMA_Abort(&hdma_i2c2_tx);
+    __HAL_I2C_DISABLE_IT(&hI2cHandler, I2C_IT_ERRI | I2C_IT_TCI | I2C_IT_STOPI |
+                                       I2C_IT_NACKI | I2C_IT_RXI | I2C_IT_TXI);
+    i2c->CR1 &= ~(I2C_CR1_TXDMAEN | I2C_CR1_RXDMAEN | I2C_CR1_PE);
+    if (HAL_GPIO_ReadPin(I2C_GPIO_PORT, I2C_SDA_PIN) == GPIO_PIN_RESET) Unstick_Bus();
+    i2c->CR2 = 0;
+    i2c->CR1 |= I2C_CR1_PE;
+
+    hI2cHandler.State = HAL_I2C_STATE_READY;
+    hI2cHandler.Mode = HAL_I2C_MODE_NONE;
+    hI2cHandler.ErrorCode = HAL_I2C_ERROR_NONE;
+    hI2cHandler.PreviousState = 0;
+    __HAL_UNLOCK(&hI2cHandler);
+    stats.recoveries++;
+}
+
+// ======================= ENGINE (IRQ context or locked) =========================
+
+static void Complete(I2cResult_t res)
+{
+    Slot_t *s = &slots[running];
+    I2cDevStats_t *d = &dev_stats[s->dev];
+    uint32_t xfer_us = Us(DWT->CYCCNT - s->t_start);
+    uint32_t wait_us = Us(s->t_start - s->t_queued);
+
+    d->jobs++;
+    d->total_xfer_us += xfer_us;
+    if (xfer_us > d->max_xfer_us) d->max_xfer_us = xfer_us;
+    if (wait_us > d->max_wait_us) d->max_wait_us = wait_us;
+    if (res == I2C_NACK) d->nacks++;
+    else if (res == I2C_TIMEOUT) d->timeouts++;
+    else if (res != I2C_OK) d->errors++;
+    stats.jobs++;
+
+    s->result = res;
+    s->state = SLOT_DONE;
+    if (!s->sync) {
+        done_fifo[done_head % I2C_BUS_QUEUE_LEN] = (uint8_t)running;
+        done_head++;
+    }
+    running = RUN_NONE;
+}
+
+static int Pick_Next(void)
+{
+    int best = -1;
+    for (int k = 0; k < I2C_BUS_QUEUE_LEN; k++) {
+        const Slot_t *s = &slots[k];
+        if (s->state != SLOT_QUEUED) continue;
+        if (best < 0 || s->prio < slots[best].prio ||
+            (s->prio == slots[best].prio && (int32_t)(s->seq - slots[best].seq) < 0)) {
+            best = k;
+        }
+    }
+    return best;
+}
+
+static void Start_Next(void)
+{
+    while (running == RUN_NONE) {
+        int k = Pick_Next();
+        if (k < 0) return;
+
+        Slot_t *s = &slots[k];
+        uint16_t msize = (s->job.reg_size == 2) ? I2C_MEMADD_SIZE_16BIT : I2C_MEMADD_SIZE_8BIT;
+        HAL_StatusTypeDef st;
+
+        running = k;
+        s->state = SLOT_RUNNING;
+        s->t_start = DWT->CYCCNT;
+        s->deadline = HAL_GetTick() + s->job.timeout_ms;
+        if (s->job.write) {
+            st = HAL_I2C_Mem_Write_DMA(&hI2cHandler, s->job.addr, s->job.reg, msize, s->job.data, s->job.len);
+        } else {
+            st = HAL_I2C_Mem_Read_DMA(&hI2cHandler, s->job.addr, s->job.reg, msize, s->job.data, s->job.len);
+        }
+        if (st != HAL_OK) {
+            Recover();
+            Complete(I2C_BUS_ERROR);
+        }
+    }
+}
+
+// Job over its deadline: take the bus back and fail it
+static void Check_Deadline(void)
+{
+    uint32_t primask = Lock();
+    if (running >= 0 && (int32_t)(HAL_GetTick() - slots[running].deadline) > 0) {
+        Recover();
+        Complete(I2C_TIMEOUT);
+        Start_Next();
+    }
+    Unlock(primask);
+}
+
+static int Enqueue(const I2cJob_t *job, int sync)
+{
+    if (!initialised && !I2cBus_Init()) return -1;
+
+    uint32_t primask = Lock();
+    int k;
+    for (k = 0; k < I2C_BUS_QUEUE_LEN; k++) {
+        if (slots[k].state == SLOT_FREE) break;
+    }
+    if (k == I2C_BUS_QUEUE_LEN) {
+        stats.queue_full++;
+        Unlock(primask);
+        return -1;
+    }
+
+    Slot_t *s = &slots[k];
+    s->job = *job;
+    if (s->job.reg_size != 2) s->job.reg_size = 1;
+    if (s->job.timeout_ms == 0) {
+        s->job.timeout_ms = (uint16_t)(5 + (job->len + 3u) * I2cBus_ByteUs() / 1000u);
+    }
+    s->dev = Find_Device(job->addr);
+    s->prio = devices[s->dev].prio;
+    s->sync = (uint8_t)sync;
+    s->seq = submit_seq++;
+    s->t_queued = DWT->CYCCNT;
+    s->state = SLOT_QUEUED;
+
+    uint32_t n = Queued();
+    if (n > stats.max_queued) stats.max_queued = n;
+    Start_Next();
+    Unlock(primask);
+    return k;
+}
+
+// ======================= HAL CALLBACKS (IRQ) =========================
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != &hI2cHandler || running < 0) return;
+    Complete(I2C_OK);
+    Start_Next();
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != &hI2cHandler || running < 0) return;
+    Complete(I2C_OK);
+    Start_Next();
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    if (hi2c != &hI2cHandler || running < 0) return;
+
+    // NACK: the HAL has already sent STOP and the bus is fine
+    if (hi2c->ErrorCode == HAL_I2C_ERROR_AF) {
+        Complete(I2C_NACK);
+    } else {
+        Recover();
+        Complete(I2C_BUS_ERROR);
+    }
+    Start_Next();
+}
+
+// ======================= PUBLIC API =========================
+
+int I2cBus_Init(void)
+{
+    if (initialised) return 1;
+
+    memset(slots, 0, sizeof(slots));
+    memset(dev_stats, 0, sizeof(dev_stats));
+    memset(&stats, 0, sizeof(stats));
+    running = RUN_NONE;
+    done_head = done_tail = 0;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // Kernel clock: HSI16, whatever the core runs at
+    RCC_OscInitTypeDef osc = {0};
+    osc.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+    osc.HSIState = RCC_HSI_ON;
+    osc.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+    osc.PLL.PLLState = RCC_PLL_NONE;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) return 0;
+
+    RCC_PeriphCLKInitTypeDef clk = {0};
+    clk.PeriphClockSelection = RCC_PERIPHCLK_I2C2;
+    clk.I2c2ClockSelection = RCC_I2C2CLKSOURCE_HSI;
+    if (HAL_RCCEx_PeriphCLKConfig(&clk) != HAL_OK) return 0;
+
+    // Bus speed: the slowest device decides
+    uint32_t khz = I2C_BUS_MAX_KHZ;
+    for (uint32_t k = 0; k < N_DEVICES - 1; k++) {
+        if (devices[k].max_khz < khz) khz = devices[k].max_khz;
+    }
+    uint32_t timing;
+    if (khz >= 1000)     { bus_khz = 1000; timing = I2C_TIMING_1M; }
+    else if (khz >= 400) { bus_khz = 400;  timing = I2C_TIMING_400K; }
+    else                 { bus_khz = 100;  timing = I2C_TIMING_100K; }
+
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_I2C2_CLK_ENABLE();
+    __HAL_RCC_I2C2_FORCE_RESET();
+    __HAL_RCC_I2C2_RELEASE_RESET();
+
+    GPIO_InitTypeDef gpio = {0};
+    gpio.Pin = I2C_SCL_PIN | I2C_SDA_PIN;
+    gpio.Mode = GPIO_MODE_AF_OD;
+    gpio.Pull = GPIO_PULLUP;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF4_I2C2;
+    HAL_GPIO_Init(I2C_GPIO_PORT, &gpio);
+
+    // A slave left mid-byte by a reset would otherwise hold the bus from the start
+    if (HAL_GPIO_ReadPin(I2C_GPIO_PORT, I2C_SDA_PIN) == GPIO_PIN_RESET) Unstick_Bus();
+
+    hI2cHandler.Instance = I2C2;
+    hI2cHandler.Init.Timing = timing;
+    hI2cHandler.Init.OwnAddress1 = 0;
+    hI2cHandler.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+    hI2cHandler.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+    hI2cHandler.Init.OwnAddress2 = 0;
+    hI2cHandler.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+    hI2cHandler.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+    if (HAL_I2C_Init(&hI2cHandler) != HAL_OK) return 0;
+    HAL_I2CEx_ConfigAnalogFilter(&hI2cHandler, I2C_ANALOGFILTER_ENABLE);
+    if (bus_khz >= 1000) HAL_I2CEx_EnableFastModePlus(I2C_FASTMODEPLUS_I2C2);
+
+    __HAL_RCC_DMAMUX1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    hdma_i2c2_rx.Instance = DMA1_Channel1;
+    hdma_i2c2_rx.Init.Request = DMA_REQUEST_I2C2_RX;
+    hdma_i2c2_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_i2c2_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_i2c2_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_i2c2_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_i2c2_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_i2c2_rx.Init.Mode = DMA_NORMAL;
+    hdma_i2c2_rx.Init.Priority = DMA_PRIORITY_HIGH;
+    HAL_DMA_Init(&hdma_i2c2_rx);
+    __HAL_LINKDMA(&hI2cHandler, hdmarx, hdma_i2c2_rx);
+
+    hdma_i2c2_tx.Instance = DMA1_Channel2;
+    hdma_i2c2_tx.Init = hdma_i2c2_rx.Init;
+    hdma_i2c2_tx.Init.Request = DMA_REQUEST_I2C2_TX;
+    hdma_i2c2_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    HAL_DMA_Init(&hdma_i2c2_tx);
+    __HAL_LINKDMA(&hI2cHandler, hdmatx, hdma_i2c2_tx);
+
+    HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, I2C_BUS_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+    HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, I2C_BUS_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+    HAL_NVIC_SetPriority(I2C2_EV_IRQn, I2C_BUS_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(I2C2_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C2_ER_IRQn, I2C_BUS_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(I2C2_ER_IRQn);
+
+    stats.khz = bus_khz;
+    initialised = 1;
+    return 1;
+}
+
+void I2cBus_DeInit(void)
+{
+    if (!initialised) return;
+    uint32_t primask = Lock();
+    if (running >= 0) {
+        Recover();
+        Complete(I2C_BUS_ERROR);
+    }
+    Unlock(primask);
+
+    HAL_NVIC_DisableIRQ(I2C2_EV_IRQn);
+    HAL_NVIC_DisableIRQ(I2C2_ER_IRQn);
+    HAL_NVIC_DisableIRQ(DMA1_Channel1_IRQn);
+    HAL_NVIC_DisableIRQ(DMA1_Channel2_IRQn);
+    HAL_DMA_DeInit(&hdma_i2c2_rx);
+    HAL_DMA_DeInit(&hdma_i2c2_tx);
+    HAL_I2C_DeInit(&hI2cHandler);
+    HAL_GPIO_DeInit(I2C_GPIO_PORT, I2C_SCL_PIN | I2C_SDA_PIN);
+    __HAL_RCC_I2C2_CLK_DISABLE();
+    initialised = 0;
+}
+
+int I2cBus_Submit(const I2cJob_t *job)
+{
+    return Enqueue(job, 0) >= 0;
+}
+
+// Deadlines, then the callbacks of finished jobs in completion order
+void I2cBus_Poll(void)
+{
+    if (!initialised) return;
+    Check_Deadline();
+
+    while (done_tail != done_head) {
+        Slot_t *s = &slots[done_fifo[done_tail % I2C_BUS_QUEUE_LEN]];
+        I2cDone_t done = s->job.done;
+        void *ctx = s->job.ctx;
+        I2cResult_t res = s->result;
+        done_tail++;
+        s->state = SLOT_FREE;
+        if (done) done(res, ctx);
+    }
+}
+
+uint32_t I2cBus_Pending(void)
+{
+    return Queued();
+}
+
+I2cResult_t I2cBus_Transfer(uint8_t addr, uint16_t reg, uint8_t reg_size,
+                            uint8_t *data, uint16_t len, int write)
+{
+    I2cJob_t job = {0};
+    job.addr = addr;
+    job.reg = reg;
+    job.reg_size = reg_size;
+    job.data = data;
+    job.len = len;
+    job.write = (uint8_t)(write != 0);
+
+    int k = Enqueue(&job, 1);
+    if (k < 0) return I2C_QUEUE_FULL;
+
+    // Spin on our own slot; the interrupts keep the queue moving meanwhile
+    while (slots[k].state != SLOT_DONE) Check_Deadline();
+
+    I2cResult_t res = slots[k].result;
+    slots[k].state = SLOT_FREE;
+    return res;
+}
+
+// HAL's probe has no DMA/IT form: run it blocking in a gap between jobs
+I2cResult_t I2cBus_Probe(uint8_t addr, uint32_t trials)
+{
+    if (!initialised && !I2cBus_Init()) return I2C_BUS_ERROR;
+
+    for (;;) {
+        uint32_t primask = Lock();
+        if (running == RUN_NONE) {
+            running = RUN_PROBE;
+            Unlock(primask);
+            break;
+        }
+        Unlock(primask);
+        Check_Deadline();
+    }
+
+    HAL_StatusTypeDef st = HAL_I2C_IsDeviceReady(&hI2cHandler, addr, trials, 2);
+    if (st != HAL_OK && hI2cHandler.ErrorCode != HAL_I2C_ERROR_AF &&
+        hI2cHandler.ErrorCode != HAL_I2C_ERROR_NONE) {
+        Recover();
+    }
+
+    uint32_t primask = Lock();
+    running = RUN_NONE;
+    Start_Next();
+    Unlock(primask);
+    return st == HAL_OK ? I2C_OK : I2C_NACK;
+}
+
+uint32_t I2cBus_ByteUs(void)
+{
+    uint32_t khz = bus_khz ? bus_khz : 100;
+    return (9000u + khz - 1) / khz;         // 8 data bits + ACK
+}
+
+int I2cBus_GetDeviceStats(int index, I2cDevStats_t *st)
+{
+    if (index < 0 || index >= (int)N_DEVICES) return 0;
+    *st = dev_stats[index];
+    st->name = devices[index].name;
+    st->addr = devices[index].addr;
+    st->prio = devices[index].prio;
+    return 1;
+}
+
+void I2cBus_GetStats(I2cBusStats_t *st)
+{
+    *st = stats;
+}
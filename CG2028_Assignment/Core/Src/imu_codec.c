@@ -0,0 +1,158 @@
+/******************************************************************************
+  * @file           : imu_codec.c
+  * @brief          : Delta / zig-zag / varint-or-Rice codec for IMU sample streams
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Encoder side (runs on the board). Consecutive LSM6DSL samples are highly
+ * correlated, so each channel is replaced by its prediction residual,
+ * zig-zag mapped so small +/- values become small unsigned ones, then
+ * written either as a varint (byte aligned, cheapest to encode) or as an
+ * adaptive Rice code (bit packed, smaller).
+ *
+ * No allocation and no HAL: the caller owns the output buffer, and the
+ * same file builds on Linux for the host decoder and benchmark
+ * (host/imu_decode.c, host/codec_bench.c).
+ */
+#include "imu_codec.h"
+
+#include "string.h"
+
+// ======================= OUTPUT HELPERS =========================
+
+static void Put_Byte(ImuEncoder_t *e, uint8_t b)
+{
+    e->out[e->len++] = b;
+}
+
+static void Put_Varint(ImuEncoder_t *e, uint16_t v)
+{
+    while (v >= 0x80) {
+        Put_Byte(e, (uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    Put_Byte(e, (uint8_t)v);
+}
+
+// n <= 24 bits per call; the accumulator never holds more than 7 bits between calls
+static void Put_Bits(ImuEncoder_t *e, uint32_t bits, uint32_t n)
+{
+    e->acc = (e->acc << n) | (bits & ((1UL << n) - 1));
+    e->nbits += n;
+    while (e->nbits >= 8) {
+        e->nbits -= 8;
+        Put_Byte(e, (uint8_t)(e->acc >> e->nbits));
+    }
+}
+
+static void Put_Rice(ImuEncoder_t *e, int ch, uint16_t zz)
+{
+    uint32_t k = ImuCodec_RiceK(e->rice_a[ch], e->rice_n[ch]);
+    uint32_t q = (uint32_t)zz >> k;
+
+    if (q < IMU_CODEC_RICE_ESCAPE) {
+        Put_Bits(e, ((1UL << q) - 1) << 1, q + 1);          // q ones, then a zero
+        if (k) Put_Bits(e, zz, k);
+    } else {
+        Put_Bits(e, (1UL << IMU_CODEC_RICE_ESCAPE) - 1, IMU_CODEC_RICE_ESCAPE);
+        Put_Bits(e, zz, 16);
+    }
+
+    e->rice_a[ch] += zz;
+    if (++e->rice_n[ch] == IMU_CODEC_RICE_N_MAX) {
+        e->rice_a[ch] >>= 1;
+        e->rice_n[ch] >>= 1;
+    }
+}
+
+// ======================= BLOCKS =========================
+
+static void Close_Block(ImuEncoder_t *e)
+{
+    if (e->block_n == 0) return;
+
+    if (e->nbits) {
+        Put_Bits(e, 0, 8 - e->nbits);                       // pad to a byte
+    }
+    uint32_t size = e->len - e->block_start;
+    e->out[e->block_start + 2] = (uint8_t)e->block_n;
+    e->out[e->block_start + 3] = (uint8_t)(e->block_n >> 8);
+    e->out[e->block_start + 4] = (uint8_t)size;
+    e->out[e->block_start + 5] = (uint8_t)(size >> 8);
+    e->block_n = 0;
+}
+
+static void Open_Block(ImuEncoder_t *e, const int16_t s[IMU_CODEC_CHANNELS])
+{
+    e->block_start = e->len;
+    Put_Byte(e, IMU_CODEC_MAGIC);
+    Put_Byte(e, e->flags);
+    Put_Byte(e, 0);                                         // count, patched on close
+    Put_Byte(e, 0);
+    Put_Byte(e, 0);                                         // size, patched on close
+    Put_Byte(e, 0);
+    for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) {
+        Put_Byte(e, (uint8_t)s[ch]);
+        Put_Byte(e, (uint8_t)((uint16_t)s[ch] >> 8));
+        e->prev[ch] = s[ch];
+        e->delta[ch] = 0;
+        e->rice_a[ch] = IMU_CODEC_RICE_A_INIT;
+        e->rice_n[ch] = 1;
+    }
+    e->acc = 0;
+    e->nbits = 0;
+    e->block_n = 1;
+}
+
+// ======================= PUBLIC API =========================
+
+void ImuCodec_InitEncoder(ImuEncoder_t *e, uint8_t *out, uint32_t cap,
+                          uint8_t flags, uint16_t block_samples)
+{
+    memset(e, 0, sizeof(*e));
+    e->out = out;
+    e->cap = cap;
+    e->flags = flags & (IMU_CODEC_RICE | IMU_CODEC_ORDER2);
+    // Block length is a 16-bit field: cap the worst case below 64 KB
+    if (block_samples == 0) block_samples = 1;
+    if (block_samples > IMU_CODEC_MAX_BLOCK) block_samples = IMU_CODEC_MAX_BLOCK;
+    e->block_samples = block_samples;
+}
+
+// Returns 0 (and stays failed) once the output buffer cannot take a worst-case sample
+int ImuCodec_Encode(ImuEncoder_t *e, const int16_t s[IMU_CODEC_CHANNELS])
+{
+    if (e->overflow) return 0;
+
+    if (e->block_n >= e->block_samples) Close_Block(e);
+
+    if (e->block_n == 0) {
+        if (e->cap - e->len < IMU_CODEC_HDR_SIZE + 1) { e->overflow = 1; return 0; }
+        Open_Block(e, s);
+        return 1;
+    }
+    if (e->cap - e->len < IMU_CODEC_MAX_SAMPLE + 1) { e->overflow = 1; return 0; }
+
+    for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) {
+        int16_t pred = e->prev[ch];
+        if (e->flags & IMU_CODEC_ORDER2) pred = (int16_t)(pred + e->delta[ch]);
+
+        uint16_t zz = ImuCodec_ZigZag((int16_t)(s[ch] - pred));
+
+        e->delta[ch] = (int16_t)(s[ch] - e->prev[ch]);
+        e->prev[ch] = s[ch];
+
+        if (e->flags & IMU_CODEC_RICE) Put_Rice(e, ch, zz);
+        else                           Put_Varint(e, zz);
+    }
+    e->block_n++;
+    return 1;
+}
+
+// Closes the open block; returns bytes written, or 0 if the buffer overflowed
+uint32_t ImuCodec_Finish(ImuEncoder_t *e)
+{
+    if (e->overflow) return 0;
+    Close_Block(e);
+    return e->len;
+}
@@ -0,0 +1,414 @@
+/******************************************************************************
+  * @file           : kernel.c
+  * @brief          : Minimal preemptive kernel (fixed priorities, PendSV switch, queues)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The cooperative scheduler cannot cut a task short: a 60 ms flash erase,
+ * a Wi-Fi exchange or a long UART banner still holds the next sample back.
+ * This kernel puts acquisition in its own thread above everything else.
+ *
+ * Threads have fixed, distinct priorities (0 highest) and their own stacks,
+ * carved at creation from an arena in RAM2. A thread runs until it blocks (sleep, empty queue) or a higher
+ * one becomes ready; the switch itself is always done by PendSV at the
+ * lowest interrupt priority, so it only happens once every interrupt has
+ * returned. PendSV saves r4-r11 and, if the thread has a live FPU context
+ * (EXC_RETURN bit 4 clear), s16-s31; s0-s15 are already in the hardware
+ * frame thanks to lazy stacking, so threads that never touch the FPU pay
+ * nothing for it.
+ *
+ * Time comes from TIM2 (timestamp.h). Sleeps and receive timeouts are
+ * served by its compare alarm, set to the earliest pending wake-up, so the
+ * kernel needs no tick of its own. SysTick stays HAL's millisecond time
+ * base; the idle thread stops it for gaps longer than
+ * KERNEL_TICKLESS_MIN_US and adds the ticks it missed on wake-up.
+ *
+ * Every switch charges the outgoing thread with the TIM2 time since the
+ * last one; that gives CPU usage per KERNEL_LOAD_WINDOW_US. Stacks are
+ * filled with a pattern at creation, and the untouched part gives the
+ * high-water mark.
+ */
+#include "main.h"
+#include "kernel.h"
+#include "timestamp.h"
+#include "mem.h"
+
+#include <string.h>
+#include "no_heap.h"
+
+#define STACK_FILL              0xA5A5A5A5UL
+#define XPSR_THUMB              0x01000000UL
+
+typedef enum { TH_READY = 0, TH_SLEEPING, TH_WAITING, TH_EXITED } ThreadState_t;
+
+typedef struct {
+    uint32_t *sp;               // must stay first: PendSV_Handler saves and loads it here
+    const char *name;
+    uint8_t  prio;
+    uint8_t  state;
+    uint8_t  timed;             // wake_us applies
+    uint32_t wake_us;
+    KernelQueue_t *wait_q;      // while TH_WAITING
+    uint32_t *stack;
+    uint32_t stack_words;
+    uint32_t run_us;            // in the current load window
+    uint16_t cpu_permille;
+    uint32_t switches;
+} Thread_t;
+
+static Thread_t threads[KERNEL_MAX_THREADS];
+static int n_threads = 0;
+// Not static: PendSV_Handler and SVC_Handler name it from asm, and LTO renames statics it moves between partitions
+Thread_t *volatile k_current __attribute__((used)) = NULL;
+static uint32_t switch_us = 0;
+static uint32_t window_us = 0;
+
+MEM_ARENA_IN(stack_arena, KERNEL_STACK_ARENA_BYTES, ".ram2");
+
+Thread_t *Kernel_Switch(void);
+
+// ======================= HELPERS =========================
+
+static uint32_t Lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static void Unlock(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+static void Wake(Thread_t *t)
+{
+    if (t->state == TH_WAITING && t->wait_q && t->wait_q->waiter == (int8_t)(t - threads))
+        t->wait_q->waiter = -1;
+    t->state = TH_READY;
+    t->timed = 0;
+    t->wait_q = NULL;
+}
+
+static Thread_t *Best_Ready(void)
+{
+    Thread_t *best = NULL;
+    for (int i = 0; i < n_threads; i++) {
+        Thread_t *t = &threads[i];
+        if (t->state == TH_READY && (!best || t->prio < best->prio)) best = t;
+    }
+    return best;
+}
+
+// Wakes every expired timeout, then points the TIM2 alarm at the earliest one left
+static void Timeouts(uint32_t now)
+{
+    uint32_t next = 0;
+    int armed = 0;
+
+    for (int i = 0; i < n_threads; i++) {
+        Thread_t *t = &threads[i];
+        if (!t->timed) continue;
+        if ((int32_t)(now - t->wake_us) >= 0) {
+            Wake(t);
+        } else if (!armed || (int32_t)(t->wake_us - next) < 0) {
+            next = t->wake_us;
+            armed = 1;
+        }
+    }
+    if (armed) Timestamp_SetAlarm(next);
+    else Timestamp_CancelAlarm();
+}
+
+// Lock held: makes the states current and asks PendSV for a switch if another thread should run
+static void Reschedule(void)
+{
+    Timeouts(Timestamp_Now());
+    if (k_current && Best_Ready() != k_current) SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+}
+
+static void On_Alarm(void)
+{
+    uint32_t primask = Lock();
+    Reschedule();
+    Unlock(primask);
+}
+
+static void Thread_Exit(void)
+{
+    uint32_t primask = Lock();
+    k_current->state = TH_EXITED;
+    Reschedule();
+    Unlock(primask);
+    for (;;) {}
+}
+
+// ======================= IDLE THREAD =========================
+
+// SysTick off until the next wake-up (or any interrupt), then uwTick caught up
+static void Sleep_Tickless(void)
+{
+    uint32_t tick_us = 1000u * uwTickFreq;
+    uint32_t to_tick_us = (uint32_t)((uint64_t)SysTick->VAL * 1000000u / SystemCoreClock);
+    uint32_t t0 = Timestamp_Now();
+
+    HAL_SuspendTick();
+    __WFI();
+    uint32_t slept = Timestamp_Now() - t0;
+    if (slept >= to_tick_us) uwTick += (1 + (slept - to_tick_us) / tick_us) * uwTickFreq;
+    HAL_ResumeTick();
+}
+
+static void Idle_Thread(void *arg)
+{
+    (void)arg;
+    for (;;) {
+        // Interrupts masked: a wake-up between the check and WFI still ends the WFI
+        __disable_irq();
+        uint32_t now = Timestamp_Now();
+        int32_t gap = INT32_MAX;
+        for (int i = 0; i < n_threads; i++) {
+            int32_t us = (int32_t)(threads[i].wake_us - now);
+            if (threads[i].timed && us < gap) gap = us;
+        }
+        if (gap > KERNEL_TICKLESS_MIN_US) Sleep_Tickless();
+        else __WFI();
+        __enable_irq();
+    }
+}
+
+// ======================= CONTEXT SWITCH =========================
+
+// From PendSV with interrupts masked: charges the time, picks the next thread
+__attribute__((used)) RAMFUNC Thread_t *Kernel_Switch(void)
+{
+    uint32_t now = Timestamp_Now();
+    k_current->run_us += now - switch_us;
+    switch_us = now;
+
+    uint32_t window = now - window_us;
+    if (window >= KERNEL_LOAD_WINDOW_US) {
+        for (int i = 0; i < n_threads; i++) {
+            threads[i].cpu_permille = (uint16_t)((uint64_t)threads[i].run_us * 1000u / window);
+            threads[i].run_us = 0;
+        }
+        window_us = now;
+    }
+
+    Timeouts(now);
+    Thread_t *next = Best_Ready();
+    if (next != k_current) next->switches++;
+    k_current = next;
+    return next;
+}
+
+__attribute__((naked)) RAMFUNC void PendSV_Handler(void)
+{
+    __asm volatile(
+        "   mrs     r0, psp                 \n"
+        "   isb                             \n"
+        "   tst     lr, #0x10               \n"     // bit 4 clear: the hardware frame holds s0-s15
+        "   it      eq                      \n"
+        "   vstmdbeq r0!, {s16-s31}         \n"
+        "   stmdb   r0!, {r4-r11, lr}       \n"
+        "   ldr     r1, pendsv_current      \n"
+        "   ldr     r1, [r1]                \n"
+        "   str     r0, [r1]                \n"     // k_current->sp
+        "   cpsid   i                       \n"
+        "   bl      Kernel_Switch           \n"
+        "   cpsie   i                       \n"
+        "   ldr     r0, [r0]                \n"     // next->sp
+        "   ldmia   r0!, {r4-r11, lr}       \n"
+        "   tst     lr, #0x10               \n"
+        "   it      eq                      \n"
+        "   vldmiaeq r0!, {s16-s31}         \n"
+        "   msr     psp, r0                 \n"
+        "   isb                             \n"
+        "   bx      lr                      \n"
+        "   .align  2                       \n"
+        "pendsv_current: .word k_current    \n"
+    );
+}
+
+// svc 0 from Kernel_Start: enter the first thread as if returning from a switch
+__attribute__((naked)) void SVC_Handler(void)
+{
+    __asm volatile(
+        "   ldr     r1, svc_current         \n"
+        "   ldr     r1, [r1]                \n"
+        "   ldr     r0, [r1]                \n"
+        "   ldmia   r0!, {r4-r11, lr}       \n"
+        "   msr     psp, r0                 \n"
+        "   isb                             \n"
+        "   bx      lr                      \n"
+        "   .align  2                       \n"
+        "svc_current: .word k_current       \n"
+    );
+}
+
+// ======================= PUBLIC API =========================
+
+void Kernel_Init(void)
+{
+    memset(threads, 0, sizeof(threads));
+    n_threads = 0;
+    k_current = NULL;
+    MemArena_Init(&stack_arena);
+    Timestamp_AlarmInit(On_Alarm);
+    Kernel_CreateThread("idle", Idle_Thread, NULL, 0xFF, KERNEL_IDLE_STACK_WORDS);
+}
+
+int Kernel_CreateThread(const char *name, KernelEntry_t entry, void *arg, uint8_t prio, uint32_t stack_words)
+{
+    if (n_threads >= KERNEL_MAX_THREADS || !entry || stack_words < 64) return -1;
+    for (int i = 0; i < n_threads; i++) {
+        if (threads[i].prio == prio) return -1;
+    }
+    stack_words &= ~1UL;
+    uint32_t *stack = MemArena_Alloc(&stack_arena, stack_words * 4u);
+    if (!stack) return -1;
+
+    for (uint32_t i = 0; i < stack_words; i++) stack[i] = STACK_FILL;
+
+    // Hardware frame as an exception would leave it, then what PendSV pops
+    uint32_t *sp = stack + stack_words;
+    *--sp = XPSR_THUMB;
+    *--sp = (uint32_t)entry & ~1UL;             // PC
+    *--sp = (uint32_t)Thread_Exit;              // LR: the entry function returned
+    *--sp = 0;                                  // R12
+    *--sp = 0;                                  // R3
+    *--sp = 0;                                  // R2
+    *--sp = 0;                                  // R1
+    *--sp = (uint32_t)arg;                      // R0
+    *--sp = EXC_RETURN_THREAD_PSP;              // thread mode, process stack, no FPU frame
+    for (int r = 11; r >= 4; r--) *--sp = 0;    // R11..R4
+
+    int id = n_threads++;
+    Thread_t *t = &threads[id];
+    t->sp = sp;
+    t->name = name;
+    t->prio = prio;
+    t->state = TH_READY;
+    t->stack = stack;
+    t->stack_words = stack_words;
+    return id;
+}
+
+void Kernel_Start(void)
+{
+    // Lazy FPU stacking (the reset default, made explicit: PendSV depends on it)
+    FPU->FPCCR |= FPU_FPCCR_ASPEN_Msk | FPU_FPCCR_LSPEN_Msk;
+    HAL_NVIC_SetPriority(PendSV_IRQn, KERNEL_IRQ_PRIORITY, 0);
+    HAL_NVIC_SetPriority(SVCall_IRQn, KERNEL_IRQ_PRIORITY, 0);
+
+    __disable_irq();
+    k_current = Best_Ready();
+    k_current->switches++;
+    switch_us = window_us = Timestamp_Now();
+    Timeouts(switch_us);
+    __enable_irq();
+
+    // Back to the top of main()'s stack for the interrupts, FPCA cleared so the SVC entry
+    // leaves no lazy FPU state behind, then into the first thread
+    __asm volatile(
+        "   msr     msp, %0     \n"
+        "   msr     control, %1 \n"
+        "   isb                 \n"
+        "   svc     0           \n"
+        :: "r" (*(volatile uint32_t *)SCB->VTOR), "r" (0) : "memory");
+    for (;;) {}
+}
+
+void Kernel_SleepUntil(uint32_t t_us)
+{
+    uint32_t primask = Lock();
+    if ((int32_t)(t_us - Timestamp_Now()) > 0) {
+        k_current->state = TH_SLEEPING;
+        k_current->timed = 1;
+        k_current->wake_us = t_us;
+        Reschedule();
+    }
+    Unlock(primask);
+}
+
+void Kernel_Sleep(uint32_t us)
+{
+    Kernel_SleepUntil(Timestamp_Now() + us);
+}
+
+void Kernel_QueueInit(KernelQueue_t *q, void *buf, uint16_t msg_size, uint16_t len)
+{
+    memset(q, 0, sizeof(*q));
+    q->buf = buf;
+    q->msg_size = msg_size;
+    q->len = len;
+    q->waiter = -1;
+}
+
+int Kernel_QueueSend(KernelQueue_t *q, const void *msg)
+{
+    uint32_t primask = Lock();
+    uint32_t fill = q->head - q->tail;
+
+    if (fill >= q->len) {
+        q->dropped++;
+        Unlock(primask);
+        return 0;
+    }
+    memcpy(q->buf + (q->head % q->len) * q->msg_size, msg, q->msg_size);
+    q->head++;
+    q->sent++;
+    if (fill + 1 > q->max_fill) q->max_fill = fill + 1;
+
+    if (q->waiter >= 0) {
+        Wake(&threads[q->waiter]);
+        Reschedule();
+    }
+    Unlock(primask);
+    return 1;
+}
+
+int Kernel_QueueReceive(KernelQueue_t *q, void *msg, uint32_t timeout_us)
+{
+    uint32_t start = Timestamp_Now();
+
+    for (;;) {
+        uint32_t primask = Lock();
+        if (q->head != q->tail) {
+            memcpy(msg, q->buf + (q->tail % q->len) * q->msg_size, q->msg_size);
+            q->tail++;
+            Unlock(primask);
+            return 1;
+        }
+        if (timeout_us != KERNEL_FOREVER && Timestamp_Now() - start >= timeout_us) {
+            Unlock(primask);
+            return 0;
+        }
+
+        // Blocks here: the switch happens as soon as the lock is released
+        Thread_t *me = k_current;
+        me->state = TH_WAITING;
+        me->wait_q = q;
+        q->waiter = (int8_t)(me - threads);
+        me->timed = timeout_us != KERNEL_FOREVER;
+        me->wake_us = start + timeout_us;
+        Reschedule();
+        Unlock(primask);
+    }
+}
+
+int Kernel_GetThreadStats(int id, KernelThreadStats_t *st)
+{
+    if (id < 0 || id >= n_threads) return 0;
+    const Thread_t *t = &threads[id];
+    uint32_t untouched = 0;
+    while (untouched < t->stack_words && t->stack[untouched] == STACK_FILL) untouched++;
+
+    st->name = t->name;
+    st->prio = t->prio;
+    st->cpu_permille = t->cpu_permille;
+    st->stack_bytes = t->stack_words * 4u;
+    st->stack_used = (t->stack_words - untouched) * 4u;
+    st->switches = t->switches;
+    return 1;
+}
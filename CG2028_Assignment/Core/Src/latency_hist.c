@@ -0,0 +1,97 @@
+/******************************************************************************
+  * @file           : latency_hist.c
+  * @brief          : Log2 histograms of microsecond latencies / jitter
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Power-of-two bins cover 1 us to tens of ms in 16 counters, cost one CLZ
+ * per sample and need no float, so the sampling loop can feed them every
+ * sample. Portable: no HAL, also built by the host tools.
+ */
+#include "latency_hist.h"
+#include "fmt.h"
+
+#include <string.h>
+#include "no_heap.h"
+
+// ======================= HELPERS =========================
+
+static uint32_t Bin_Of(uint32_t us)
+{
+    if (us == 0) return 0;
+    uint32_t b = 32u - (uint32_t)__builtin_clz(us);      // bit length
+    return b < LAT_HIST_BINS - 1 ? b : LAT_HIST_BINS - 1;
+}
+
+// Largest value counted in bin b (below the open last bin)
+static uint32_t Bin_Top(uint32_t b)
+{
+    return b ? (1u << b) - 1 : 0;
+}
+
+// ======================= PUBLIC API =========================
+
+void LatencyHist_Reset(LatencyHist_t *h)
+{
+    memset(h, 0, sizeof(*h));
+    h->min_us = 0xFFFFFFFFUL;
+}
+
+void LatencyHist_Add(LatencyHist_t *h, uint32_t us)
+{
+    h->bins[Bin_Of(us)]++;
+    h->count++;
+    h->sum_us += us;
+    if (us < h->min_us) h->min_us = us;
+    if (us > h->max_us) h->max_us = us;
+}
+
+uint32_t LatencyHist_Mean(const LatencyHist_t *h)
+{
+    return h->count ? (uint32_t)(h->sum_us / h->count) : 0;
+}
+
+uint32_t LatencyHist_Percentile(const LatencyHist_t *h, uint32_t pct)
+{
+    if (h->count == 0) return 0;
+    uint64_t need = ((uint64_t)h->count * pct + 99) / 100;
+    uint64_t seen = 0;
+    for (uint32_t b = 0; b < LAT_HIST_BINS; b++) {
+        seen += h->bins[b];
+        if (seen < need) continue;
+        if (b == LAT_HIST_BINS - 1 || Bin_Top(b) > h->max_us) return h->max_us;
+        return Bin_Top(b);
+    }
+    return h->max_us;
+}
+
+void LatencyHist_Format(const LatencyHist_t *h, const char *name, Fmt_t *f)
+{
+    Fmt_Str(f, name);
+    Fmt_Str(f, ": n ");
+    Fmt_Uint(f, h->count);
+    Fmt_Str(f, ", min ");
+    Fmt_Uint(f, h->count ? h->min_us : 0);
+    Fmt_Str(f, ", mean ");
+    Fmt_Uint(f, LatencyHist_Mean(h));
+    Fmt_Str(f, ", p99 <= ");
+    Fmt_Uint(f, LatencyHist_Percentile(h, 99));
+    Fmt_Str(f, ", max ");
+    Fmt_Uint(f, h->max_us);
+    Fmt_Str(f, " us\r\n");
+}
+
+void LatencyHist_FormatBins(const LatencyHist_t *h, Fmt_t *f)
+{
+    uint32_t last = 0;
+    for (uint32_t b = 0; b < LAT_HIST_BINS; b++) {
+        if (h->bins[b]) last = b;
+    }
+
+    Fmt_Str(f, "  bins:");
+    for (uint32_t b = 0; b <= last; b++) {
+        Fmt_Char(f, ' ');
+        Fmt_Uint(f, h->bins[b]);
+    }
+    Fmt_Str(f, "\r\n");
+}
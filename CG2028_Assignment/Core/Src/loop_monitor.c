@@ -0,0 +1,78 @@
+/******************************************************************************
+  * @file           : loop_monitor.c
+  * @brief          : Sample-loop interval and deadline-miss monitor
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * A 20 ms interval would land in one log2 bin, so the histogram is of
+ * how far each interval ran past its nominal period: 0 on the grid, a
+ * few us of interrupt latency, whole milliseconds when something held
+ * the loop. A stretch over the slack is a missed deadline, counted
+ * against the FSM state the late sample arrived in. One CLZ and a few
+ * adds per sample; no HAL, also built by the host tools.
+ */
+#include "loop_monitor.h"
+
+#include <string.h>
+#include "no_heap.h"
+
+static const char *const state_names[LOOP_MON_STATES] = { "NORMAL", "FALLING", "STILLNESS", "CONFIRMED" };
+
+void LoopMonitor_Init(LoopMonitor_t *m, uint32_t slack_us)
+{
+    memset(m, 0, sizeof(*m));
+    LatencyHist_Reset(&m->stretch);
+    m->slack_us = slack_us;
+    m->min_interval_us = 0xFFFFFFFFUL;
+}
+
+void LoopMonitor_Sample(LoopMonitor_t *m, uint32_t now_us, uint32_t next_period_us, FallState_t state)
+{
+    uint32_t period_us = m->period_us;
+    uint32_t interval_us = now_us - m->last_us;
+
+    m->last_us = now_us;
+    m->period_us = next_period_us;
+    if (period_us == 0 || (uint32_t)state >= LOOP_MON_STATES) return;
+
+    uint32_t stretch_us = interval_us > period_us ? interval_us - period_us : 0;
+    LatencyHist_Add(&m->stretch, stretch_us);
+    if (interval_us < m->min_interval_us) m->min_interval_us = interval_us;
+    if (interval_us > m->max_interval_us) m->max_interval_us = interval_us;
+
+    m->samples[state]++;
+    if (stretch_us > m->slack_us) m->misses[state]++;
+    if (stretch_us > m->worst_us[state]) m->worst_us[state] = stretch_us;
+}
+
+void LoopMonitor_Format(const LoopMonitor_t *m, int n, Fmt_t *f)
+{
+    if (n == 0) {
+        LatencyHist_Format(&m->stretch, "Interval over period", f);
+    } else if (n == 1) {
+        LatencyHist_FormatBins(&m->stretch, f);
+    } else if (n == 2) {
+        Fmt_Str(f, "Deadline miss (> ");
+        Fmt_Uint(f, m->slack_us);
+        Fmt_Str(f, " us late, interval ");
+        Fmt_Uint(f, m->stretch.count ? m->min_interval_us : 0);
+        Fmt_Str(f, "..");
+        Fmt_Uint(f, m->max_interval_us);
+        Fmt_Str(f, " us):");
+        for (int s = 0; s < LOOP_MON_STATES; s++) {
+            Fmt_Char(f, ' ');
+            Fmt_Str(f, state_names[s]);
+            Fmt_Char(f, ' ');
+            Fmt_Uint(f, m->misses[s]);
+            Fmt_Char(f, '/');
+            Fmt_Uint(f, m->samples[s]);
+            if (m->misses[s]) {
+                Fmt_Str(f, " (<= ");
+                Fmt_Uint(f, m->worst_us[s]);
+                Fmt_Char(f, ')');
+            }
+            if (s < LOOP_MON_STATES - 1) Fmt_Char(f, ',');
+        }
+        Fmt_Str(f, "\r\n");
+    }
+}
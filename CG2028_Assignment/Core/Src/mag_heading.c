@@ -0,0 +1,317 @@
+/******************************************************************************
+  * @file           : mag_heading.c
+  * @brief          : LIS3MDL rotation channel with hard/soft-iron calibration (fixed point)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The gyro only gives instantaneous rate (total_gyro > threshold) and the
+ * fusion angle drifts with the gyro bias. The Earth's field is a fixed
+ * reference, so the angle between the field vector before the event and
+ * the one now is a drift-free measure of how far the body turned (blind
+ * only to rotation about the field line itself).
+ *
+ * The LIS3MDL runs continuously at MAG_ODR_HZ. Every MAG_READ_EVERY IMU
+ * samples the main loop queues one 6-byte read as a sensor-priority job
+ * right behind the IMU read, so it lands in the same slot and never
+ * blocks. The callback (from I2cBus_Poll) removes the hard-iron offset,
+ * applies the Q14 soft-iron matrix and keeps a short history; the event
+ * reference is the entry from MAG_PRE_EVENT_MS before the trigger, since
+ * the trigger usually comes at the impact.
+ *
+ * Calibration is learned in the background from the running min/max of
+ * every axis as the wearer moves about: the centre is the hard-iron
+ * offset, the span ratios give a diagonal soft-iron matrix. Once every
+ * axis has seen MAG_CAL_MIN_SPAN it is used at once and, if it differs
+ * enough from the stored one, written to the config store (rate-limited
+ * to spare the flash). The full 3x3 matrix is stored so a bench
+ * calibration can replace the diagonal estimate.
+ */
+#include "main.h"
+#include "mag_heading.h"
+#include "posture.h"
+#include "i2c_bus.h"
+#include "../../Drivers/BSP/Components/lis3mdl/lis3mdl.h"
+
+#include "string.h"
+#include "no_heap.h"
+
+#define MAG_ADDR                LIS3MDL_MAG_I2C_ADDRESS_HIGH
+#define MAG_AUTO_INC            0x80    /* sub-address MSB: register auto-increment */
+#define MAG_VEC_LIMIT           16383   /* calibrated components, keeps the cross product in int64 */
+#define MAG_SCALE_MIN_Q14       8192    /* soft-iron scale limits, 0.5 .. 2.0 */
+#define MAG_SCALE_MAX_Q14       32767
+
+typedef struct {
+    uint32_t tick;
+    int16_t  v[3];
+} MagEntry_t;
+
+static int present = 0;
+static MagCalibration_t cal;                // in use; from flash or freshly learned
+static uint8_t raw_buf[6];
+static volatile int read_pending = 0;
+static uint32_t sample_count = 0;
+
+static MagEntry_t history[MAG_HISTORY];
+static uint32_t n_entries = 0;
+
+// Background calibration
+static int32_t raw_lpf[3];
+static int16_t raw_min[3], raw_max[3];
+static int collecting = 0;
+static uint32_t last_save = 0;
+static int saved_once = 0;
+
+// Event window
+static int event_open = 0;
+static uint32_t event_tick = 0;
+static int ref_valid = 0;
+static int16_t ref_v[3];
+static int32_t max_angle = 0;
+
+static MagHeadingStats_t stats;
+
+// ======================= HELPERS =========================
+
+static int Write_Reg(uint8_t reg, uint8_t val)
+{
+    return I2cBus_Transfer(MAG_ADDR, reg, 1, &val, 1, 1) == I2C_OK;
+}
+
+static int32_t Abs(int32_t v) { return v < 0 ? -v : v; }
+
+static int16_t Clamp16(int32_t v, int32_t lim)
+{
+    return (int16_t)(v > lim ? lim : (v < -lim ? -lim : v));
+}
+
+static const MagEntry_t *Entry(uint32_t back)
+{
+    return &history[(n_entries - 1 - back) % MAG_HISTORY];
+}
+
+// Newest entry taken at or before tick, else the oldest one kept (needs n_entries > 0)
+static const MagEntry_t *Entry_At(uint32_t tick)
+{
+    uint32_t kept = n_entries < MAG_HISTORY ? n_entries : MAG_HISTORY;
+    for (uint32_t b = 0; b < kept; b++) {
+        if ((int32_t)(Entry(b)->tick - tick) <= 0) return Entry(b);
+    }
+    return Entry(kept - 1);
+}
+
+// Angle between two field vectors, same arithmetic as Posture_GetDelta()
+static int32_t Angle(const int16_t a[3], const int16_t b[3])
+{
+    int64_t cx = (int64_t)a[1] * b[2] - (int64_t)a[2] * b[1];
+    int64_t cy = (int64_t)a[2] * b[0] - (int64_t)a[0] * b[2];
+    int64_t cz = (int64_t)a[0] * b[1] - (int64_t)a[1] * b[0];
+    int64_t dot = (int64_t)a[0] * b[0] + (int64_t)a[1] * b[1] + (int64_t)a[2] * b[2];
+
+    uint32_t cross = Posture_Isqrt((uint64_t)(cx * cx + cy * cy + cz * cz));
+    while (cross > 0x3FFFFFFF || dot > 0x3FFFFFFF || dot < -0x3FFFFFFF) {
+        cross >>= 1;
+        dot /= 2;
+    }
+    return Posture_Atan2((int32_t)cross, (int32_t)dot);
+}
+
+static void Calibrate(const int16_t raw[3], int16_t out[3])
+{
+    int32_t d[3];
+    for (int k = 0; k < 3; k++) d[k] = (int32_t)raw[k] - cal.offset[k];
+    for (int r = 0; r < 3; r++) {
+        const int16_t *row = &cal.soft_q14[3 * r];
+        int32_t acc = row[0] * d[0] + row[1] * d[1] + row[2] * d[2];
+        out[r] = Clamp16(acc >> 14, MAG_VEC_LIMIT);
+    }
+}
+
+static void Learn(const int16_t raw[3])
+{
+    // Two-sample average, so a single spike does not stretch the span
+    for (int k = 0; k < 3; k++) {
+        raw_lpf[k] = collecting ? (raw_lpf[k] + raw[k]) / 2 : raw[k];
+        int16_t v = (int16_t)raw_lpf[k];
+        if (!collecting || v < raw_min[k]) raw_min[k] = v;
+        if (!collecting || v > raw_max[k]) raw_max[k] = v;
+    }
+    collecting = 1;
+}
+
+// Calibration from the min/max collected so far; 0 until every axis spans enough
+static int Learned(MagCalibration_t *out)
+{
+    int32_t span[3], avg = 0;
+    for (int k = 0; k < 3; k++) {
+        span[k] = (int32_t)raw_max[k] - raw_min[k];
+        if (!collecting || span[k] < MAG_CAL_MIN_SPAN) return 0;
+        avg += span[k];
+    }
+    avg /= 3;
+
+    memset(out, 0, sizeof(*out));
+    for (int k = 0; k < 3; k++) {
+        int32_t s = (avg << 14) / span[k];
+        if (s < MAG_SCALE_MIN_Q14) s = MAG_SCALE_MIN_Q14;
+        if (s > MAG_SCALE_MAX_Q14) s = MAG_SCALE_MAX_Q14;
+        out->offset[k] = (int16_t)(((int32_t)raw_max[k] + raw_min[k]) / 2);
+        out->soft_q14[4 * k] = (int16_t)s;
+    }
+    out->valid = 1;
+    return 1;
+}
+
+static int Cal_Differs(const MagCalibration_t *a, const MagCalibration_t *b)
+{
+    if (!a->valid || !b->valid) return a->valid != b->valid;
+    for (int k = 0; k < 3; k++) {
+        if (Abs(a->offset[k] - b->offset[k]) > MAG_CAL_SAVE_LSB) return 1;
+    }
+    for (int k = 0; k < 9; k++) {
+        if (Abs(a->soft_q14[k] - b->soft_q14[k]) > MAG_CAL_SAVE_Q14) return 1;
+    }
+    return 0;
+}
+
+// From I2cBus_Poll(): one field sample
+static void On_Done(I2cResult_t res, void *ctx)
+{
+    (void)ctx;
+    read_pending = 0;
+    if (res != I2C_OK) {
+        stats.errors++;
+        return;
+    }
+
+    int16_t raw[3];
+    for (int k = 0; k < 3; k++) raw[k] = (int16_t)(raw_buf[2 * k] | (raw_buf[2 * k + 1] << 8));
+    stats.samples++;
+    Learn(raw);
+
+    MagEntry_t *e = &history[n_entries % MAG_HISTORY];
+    e->tick = HAL_GetTick();
+    Calibrate(raw, e->v);
+    n_entries++;
+
+    if (!event_open || !cal.valid) return;
+    if (!ref_valid) {
+        memcpy(ref_v, Entry_At(event_tick - MAG_PRE_EVENT_MS)->v, sizeof(ref_v));
+        ref_valid = 1;
+    }
+    int32_t a = Angle(ref_v, e->v);
+    if (a > max_angle) max_angle = a;
+}
+
+// ======================= PUBLIC API =========================
+
+int MagHeading_Init(void)
+{
+    uint8_t id = 0;
+
+    memset(&stats, 0, sizeof(stats));
+    cal = Config_Get()->mag;
+    present = 0;
+    read_pending = 0;
+    n_entries = 0;
+    collecting = 0;
+    MagHeading_StopEvent();
+
+    if (I2cBus_Transfer(MAG_ADDR, LIS3MDL_MAG_WHO_AM_I_REG, 1, &id, 1, 0) != I2C_OK ||
+        id != I_AM_LIS3MDL) return 0;
+
+    int ok = Write_Reg(LIS3MDL_MAG_CTRL_REG1, LIS3MDL_MAG_OM_XY_MEDIUM | LIS3MDL_MAG_ODR_40_HZ);
+    ok = ok && Write_Reg(LIS3MDL_MAG_CTRL_REG2, LIS3MDL_MAG_FS_4_GA);
+    ok = ok && Write_Reg(LIS3MDL_MAG_CTRL_REG4, LIS3MDL_MAG_OM_Z_MEDIUM);
+    ok = ok && Write_Reg(LIS3MDL_MAG_CTRL_REG5, LIS3MDL_MAG_BDU_MSBLSB);
+    ok = ok && Write_Reg(LIS3MDL_MAG_CTRL_REG3, 0x00);      // continuous conversion
+    if (!ok) return 0;
+
+    present = 1;
+    return 1;
+}
+
+void MagHeading_Sample(void)
+{
+    if (!present || ++sample_count % MAG_READ_EVERY) return;
+    if (read_pending) {
+        stats.busy++;
+        return;
+    }
+
+    I2cJob_t job = {0};
+    job.addr = MAG_ADDR;
+    job.reg_size = 1;
+    job.reg = LIS3MDL_MAG_OUTX_L | MAG_AUTO_INC;
+    job.data = raw_buf;
+    job.len = sizeof(raw_buf);
+    job.done = On_Done;
+
+    read_pending = 1;
+    if (!I2cBus_Submit(&job)) {
+        read_pending = 0;
+        stats.errors++;
+    }
+}
+
+void MagHeading_Poll(void)
+{
+    MagCalibration_t next;
+
+    // The reference of an open event stays in the calibration it was taken with
+    if (!present || event_open || !Learned(&next)) return;
+
+    const MagCalibration_t *stored = &Config_Get()->mag;
+    if (!Cal_Differs(&next, stored)) {
+        if (Cal_Differs(&cal, stored)) n_entries = 0;
+        cal = *stored;
+        collecting = 0;             // confirmed; start a fresh estimate
+        return;
+    }
+
+    cal = next;
+    n_entries = 0;                  // history was in the old calibration
+    if (saved_once && HAL_GetTick() - last_save < MAG_CAL_SAVE_MIN_MS) return;
+
+    ConfigRecord_t rec = *Config_Get();
+    rec.mag = next;
+    if (!Config_Save(&rec)) return;         // flash busy: retry on the next pass
+    last_save = HAL_GetTick();
+    saved_once = 1;
+    collecting = 0;
+    stats.saves++;
+}
+
+void MagHeading_StartEvent(uint32_t tick)
+{
+    event_open = 1;
+    event_tick = tick;
+    ref_valid = 0;                      // looked up on the next sample
+    max_angle = 0;
+}
+
+void MagHeading_StopEvent(void)
+{
+    event_open = 0;
+    ref_valid = 0;
+}
+
+int32_t MagHeading_GetEventRotation(void)
+{
+    return max_angle;
+}
+
+int MagHeading_IsCalibrated(void)
+{
+    return cal.valid != 0;
+}
+
+const MagCalibration_t *MagHeading_GetCalibration(void)
+{
+    return &cal;
+}
+
+void MagHeading_GetStats(MagHeadingStats_t *st)
+{
+    *st = stats;
+}
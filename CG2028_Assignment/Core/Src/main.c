@@ -8,354 +8,1055 @@
 #include "../../Drivers/BSP/B-L4S5I-IOT01/stm32l4s5i_iot01_accelero.h"
 #include "../../Drivers/BSP/B-L4S5I-IOT01/stm32l4s5i_iot01_tsensor.h"
 #include "../../Drivers/BSP/B-L4S5I-IOT01/stm32l4s5i_iot01_gyro.h"
+#include "posture.h"
+#include "fusion.h"
+#include "noise_floor.h"
+#include "fall_detect.h"
+#include "alert_trace.h"
+#include "auto_calib.h"
+#include "config_store.h"
+#include "blackbox.h"
+#include "qspi_flash.h"
+#include "alert_client.h"
+#include "wifi_async.h"
+#include "nfc_status.h"
+#include "i2c_bus.h"
+#include "baro_fifo.h"
+#include "height_drop.h"
+#include "mag_heading.h"
+#include "timestamp.h"
+#include "latency_hist.h"
+#include "loop_monitor.h"
+#include "sched.h"
+#include "kernel.h"
+#include "mem.h"
+#include "uart_tx.h"
+#include "fmt.h"
 
-#include "stdio.h"
-#include "string.h"
 #include <sys/stat.h>
 #include <math.h>
+#ifdef FMT_BENCH_NEWLIB
+#include <stdio.h>
+#endif
+#include "no_heap.h"
 
 static void UART1_Init(void);
 static void Buzzer_GPIO_Init(void);
 static void Button_GPIO_Init(void);
-static void ADC1_Init(void); 
-uint32_t Read_Sound_Sensor(void); 
-
-extern void initialise_monitor_handles(void);   
-
-extern int mov_avg(int N, int* accel_buff); 
-int mov_avg_C(int N, int* accel_buff); 
+static void ADC1_Init(void);
+uint32_t Read_Sound_Sensor(void);
+uint32_t Read_Supply_mV(void);
+static void Log_FallEvent(uint8_t code, float total_accel, float total_gyro, int trigger);
+static void Format_Status(Fmt_t *f, uint32_t sound, float accel, float gyro);
+static void Format_Evidence(Fmt_t *f);
+static int Format_Latency(int n, Fmt_t *f);
+#ifdef FMT_BENCH_NEWLIB
+static void Bench_Format(void);
+#endif
+static void Ramfunc_Protect(void);
+static void Thread_Acquire(void *arg);
+static void Thread_App(void *arg);
+static void App_Wait(uint32_t idle_us);
+static uint32_t Acquire_UntilUs(void);
+static void Task_Detect(uint8_t ev);
+static void Detect_Sample(void);
+static void Task_Housekeeping(uint8_t ev);
+static void Task_Ui(uint8_t ev);
+static void Task_Telemetry(uint8_t ev);
+
+#define SOUND_WINDOW_US     10000   /* peak-to-peak window of Read_Sound_Sensor() */
+#define SUPPLY_READ_MS      60000
+
+// Threads: acquisition preempts the app thread, which runs the cooperative tasks below
+#define ACQ_PRIO            0
+#define APP_PRIO            1
+#define ACQ_STACK_WORDS     512
+#define ACQ_SLACK_US        1000    /* a sample this far past its period missed its deadline */
+#define APP_STACK_WORDS     2048    /* fusion, flash and Wi-Fi polls, the FSM */
+#define APP_QUEUE_LEN       8       /* 160 ms of samples at 50 Hz */
+
+// App-thread tasks, highest priority first. Deadlines run from the release (or post) to the end of the run.
+#define DETECT_DEADLINE_US      20000   /* before the next sample */
+#define HOUSE_PERIOD_MS         5
+#define HOUSE_DEADLINE_US       5000
+#define UI_PERIOD_MS            10
+#define UI_DEADLINE_US          10000
+#define TELEMETRY_PERIOD_MS     500
+#define TELEMETRY_DEADLINE_US   20000
+
+#define EV_SAMPLE           1       /* app queue -> detection: `sample` holds a new one */
+#define EV_WIFI_DRDY        1       /* ISM43362 DRDY EXTI -> housekeeping */
+
+#ifdef DEBUG
+#define BUILD_NAME          "Debug (-O0)"
+#else
+#define BUILD_NAME          "Release (-O2 core, -Os drivers, LTO)"
+#endif
+
+#define BEEP_MS             80
+#define ALARM_TOGGLE_MS     100
+
+extern void initialise_monitor_handles(void);
+
+extern int mov_avg(int N, int* accel_buff);
+
+extern uint8_t _sramfunc[], _eramfunc[];    // SRAM2 hot code, from the linker script
 
 UART_HandleTypeDef huart1;
-ADC_HandleTypeDef hadc1; 
-
-typedef enum {
-    STATE_NORMAL = 0,
-    STATE_FALLING,
-    STATE_STILLNESS_CHECK,
-    STATE_CONFIRMED
-} FallState_t;
-
-FallState_t current_state = STATE_NORMAL;
-uint32_t state_timer = 0;
-
-int seen_impact = 0;
-int seen_rotation = 0;
-int seen_freefall = 0; 
-int seen_loud_noise = 0; 
-
-int system_armed = 1; 
+ADC_HandleTypeDef hadc1;
+
+FallDetect_t fall;                  // FSM state, when it was entered, evidence seen
+_Static_assert(FALL_SEEN_IMPACT == BB_TRIG_IMPACT && FALL_SEEN_FREEFALL == BB_TRIG_FREEFALL &&
+               FALL_SEEN_ROTATION == BB_TRIG_ROTATION && FALL_SEEN_LOUD == BB_TRIG_LOUD &&
+               FALL_SEEN_HEIGHT == BB_TRIG_HEIGHT, "black-box trigger bits out of step with fall_detect.h");
+uint32_t sample_us = 0;             // when the current IMU sample was taken (its DRDY edge)
+
+// Sampling latency / jitter, dumped once a minute
+LatencyHist_t hist_age;             // DRDY edge -> IMU read started
+LatencyHist_t hist_acquire;         // IMU read started -> sound window done
+LoopMonitor_t loop_mon;             // sample interval over its period, deadline misses per FSM state
+
+int system_armed = 1;
+
+// Acquisition thread (and the Wi-Fi DRDY interrupt) -> app thread
+#define APP_MSG_SAMPLE      1
+#define APP_MSG_SUPPLY      2
+#define APP_MSG_WIFI_DRDY   3
+
+// One IMU + sound sample: taken from the pool by acquisition, handed back once detection is done
+typedef struct {
+    int16_t  accel_mg[3];           // raw
+    float    gyro_dps[3];
+    uint32_t sound;
+    uint32_t sample_us;             // DRDY edge of the IMU sample
+    uint32_t sound_start_us;
+    uint32_t dt_us;                 // since the previous sample
+} Sample_t;
+
+typedef struct {
+    uint8_t   type;                 // APP_MSG_*
+    Sample_t *sample;               // APP_MSG_SAMPLE
+    uint32_t  supply_mv;            // APP_MSG_SUPPLY
+} AppMsg_t;
+
+_Static_assert((ACQ_STACK_WORDS + APP_STACK_WORDS + KERNEL_IDLE_STACK_WORDS) * 4 <= KERNEL_STACK_ARENA_BYTES,
+               "thread stacks do not fit the kernel stack arena");
+static KernelQueue_t app_q;
+static AppMsg_t app_q_buf[APP_QUEUE_LEN];
+MEM_POOL(sample_pool, Sample_t, APP_QUEUE_LEN + 2);    // queued, being filled, in detection
+static volatile uint32_t acq_next_us = 0;   // next acquisition release
+static uint32_t acq_overruns = 0;           // grid restarted after falling a period behind
+
+static Sample_t *sample = NULL;             // the one detection is working on
+static int task_detect = -1, task_house = -1, task_ui = -1, task_telemetry = -1;
+
+// Peaks since the last 500 ms status line
+static uint32_t peak_sound_window = 0;
+static float peak_accel_window = 0.0f;
+static float peak_gyro_window = 0.0f;
+
+// DWT cycles to format the 500 ms status line into the UART ring
+static uint32_t status_cycles = 0;
+static uint32_t status_cycles_max = 0;
+
+// DWT cycles of detection per sample: compares the Debug and Release images on the same motion
+static uint64_t detect_cycles_total = 0;
+static uint32_t detect_cycles_max = 0;
+static uint32_t detect_runs = 0;
 
 int main(void)
 {
-    const int N=4;
-
     HAL_Init();
+    int ts_ok = Timestamp_Init();
+    Config_Init();
     UART1_Init();
+    UartTx_Init();
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    Ramfunc_Protect();
     BSP_LED_Init(LED2);
     BSP_ACCELERO_Init();
     BSP_GYRO_Init();
+    int drdy_ok = Timestamp_ImuDrdyInit();
 
     Buzzer_GPIO_Init();
     Button_GPIO_Init();
-    ADC1_Init(); 
+    ADC1_Init();
+    Posture_Init();
+    NoiseFloor_Init();
+    FallDetect_Init(&fall);
+    BlackBox_Init();
+    int wifi_ok = AlertClient_Init();
+    int nfc_ok = NfcStatus_Init();
+    int baro_ok = BaroFifo_Init();
+    int mag_ok = MagHeading_Init();
+    NfcStatus_SetSupply(Read_Supply_mV());
 
     BSP_LED_Off(LED2);
-    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_RESET); 
-
-    int accel_buff_x[4]={0};
-    int accel_buff_y[4]={0};
-    int accel_buff_z[4]={0};
-    int i=0;
-    int delay_ms=20; 
-    char buffer[600]; 
-
-    int btn_press_count = 0;
-    uint32_t btn_first_press_time = 0;
-    uint32_t btn_last_debounce_time = 0;
-    int btn_last_state = 1; 
-    int btn_waiting_for_decision = 0;
-
-    uint32_t last_sensor_read_time = 0;
-    
-    uint32_t peak_sound_window = 0; 
-    float peak_accel_window = 0.0f; 
-    float peak_gyro_window = 0.0f;  
-    
-    uint32_t sound_history[3] = {0, 0, 0}; 
-    uint32_t bg_sound_max = 0;
-
-    while (1)
-    {
-        // ========== MULTI-PRESS BUTTON HANDLER ==========
-        int btn_current = HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_13);
-
-        if (btn_current == GPIO_PIN_RESET && btn_last_state == 1 && (HAL_GetTick() - btn_last_debounce_time > 50)) {
-            btn_press_count++;
-            btn_last_debounce_time = HAL_GetTick();
-            if (btn_press_count == 1) btn_first_press_time = HAL_GetTick(); 
-            btn_waiting_for_decision = 1;
-        }
-        btn_last_state = (btn_current == GPIO_PIN_SET) ? 1 : 0;
-
-        if (btn_waiting_for_decision && (HAL_GetTick() - btn_first_press_time > 500)) {
-            btn_waiting_for_decision = 0;
-
-            if (btn_press_count == 1) {
-                if (current_state == STATE_CONFIRMED) {
-                    current_state = STATE_NORMAL;
-                    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_RESET); 
-                    BSP_LED_Off(LED2);
-                    sprintf(buffer, "\r\n--- ALARM RESET (1 press) ---\r\n");
-                    HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-                }
-            }
-            else if (btn_press_count == 2) {
-                system_armed = !system_armed;
-                current_state = STATE_NORMAL; 
-                BSP_LED_Off(LED2);
-                HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_RESET); 
-
-                int beeps = system_armed ? 1 : 2;
-                for (int b = 0; b < beeps; b++) {
-                    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_SET);
-                    HAL_Delay(80);
-                    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_RESET);
-                    if (b < beeps - 1) HAL_Delay(80); 
-                }
-
-                if (system_armed) sprintf(buffer, "\r\n--- SYSTEM ARMED (2 presses) ---\r\n");
-                else sprintf(buffer, "\r\n--- SYSTEM DISARMED (2 presses) ---\r\n");
-                
-                HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-            }
-            else if (btn_press_count >= 3) {
-                system_armed = 1; 
-                current_state = STATE_CONFIRMED;
-                sprintf(buffer, 
-                    "\r\n___SEND_TELEGRAM_ALERT___\r\n"
-                    "!!! MANUAL ALARM TRIGGERED (3 presses) !!!\r\n");
-                HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-            }
-            btn_press_count = 0; 
-        }
+    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_RESET);
+
+    BlackBoxStats_t bb_stats;
+    BlackBox_GetStats(&bb_stats);
+    Fmt_t f;
+    UartTx_Begin(&f);
+    Fmt_Str(&f, "\r\nBuild: " BUILD_NAME ", ");
+    Fmt_Uint(&f, (uint32_t)(_eramfunc - _sramfunc));
+    Fmt_Str(&f, " B of hot code in SRAM2 @0x");
+    Fmt_Hex(&f, (uint32_t)_sramfunc, 8);
+    Fmt_Str(&f, " (write-protected)\r\n");
+    Fmt_Str(&f, "Black box: ");
+    Fmt_Str(&f, QspiFlash_IsMapped() ? "QSPI mapped @0x90000000" : "QSPI OFFLINE");
+    Fmt_Str(&f, ", head 0x");
+    Fmt_Hex(&f, bb_stats.head_addr, 6);
+    Fmt_Str(&f, ", next record ");
+    Fmt_Uint(&f, bb_stats.next_rec_seq);
+    Fmt_Str(&f, "\r\n");
+
+    if (AlertClient_GetState() == ALERT_OFF) {
+        Fmt_Str(&f, "Wi-Fi alerts: off (no SSID configured)\r\n");
+    } else {
+        Fmt_Str(&f, "Wi-Fi alerts: ");
+        Fmt_Str(&f, wifi_ok ? "module starting in the background" : "SPI3 bus init failed");
+        Fmt_Str(&f, ", server port ");
+        Fmt_Uint(&f, ALERT_SERVER_PORT);
+        Fmt_Str(&f, "\r\n");
+    }
 
-        // ========== NON-BLOCKING SENSOR GATE ==========
-        if (HAL_GetTick() - last_sensor_read_time < (uint32_t)delay_ms) continue;
-        last_sensor_read_time = HAL_GetTick();
+    Fmt_Str(&f, "NFC tag: ");
+    Fmt_Str(&f, nfc_ok ? "status record + black-box mailbox" : "not found");
+    Fmt_Str(&f, "\r\nTimestamps: ");
+    Fmt_Str(&f, ts_ok ? "TIM2 1 MHz free-running" : "TIM2 FAILED");
+    Fmt_Str(&f, ", IMU DRDY capture ");
+    Fmt_Str(&f, drdy_ok ? "on INT1/EXTI11" : "off (read time used)");
+    Fmt_Str(&f, "\r\n");
+    LatencyHist_Reset(&hist_age);
+    LoopMonitor_Init(&loop_mon, ACQ_SLACK_US);
+    LatencyHist_Reset(&hist_acquire);
+
+    I2cBusStats_t i2c_stats;
+    I2cBus_GetStats(&i2c_stats);
+    Fmt_Str(&f, "I2C2: ");
+    Fmt_Uint(&f, i2c_stats.khz);
+    Fmt_Str(&f, " kHz, DMA job queue (IMU first)\r\n");
+
+    if (baro_ok) {
+        Fmt_Str(&f, "Barometer: LPS22HB ");
+        Fmt_Uint(&f, HEIGHT_ODR_HZ);
+        Fmt_Str(&f, " Hz FIFO, ");
+        Fmt_Uint(&f, BARO_BATCH_MS);
+        Fmt_Str(&f, " ms batches, ");
+        Fmt_Uint(&f, BaroFifo_BusUsPerSecond());
+        Fmt_Str(&f, " us/s of I2C2\r\n");
+    } else {
+        Fmt_Str(&f, "Barometer: LPS22HB not found, no height-drop evidence\r\n");
+    }
 
-        if (!system_armed) {
-            delay_ms = 500; 
-            HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_RESET); 
-            BSP_LED_Off(LED2);
-            continue; 
+    if (mag_ok) {
+        Fmt_Str(&f, "Magnetometer: LIS3MDL ");
+        Fmt_Uint(&f, MAG_ODR_HZ);
+        Fmt_Str(&f, " Hz, read every ");
+        Fmt_Uint(&f, MAG_READ_EVERY);
+        Fmt_Str(&f, " IMU samples, ");
+        Fmt_Str(&f, MagHeading_IsCalibrated() ? "stored hard/soft-iron calibration" : "calibration not learned yet");
+        Fmt_Str(&f, "\r\n");
+    } else {
+        Fmt_Str(&f, "Magnetometer: LIS3MDL not found, no field rotation evidence\r\n");
+    }
+
+    Kernel_Init();
+    Kernel_QueueInit(&app_q, app_q_buf, sizeof(AppMsg_t), APP_QUEUE_LEN);
+    MemPool_Init(&sample_pool);
+    Kernel_CreateThread("acquire", Thread_Acquire, NULL, ACQ_PRIO, ACQ_STACK_WORDS);
+    Kernel_CreateThread("app", Thread_App, NULL, APP_PRIO, APP_STACK_WORDS);
+
+    Fmt_Str(&f, "Kernel: acquire thread every ");
+    Fmt_Uint(&f, Config_Get()->sample_period_ms);
+    Fmt_Str(&f, " ms preempts the app thread (detect on sample, house ");
+    Fmt_Uint(&f, HOUSE_PERIOD_MS);
+    Fmt_Str(&f, " ms, ui ");
+    Fmt_Uint(&f, UI_PERIOD_MS);
+    Fmt_Str(&f, " ms, telemetry ");
+    Fmt_Uint(&f, TELEMETRY_PERIOD_MS);
+    Fmt_Str(&f, " ms)\r\n");
+    UartTx_Commit(&f);
+#ifdef FMT_BENCH_NEWLIB
+    Bench_Format();
+#endif
+
+    Kernel_Start();
+}
+
+// ======================= ACQUISITION THREAD =========================
+// Highest priority: IMU + sound on a drift-free grid, whatever the app thread is in the middle of
+static void Thread_Acquire(void *arg)
+{
+    uint32_t next_us = Timestamp_Now();
+    uint32_t last_read_us = next_us;
+    uint32_t last_supply_ms = HAL_GetTick();
+    (void)arg;
+
+    for (;;) {
+        Kernel_SleepUntil(next_us);
+
+        uint32_t read_us = Timestamp_Now();
+        uint32_t sample_dt_us = read_us - last_read_us;
+        last_read_us = read_us;
+
+        // Next release: slow while disarmed, 100 ms while the alarm sounds
+        FallState_t state = fall.state;
+        uint32_t period_ms = Config_Get()->sample_period_ms;
+        if (!system_armed && !AutoCalib_IsActive()) period_ms = 500;
+        else if (state == STATE_CONFIRMED) period_ms = 100;
+        uint32_t period_us = period_ms * 1000u;
+        // Grid restarts below show up here as one long stretch and a miss
+        LoopMonitor_Sample(&loop_mon, read_us, period_us, state);
+        next_us += period_us;
+        if ((int32_t)(next_us - read_us) <= 0) {
+            acq_overruns++;
+            next_us = read_us + period_us;
+        }
+        acq_next_us = next_us;
+
+        // The ADC is this thread's, so the supply is measured here too
+        if (HAL_GetTick() - last_supply_ms > SUPPLY_READ_MS) {
+            last_supply_ms = HAL_GetTick();
+            AppMsg_t supply = {0};
+            supply.type = APP_MSG_SUPPLY;
+            supply.supply_mv = Read_Supply_mV();
+            Kernel_QueueSend(&app_q, &supply);
         }
 
-        int16_t accel_data_i16[3] = { 0 };          
-        BSP_ACCELERO_AccGetXYZ(accel_data_i16);
+        if (!system_armed && !AutoCalib_IsActive()) continue;
 
-        accel_buff_x[i%4]=accel_data_i16[0]; 
-        accel_buff_y[i%4]=accel_data_i16[1]; 
-        accel_buff_z[i%4]=accel_data_i16[2]; 
+        // Pool empty: detection is a whole queue behind, the pool counts the lost sample
+        Sample_t *s = MemPool_Alloc(&sample_pool);
+        if (!s) continue;
+
+        uint32_t imu_read_us = Timestamp_Now();
+        BSP_ACCELERO_AccGetXYZ(s->accel_mg);
+        s->sample_us = Timestamp_ImuSampleTime(imu_read_us);
+        if (s->sample_us != imu_read_us) LatencyHist_Add(&hist_age, imu_read_us - s->sample_us);
 
         float gyro_data[3]={0.0};
         BSP_GYRO_GetXYZ(gyro_data);
+        // Magnetometer read queued right behind the IMU reads; applied from I2cBus_Poll()
+        MagHeading_Sample();
+        for (int k = 0; k < 3; k++) s->gyro_dps[k] = gyro_data[k] / 1000.0f;
+
+        s->sound_start_us = Timestamp_Now();
+        s->sound = Read_Sound_Sensor();
+        LatencyHist_Add(&hist_acquire, Timestamp_Now() - imu_read_us);
+        s->dt_us = sample_dt_us;
+
+        AppMsg_t m = {0};
+        m.type = APP_MSG_SAMPLE;
+        m.sample = s;
+        if (!Kernel_QueueSend(&app_q, &m)) MemPool_Free(&sample_pool, s);
+    }
+}
 
-        float gyro_velocity[3]={0.0};
-        gyro_velocity[0] = (gyro_data[0] / 1000.0f);
-        gyro_velocity[1] = (gyro_data[1] / 1000.0f);
-        gyro_velocity[2] = (gyro_data[2] / 1000.0f);
+// Time to the next acquisition release: the I2C2 slot left for background transfers
+static uint32_t Acquire_UntilUs(void)
+{
+    int32_t us = (int32_t)(acq_next_us - Timestamp_Now());
+    return us > 0 ? (uint32_t)us : 0;
+}
 
-        float accel_filt_asm[3]={0}; 
-        accel_filt_asm[0]= (float)mov_avg(N,accel_buff_x) * (9.8f/1000.0f);
-        accel_filt_asm[1]= (float)mov_avg(N,accel_buff_y) * (9.8f/1000.0f);
-        accel_filt_asm[2]= (float)mov_avg(N,accel_buff_z) * (9.8f/1000.0f);
+// ======================= APP THREAD =========================
+// The cooperative tasks: modules that are not thread-safe are only ever called from here
+static void Thread_App(void *arg)
+{
+    (void)arg;
+
+    // Registration order is priority order
+    Sched_Init(Timestamp_Now, App_Wait);
+    task_detect = Sched_AddTask("detect", Task_Detect, 0, DETECT_DEADLINE_US);
+    task_house = Sched_AddTask("house", Task_Housekeeping, HOUSE_PERIOD_MS, HOUSE_DEADLINE_US);
+    task_ui = Sched_AddTask("ui", Task_Ui, UI_PERIOD_MS, UI_DEADLINE_US);
+    task_telemetry = Sched_AddTask("telemetry", Task_Telemetry, TELEMETRY_PERIOD_MS, TELEMETRY_DEADLINE_US);
+    Sched_Run();
+}
 
-        uint32_t current_sound = Read_Sound_Sensor();
+// Scheduler idle hook: block on the app queue until the next task release at the latest
+static void App_Wait(uint32_t idle_us)
+{
+    AppMsg_t m;
+    if (!Kernel_QueueReceive(&app_q, &m, idle_us)) return;
+
+    switch (m.type) {
+    case APP_MSG_SAMPLE:
+        // Detection runs before the next receive: the previous sample is finished with
+        if (sample) MemPool_Free(&sample_pool, sample);
+        sample = m.sample;
+        Sched_Post(task_detect, EV_SAMPLE);
+        break;
+    case APP_MSG_SUPPLY:
+        NfcStatus_SetSupply(m.supply_mv);
+        break;
+    case APP_MSG_WIFI_DRDY:
+        Sched_Post(task_house, EV_WIFI_DRDY);
+        break;
+    default:
+        break;
+    }
+}
+
+// ======================= DETECTION TASK =========================
+static void Task_Detect(uint8_t ev)
+{
+    (void)ev;
+    uint32_t t0 = DWT->CYCCNT;
+    Detect_Sample();
+    uint32_t cycles = DWT->CYCCNT - t0;
+
+    detect_cycles_total += cycles;
+    detect_runs++;
+    if (cycles > detect_cycles_max) detect_cycles_max = cycles;
+}
+
+// Filtering, black box, noise floor, calibration or fusion + fall FSM on the sample just received
+RAMFUNC static void Detect_Sample(void)
+{
+    const int N=4;
+    static int accel_buff_x[4]={0};
+    static int accel_buff_y[4]={0};
+    static int accel_buff_z[4]={0};
+    static int i=0;
+    Fmt_t f;
+
+    const ConfigRecord_t *cfg = Config_Get();
+    sample_us = sample->sample_us;
+
+    accel_buff_x[i%4]=sample->accel_mg[0];
+    accel_buff_y[i%4]=sample->accel_mg[1];
+    accel_buff_z[i%4]=sample->accel_mg[2];
+    i++;
+
+    Posture_Update(sample->accel_mg);
+
+    const float *gyro_velocity = sample->gyro_dps;
+    float accel_filt_asm[3];
+    accel_filt_asm[0]= (float)mov_avg(N,accel_buff_x) * (9.8f/1000.0f);
+    accel_filt_asm[1]= (float)mov_avg(N,accel_buff_y) * (9.8f/1000.0f);
+    accel_filt_asm[2]= (float)mov_avg(N,accel_buff_z) * (9.8f/1000.0f);
+
+    uint32_t current_sound = sample->sound;
+    float total_accel = FallDetect_Magnitude(accel_filt_asm[0], accel_filt_asm[1], accel_filt_asm[2]);
+    float total_gyro = FallDetect_Magnitude(gyro_velocity[0], gyro_velocity[1], gyro_velocity[2]);
+
+    // Raw sample into the black-box pre/post trigger windows (RAM copy only)
+    BlackBoxSample_t bb_sample;
+    for (int k = 0; k < 3; k++) {
+        float g = gyro_velocity[k];
+        bb_sample.accel_mg[k] = sample->accel_mg[k];
+        bb_sample.gyro_dps[k] = (int16_t)(g > 32767.0f ? 32767.0f : (g < -32768.0f ? -32768.0f : g));
+    }
+    bb_sample.sound = (uint16_t)(current_sound > 0xFFFF ? 0xFFFF : current_sound);
+    bb_sample.state = (uint8_t)fall.state;
+    uint32_t sound_dt = (sample->sound_start_us + SOUND_WINDOW_US / 2 - sample_us) / 100;
+    bb_sample.sound_dt = (uint8_t)(sound_dt < 255 ? sound_dt : 255);
+    BlackBox_PushSample(&bb_sample, sample_us);
+
+    NoiseFloor_SetMarginDb(cfg->loud_margin_db);
+    NoiseFloor_Update(current_sound);
+
+    if (AutoCalib_IsActive()) {
+        AutoCalib_Step(total_accel, total_gyro);
+        return;
+    }
 
-        float total_accel = sqrtf(powf(accel_filt_asm[0], 2) + powf(accel_filt_asm[1], 2) + powf(accel_filt_asm[2], 2));
-        float total_gyro = sqrtf(powf(gyro_velocity[0], 2) + powf(gyro_velocity[1], 2) + powf(gyro_velocity[2], 2));
+    // Attitude fusion only runs inside the fall window (started on NORMAL -> FALLING)
+    if (fall.state == STATE_FALLING || fall.state == STATE_STILLNESS_CHECK) {
+        Fusion_Update(gyro_velocity[0], gyro_velocity[1], gyro_velocity[2],
+                      accel_filt_asm[0], accel_filt_asm[1], accel_filt_asm[2],
+                      (float)sample->dt_us / 1000000.0f);
+    }
 
-        if (current_sound > peak_sound_window) peak_sound_window = current_sound;
-        if (total_accel > peak_accel_window) peak_accel_window = total_accel;
-        if (total_gyro > peak_gyro_window) peak_gyro_window = total_gyro;
+    if (current_sound > peak_sound_window) peak_sound_window = current_sound;
+    if (total_accel > peak_accel_window) peak_accel_window = total_accel;
+    if (total_gyro > peak_gyro_window) peak_gyro_window = total_gyro;
 
-        float ACCEL_THRESHOLD_HIGH = 20.0f; 
-        float ACCEL_THRESHOLD_LOW = 5.0f;   
-        float GYRO_THRESHOLD = 400.0f;      
+    // Event windows are closed on every NORMAL sample, as before the FSM step
+    FallState_t prev_state = fall.state;
+    if (prev_state != STATE_FALLING && prev_state != STATE_STILLNESS_CHECK) Fusion_Stop();
+    if (prev_state == STATE_NORMAL) {
+        HeightDrop_StopEvent();
+        MagHeading_StopEvent();
+    }
 
-        static int last_printed_second = -1;
+    // Only what the current state looks at: NORMAL, the common case, needs the magnitudes alone
+    FallInput_t in = { .sample_us = sample_us, .total_accel = total_accel, .total_gyro = total_gyro };
+    if (prev_state == STATE_FALLING) {
+        in.rotation_deg = Fusion_GetEventRotation();
+        in.mag_rotation = MagHeading_GetEventRotation();
+        in.height_drop = (uint8_t)HeightDrop_Seen();
+    }
+    if (prev_state == STATE_STILLNESS_CHECK) in.posture_delta = Posture_GetDelta();
+    if (prev_state == STATE_FALLING || prev_state == STATE_STILLNESS_CHECK)
+        in.loud = (uint8_t)NoiseFloor_IsLoud(current_sound);
+
+    int countdown;
+    FallEvent_t event = FallDetect_Step(&fall, &in, cfg, &countdown);
+    uint32_t decided_us = Timestamp_Now();
+
+    if (countdown >= 0) {
+        static const char *const number_art[FALL_COUNTDOWN_S] = {
+            "\r\n 55555 \r\n 5     \r\n 5555  \r\n     5 \r\n  555  \r\n",
+            "\r\n 4   4 \r\n 4   4 \r\n 44444 \r\n     4 \r\n     4 \r\n",
+            "\r\n  333  \r\n 3   3 \r\n   33  \r\n 3   3 \r\n  333  \r\n",
+            "\r\n  222  \r\n 2   2 \r\n   22  \r\n  2    \r\n 22222 \r\n",
+            "\r\n   1   \r\n  11   \r\n   1   \r\n   1   \r\n  111  \r\n",
+        };
+        UartTx_Write(number_art[countdown]);
+    }
 
-        // 500ms Print and Baseline Update (Silenced during ALARM)
-        if (i % 25 == 0) {
-            if (current_state != STATE_CONFIRMED) {
-                sprintf(buffer, "Sound:%lu | Accel:%.2f | Gyro:%.2f\r\n", peak_sound_window, peak_accel_window, peak_gyro_window);
-                HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
+    // ********* Fall Detection FSM: side effects of the transition *********/
+    switch (event) {
+        case FALL_EV_TRIGGER:
+            Posture_CaptureReference();
+            HeightDrop_StartEvent(HAL_GetTick());
+            MagHeading_StartEvent(HAL_GetTick());
+            Fusion_Start(accel_filt_asm[0], accel_filt_asm[1], accel_filt_asm[2]);
+
+            UartTx_Begin(&f);
+            Fmt_Str(&f,
+                "\r\n=================================\r\n"
+                " EVENT DETECTED - INVESTIGATING...\r\n"
+                " Trigger: ");
+            if (fall.seen & FALL_SEEN_IMPACT) Fmt_Str(&f, "IMPACT ");
+            if (fall.seen & FALL_SEEN_FREEFALL) Fmt_Str(&f, "FREEFALL ");
+            if (fall.seen & FALL_SEEN_ROTATION) Fmt_Str(&f, "ROTATION");
+            Fmt_Str(&f, "\r\n Sample time: ");
+            Fmt_Uint(&f, sample_us);
+            Fmt_Str(&f, " us\r\n=================================\r\n");
+            UartTx_Commit(&f);
+            Log_FallEvent(BB_EVT_TRIGGER, total_accel, total_gyro, 1);
+            break;
+
+        case FALL_EV_CRASH:
+            // Sentinel + ASCII Art prints ONCE right here
+            AlertTrace_Sentinel(ALERT_TRACE_CRASH, fall.trigger_us, sample_us, decided_us);
+            UartTx_Write(
+                "!!! CRASH DETECTED - IMMEDIATE ALARM !!!\r\n"
+                "  AAA  L       AAA  RRRR  M   M \r\n"
+                " A   A L      A   A R   R MM MM \r\n"
+                " AAAAA L      AAAAA RRRR  M M M \r\n"
+                " A   A L      A   A R   R M   M \r\n"
+                " A   A LLLLLL A   A R   R M   M \r\n");
+            Log_FallEvent(BB_EVT_CONFIRMED, total_accel, total_gyro, 0);
+            break;
+
+        case FALL_EV_SILENT_FALL:
+            UartTx_Begin(&f);
+            Fmt_Str(&f,
+                "\r\n=================================\r\n"
+                " SSSSS TTTTT  I  L       L     N   N EEEEE SSSSS SSSSS \r\n"
+                " S       T    I  L       L     NN  N E     S     S     \r\n"
+                " SSSSS   T    I  L       L     N N N EEEEE SSSSS SSSSS \r\n"
+                "     S   T    I  L       L     N  NN E         S     S \r\n"
+                " SSSSS   T    I  LLLLLLL LLLLL N   N EEEEE SSSSS SSSSS \r\n"
+                "=================================\r\n"
+                "Silent Fall. Waiting 5s for Recovery...\r\n");
+            Format_Evidence(&f);
+            UartTx_Commit(&f);
+            Log_FallEvent(BB_EVT_SILENT_FALL, total_accel, total_gyro, 0);
+            break;
+
+        case FALL_EV_TIMEOUT:
+            UartTx_Begin(&f);
+            Fmt_Str(&f, "\r\n--- TIMEOUT (1.5s) - INSUFFICIENT EVIDENCE ---\r\n");
+            Format_Evidence(&f);
+            UartTx_Commit(&f);
+            Log_FallEvent(BB_EVT_TIMEOUT, total_accel, total_gyro, 0);
+            break;
+
+        case FALL_EV_DELAYED_CRASH:
+            // Sentinel + ASCII Art prints ONCE right here
+            AlertTrace_Sentinel(ALERT_TRACE_DELAYED, fall.trigger_us, sample_us, decided_us);
+            UartTx_Write(
+                "!!! DELAYED CRASH DETECTED - IMMEDIATE ALARM !!!\r\n"
+                "  AAA  L       AAA  RRRR  M   M \r\n"
+                " A   A L      A   A R   R MM MM \r\n"
+                " AAAAA L      AAAAA RRRR  M M M \r\n"
+                " A   A L      A   A R   R M   M \r\n"
+                " A   A LLLLLL A   A R   R M   M \r\n");
+            Log_FallEvent(BB_EVT_CONFIRMED, total_accel, total_gyro, 0);
+            break;
+
+        case FALL_EV_RECOVERED:
+            UartTx_Begin(&f);
+            Fmt_Str(&f,
+                "\r\n=================================\r\n"
+                " N   N  OOO  RRRR  M   M  AAA  L     \r\n"
+                " NN  N O   O R   R MM MM A   A L     \r\n"
+                " N N N O   O RRRR  M M M AAAAA L     \r\n"
+                " N  NN O   O R   R M   M A   A L     \r\n"
+                " N   N  OOO  R   R M   M A   A LLLLL \r\n"
+                "=================================\r\n"
+                "RECOVERY DETECTED (Push/Stand: ");
+            Fmt_Float(&f, fabsf(total_accel - 9.8f), 2);
+            Fmt_Str(&f, " | Tilt: ");
+            Fmt_Fixed(&f, in.posture_delta, 1);
+            Fmt_Str(&f, " deg)\r\n");
+            UartTx_Commit(&f);
+            Log_FallEvent(BB_EVT_RECOVERED, total_accel, total_gyro, 0);
+            break;
+
+        case FALL_EV_STILL:
+            // Sentinel + ASCII Art prints ONCE right here
+            AlertTrace_Sentinel(ALERT_TRACE_STILL, fall.trigger_us, sample_us, decided_us);
+            UartTx_Write(
+                "  AAA  L       AAA  RRRR  M   M \r\n"
+                " A   A L      A   A R   R MM MM \r\n"
+                " AAAAA L      AAAAA RRRR  M M M \r\n"
+                " A   A L      A   A R   R M   M \r\n"
+                " A   A LLLLLL A   A R   R M   M \r\n");
+            Log_FallEvent(BB_EVT_CONFIRMED, total_accel, total_gyro, 0);
+            break;
+
+        case FALL_EV_NONE:
+            // CONFIRMED: TOTAL UART SILENCE. No printing allowed here. The UI task sounds the alarm.
+            break;
+    }
+}
+
+// ======================= HOUSEKEEPING TASK =========================
+// Non-blocking service polls; also run at once when the Wi-Fi module raises DRDY
+static void Task_Housekeeping(uint8_t ev)
+{
+    (void)ev;
+
+    // Advance any pending config flash write by one step (never waits)
+    Config_Poll();
+    // Move at most one page of queued black-box data to the QSPI flash
+    BlackBox_Poll();
+    // Stage times of an alarm whose sentinel has just left the UART
+    AlertTrace_Poll();
+    // Collect finished Wi-Fi steps and queue the next (the AT traffic runs on DMA)
+    AlertClient_Poll();
+    // Finished I2C2 background jobs (NFC tag, barometer, magnetometer) report back here
+    I2cBus_Poll();
+    // A newly learned magnetometer calibration goes to the config store when flash is idle
+    MagHeading_Poll();
+    // Barometer FIFO and NFC tag share I2C2 with the IMU: their transfers only go in the gap before the next sample
+    uint32_t slot_ms = Acquire_UntilUs() / 1000;
+    BaroFifo_Poll(slot_ms);
+    NfcStatus_Poll(slot_ms);
+}
+
+// ======================= UI TASK =========================
+// Multi-press button, arm/disarm and calibration beeps, and the alarm buzzer/LED
+static void Task_Ui(uint8_t ev)
+{
+    static int btn_press_count = 0;
+    static uint32_t btn_first_press_time = 0;
+    static uint32_t btn_last_debounce_time = 0;
+    static int btn_last_state = 1;
+    static int btn_waiting_for_decision = 0;
+    static int btn_long_handled = 0;
+    static uint32_t beep_phases = 0;        // buzzer on/off phases left, on while odd
+    static uint32_t beep_phase_start = 0;
+    static uint32_t last_alarm_toggle = 0;
+    (void)ev;
+
+    // ========== MULTI-PRESS BUTTON HANDLER ==========
+    int btn_current = HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_13);
+
+    if (btn_current == GPIO_PIN_RESET && btn_last_state == 1 && (HAL_GetTick() - btn_last_debounce_time > 50)) {
+        btn_press_count++;
+        btn_last_debounce_time = HAL_GetTick();
+        if (btn_press_count == 1) btn_first_press_time = HAL_GetTick();
+        btn_waiting_for_decision = 1;
+    }
+
+    // Long hold (3s) on a single press enters guided auto-calibration
+    if (btn_current == GPIO_PIN_RESET && btn_press_count == 1 && !btn_long_handled &&
+        (HAL_GetTick() - btn_last_debounce_time > AUTO_CALIB_HOLD_MS)) {
+        btn_long_handled = 1;
+        btn_waiting_for_decision = 0;
+        btn_press_count = 0;
+        fall.state = STATE_NORMAL;
+        BSP_LED_Off(LED2);
+        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_RESET);
+        AutoCalib_Start();
+    }
+    if (btn_current == GPIO_PIN_SET) btn_long_handled = 0;
+    btn_last_state = (btn_current == GPIO_PIN_SET) ? 1 : 0;
+
+    if (btn_waiting_for_decision && btn_current == GPIO_PIN_SET && (HAL_GetTick() - btn_first_press_time > 500)) {
+        btn_waiting_for_decision = 0;
+
+        if (btn_press_count == 1) {
+            if (fall.state == STATE_CONFIRMED) {
+                fall.state = STATE_NORMAL;
+                HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_RESET);
+                BSP_LED_Off(LED2);
+                UartTx_Write("\r\n--- ALARM RESET (1 press) ---\r\n");
+                Log_FallEvent(BB_EVT_RESET, 0.0f, 0.0f, 0);
             }
-            
-            sound_history[2] = sound_history[1];
-            sound_history[1] = sound_history[0];
-            sound_history[0] = peak_sound_window;
-
-            bg_sound_max = sound_history[0];
-            if (sound_history[1] > bg_sound_max) bg_sound_max = sound_history[1];
-            if (sound_history[2] > bg_sound_max) bg_sound_max = sound_history[2];
-
-            peak_sound_window = 0; 
-            peak_accel_window = 0.0f;
-            peak_gyro_window = 0.0f;
         }
-        
-        i++; 
-
-        // ********* Fall Detection FSM *********/
-        switch (current_state) {
-            case STATE_NORMAL:
-                seen_impact = 0;
-                seen_rotation = 0;
-                seen_freefall = 0;
-                seen_loud_noise = 0;
-                delay_ms = 20; 
-
-                if (total_accel > ACCEL_THRESHOLD_HIGH) seen_impact = 1;
-                if (total_accel < ACCEL_THRESHOLD_LOW)  seen_freefall = 1;
-                if (total_gyro  > GYRO_THRESHOLD)       seen_rotation = 1;
-
-                if (seen_impact || seen_freefall || seen_rotation) {
-                    current_state = STATE_FALLING;
-                    state_timer = HAL_GetTick();
-
-                    sprintf(buffer,
-                        "\r\n=================================\r\n"
-                        " EVENT DETECTED - INVESTIGATING...\r\n"
-                        " Trigger: %s%s%s\r\n"
-                        "=================================\r\n",
-                        seen_impact ? "IMPACT " : "",
-                        seen_freefall ? "FREEFALL " : "",
-                        seen_rotation ? "ROTATION" : "");
-                    HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-                }
-                break;
-
-            case STATE_FALLING:
-                delay_ms = 20; 
-
-                if (total_accel > ACCEL_THRESHOLD_HIGH) seen_impact = 1; 
-                if (total_accel < ACCEL_THRESHOLD_LOW)  seen_freefall = 1; 
-                if (total_gyro  > GYRO_THRESHOLD)       seen_rotation = 1; 
-                
-                if (current_sound > (bg_sound_max + 600)) seen_loud_noise = 1;
-
-                if (seen_impact && (seen_freefall || seen_rotation)) {
-                    if (seen_loud_noise) {
-                        current_state = STATE_CONFIRMED;
-                        // Sentinel + ASCII Art prints ONCE right here
-                        sprintf(buffer, 
-                            "\r\n___SEND_TELEGRAM_ALERT___\r\n"
-                            "!!! CRASH DETECTED - IMMEDIATE ALARM !!!\r\n"
-                            "  AAA  L       AAA  RRRR  M   M \r\n"
-                            " A   A L      A   A R   R MM MM \r\n"
-                            " AAAAA L      AAAAA RRRR  M M M \r\n"
-                            " A   A L      A   A R   R M   M \r\n"
-                            " A   A LLLLLL A   A R   R M   M \r\n");
-                        HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-                    } 
-                    else {
-                        current_state = STATE_STILLNESS_CHECK;
-                        state_timer = HAL_GetTick();
-                        last_printed_second = -1;
-                        sprintf(buffer,
-                            "\r\n=================================\r\n"
-                            " SSSSS TTTTT  I  L       L     N   N EEEEE SSSSS SSSSS \r\n"
-                            " S       T    I  L       L     NN  N E     S     S     \r\n"
-                            " SSSSS   T    I  L       L     N N N EEEEE SSSSS SSSSS \r\n"
-                            "     S   T    I  L       L     N  NN E         S     S \r\n"
-                            " SSSSS   T    I  LLLLLLL LLLLL N   N EEEEE SSSSS SSSSS \r\n"
-                            "=================================\r\n"
-                            "Silent Fall. Waiting 5s for Recovery...\r\n");
-                        HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-                    }
-                }
-                else if (HAL_GetTick() - state_timer > 1500) {
-                    current_state = STATE_NORMAL;
-                    sprintf(buffer, "\r\n--- TIMEOUT (1.5s) - INSUFFICIENT EVIDENCE ---\r\n");
-                    HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-                }
-                break;
-
-            case STATE_STILLNESS_CHECK:
-                delay_ms = 20; 
-
-                uint32_t elapsed_time = HAL_GetTick() - state_timer;
-                int current_second = elapsed_time / 1000;
-
-                if (current_second != last_printed_second && current_second < 5) {
-                    char* number_art = "";
-                    switch(current_second) {
-                        case 0: number_art = "\r\n 55555 \r\n 5     \r\n 5555  \r\n     5 \r\n  555  \r\n"; break;
-                        case 1: number_art = "\r\n 4   4 \r\n 4   4 \r\n 44444 \r\n     4 \r\n     4 \r\n"; break;
-                        case 2: number_art = "\r\n  333  \r\n 3   3 \r\n   33  \r\n 3   3 \r\n  333  \r\n"; break;
-                        case 3: number_art = "\r\n  222  \r\n 2   2 \r\n   22  \r\n  2    \r\n 22222 \r\n"; break;
-                        case 4: number_art = "\r\n   1   \r\n  11   \r\n   1   \r\n   1   \r\n  111  \r\n"; break;
-                    }
-                    sprintf(buffer, "%s", number_art);
-                    HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-                    last_printed_second = current_second;
-                }
-
-                if (elapsed_time < 2000 && current_sound > (bg_sound_max + 600)) {
-                    current_state = STATE_CONFIRMED;
-                    // Sentinel + ASCII Art prints ONCE right here
-                    sprintf(buffer, 
-                        "\r\n___SEND_TELEGRAM_ALERT___\r\n"
-                        "!!! DELAYED CRASH DETECTED - IMMEDIATE ALARM !!!\r\n"
-                        "  AAA  L       AAA  RRRR  M   M \r\n"
-                        " A   A L      A   A R   R MM MM \r\n"
-                        " AAAAA L      AAAAA RRRR  M M M \r\n"
-                        " A   A L      A   A R   R M   M \r\n"
-                        " A   A LLLLLL A   A R   R M   M \r\n");
-                    HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-                }
-
-                else if (elapsed_time > 2000 && (fabs(total_accel - 9.8f) > 4.5f)) {
-                    current_state = STATE_NORMAL;
-                    last_printed_second = -1; 
-                    sprintf(buffer, 
-                        "\r\n=================================\r\n"
-                        " N   N  OOO  RRRR  M   M  AAA  L     \r\n"
-                        " NN  N O   O R   R MM MM A   A L     \r\n"
-                        " N N N O   O RRRR  M M M AAAAA L     \r\n"
-                        " N  NN O   O R   R M   M A   A L     \r\n"
-                        " N   N  OOO  R   R M   M A   A LLLLL \r\n"
-                        "=================================\r\n"
-                        "RECOVERY DETECTED (Push/Stand: %.2f)\r\n", fabs(total_accel - 9.8f));
-                    HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-                }
-                else if (elapsed_time > 5000) {
-                    current_state = STATE_CONFIRMED;
-                    last_printed_second = -1; 
-                    // Sentinel + ASCII Art prints ONCE right here
-                    sprintf(buffer, 
-                        "\r\n___SEND_TELEGRAM_ALERT___\r\n"
-                        "  AAA  L       AAA  RRRR  M   M \r\n"
-                        " A   A L      A   A R   R MM MM \r\n"
-                        " AAAAA L      AAAAA RRRR  M M M \r\n"
-                        " A   A L      A   A R   R M   M \r\n"
-                        " A   A LLLLLL A   A R   R M   M \r\n");
-                    HAL_UART_Transmit(&huart1, (uint8_t*)buffer, strlen(buffer), HAL_MAX_DELAY);
-                }
-                break;
-
-            case STATE_CONFIRMED:
-                delay_ms = 100; 
-                BSP_LED_Toggle(LED2); 
-                HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_3); 
-                // TOTAL UART SILENCE. No printing allowed here.
-                break;
+        else if (btn_press_count == 2) {
+            system_armed = !system_armed;
+            fall.state = STATE_NORMAL;
+            BSP_LED_Off(LED2);
+
+            // One beep for armed, two for disarmed, played out below
+            beep_phases = system_armed ? 1 : 3;
+            beep_phase_start = HAL_GetTick();
+
+            UartTx_Write(system_armed ? "\r\n--- SYSTEM ARMED (2 presses) ---\r\n"
+                                      : "\r\n--- SYSTEM DISARMED (2 presses) ---\r\n");
+            AlertClient_Publish(system_armed ? ALERT_ARMED : ALERT_DISARMED, 0, 0, Timestamp_Now());
+            NfcStatus_SetArmed(system_armed);
+        }
+        else if (btn_press_count >= 3) {
+            system_armed = 1;
+            fall.state = STATE_CONFIRMED;
+            NfcStatus_SetArmed(1);
+            uint32_t now_us = Timestamp_Now();
+            AlertTrace_Sentinel(ALERT_TRACE_MANUAL, now_us, now_us, now_us);
+            UartTx_Write("!!! MANUAL ALARM TRIGGERED (3 presses) !!!\r\n");
+            Log_FallEvent(BB_EVT_MANUAL, 0.0f, 0.0f, 0);
         }
+        btn_press_count = 0;
+    }
+
+    // ========== BUZZER / LED ==========
+    uint32_t cal_beeps = AutoCalib_TakeBeeps();
+    if (cal_beeps) {
+        beep_phases = 2 * cal_beeps - 1;
+        beep_phase_start = HAL_GetTick();
+    }
+    if (beep_phases && HAL_GetTick() - beep_phase_start >= BEEP_MS) {
+        beep_phases--;
+        beep_phase_start = HAL_GetTick();
+    }
+    if (fall.state == STATE_CONFIRMED) {
+        if (HAL_GetTick() - last_alarm_toggle >= ALARM_TOGGLE_MS) {
+            last_alarm_toggle = HAL_GetTick();
+            BSP_LED_Toggle(LED2);
+            HAL_GPIO_TogglePin(GPIOA, GPIO_PIN_3);
+        }
+    } else {
+        HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, (beep_phases & 1) ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    }
+}
+
+// ======================= TELEMETRY TASK =========================
+// 500 ms status line and, once a minute, the latency / task dump, one short line per run
+static void Task_Telemetry(uint8_t ev)
+{
+    static uint32_t last_latency_print = 0;
+    static int latency_line = -1;           // next line of the dump, -1 = none due
+    Fmt_t f;
+    (void)ev;
+
+    // Silenced during ALARM, skipped while disarmed or calibrating (the sampling loop was then too)
+    if (system_armed && !AutoCalib_IsActive() && fall.state != STATE_CONFIRMED) {
+        uint32_t t0 = DWT->CYCCNT;
+        UartTx_Begin(&f);
+        Format_Status(&f, peak_sound_window, peak_accel_window, peak_gyro_window);
+        UartTx_Commit(&f);
+        status_cycles = DWT->CYCCNT - t0;
+        if (status_cycles > status_cycles_max) status_cycles_max = status_cycles;
+    }
+    peak_sound_window = 0;
+    peak_accel_window = 0.0f;
+    peak_gyro_window = 0.0f;
+
+    if (latency_line < 0 && HAL_GetTick() - last_latency_print > 60000 && fall.state == STATE_NORMAL) {
+        last_latency_print = HAL_GetTick();
+        latency_line = 0;
+    }
+    if (latency_line < 0) return;
+
+    // One line per run leaves the UART ring room for the status line and the banners
+    UartTx_Begin(&f);
+    int more = Format_Latency(latency_line, &f);
+    UartTx_Commit(&f);
+    latency_line = more ? latency_line + 1 : -1;
+}
+
+// ======================= BLACK-BOX EVENT LOGGING + ALERTS =========================
+// trigger = 1 also stores the pre-trigger window and starts the post-trigger one
+static void Log_FallEvent(uint8_t code, float total_accel, float total_gyro, int trigger)
+{
+    BlackBoxEvent_t ev;
+    ev.code = code;
+    ev.trigger = fall.seen;         // FALL_SEEN_* are the BB_TRIG_* bits
+    ev.posture_dd = (int16_t)Posture_GetDelta();
+    ev.rotation_deg = Fusion_GetEventRotation();
+    ev.total_accel = total_accel;
+    ev.total_gyro = total_gyro;
+    // Button events happen now; detector events belong to the sample that raised them
+    ev.t_us = (code == BB_EVT_MANUAL || code == BB_EVT_RESET) ? Timestamp_Now() : sample_us;
+
+    if (trigger) BlackBox_Trigger(&ev);
+    else         BlackBox_LogEvent(&ev);
+    NfcStatus_LogEvent(code);
+
+    // The same events gateway.py forwards from the serial log also go out over Wi-Fi
+    if (code == BB_EVT_CONFIRMED) {
+        AlertClient_Publish(ALERT_FALL, (int16_t)(total_accel * 100.0f), (int16_t)(total_gyro * 10.0f), ev.t_us);
+    } else if (code == BB_EVT_MANUAL) {
+        AlertClient_Publish(ALERT_MANUAL, 0, 0, ev.t_us);
+    } else if (code == BB_EVT_RESET) {
+        AlertClient_Publish(ALERT_RESET, 0, 0, ev.t_us);
+    }
+}
+
+// ======================= CONSOLE LINES =========================
+// "Sound:.. (floor .. dB, loud > .. dB) | Accel:.. | Gyro:..", the 500 ms status line
+static void Format_Status(Fmt_t *f, uint32_t sound, float accel, float gyro)
+{
+    Fmt_Str(f, "Sound:");
+    Fmt_Uint(f, sound);
+    Fmt_Str(f, " (floor ");
+    Fmt_Int(f, NoiseFloor_GetFloorDb() / 256);
+    Fmt_Str(f, " dB, loud > ");
+    Fmt_Int(f, NoiseFloor_GetThresholdDb() / 256);
+    Fmt_Str(f, " dB) | Accel:");
+    Fmt_Float(f, accel, 2);
+    Fmt_Str(f, " | Gyro:");
+    Fmt_Float(f, gyro, 2);
+    Fmt_Str(f, "\r\n");
+}
+
+// Evidence gathered in the fall window, under the silent-fall and timeout banners
+static void Format_Evidence(Fmt_t *f)
+{
+    Fmt_Str(f, "Rotation: ");
+    Fmt_Float(f, Fusion_GetEventRotation(), 1);
+    Fmt_Str(f, " deg | Mag: ");
+    Fmt_Fixed(f, MagHeading_GetEventRotation(), 1);
+    Fmt_Str(f, " deg | Height drop: ");
+    Fmt_Int(f, HeightDrop_GetDropMm());
+    Fmt_Str(f, " mm | Fusion: ");
+    Fmt_Uint(f, Fusion_GetLastCycles());
+    Fmt_Str(f, " cyc (max ");
+    Fmt_Uint(f, Fusion_GetMaxCycles());
+    Fmt_Str(f, ")\r\n");
+}
+
+#ifdef FMT_BENCH_NEWLIB
+// Boot-time comparison with newlib; needs -u _printf_float back on the link line
+static void Bench_Format(void)
+{
+    static char line[120];
+    const int reps = 100;
+    Fmt_t f;
+
+    uint32_t t0 = DWT->CYCCNT;
+    for (int k = 0; k < reps; k++) {
+        snprintf(line, sizeof(line), "Sound:%lu (floor %ld dB, loud > %ld dB) | Accel:%.2f | Gyro:%.2f\r\n",
+                 1234UL, NoiseFloor_GetFloorDb() / 256, NoiseFloor_GetThresholdDb() / 256, 9.81f, 123.45f);
+    }
+    uint32_t newlib = (DWT->CYCCNT - t0) / reps;
+
+    t0 = DWT->CYCCNT;
+    for (int k = 0; k < reps; k++) {
+        Fmt_Init(&f, line, sizeof(line));
+        Format_Status(&f, 1234, 9.81f, 123.45f);
+        Fmt_End(&f);
+    }
+    uint32_t fmt = (DWT->CYCCNT - t0) / reps;
+
+    UartTx_Begin(&f);
+    Fmt_Str(&f, "Status line: snprintf ");
+    Fmt_Uint(&f, newlib);
+    Fmt_Str(&f, " cyc, fmt.c ");
+    Fmt_Uint(&f, fmt);
+    Fmt_Str(&f, " cyc\r\n");
+    UartTx_Commit(&f);
+}
+#endif
+
+// ======================= LATENCY / TASK DUMP =========================
+// Line n of the dump into f; returns 0 for the last one
+#define LATENCY_HISTS       2
 
-        if (current_state != STATE_CONFIRMED) {
-            HAL_GPIO_WritePin(GPIOA, GPIO_PIN_3, GPIO_PIN_RESET); 
+static int Format_Latency(int n, Fmt_t *f)
+{
+    static const char *const names[LATENCY_HISTS] = { "DRDY->read", "Acquisition" };
+    const LatencyHist_t *const hists[LATENCY_HISTS] = { &hist_age, &hist_acquire };
+    TimestampStats_t ts;
+    SchedStats_t st;
+    KernelThreadStats_t th;
+    MemStats_t mem;
+    UartTxStats_t tx;
+
+    if (n == 0) {
+        Timestamp_GetStats(&ts);
+        Fmt_Str(f, "\r\nLatency (log2 us bins: 0, 1, 2-3, 4-7, ...), DRDY edges ");
+        Fmt_Uint(f, ts.drdy_edges);
+        Fmt_Str(f, ", no edge ");
+        Fmt_Uint(f, ts.drdy_stale);
+        Fmt_Str(f, "\r\n");
+        return 1;
+    }
+    n--;
+    if (n < 2 * LATENCY_HISTS) {
+        if (n % 2 == 0) LatencyHist_Format(hists[n / 2], names[n / 2], f);
+        else LatencyHist_FormatBins(hists[n / 2], f);
+        return 1;
+    }
+    n -= 2 * LATENCY_HISTS;
+    if (n < LOOP_MON_LINES) {
+        LoopMonitor_Format(&loop_mon, n, f);
+        return 1;
+    }
+    n -= LOOP_MON_LINES;
+    if (Sched_GetStats(n, &st)) {
+        Fmt_Str(f, st.name);
+        Fmt_Str(f, ": runs ");
+        Fmt_Uint(f, st.runs);
+        Fmt_Str(f, ", late <= ");
+        Fmt_Uint(f, st.max_late_us);
+        Fmt_Str(f, ", exec <= ");
+        Fmt_Uint(f, st.max_exec_us);
+        Fmt_Str(f, " (avg ");
+        Fmt_Uint(f, st.runs ? (uint32_t)(st.total_exec_us / st.runs) : 0UL);
+        Fmt_Str(f, ") us, overrun ");
+        Fmt_Uint(f, st.overruns);
+        Fmt_Str(f, ", miss ");
+        Fmt_Uint(f, st.misses);
+        Fmt_Str(f, ", queued <= ");
+        Fmt_Uint(f, st.max_queued);
+        Fmt_Str(f, ", drop ");
+        Fmt_Uint(f, st.dropped);
+        Fmt_Str(f, "\r\n");
+        return 1;
+    }
+    int tasks = 0;
+    while (Sched_GetStats(tasks, &st)) tasks++;
+    n -= tasks;
+    if (Kernel_GetThreadStats(n, &th)) {
+        Fmt_Str(f, "Thread ");
+        Fmt_Str(f, th.name);
+        Fmt_Str(f, " (prio ");
+        Fmt_Uint(f, th.prio);
+        Fmt_Str(f, "): cpu ");
+        Fmt_Fixed(f, (int32_t)th.cpu_permille, 1);
+        Fmt_Str(f, "%, stack ");
+        Fmt_Uint(f, th.stack_used);
+        Fmt_Char(f, '/');
+        Fmt_Uint(f, th.stack_bytes);
+        Fmt_Str(f, " bytes, switched in ");
+        Fmt_Uint(f, th.switches);
+        Fmt_Str(f, "\r\n");
+        return 1;
+    }
+    int threads = 0;
+    while (Kernel_GetThreadStats(threads, &th)) threads++;
+    n -= threads;
+    if (Mem_GetStats(n, &mem)) {
+        Fmt_Str(f, mem.is_pool ? "Pool " : "Arena ");
+        Fmt_Str(f, mem.name);
+        Fmt_Str(f, ": ");
+        Fmt_Uint(f, mem.used);
+        Fmt_Char(f, '/');
+        Fmt_Uint(f, mem.size);
+        if (mem.is_pool) {
+            Fmt_Str(f, " blocks of ");
+            Fmt_Uint(f, mem.block_size);
+            Fmt_Str(f, " B in use");
+        } else {
+            Fmt_Str(f, " B used");
+        }
+        Fmt_Str(f, ", peak ");
+        Fmt_Uint(f, mem.peak);
+        Fmt_Str(f, ", failed ");
+        Fmt_Uint(f, mem.fails);
+        Fmt_Str(f, "\r\n");
+        return 1;
+    }
+    int regions = 0;
+    while (Mem_GetStats(regions, &mem)) regions++;
+    n -= regions;
+    if (n == 0) {
+        UartTx_GetStats(&tx);
+        Fmt_Str(f, "Console: ");
+        Fmt_Uint(f, tx.bytes);
+        Fmt_Str(f, " B sent, ring <= ");
+        Fmt_Uint(f, tx.high_water);
+        Fmt_Char(f, '/');
+        Fmt_Uint(f, UART_TX_RING_BYTES);
+        Fmt_Str(f, " B, dropped ");
+        Fmt_Uint(f, tx.dropped);
+        Fmt_Str(f, " B, status line ");
+        Fmt_Uint(f, status_cycles);
+        Fmt_Str(f, " cyc (max ");
+        Fmt_Uint(f, status_cycles_max);
+        Fmt_Str(f, ")\r\n");
+        return 1;
+    }
+    if (n == 1) {
+        Fmt_Str(f, "Build: " BUILD_NAME ", detect ");
+        Fmt_Uint(f, detect_runs ? (uint32_t)(detect_cycles_total / detect_runs) : 0UL);
+        Fmt_Str(f, " cyc avg (max ");
+        Fmt_Uint(f, detect_cycles_max);
+        Fmt_Str(f, ") over ");
+        Fmt_Uint(f, detect_runs);
+        Fmt_Str(f, " samples\r\n");
+        return 1;
+    }
+    if (n == 2) {
+        AlertTrace_t at;
+        Fmt_Str(f, "Last alarm: ");
+        if (!AlertTrace_GetLast(&at)) {
+            Fmt_Str(f, "none\r\n");
+            return 1;
         }
+        Fmt_Str(f, "trigger->confirm ");
+        Fmt_Uint(f, at.confirm_us - at.trigger_us);
+        Fmt_Str(f, ", ->decided ");
+        Fmt_Uint(f, at.decided_us - at.confirm_us);
+        Fmt_Str(f, ", ->queued ");
+        Fmt_Uint(f, at.queued_us - at.decided_us);
+        Fmt_Str(f, ", ->sent ");
+        Fmt_Uint(f, at.sent_us - at.queued_us);
+        Fmt_Str(f, " us\r\n");
+        return 1;
+    }
+    Fmt_Str(f, "Acquisition: grid restarts ");
+    Fmt_Uint(f, acq_overruns);
+    Fmt_Str(f, ", app queue max ");
+    Fmt_Uint(f, app_q.max_fill);
+    Fmt_Char(f, '/');
+    Fmt_Uint(f, APP_QUEUE_LEN);
+    Fmt_Str(f, ", drop ");
+    Fmt_Uint(f, app_q.dropped);
+    Fmt_Str(f, "\r\n");
+    return 0;
+}
+
+// ======================= SRAM2 CODE =========================
+// The 1K SRAM2 pages holding .ramfunc stay read-only until reset: a stray write
+// (a thread stack overflowing from .ram2) faults instead of corrupting code
+static void Ramfunc_Protect(void)
+{
+    uint32_t pages = ((uint32_t)(_eramfunc - (uint8_t *)SRAM2_BASE) + 1023) / 1024;
+    if (pages == 0) return;
+
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+    __HAL_SYSCFG_SRAM2_WRP_1_31_ENABLE(pages >= 32 ? 0xFFFFFFFFUL : (1UL << pages) - 1);
+}
+
+// ======================= EXTI DISPATCH =========================
+static const AppMsg_t wifi_drdy_msg = { .type = APP_MSG_WIFI_DRDY };
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+    switch (GPIO_Pin) {
+    case ISM43362_DRDY_EXTI1_Pin:
+        WifiAsync_OnEvent(WIFI_EVT_DRDY);
+        Kernel_QueueSend(&app_q, &wifi_drdy_msg);
+        break;
+    case LSM6DSL_INT1_EXTI11_Pin:
+        Timestamp_OnImuDrdy();
+        break;
+    default:
+        break;
     }
 }
 
@@ -407,11 +1108,11 @@ static void ADC1_Init(void)
 
 uint32_t Read_Sound_Sensor(void)
 {
-    uint32_t start_time = HAL_GetTick();
+    uint32_t start_us = Timestamp_Now();
     uint32_t max_val = 0;
     uint32_t min_val = 4095;
 
-    while (HAL_GetTick() - start_time < 10) {
+    while (Timestamp_Now() - start_us < SOUND_WINDOW_US) {
         HAL_ADC_Start(&hadc1);
         if (HAL_ADC_PollForConversion(&hadc1, 1) == HAL_OK) {
             uint32_t val = HAL_ADC_GetValue(&hadc1);
@@ -422,15 +1123,26 @@ uint32_t Read_Sound_Sensor(void)
     return (max_val - min_val);
 }
 
-int mov_avg_C(int N, int* accel_buff)
-{ 
-    int result=0;
-    for(int i=0; i<N;i++)
-    {
-        result+=accel_buff[i];
-    }
-    result=result/4;
-    return result;
+// VDDA from the internal reference (the board has no battery gauge); borrows ADC1 from the sound channel
+uint32_t Read_Supply_mV(void)
+{
+    ADC_ChannelConfTypeDef sConfig = {0};
+    uint32_t raw = 0;
+
+    sConfig.Channel = ADC_CHANNEL_VREFINT;
+    sConfig.Rank = ADC_REGULAR_RANK_1;
+    sConfig.SamplingTime = ADC_SAMPLETIME_247CYCLES_5;
+    sConfig.SingleDiff = ADC_SINGLE_ENDED;
+    sConfig.OffsetNumber = ADC_OFFSET_NONE;
+    sConfig.Offset = 0;
+    if (HAL_ADC_ConfigChannel(&hadc1, &sConfig) != HAL_OK) return 0;
+    HAL_ADC_Start(&hadc1);
+    if (HAL_ADC_PollForConversion(&hadc1, 2) == HAL_OK) raw = HAL_ADC_GetValue(&hadc1);
+
+    sConfig.Channel = ADC_CHANNEL_13;
+    sConfig.SamplingTime = ADC_SAMPLETIME_92CYCLES_5;
+    HAL_ADC_ConfigChannel(&hadc1, &sConfig);
+    return raw ? __HAL_ADC_CALC_VREFANALOG_VOLTAGE(raw, ADC_RESOLUTION_12B) : 0;
 }
 
 static void UART1_Init(void)
@@ -0,0 +1,163 @@
+/******************************************************************************
+  * @file           : mem.c
+  * @brief          : Static memory: bump arenas and fixed-block object pools, no heap
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The firmware never uses the newlib heap: its time per call depends on
+ * the free-list history and a failed _sbrk shows up long after the fact.
+ * Every buffer is either a plain static, carved once from an arena at
+ * init, or a block from a pool of one fixed type. All of them are sized
+ * at compile time, so the link map is the memory budget, and the minute
+ * dump reports how full each region got.
+ *
+ * no_heap.h poisons malloc and friends in the sampling and detection
+ * sources, and makefile.targets fails the build if one of their objects
+ * still refers to a heap symbol.
+ *
+ * Portable: the only target-specific part is masking interrupts around
+ * the pool free list, so the host tests run it as is.
+ */
+#include "mem.h"
+#include "no_heap.h"
+
+static void *regions[MEM_MAX_REGIONS];
+static uint8_t region_is_pool[MEM_MAX_REGIONS];
+static int n_regions = 0;
+
+#if defined(__arm__)
+static uint32_t Lock(void)
+{
+    uint32_t primask;
+    __asm volatile("mrs %0, primask\n\tcpsid i" : "=r" (primask) :: "memory");
+    return primask;
+}
+
+static void Unlock(uint32_t primask)
+{
+    __asm volatile("msr primask, %0" :: "r" (primask) : "memory");
+}
+#else
+static uint32_t Lock(void) { return 0; }
+static void Unlock(uint32_t primask) { (void)primask; }
+#endif
+
+static void Register(void *region, uint8_t is_pool)
+{
+    for (int k = 0; k < n_regions; k++) {
+        if (regions[k] == region) return;
+    }
+    if (n_regions >= MEM_MAX_REGIONS) return;
+    regions[n_regions] = region;
+    region_is_pool[n_regions] = is_pool;
+    n_regions++;
+}
+
+// ======================= ARENA =========================
+
+void MemArena_Init(MemArena_t *a)
+{
+    a->used = 0;
+    a->peak = 0;
+    a->fails = 0;
+    Register(a, 0);
+}
+
+void *MemArena_Alloc(MemArena_t *a, uint32_t size)
+{
+    uint32_t need = MEM_ROUND(size);
+    if (need < size || need > a->size - a->used) {
+        a->fails++;
+        return NULL;
+    }
+    void *p = a->base + a->used;
+    a->used += need;
+    if (a->used > a->peak) a->peak = a->used;
+    return p;
+}
+
+uint32_t MemArena_Mark(const MemArena_t *a)
+{
+    return a->used;
+}
+
+void MemArena_Release(MemArena_t *a, uint32_t mark)
+{
+    if (mark < a->used) a->used = mark;
+}
+
+// ======================= POOL =========================
+
+void MemPool_Init(MemPool_t *p)
+{
+    p->free_list = NULL;
+    for (uint32_t k = p->count; k-- > 0; ) {
+        void **block = (void **)(p->blocks + k * p->block_size);
+        *block = p->free_list;
+        p->free_list = block;
+    }
+    p->in_use = 0;
+    p->peak = 0;
+    p->fails = 0;
+    Register(p, 1);
+}
+
+void *MemPool_Alloc(MemPool_t *p)
+{
+    uint32_t primask = Lock();
+    void **block = (void **)p->free_list;
+    if (!block) {
+        p->fails++;
+        Unlock(primask);
+        return NULL;
+    }
+    p->free_list = *block;
+    p->in_use++;
+    if (p->in_use > p->peak) p->peak = p->in_use;
+    Unlock(primask);
+    return block;
+}
+
+int MemPool_Free(MemPool_t *p, void *block)
+{
+    uint8_t *b = (uint8_t *)block;
+    if (!b || b < p->blocks || b >= p->blocks + p->count * p->block_size ||
+        (uint32_t)(b - p->blocks) % p->block_size != 0) {
+        return 0;
+    }
+
+    uint32_t primask = Lock();
+    *(void **)b = p->free_list;
+    p->free_list = b;
+    p->in_use--;
+    Unlock(primask);
+    return 1;
+}
+
+// ======================= REPORT =========================
+
+int Mem_GetStats(int n, MemStats_t *st)
+{
+    if (n < 0 || n >= n_regions) return 0;
+
+    if (region_is_pool[n]) {
+        const MemPool_t *p = regions[n];
+        st->name = p->name;
+        st->is_pool = 1;
+        st->size = p->count;
+        st->block_size = p->block_size;
+        st->used = p->in_use;
+        st->peak = p->peak;
+        st->fails = p->fails;
+    } else {
+        const MemArena_t *a = regions[n];
+        st->name = a->name;
+        st->is_pool = 0;
+        st->size = a->size;
+        st->block_size = 0;
+        st->used = a->used;
+        st->peak = a->peak;
+        st->fails = a->fails;
+    }
+    return 1;
+}
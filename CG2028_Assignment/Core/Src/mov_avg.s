@@ -12,7 +12,8 @@
  .bss
  .align 4
 
- .text
+ @ Runs from SRAM2 with the detection task (RAMFUNC in main.h)
+ .section .ramfunc,"ax",%progbits
  .align 2
 @ CG2028 Assignment, Sem 2, AY 2025/26
 @ (c) ECE NUS, 2025
@@ -0,0 +1,462 @@
+/******************************************************************************
+  * @file           : nfc_status.c
+  * @brief          : Tap-to-read status record and log mailbox on the ST25DV tag
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Keeps one NDEF Text record in the ST25DV user EEPROM, so any phone shows
+ * the device status on a tap without an app or a PC:
+ *
+ *   FALL MONITOR ARMED    VDD 3.30V
+ *   falls 001 manual 000 triggers 00042
+ *   updated 0002h17m after boot
+ *   *00007 FALL      0002h17m
+ *    00006 RECOVERED 0001h05m
+ *   ...
+ *
+ * Every field has a fixed width and history lines are ring slots (the
+ * newest one marked '*'), so an update changes a few bytes in place
+ * instead of shifting the text. The record is rebuilt in RAM and compared
+ * against a mirror of what the tag holds (read back at boot); only 4-byte
+ * EEPROM blocks that differ are written, in runs of up to NFC_WRITE_MAX.
+ *
+ * Bus sharing: the tag sits on I2C2 with the LSM6DSL. Its transfers are
+ * background-class jobs in the I2C2 scheduler (i2c_bus.c), so a queued IMU
+ * read always goes first; one already on the wire still has to finish, so
+ * NfcStatus_Poll() also gets the time left before the next IMU sample and
+ * only queues a transfer that ends inside it. One job is in flight at a
+ * time and its result is applied in On_Done(). The tag programs its EEPROM
+ * on its own after the transfer (5 ms per block); during that time it NACKs
+ * every access, so the module waits it out on the tick instead of polling
+ * the bus like the ST driver does.
+ *
+ * The fast-transfer mailbox serves on-demand dumps of the black-box log
+ * (protocol in nfc_status.h). It is checked every NFC_MB_POLL_MS; control
+ * read, request read, flash read and reply write each take their own pass.
+ */
+#include "main.h"
+#include "nfc_status.h"
+#include "i2c_bus.h"
+#include "blackbox.h"
+#include "qspi_flash.h"
+#include "../../Drivers/BSP/B-L4S5I-IOT01/stm32l4s5i_iot01_nfctag.h"
+#include "../../Drivers/BSP/Components/st25dv/st25dv_reg.h"
+
+#include "fmt.h"
+#include "string.h"
+
+#define NFC_INSTANCE            0
+#define NFC_SUPPLY_STEP_MV      50      /* supply change that is worth an EEPROM write */
+
+typedef struct {
+    uint32_t seq;               // 1-based event number, 0 = empty slot
+    uint32_t tick;
+    uint8_t  code;
+} NfcEvent_t;
+
+typedef enum {
+    MB_IDLE = 0,
+    MB_FETCH,                   // RF message waiting, length known
+    MB_SERVE,                   // request read, reply not built yet
+    MB_REPLY,                   // reply built, waiting for a slot
+    MB_CTRL                     // MB_CTRL_Dyn write (mb_ctrl) waiting for a slot
+} MbState_t;
+
+// What the job in flight was for
+typedef enum {
+    OP_NONE = 0,
+    OP_RECORD,
+    OP_MB_CHECK,
+    OP_MB_CTRL,
+    OP_MB_FETCH,
+    OP_MB_REPLY
+} NfcOp_t;
+
+static const char *const event_names[] = {
+    "?", "TRIGGER", "TIMEOUT", "SILENT", "FALL", "RECOVERED", "MANUAL", "RESET"
+};
+
+static int present = 0;
+
+// Status fields (written by the setters, read by Render)
+static int armed = 1;
+static int alarm_on = 0;
+static uint32_t supply_mv = 0;
+static uint32_t supply_shown_mv = 0;
+static uint32_t falls = 0, manual = 0, triggers = 0;
+static NfcEvent_t history[NFC_EVENTS_SHOWN];
+static uint32_t event_seq = 0;
+
+// Record image and what the tag currently holds
+static uint8_t image[NFC_AREA_SIZE];
+static uint8_t mirror[NFC_AREA_SIZE];
+static uint32_t image_len = 0;
+static int render_pending = 1;
+static uint32_t last_render = 0;
+static uint32_t busy_until = 0;     // tag programming its EEPROM until this tick
+
+// Job in flight
+static NfcOp_t op = OP_NONE;
+static uint32_t op_addr = 0, op_len = 0;
+
+// Mailbox
+static MbState_t mb_state = MB_IDLE;
+static uint32_t last_mb_poll = 0;
+static uint8_t mb_req[NFC_MB_REQ_MAX];
+static uint32_t mb_req_len = 0;
+static uint8_t mb_reply[10 + NFC_MB_CHUNK];
+static uint32_t mb_reply_len = 0;
+static uint8_t mb_ctrl[2];          // MB_CTRL_Dyn, MB_LEN_Dyn
+
+static NfcStatusStats_t stats;
+
+// ======================= RECORD =========================
+
+static uint32_t Cap(uint32_t v, uint32_t max) { return v > max ? max : v; }
+
+// Builds CC + NDEF TLV (one Text record) into image[]; RAM only
+static void Render(void)
+{
+    char text[NFC_AREA_SIZE];
+    uint32_t now = HAL_GetTick();
+    uint32_t up_min = now / 60000;
+    const char *st = !armed ? "DISARMED" : (alarm_on ? "ALARM" : "ARMED");
+    uint32_t n;
+    Fmt_t f;
+
+    Fmt_Init(&f, text, sizeof(text));
+    Fmt_Str(&f, "FALL MONITOR ");
+    Fmt_StrPad(&f, st, 8);
+    Fmt_Str(&f, " VDD ");
+    Fmt_Uint(&f, Cap(supply_mv / 1000, 9));
+    Fmt_Char(&f, '.');
+    Fmt_UintPad(&f, (supply_mv % 1000) / 10, 2, '0');
+    Fmt_Str(&f, "V\nfalls ");
+    Fmt_UintPad(&f, Cap(falls, 999), 3, '0');
+    Fmt_Str(&f, " manual ");
+    Fmt_UintPad(&f, Cap(manual, 999), 3, '0');
+    Fmt_Str(&f, " triggers ");
+    Fmt_UintPad(&f, Cap(triggers, 99999), 5, '0');
+    Fmt_Str(&f, "\nupdated ");
+    Fmt_UintPad(&f, (up_min / 60) % 10000, 4, '0');
+    Fmt_Char(&f, 'h');
+    Fmt_UintPad(&f, up_min % 60, 2, '0');
+    Fmt_Str(&f, "m after boot\n");
+    for (int k = 0; k < NFC_EVENTS_SHOWN; k++) {
+        const NfcEvent_t *e = &history[k];
+        if (e->seq == 0) {
+            Fmt_Str(&f, " ----- --------- ----h--m\n");
+        } else {
+            uint32_t m = e->tick / 60000;
+            Fmt_Char(&f, e->seq == event_seq ? '*' : ' ');
+            Fmt_UintPad(&f, e->seq % 100000, 5, '0');
+            Fmt_Char(&f, ' ');
+            Fmt_StrPad(&f, event_names[e->code], 9);
+            Fmt_Char(&f, ' ');
+            Fmt_UintPad(&f, (m / 60) % 10000, 4, '0');
+            Fmt_Char(&f, 'h');
+            Fmt_UintPad(&f, m % 60, 2, '0');
+            Fmt_Str(&f, "m\n");
+        }
+    }
+    n = Fmt_Len(&f);
+
+    uint8_t *p = image;
+    uint32_t payload = 3 + n;         // status byte + "en" + text
+    *p++ = 0xE1;                                // Type 5 capability container
+    *p++ = 0x40;                                // mapping 1.0, read/write
+    *p++ = NFC_AREA_SIZE / 8;
+    *p++ = 0x01;                                // multiple block read
+    *p++ = 0x03;                                // NDEF message TLV
+    *p++ = (uint8_t)(4 + payload);
+    *p++ = 0xD1;                                // MB | ME | SR, well-known type
+    *p++ = 0x01;
+    *p++ = (uint8_t)payload;
+    *p++ = 'T';
+    *p++ = 0x02;                                // UTF-8, 2-byte language code
+    *p++ = 'e';
+    *p++ = 'n';
+    memcpy(p, text, n);
+    p += n;
+    *p++ = 0xFE;                                // terminator TLV
+    image_len = (uint32_t)(p - image);
+    memset(p, 0, NFC_AREA_SIZE - image_len);
+
+    for (uint32_t k = 0; k < image_len; k++) {
+        if (image[k] == mirror[k]) stats.bytes_clean++;
+    }
+    supply_shown_mv = supply_mv;
+    render_pending = 0;
+    last_render = now;
+    stats.renders++;
+}
+
+// First run of 4-byte blocks that differ from the tag, at most NFC_WRITE_MAX bytes
+static int Next_Dirty(uint32_t *addr, uint32_t *len)
+{
+    uint32_t end = (image_len + 3) & ~3u;
+    for (uint32_t a = 0; a < end; a += 4) {
+        if (memcmp(image + a, mirror + a, 4) == 0) continue;
+        uint32_t b = a + 4;
+        while (b < end && b - a < NFC_WRITE_MAX && memcmp(image + b, mirror + b, 4) != 0) b += 4;
+        *addr = a;
+        *len = b - a;
+        return 1;
+    }
+    return 0;
+}
+
+// ======================= BUS SLOTS =========================
+
+// Device address + 16-bit register address + data, plus 1 ms of tick granularity
+static int Fits(uint32_t slot_ms, uint32_t bytes)
+{
+    return (bytes + 3) * I2cBus_ByteUs() + 1000 <= slot_ms * 1000;
+}
+
+static void On_Done(I2cResult_t res, void *ctx);
+
+// Queues one background job on the data address; 1 if it was accepted
+static int Start(NfcOp_t what, int write, uint16_t reg, uint8_t *data, uint16_t len)
+{
+    I2cJob_t job = {0};
+    job.addr = ST25DV_ADDR_DATA_I2C;
+    job.write = (uint8_t)write;
+    job.reg_size = 2;
+    job.reg = reg;
+    job.data = data;
+    job.len = len;
+    job.done = On_Done;
+
+    op = what;
+    if (!I2cBus_Submit(&job)) {
+        op = OP_NONE;
+        return 0;
+    }
+    return 1;
+}
+
+// ======================= MAILBOX =========================
+
+static void Put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+// Builds the reply; 0 = flash busy, try again on a later pass
+static int Mb_Serve(void)
+{
+    uint8_t cmd = mb_req_len ? mb_req[0] : 0;
+
+    if (cmd == NFC_MB_INFO) {
+        BlackBoxStats_t bb;
+        BlackBox_GetStats(&bb);
+        mb_reply[0] = NFC_MB_INFO;
+        Put32(mb_reply + 1, bb.head_addr);
+        Put32(mb_reply + 5, bb.next_rec_seq);
+        Put32(mb_reply + 9, bb.sector_seq);
+        mb_reply_len = 13;
+        return 1;
+    }
+    if (cmd == NFC_MB_READ && mb_req_len >= 6) {
+        uint32_t addr = mb_req[1] | (mb_req[2] << 8) | ((uint32_t)mb_req[3] << 16) | ((uint32_t)mb_req[4] << 24);
+        uint32_t len = mb_req[5];
+        if (len > NFC_MB_CHUNK) len = NFC_MB_CHUNK;
+        if (len > 0 && addr < QSPI_FLASH_SIZE) {
+            if (addr + len > QSPI_FLASH_SIZE) len = QSPI_FLASH_SIZE - addr;
+            if (!QspiFlash_Read(addr, mb_reply + 6, len)) return 0;
+            mb_reply[0] = NFC_MB_READ;
+            Put32(mb_reply + 1, addr);
+            mb_reply[5] = (uint8_t)len;
+            mb_reply_len = 6 + len;
+            stats.mb_bytes += len;
+            return 1;
+        }
+    }
+    mb_reply[0] = NFC_MB_ERROR;
+    mb_reply[1] = cmd;
+    mb_reply_len = 2;
+    return 1;
+}
+
+// MB_CTRL_Dyn / MB_LEN_Dyn read back: decide what the mailbox needs next
+static void Mb_Check(void)
+{
+    if (!(mb_ctrl[0] & ST25DV_MB_CTRL_DYN_MBEN_MASK)) {
+        // Mailbox switched off (RF side, or a foreign message dropped below); turn it back on
+        mb_ctrl[0] = ST25DV_MB_CTRL_DYN_MBEN_MASK;
+        mb_state = MB_CTRL;
+    } else if (mb_ctrl[0] & ST25DV_MB_CTRL_DYN_RFPUTMSG_MASK) {
+        mb_req_len = (uint32_t)mb_ctrl[1] + 1;
+        if (mb_req_len <= NFC_MB_REQ_MAX) {
+            mb_state = MB_FETCH;
+        } else {
+            // Not one of ours: disabling the mailbox drops the message, the next check re-enables it
+            mb_ctrl[0] = 0;
+            mb_state = MB_CTRL;
+        }
+    }
+}
+
+// One mailbox step per call; returns 1 if it used (or was refused) the slot
+static int Mb_Step(uint32_t slot_ms)
+{
+    switch (mb_state) {
+    case MB_FETCH:
+        if (Fits(slot_ms, mb_req_len)) Start(OP_MB_FETCH, 0, ST25DV_MAILBOX_RAM_REG, mb_req, (uint16_t)mb_req_len);
+        return 1;
+
+    case MB_SERVE:
+        if (Mb_Serve()) mb_state = MB_REPLY;
+        return 1;
+
+    case MB_REPLY:
+        if (Fits(slot_ms, mb_reply_len)) Start(OP_MB_REPLY, 1, ST25DV_MAILBOX_RAM_REG, mb_reply, (uint16_t)mb_reply_len);
+        return 1;
+
+    case MB_CTRL:
+        if (Fits(slot_ms, 1)) Start(OP_MB_CTRL, 1, ST25DV_MB_CTRL_DYN_REG, mb_ctrl, 1);
+        return 1;
+
+    case MB_IDLE:
+    default:
+        break;
+    }
+
+    uint32_t now = HAL_GetTick();
+    if (now - last_mb_poll < NFC_MB_POLL_MS || !Fits(slot_ms, 2)) return 0;
+    last_mb_poll = now;
+    Start(OP_MB_CHECK, 0, ST25DV_MB_CTRL_DYN_REG, mb_ctrl, 2);
+    return 1;
+}
+
+// Result of the job in flight (from I2cBus_Poll); failures retry on a later pass
+static void On_Done(I2cResult_t res, void *ctx)
+{
+    NfcOp_t what = op;
+    op = OP_NONE;
+
+    if (res == I2C_NACK) stats.nacks++;
+    else if (res != I2C_OK) stats.errors++;
+    if (res != I2C_OK) return;
+
+    switch (what) {
+    case OP_RECORD:
+        memcpy(mirror + op_addr, image + op_addr, op_len);
+        busy_until = HAL_GetTick() + (op_len / 4) * NFC_BLOCK_WRITE_MS + 1;
+        stats.writes++;
+        stats.bytes_written += op_len;
+        break;
+    case OP_MB_CHECK:
+        Mb_Check();
+        break;
+    case OP_MB_CTRL:
+    case OP_MB_REPLY:
+        mb_state = MB_IDLE;
+        break;
+    case OP_MB_FETCH:
+        mb_state = MB_SERVE;
+        stats.mb_requests++;
+        break;
+    default:
+        break;
+    }
+}
+
+// ======================= PUBLIC API =========================
+
+int NfcStatus_Init(void)
+{
+    memset(&stats, 0, sizeof(stats));
+    memset(history, 0, sizeof(history));
+    present = 0;
+
+    if (BSP_NFCTAG_Init(NFC_INSTANCE) != NFCTAG_OK) return 0;
+
+    // Boot only: the static MB_MODE register needs the I2C security session
+    // (factory password) and a blocking EEPROM write, once per tag
+    ST25DV_EN_STATUS mb_mode = ST25DV_DISABLE;
+    if (BSP_NFCTAG_ReadMBMode(NFC_INSTANCE, &mb_mode) == NFCTAG_OK && mb_mode != ST25DV_ENABLE) {
+        ST25DV_PASSWD pwd = { 0, 0 };
+        BSP_NFCTAG_PresentI2CPassword(NFC_INSTANCE, pwd);
+        BSP_NFCTAG_WriteMBMode(NFC_INSTANCE, ST25DV_ENABLE);
+    }
+    BSP_NFCTAG_SetMBEN_Dyn(NFC_INSTANCE);
+
+    // Start from what the tag already holds, so a reboot rewrites only what changed
+    if (BSP_NFCTAG_ReadData(NFC_INSTANCE, mirror, 0, NFC_AREA_SIZE) != NFCTAG_OK) return 0;
+
+    render_pending = 1;
+    mb_state = MB_IDLE;
+    op = OP_NONE;
+    present = 1;
+    return 1;
+}
+
+void NfcStatus_Poll(uint32_t slot_ms)
+{
+    if (!present || op != OP_NONE) return;
+
+    uint32_t now = HAL_GetTick();
+    if ((int32_t)(now - busy_until) < 0) return;        // tag still programming, it would NACK
+
+    if (render_pending || now - last_render >= NFC_REFRESH_MS) Render();
+
+    // A phone holding the tag goes first
+    if (Mb_Step(slot_ms)) return;
+
+    uint32_t addr, len;
+    if (!Next_Dirty(&addr, &len) || !Fits(slot_ms, len)) return;
+    op_addr = addr;
+    op_len = len;
+    Start(OP_RECORD, 1, (uint16_t)addr, image + addr, (uint16_t)len);
+}
+
+void NfcStatus_SetArmed(int on)
+{
+    if (armed == !!on && !alarm_on) return;
+    armed = !!on;
+    alarm_on = 0;
+    render_pending = 1;
+}
+
+void NfcStatus_SetSupply(uint32_t mv)
+{
+    supply_mv = mv;
+    uint32_t diff = mv > supply_shown_mv ? mv - supply_shown_mv : supply_shown_mv - mv;
+    if (diff >= NFC_SUPPLY_STEP_MV) render_pending = 1;
+}
+
+void NfcStatus_LogEvent(uint8_t code)
+{
+    switch (code) {
+    case BB_EVT_TRIGGER:    triggers++; return;       // shown on the next write, not worth one
+    case BB_EVT_TIMEOUT:    return;
+    case BB_EVT_CONFIRMED:  falls++;  alarm_on = 1; break;
+    case BB_EVT_MANUAL:     manual++; alarm_on = 1; break;
+    case BB_EVT_RESET:      alarm_on = 0; break;
+    case BB_EVT_SILENT_FALL:
+    case BB_EVT_RECOVERED:  break;
+    default:                return;
+    }
+
+    event_seq++;
+    NfcEvent_t *e = &history[(event_seq - 1) % NFC_EVENTS_SHOWN];
+    e->seq = event_seq;
+    e->tick = HAL_GetTick();
+    e->code = code;
+    render_pending = 1;
+}
+
+int NfcStatus_IsPresent(void)
+{
+    return present;
+}
+
+void NfcStatus_GetStats(NfcStatusStats_t *st)
+{
+    *st = stats;
+}
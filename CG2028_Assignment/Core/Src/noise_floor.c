@@ -0,0 +1,155 @@
+/******************************************************************************
+  * @file           : noise_floor.c
+  * @brief          : Adaptive background-noise (sound floor) estimator
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Replaces the old "max of the last three 500 ms peaks + 600" baseline.
+ * Every envelope sample goes into a 1 dB log-histogram. Newer samples get
+ * a geometrically growing weight, so old data fades out exponentially with
+ * no per-sample sweep over the bins. Quantiles are read off the histogram.
+ * The noise floor is the median (P50) background level, and the loud-noise
+ * threshold is a configurable number of dB above it. It scales with the
+ * room instead of being +600 LSB everywhere, and one noisy half second
+ * moves the median by a fraction of a dB where it used to raise the
+ * baseline for 1.5 s.
+ *
+ * Update is O(1): one log2, one bin increment, one weight bump, and the
+ * P50 marker moves by at most a bin or two. A full walk over the bins only
+ * happens for on-demand quantiles and the rare weight rescale.
+ */
+#include "noise_floor.h"
+#include "no_heap.h"
+
+#define WEIGHT_START     (1UL << 8)
+#define WEIGHT_RESCALE   (1UL << 20)
+#define RESCALE_SHIFT    12
+
+// NOISE_FLOOR_QUANTILE as a Q16 fraction: the per-sample target is one UMULL, no divide
+#define FLOOR_FRAC_Q16   ((NOISE_FLOOR_QUANTILE * 65536UL) / 100)
+
+static uint32_t hist[NOISE_BINS];
+static uint32_t total = 0;
+static uint32_t weight = WEIGHT_START;
+
+// Running marker for the floor quantile: floor_below = sum of hist[0 .. floor_bin-1]
+static int floor_bin = 0;
+static uint32_t floor_below = 0;
+static int32_t floor_db_q8 = 0;
+static int32_t threshold_db_q8 = NOISE_MIN_THRESHOLD_DB * 256;
+static int32_t margin_db_q8 = NOISE_LOUD_MARGIN_DB * 256;
+
+void NoiseFloor_Init(void)
+{
+    for (int b = 0; b < NOISE_BINS; b++) hist[b] = 0;
+    total = 0;
+    weight = WEIGHT_START;
+    floor_bin = 0;
+    floor_below = 0;
+    floor_db_q8 = 0;
+    threshold_db_q8 = NOISE_MIN_THRESHOLD_DB * 256;
+}
+
+/*
+ * 20*log10(v) in Q8 dB = 6.0206 * log2(v).
+ * log2 from the MSB position plus log2(1+f) ~= f + 0.3431*f*(1-f) for the mantissa.
+ */
+int32_t NoiseFloor_ToDb(uint32_t envelope)
+{
+    if (envelope <= 1) return 0;
+
+    int msb = 31 - __builtin_clz(envelope);
+    uint32_t f = (msb >= 16) ? (envelope >> (msb - 16)) & 0xFFFF
+                             : (envelope << (16 - msb)) & 0xFFFF;   // Q16 fraction
+    uint32_t corr = (uint32_t)(((uint64_t)f * (65536 - f) >> 16) * 22486 >> 16);   // 0.3431 in Q16
+    uint32_t log2_q16 = ((uint32_t)msb << 16) + f + corr;
+
+    return (int32_t)(((uint64_t)log2_q16 * 1541) >> 16);      // 6.0206 dB in Q8 = 1541
+}
+
+static void Rescale(void)
+{
+    total = 0;
+    floor_below = 0;
+    for (int b = 0; b < NOISE_BINS; b++) {
+        hist[b] >>= RESCALE_SHIFT;
+        total += hist[b];
+        if (b < floor_bin) floor_below += hist[b];
+    }
+    weight >>= RESCALE_SHIFT;
+}
+
+int32_t NoiseFloor_GetQuantileDb(uint32_t percent)
+{
+    if (total == 0) return 0;
+
+    uint64_t target = (uint64_t)total * percent / 100;
+    uint64_t cum = 0;
+    for (int b = 0; b < NOISE_BINS; b++) {
+        if (hist[b] == 0) continue;
+        if (cum + hist[b] >= target) {
+            // Linear interpolation inside the 1 dB bin
+            uint32_t frac = (uint32_t)(((target - cum) << 8) / hist[b]);
+            return (b << 8) + (int32_t)frac;
+        }
+        cum += hist[b];
+    }
+    return (NOISE_BINS - 1) << 8;
+}
+
+void NoiseFloor_Update(uint32_t envelope)
+{
+    int bin = NoiseFloor_ToDb(envelope) >> 8;
+    if (bin >= NOISE_BINS) bin = NOISE_BINS - 1;
+
+    hist[bin] += weight;
+    total += weight;
+    floor_below += weight & -(uint32_t)(bin < floor_bin);   // a coin flip at the median: no branch
+    weight += (weight >> NOISE_DECAY_SHIFT) + 1;
+    if (weight >= WEIGHT_RESCALE) Rescale();
+
+    // Slide the floor-quantile marker; normally zero or one step per sample
+    uint32_t target = (uint32_t)(((uint64_t)total * FLOOR_FRAC_Q16) >> 16);
+    while (floor_bin > 0 && floor_below > target) {
+        floor_bin--;
+        floor_below -= hist[floor_bin];
+    }
+    while (floor_bin < NOISE_BINS - 1 && floor_below + hist[floor_bin] < target) {
+        floor_below += hist[floor_bin];
+        floor_bin++;
+    }
+
+    // Linear interpolation inside the 1 dB bin, as NoiseFloor_GetQuantileDb(). The
+    // remainder is at most hist[floor_bin], so one 32-bit UDIV does it on the M4
+    // where a 64-bit divide is a library call.
+    uint32_t h = hist[floor_bin], rem = target - floor_below;
+    floor_db_q8 = floor_bin << 8;
+    if (h >= (1UL << 24)) floor_db_q8 += (int32_t)(rem / (h >> 8));
+    else if (h != 0)      floor_db_q8 += (int32_t)((rem << 8) / h);
+
+    // Tracks from the first sample: the median of a few is already the room, and
+    // holding the bare minimum instead called a whole noisy room loud at boot
+    int32_t t = floor_db_q8 + margin_db_q8;
+    if (t < NOISE_MIN_THRESHOLD_DB * 256) t = NOISE_MIN_THRESHOLD_DB * 256;
+    threshold_db_q8 = t;
+}
+
+int NoiseFloor_IsLoud(uint32_t envelope)
+{
+    return NoiseFloor_ToDb(envelope) > threshold_db_q8;
+}
+
+void NoiseFloor_SetMarginDb(int32_t margin_db)
+{
+    margin_db_q8 = margin_db * 256;
+}
+
+int32_t NoiseFloor_GetFloorDb(void)
+{
+    return floor_db_q8;
+}
+
+int32_t NoiseFloor_GetThresholdDb(void)
+{
+    return threshold_db_q8;
+}
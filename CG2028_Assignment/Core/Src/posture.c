@@ -0,0 +1,160 @@
+/******************************************************************************
+  * @file           : posture.c
+  * @brief          : Gravity-vector posture / tilt estimation (fixed point)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The total_accel magnitude used by the FSM throws away orientation, so a
+ * person lying flat and a person standing still both read ~9.8 m/s^2.
+ * This module low-passes each accel axis to track the gravity vector and
+ * turns it into tilt angles using integer-only atan2/asin (no libm).
+ *
+ * Cost per sample is three shift/add updates. The angle maths only runs
+ * when the FSM asks for it.
+ */
+#include "posture.h"
+#include "no_heap.h"
+
+static int32_t grav_q4[3];      // gravity estimate, mg << 4
+static int32_t ref_mg[3];       // gravity latched before the fall, mg
+static int primed = 0;
+static int ref_valid = 0;
+
+void Posture_Init(void)
+{
+    for (int k = 0; k < 3; k++) {
+        grav_q4[k] = 0;
+        ref_mg[k] = 0;
+    }
+    primed = 0;
+    ref_valid = 0;
+}
+
+void Posture_Update(const int16_t accel_mg[3])
+{
+    if (!primed) {
+        for (int k = 0; k < 3; k++) grav_q4[k] = (int32_t)accel_mg[k] * 16;
+        primed = 1;
+        return;
+    }
+    for (int k = 0; k < 3; k++) {
+        grav_q4[k] += ((int32_t)accel_mg[k] * 16 - grav_q4[k]) >> POSTURE_LPF_SHIFT;
+    }
+}
+
+void Posture_CaptureReference(void)
+{
+    for (int k = 0; k < 3; k++) ref_mg[k] = grav_q4[k] >> 4;
+    ref_valid = 1;
+}
+
+// ======================= FIXED-POINT MATHS =========================
+
+uint32_t Posture_Isqrt(uint64_t v)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+
+    while (bit > v) bit >>= 2;
+    while (bit != 0) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+/*
+ * atan(z) for z in [0,1] (Q15), result in deci-degrees.
+ * atan(z) ~= pi/4*z - z*(z-1)*(0.2447 + 0.0663*z)   (max err ~0.09 deg)
+ * Constants rescaled to deci-degrees: 450, 140.2 (Q8 = 35891), 38.0 (Q8 = 9728).
+ */
+static int32_t atan_unit(int32_t z)
+{
+    int32_t c = 35891 + ((9728 * z) >> 15);        // Q8
+    int32_t p = (z * (z - 32768)) >> 15;            // Q15, <= 0
+    int32_t r = 450 * z - ((p * c) >> 8);           // Q15 deci-degrees
+    return (r + 16384) >> 15;
+}
+
+int32_t Posture_Atan2(int32_t y, int32_t x)
+{
+    // Magnitudes negated as unsigned: |INT32_MIN| = 2^31 has no int32_t
+    uint32_t ax = (x < 0) ? 0U - (uint32_t)x : (uint32_t)x;
+    uint32_t ay = (y < 0) ? 0U - (uint32_t)y : (uint32_t)y;
+    int32_t a;
+
+    if (ax == 0 && ay == 0) return 0;
+
+    if (ay <= ax) a = atan_unit((int32_t)(((uint64_t)ay << 15) / ax));
+    else          a = 900 - atan_unit((int32_t)(((uint64_t)ax << 15) / ay));
+
+    if (x < 0) a = 1800 - a;
+    if (y < 0) a = -a;
+    return a;
+}
+
+// asin(num/den) for |num| <= den, via atan2(num, sqrt(den^2 - num^2))
+int32_t Posture_Asin(int32_t num, int32_t den)
+{
+    if (den <= 0) return 0;
+    if (num >= den) return 900;
+    if (num <= -den) return -900;
+
+    // Scale den up to 2^29..2^30 so the root keeps ~30 bits even with num close to den
+    int shift = __builtin_clz((uint32_t)den) - 2;
+    int64_t n = num, d = den;
+    if (shift > 0) { n *= (int64_t)1 << shift; d <<= shift; }     // n may be negative: no <<
+
+    uint64_t rem = (uint64_t)(d * d - n * n);
+    return Posture_Atan2((int32_t)n, (int32_t)Posture_Isqrt(rem));
+}
+
+// ======================= POSTURE ANGLES =========================
+
+/*
+ * Forward/back tilt: asin(-gx / |g|), taken as atan2(-gx, |(gy, gz)|) so a
+ * truncated |g| cannot throw it off near +-90 deg. Both sides get 8 more
+ * bits before the root.
+ */
+int32_t Posture_GetPitch(void)
+{
+    int64_t gy = grav_q4[1], gz = grav_q4[2];
+    uint32_t side = Posture_Isqrt((uint64_t)(gy * gy + gz * gz) << 16);
+    return Posture_Atan2(-grav_q4[0] * 256, (int32_t)side);
+}
+
+// Sideways tilt: atan2(gy, gz)
+int32_t Posture_GetRoll(void)
+{
+    return Posture_Atan2(grav_q4[1], grav_q4[2]);
+}
+
+/*
+ * Angle between the pre-fall gravity vector and the current one:
+ * atan2(|ref x g|, ref . g). 0 = same posture, 900 = rotated onto side/back.
+ */
+int32_t Posture_GetDelta(void)
+{
+    if (!ref_valid) return 0;
+
+    int32_t gx = grav_q4[0] >> 4, gy = grav_q4[1] >> 4, gz = grav_q4[2] >> 4;
+
+    int64_t cx = (int64_t)ref_mg[1] * gz - (int64_t)ref_mg[2] * gy;
+    int64_t cy = (int64_t)ref_mg[2] * gx - (int64_t)ref_mg[0] * gz;
+    int64_t cz = (int64_t)ref_mg[0] * gy - (int64_t)ref_mg[1] * gx;
+    int64_t dot = (int64_t)ref_mg[0] * gx + (int64_t)ref_mg[1] * gy + (int64_t)ref_mg[2] * gz;
+
+    uint32_t cross = Posture_Isqrt((uint64_t)(cx * cx + cy * cy + cz * cz));
+
+    // Bring both operands into int32 range with the same scale
+    while (cross > 0x3FFFFFFF || dot > 0x3FFFFFFF || dot < -0x3FFFFFFF) {
+        cross >>= 1;
+        dot /= 2;
+    }
+    return Posture_Atan2((int32_t)cross, (int32_t)dot);
+}
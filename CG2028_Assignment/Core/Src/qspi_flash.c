@@ -0,0 +1,421 @@
+/******************************************************************************
+  * @file           : qspi_flash.c
+  * @brief          : MX25R6435F quad-SPI NOR driver (OCTOSPI1, interrupt driven)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The L4S5 has no QUADSPI block; the MX25R6435F sits on OCTOSPI1 (port 1,
+ * PE10..PE15), which we drive in 4-line mode through HAL_OSPI.
+ *
+ * Init and reads are blocking and only used at boot. Program and erase
+ * never wait: the command phase is issued, the data phase runs under the
+ * OCTOSPI interrupt, and the busy wait on the WIP bit is done by the
+ * peripheral's auto-polling mode, which raises an interrupt on match.
+ * The caller just checks QspiFlash_IsBusy() from the main loop.
+ *
+ * Reads go through memory-mapped mode: the chip is left in quad I/O read
+ * (0xEB) and its contents appear at 0x90000000, so log readers and lookup
+ * tables can use plain pointers. Arbitration: QspiFlash_MapAcquire()
+ * hands out a pointer and holds a lease until QspiFlash_MapRelease().
+ * Program/erase refuse to start while a lease is held (the caller retries
+ * on its next poll); otherwise they abort mapped mode, run in indirect
+ * mode, and the next acquire maps the chip again.
+ */
+#include "main.h"
+#include "qspi_flash.h"
+#include "../../Drivers/BSP/Components/mx25r6435f/mx25r6435f.h"
+
+#include "string.h"
+
+OSPI_HandleTypeDef hospi1;
+
+static volatile QspiState_t state = QSPI_IDLE;
+static int mapped = 0;
+static uint32_t map_users = 0;
+
+// Throughput accounting (DWT cycles from command to WIP clear)
+static QspiStats_t stats;
+static uint32_t op_start = 0;
+static uint32_t op_bytes = 0;
+
+// ======================= COMMAND HELPERS =========================
+
+static void Cmd_Base(OSPI_RegularCmdTypeDef *cmd, uint32_t instruction)
+{
+    cmd->OperationType      = HAL_OSPI_OPTYPE_COMMON_CFG;
+    cmd->FlashId            = HAL_OSPI_FLASH_ID_1;
+    cmd->Instruction        = instruction;
+    cmd->InstructionMode    = HAL_OSPI_INSTRUCTION_1_LINE;
+    cmd->InstructionSize    = HAL_OSPI_INSTRUCTION_8_BITS;
+    cmd->InstructionDtrMode = HAL_OSPI_INSTRUCTION_DTR_DISABLE;
+    cmd->Address            = 0;
+    cmd->AddressMode        = HAL_OSPI_ADDRESS_NONE;
+    cmd->AddressSize        = HAL_OSPI_ADDRESS_24_BITS;
+    cmd->AddressDtrMode     = HAL_OSPI_ADDRESS_DTR_DISABLE;
+    cmd->AlternateBytes     = 0;
+    cmd->AlternateBytesMode = HAL_OSPI_ALTERNATE_BYTES_NONE;
+    cmd->AlternateBytesSize = HAL_OSPI_ALTERNATE_BYTES_8_BITS;
+    cmd->AlternateBytesDtrMode = HAL_OSPI_ALTERNATE_BYTES_DTR_DISABLE;
+    cmd->DataMode           = HAL_OSPI_DATA_NONE;
+    cmd->NbData             = 0;
+    cmd->DataDtrMode        = HAL_OSPI_DATA_DTR_DISABLE;
+    cmd->DummyCycles        = 0;
+    cmd->DQSMode            = HAL_OSPI_DQS_DISABLE;
+    cmd->SIOOMode           = HAL_OSPI_SIOO_INST_EVERY_CMD;
+}
+
+// Instruction-only commands finish in a few SPI clocks
+static int Send_Instruction(uint32_t instruction)
+{
+    OSPI_RegularCmdTypeDef cmd;
+    Cmd_Base(&cmd, instruction);
+    return HAL_OSPI_Command(&hospi1, &cmd, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) == HAL_OK;
+}
+
+static int Read_Status(uint8_t *sr)
+{
+    OSPI_RegularCmdTypeDef cmd;
+    Cmd_Base(&cmd, READ_STATUS_REG_CMD);
+    cmd.DataMode = HAL_OSPI_DATA_1_LINE;
+    cmd.NbData = 1;
+    if (HAL_OSPI_Command(&hospi1, &cmd, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) return 0;
+    return HAL_OSPI_Receive(&hospi1, sr, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) == HAL_OK;
+}
+
+// Poll SR until (SR & mask) == match; blocking variant is boot-only
+static int Wait_Status(uint8_t mask, uint8_t match, int blocking)
+{
+    OSPI_RegularCmdTypeDef cmd;
+    Cmd_Base(&cmd, READ_STATUS_REG_CMD);
+    cmd.DataMode = HAL_OSPI_DATA_1_LINE;
+    cmd.NbData = 1;
+    if (HAL_OSPI_Command(&hospi1, &cmd, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) return 0;
+
+    OSPI_AutoPollingTypeDef poll = {0};
+    poll.Match = match;
+    poll.Mask = mask;
+    poll.MatchMode = HAL_OSPI_MATCH_MODE_AND;
+    poll.AutomaticStop = HAL_OSPI_AUTOMATIC_STOP_ENABLE;
+    poll.Interval = 0x10;
+
+    if (blocking) return HAL_OSPI_AutoPolling(&hospi1, &poll, MX25R6435F_SECTOR_ERASE_MAX_TIME) == HAL_OK;
+    return HAL_OSPI_AutoPolling_IT(&hospi1, &poll) == HAL_OK;
+}
+
+static int Write_Enable(void)
+{
+    if (!Send_Instruction(WRITE_ENABLE_CMD)) return 0;
+    return Wait_Status(MX25R6435F_SR_WEL, MX25R6435F_SR_WEL, 1);
+}
+
+// ======================= MEMORY-MAPPED MODE =========================
+
+// Quad I/O read (0xEB): address, mode byte and data on 4 lines
+static int Enter_Mapped(void)
+{
+    OSPI_RegularCmdTypeDef cmd;
+    Cmd_Base(&cmd, QUAD_INOUT_READ_CMD);
+    cmd.OperationType = HAL_OSPI_OPTYPE_READ_CFG;
+    cmd.AddressMode = HAL_OSPI_ADDRESS_4_LINES;
+    cmd.AlternateBytes = MX25R6435F_ALT_BYTES_NO_PE_MODE;
+    cmd.AlternateBytesMode = HAL_OSPI_ALTERNATE_BYTES_4_LINES;
+    cmd.DataMode = HAL_OSPI_DATA_4_LINES;
+    cmd.DummyCycles = MX25R6435F_DUMMY_CYCLES_READ_QUAD;
+    if (HAL_OSPI_Command(&hospi1, &cmd, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) return 0;
+
+    // HAL needs a write config too; the MPU keeps the window read-only anyway
+    Cmd_Base(&cmd, QUAD_PAGE_PROG_CMD);
+    cmd.OperationType = HAL_OSPI_OPTYPE_WRITE_CFG;
+    cmd.AddressMode = HAL_OSPI_ADDRESS_4_LINES;
+    cmd.DataMode = HAL_OSPI_DATA_4_LINES;
+    if (HAL_OSPI_Command(&hospi1, &cmd, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) return 0;
+
+    // Release nCS after a short idle so the MX25R can drop to standby current
+    OSPI_MemoryMappedTypeDef mm;
+    mm.TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_ENABLE;
+    mm.TimeOutPeriod = 0x20;
+    if (HAL_OSPI_MemoryMapped(&hospi1, &mm) != HAL_OK) return 0;
+
+    mapped = 1;
+    stats.to_mapped++;
+    return 1;
+}
+
+static int Exit_Mapped(void)
+{
+    if (!mapped) return 1;
+    if (HAL_OSPI_Abort(&hospi1) != HAL_OK) return 0;
+    mapped = 0;
+    stats.to_indirect++;
+    return 1;
+}
+
+/*
+ * Pointer to flash byte addr inside the 0x90000000 window, or NULL while a
+ * program/erase is running. Valid until the matching QspiFlash_MapRelease().
+ */
+const uint8_t *QspiFlash_MapAcquire(uint32_t addr)
+{
+    if (state != QSPI_IDLE || addr >= QSPI_FLASH_SIZE) return NULL;
+    if (!mapped && !Enter_Mapped()) {
+        state = QSPI_ERROR;
+        return NULL;
+    }
+    map_users++;
+    stats.map_acquires++;
+    return (const uint8_t *)OCTOSPI1_BASE + addr;
+}
+
+void QspiFlash_MapRelease(void)
+{
+    if (map_users > 0) map_users--;
+}
+
+// Program/erase need indirect mode; refuse while a reader holds a pointer
+static int Claim_Indirect(void)
+{
+    if (state != QSPI_IDLE) return 0;
+    if (map_users > 0) {
+        stats.deferred++;
+        return 0;
+    }
+    if (!Exit_Mapped()) {
+        state = QSPI_ERROR;
+        return 0;
+    }
+    return 1;
+}
+
+// ======================= BRING-UP =========================
+
+static void OSPI_MspInit(void)
+{
+    __HAL_RCC_OSPIM_CLK_ENABLE();
+    __HAL_RCC_OSPI1_CLK_ENABLE();
+    __HAL_RCC_GPIOE_CLK_ENABLE();
+
+    __HAL_RCC_OSPI1_FORCE_RESET();
+    __HAL_RCC_OSPI1_RELEASE_RESET();
+
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    GPIO_InitStruct.Pin = GPIO_PIN_10 | GPIO_PIN_11 | GPIO_PIN_12 | GPIO_PIN_13 | GPIO_PIN_14 | GPIO_PIN_15;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    GPIO_InitStruct.Alternate = GPIO_AF10_OCTOSPIM_P1;
+    HAL_GPIO_Init(GPIOE, &GPIO_InitStruct);
+
+    HAL_NVIC_SetPriority(OCTOSPI1_IRQn, 14, 0);
+    HAL_NVIC_EnableIRQ(OCTOSPI1_IRQn);
+
+    // The default memory map makes 0x90000000 Device memory (no unaligned
+    // reads). Make the 8 MB window Normal, non-cacheable, read-only, no execute.
+    MPU_Region_InitTypeDef region = {0};
+    HAL_MPU_Disable();
+    region.Enable = MPU_REGION_ENABLE;
+    region.Number = MPU_REGION_NUMBER0;
+    region.BaseAddress = OCTOSPI1_BASE;
+    region.Size = MPU_REGION_SIZE_8MB;
+    region.SubRegionDisable = 0x00;
+    region.TypeExtField = MPU_TEX_LEVEL1;
+    region.AccessPermission = MPU_REGION_PRIV_RO_URO;
+    region.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+    region.IsShareable = MPU_ACCESS_NOT_SHAREABLE;
+    region.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+    region.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+    HAL_MPU_ConfigRegion(&region);
+    HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+int QspiFlash_Init(void)
+{
+    OSPI_MspInit();
+
+    hospi1.Instance = OCTOSPI1;
+    hospi1.Init.FifoThreshold = 4;
+    hospi1.Init.DualQuad = HAL_OSPI_DUALQUAD_DISABLE;
+    hospi1.Init.MemoryType = HAL_OSPI_MEMTYPE_MACRONIX;
+    hospi1.Init.DeviceSize = 23;                    // 2^23 = 8 MB
+    hospi1.Init.ChipSelectHighTime = 1;
+    hospi1.Init.FreeRunningClock = HAL_OSPI_FREERUNCLK_DISABLE;
+    hospi1.Init.ClockMode = HAL_OSPI_CLOCK_MODE_0;
+    hospi1.Init.ClockPrescaler = 1;                 // SYSCLK / 1
+    hospi1.Init.SampleShifting = HAL_OSPI_SAMPLE_SHIFTING_NONE;
+    hospi1.Init.DelayHoldQuarterCycle = HAL_OSPI_DHQC_DISABLE;
+    hospi1.Init.ChipSelectBoundary = 0;
+    hospi1.Init.DelayBlockBypass = HAL_OSPI_DELAY_BLOCK_BYPASSED;
+    if (HAL_OSPI_Init(&hospi1) != HAL_OK) goto fail;
+
+    OSPIM_CfgTypeDef ospim = {0};
+    ospim.ClkPort = 1;
+    ospim.NCSPort = 1;
+    ospim.IOLowPort = HAL_OSPIM_IOPORT_1_LOW;
+    if (HAL_OSPIM_Config(&hospi1, &ospim, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) goto fail;
+
+    // Software reset, then make sure no program/erase is left over from before
+    if (!Send_Instruction(RESET_ENABLE_CMD)) goto fail;
+    if (!Send_Instruction(RESET_MEMORY_CMD)) goto fail;
+    HAL_Delay(1);
+    if (!Wait_Status(MX25R6435F_SR_WIP, 0, 1)) goto fail;
+
+    // Quad Enable is non-volatile; only write SR when it is not set yet
+    uint8_t sr = 0;
+    if (!Read_Status(&sr)) goto fail;
+    if ((sr & MX25R6435F_SR_QE) == 0) {
+        if (!Write_Enable()) goto fail;
+
+        OSPI_RegularCmdTypeDef cmd;
+        Cmd_Base(&cmd, WRITE_STATUS_CFG_REG_CMD);
+        cmd.DataMode = HAL_OSPI_DATA_1_LINE;
+        cmd.NbData = 1;
+        sr |= MX25R6435F_SR_QE;
+        if (HAL_OSPI_Command(&hospi1, &cmd, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) goto fail;
+        if (HAL_OSPI_Transmit(&hospi1, &sr, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) goto fail;
+        if (!Wait_Status(MX25R6435F_SR_WIP, 0, 1)) goto fail;
+    }
+
+    state = QSPI_IDLE;
+    return Enter_Mapped();
+
+fail:
+    state = QSPI_ERROR;
+    return 0;
+}
+
+// Copying read through the mapped window (for callers that want a RAM copy)
+int QspiFlash_Read(uint32_t addr, void *dst, uint32_t len)
+{
+    if (len == 0 || addr + len > QSPI_FLASH_SIZE) return 0;
+
+    const uint8_t *src = QspiFlash_MapAcquire(addr);
+    if (src == NULL) return 0;
+
+    uint32_t t0 = DWT->CYCCNT;
+    memcpy(dst, src, len);
+    stats.read_cycles += DWT->CYCCNT - t0;
+    stats.read_bytes += len;
+
+    QspiFlash_MapRelease();
+    return 1;
+}
+
+// ======================= NON-BLOCKING PROGRAM / ERASE =========================
+
+/*
+ * Quad page program (0x38). len must not cross a 256 B page and src must
+ * stay untouched until QspiFlash_IsBusy() drops.
+ */
+int QspiFlash_StartProgram(uint32_t addr, const void *src, uint32_t len)
+{
+    if (len == 0 || (addr & (QSPI_PAGE_SIZE - 1)) + len > QSPI_PAGE_SIZE) return 0;
+    if (!Claim_Indirect()) return 0;
+
+    if (!Write_Enable()) { state = QSPI_ERROR; return 0; }
+
+    OSPI_RegularCmdTypeDef cmd;
+    Cmd_Base(&cmd, QUAD_PAGE_PROG_CMD);
+    cmd.Address = addr;
+    cmd.AddressMode = HAL_OSPI_ADDRESS_4_LINES;
+    cmd.DataMode = HAL_OSPI_DATA_4_LINES;
+    cmd.NbData = len;
+
+    op_start = DWT->CYCCNT;
+    op_bytes = len;
+    state = QSPI_PROGRAMMING;
+    if (HAL_OSPI_Command(&hospi1, &cmd, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK ||
+        HAL_OSPI_Transmit_IT(&hospi1, (uint8_t *)src) != HAL_OK) {
+        state = QSPI_ERROR;
+        return 0;
+    }
+    return 1;
+}
+
+int QspiFlash_StartErase(uint32_t sector_addr)
+{
+    if (!Claim_Indirect()) return 0;
+
+    if (!Write_Enable()) { state = QSPI_ERROR; return 0; }
+
+    OSPI_RegularCmdTypeDef cmd;
+    Cmd_Base(&cmd, SECTOR_ERASE_CMD);
+    cmd.Address = sector_addr & ~(QSPI_SECTOR_SIZE - 1);
+    cmd.AddressMode = HAL_OSPI_ADDRESS_1_LINE;
+    op_start = DWT->CYCCNT;
+    op_bytes = 0;
+    if (HAL_OSPI_Command(&hospi1, &cmd, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK) {
+        state = QSPI_ERROR;
+        return 0;
+    }
+
+    state = QSPI_WAIT_READY;
+    if (!Wait_Status(MX25R6435F_SR_WIP, 0, 0)) {
+        state = QSPI_ERROR;
+        return 0;
+    }
+    return 1;
+}
+
+int QspiFlash_IsBusy(void)
+{
+    return state == QSPI_PROGRAMMING || state == QSPI_WAIT_READY;
+}
+
+QspiState_t QspiFlash_GetState(void)
+{
+    return state;
+}
+
+void QspiFlash_ClearError(void)
+{
+    if (state == QSPI_ERROR) {
+        HAL_OSPI_Abort(&hospi1);
+        mapped = 0;
+        state = QSPI_IDLE;
+    }
+}
+
+int QspiFlash_IsMapped(void)
+{
+    return mapped;
+}
+
+void QspiFlash_GetStats(QspiStats_t *st)
+{
+    *st = stats;
+}
+
+// ======================= IRQ CALLBACKS =========================
+
+// Data phase done: the chip is now programming internally, poll WIP under IRQ
+void HAL_OSPI_TxCpltCallback(OSPI_HandleTypeDef *hospi)
+{
+    (void)hospi;
+    if (state != QSPI_PROGRAMMING) return;
+    state = QSPI_WAIT_READY;
+    if (!Wait_Status(MX25R6435F_SR_WIP, 0, 0)) state = QSPI_ERROR;
+}
+
+void HAL_OSPI_StatusMatchCallback(OSPI_HandleTypeDef *hospi)
+{
+    (void)hospi;
+    if (state != QSPI_WAIT_READY) return;
+
+    uint32_t cycles = DWT->CYCCNT - op_start;
+    if (op_bytes) {
+        stats.prog_bytes += op_bytes;
+        stats.prog_cycles += cycles;
+    } else {
+        stats.erases++;
+        stats.erase_cycles += cycles;
+    }
+    state = QSPI_IDLE;
+}
+
+void HAL_OSPI_ErrorCallback(OSPI_HandleTypeDef *hospi)
+{
+    (void)hospi;
+    state = QSPI_ERROR;
+}
@@ -0,0 +1,285 @@
+/******************************************************************************
+  * @file           : sched.c
+  * @brief          : Cooperative run-to-completion task scheduler (timer wheel + event queues)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Each piece of work the main loop used to interleave by hand is a task:
+ * a function that runs to completion, once per periodic release of its
+ * timer or per event posted to it. Nothing preempts a task; the registration
+ * order is the priority order, and after every run the scheduler starts
+ * again from the top, so a short high-priority task never waits behind
+ * more than one lower-priority run.
+ *
+ * Timers sit in a hashed wheel of SCHED_WHEEL_SLOTS one-tick slots: a task
+ * due at tick T is chained in slot T % SLOTS, and advancing the wheel one
+ * tick only looks at one slot. Periods longer than the wheel simply stay in
+ * their slot until the matching turn. Releases are on the tick grid from
+ * the last release, never from when the task got to run, so periods do
+ * not drift with load.
+ *
+ * Events carry a code and the time they were posted. Each task has its own
+ * single-producer / single-consumer ring (spsc_ring.h; producer: one ISR or
+ * task, consumer: the scheduler), so posting needs no lock and no
+ * interrupt masking.
+ *
+ * Accounting per task: lateness (release -> start), execution time,
+ * deadline misses (release -> finish over deadline_us) and overruns (a
+ * release while the previous one is still waiting; the two are merged
+ * into one run). When nothing is ready the idle hook gets the time to the
+ * next release and may sleep.
+ *
+ * Portable: no HAL, the clock and the idle hook are passed in, so the host
+ * tests run it on a simulated clock.
+ */
+#include "sched.h"
+#include "spsc_ring.h"
+
+#include <string.h>
+#include "no_heap.h"
+
+typedef struct {
+    uint32_t posted_us;
+    uint8_t  ev;
+} Event_t;
+
+SPSC_RING(EventRing, Event_t, SCHED_QUEUE_LEN)
+
+typedef struct {
+    SchedTask_t fn;
+    uint32_t period_ticks;      // 0: no timer
+    uint32_t due_tick;          // next release, wheel ticks
+    int8_t   next;              // wheel slot chain, -1 = end
+    uint8_t  pending;           // timer release not run yet
+    uint32_t release_us;        // of the pending release
+
+    EventRing_t events;         // producer: Sched_Post, consumer: Sched_RunOnce
+
+    SchedStats_t st;
+} Task_t;
+
+static SchedClock_t clock_us;
+static SchedIdle_t idle_hook;
+static Task_t tasks[SCHED_MAX_TASKS];
+static int n_tasks = 0;
+
+static int8_t wheel[SCHED_WHEEL_SLOTS];
+static uint32_t wheel_tick = 0;             // last tick the wheel has expired
+static uint32_t wheel_us = 0;               // clock time of wheel_tick
+
+// ======================= TIMER WHEEL =========================
+
+static uint32_t Ticks_Of(uint32_t period_ms)
+{
+    uint32_t ticks = period_ms * 1000u / SCHED_TICK_US;
+    return ticks ? ticks : 1;
+}
+
+static void Insert(int id)
+{
+    Task_t *t = &tasks[id];
+    int8_t *head = &wheel[t->due_tick & (SCHED_WHEEL_SLOTS - 1)];
+    t->next = *head;
+    *head = (int8_t)id;
+}
+
+static void Unlink(int id)
+{
+    int8_t *link = &wheel[tasks[id].due_tick & (SCHED_WHEEL_SLOTS - 1)];
+    while (*link >= 0) {
+        if (*link == id) {
+            *link = tasks[id].next;
+            return;
+        }
+        link = &tasks[*link].next;
+    }
+}
+
+static void Release(Task_t *t)
+{
+    t->st.releases++;
+    if (t->pending) {
+        t->st.overruns++;
+        return;
+    }
+    t->pending = 1;
+    t->release_us = wheel_us;
+}
+
+// One tick: release every timer in this slot that is due on this turn
+static void Expire(void)
+{
+    int8_t *link = &wheel[wheel_tick & (SCHED_WHEEL_SLOTS - 1)];
+    int8_t fired = -1;
+
+    while (*link >= 0) {
+        Task_t *t = &tasks[*link];
+        if (t->due_tick != wheel_tick) {
+            link = &t->next;
+            continue;
+        }
+        int8_t id = *link;
+        *link = t->next;
+        t->next = fired;
+        fired = id;
+    }
+
+    // Re-armed only after the walk: a period of a whole number of turns lands in this slot again
+    while (fired >= 0) {
+        int8_t id = fired;
+        Task_t *t = &tasks[id];
+        fired = t->next;
+        Release(t);
+        t->due_tick += t->period_ticks;
+        Insert(id);
+    }
+}
+
+static void Advance(uint32_t now)
+{
+    while (now - wheel_us >= SCHED_TICK_US) {
+        wheel_us += SCHED_TICK_US;
+        wheel_tick++;
+        Expire();
+    }
+}
+
+static uint32_t Until(const Task_t *t, uint32_t now)
+{
+    if (!t->period_ticks) return SCHED_IDLE_FOREVER;
+    int32_t us = (int32_t)(wheel_us + (t->due_tick - wheel_tick) * SCHED_TICK_US - now);
+    return us > 0 ? (uint32_t)us : 0;
+}
+
+// ======================= DISPATCH =========================
+
+static void Run(Task_t *t, uint8_t ev, uint32_t release_us)
+{
+    uint32_t start = clock_us();
+    t->fn(ev);
+    uint32_t end = clock_us();
+
+    uint32_t late = start - release_us;
+    uint32_t exec = end - start;
+    t->st.runs++;
+    t->st.total_exec_us += exec;
+    if (late > t->st.max_late_us) t->st.max_late_us = late;
+    if (exec > t->st.max_exec_us) t->st.max_exec_us = exec;
+    if (t->st.deadline_us && end - release_us > t->st.deadline_us) t->st.misses++;
+}
+
+// ======================= PUBLIC API =========================
+
+void Sched_Init(SchedClock_t now_us, SchedIdle_t idle)
+{
+    clock_us = now_us;
+    idle_hook = idle;
+    memset(tasks, 0, sizeof(tasks));
+    memset(wheel, -1, sizeof(wheel));
+    n_tasks = 0;
+    wheel_tick = 0;
+    wheel_us = clock_us();
+}
+
+int Sched_AddTask(const char *name, SchedTask_t fn, uint32_t period_ms, uint32_t deadline_us)
+{
+    if (n_tasks >= SCHED_MAX_TASKS || !fn) return -1;
+
+    int id = n_tasks++;
+    Task_t *t = &tasks[id];
+    t->fn = fn;
+    t->next = -1;
+    t->st.name = name;
+    t->st.deadline_us = deadline_us;
+    if (period_ms) {
+        // First release on the next tick, then on its own grid
+        t->st.period_ms = period_ms;
+        t->period_ticks = Ticks_Of(period_ms);
+        t->due_tick = wheel_tick + 1;
+        Insert(id);
+    }
+    return id;
+}
+
+void Sched_SetPeriod(int id, uint32_t period_ms)
+{
+    if (id < 0 || id >= n_tasks) return;
+    Task_t *t = &tasks[id];
+    if (period_ms == t->st.period_ms) return;
+
+    uint32_t last = wheel_tick;
+    if (t->period_ticks) {
+        last = t->due_tick - t->period_ticks;
+        Unlink(id);
+    }
+    t->st.period_ms = period_ms;
+    t->period_ticks = period_ms ? Ticks_Of(period_ms) : 0;
+    if (!period_ms) return;
+
+    t->due_tick = last + t->period_ticks;
+    if ((int32_t)(t->due_tick - wheel_tick) <= 0) t->due_tick = wheel_tick + 1;
+    Insert(id);
+}
+
+int Sched_Post(int id, uint8_t ev)
+{
+    if (id < 0 || id >= n_tasks) return 0;
+    Event_t e = { clock_us(), ev };
+    return EventRing_Push(&tasks[id].events, &e);
+}
+
+int Sched_RunOnce(void)
+{
+    uint32_t now = clock_us();
+    Advance(now);
+
+    for (int id = 0; id < n_tasks; id++) {
+        Task_t *t = &tasks[id];
+        Event_t e;
+        if (EventRing_Pop(&t->events, &e)) {
+            Run(t, e.ev, e.posted_us);
+            return 1;
+        }
+        if (t->pending) {
+            t->pending = 0;
+            Run(t, SCHED_EV_TIMER, t->release_us);
+            return 1;
+        }
+    }
+
+    uint32_t idle_us = SCHED_IDLE_FOREVER;
+    for (int id = 0; id < n_tasks; id++) {
+        uint32_t us = Until(&tasks[id], now);
+        if (us < idle_us) idle_us = us;
+    }
+    if (idle_hook) idle_hook(idle_us);
+    return 0;
+}
+
+void Sched_Run(void)
+{
+    for (;;) Sched_RunOnce();
+}
+
+int Sched_Ready(void)
+{
+    for (int id = 0; id < n_tasks; id++) {
+        if (tasks[id].pending || EventRing_Count(&tasks[id].events)) return 1;
+    }
+    return 0;
+}
+
+uint32_t Sched_UntilUs(int id)
+{
+    if (id < 0 || id >= n_tasks) return SCHED_IDLE_FOREVER;
+    return Until(&tasks[id], clock_us());
+}
+
+int Sched_GetStats(int id, SchedStats_t *st)
+{
+    if (id < 0 || id >= n_tasks) return 0;
+    *st = tasks[id].st;
+    st->dropped = tasks[id].events.overflows;
+    st->max_queued = tasks[id].events.high_water;
+    return 1;
+}
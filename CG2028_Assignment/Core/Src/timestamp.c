@@ -0,0 +1,148 @@
+/******************************************************************************
+  * @file           : timestamp.c
+  * @brief          : Free-running 1 MHz TIM2 timestamps and sensor DRDY capture
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * HAL_GetTick() is 1 ms and the loop takes its readings after the 10 ms
+ * sound-ADC window, so tick stamps say little about when a sample was
+ * really taken. TIM2 is the one 32-bit general-purpose timer on this part
+ * that nothing else uses; here it free-runs at 1 MHz and every sample,
+ * event and alert is stamped from it.
+ *
+ * The LSM6DSL pulses INT1 (75 us) each time a new accelerometer sample is
+ * ready. PD11 has no timer channel, so the edge goes to EXTI11 and the
+ * handler latches TIM2 - a few us of interrupt entry later, far below
+ * the 19 ms ODR period. Pulsed mode matters: a latched DRDY would stay
+ * high over the samples the 50 Hz loop skips from the 52 Hz stream and
+ * give no new edge.
+ *
+ * Channel 1 of the same counter is a one-shot compare alarm: the kernel
+ * uses it to wake sleeping threads at an exact microsecond, independent
+ * of SysTick (which it stops during long idle periods).
+ */
+#include "main.h"
+#include "timestamp.h"
+#include "i2c_bus.h"
+#include "../../Drivers/BSP/Components/lsm6dsl/lsm6dsl.h"
+#include "no_heap.h"
+
+#define LSM6DSL_DRDY_PULSED     0x80    /* DRDY_PULSE_CFG_G: 75 us pulses instead of a latched level */
+#define LSM6DSL_INT1_DRDY_XL    0x01    /* INT1_CTRL: accelerometer data ready */
+
+TIM_HandleTypeDef htim2;                // TIM2_IRQHandler
+static volatile uint32_t drdy_us = 0;
+static volatile uint32_t drdy_prev_us = 0;
+static volatile uint32_t drdy_edges = 0;
+static uint32_t drdy_stale = 0;
+static TimestampAlarm_t alarm_fn = NULL;
+
+// ======================= PUBLIC API =========================
+
+int Timestamp_Init(void)
+{
+    // Timer clock is PCLK1, doubled when APB1 is divided
+    uint32_t clk = HAL_RCC_GetPCLK1Freq();
+    if ((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_HCLK_DIV1) clk *= 2;
+
+    __HAL_RCC_TIM2_CLK_ENABLE();
+    htim2.Instance = TIM2;
+    htim2.Init.Prescaler = clk / TIMESTAMP_HZ - 1;
+    htim2.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim2.Init.Period = 0xFFFFFFFFUL;
+    htim2.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim2.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+    if (HAL_TIM_Base_Init(&htim2) != HAL_OK) return 0;
+
+    // The prescaler only loads on an update event; force one so the first count is already 1 us
+    htim2.Instance->EGR = TIM_EGR_UG;
+    return HAL_TIM_Base_Start(&htim2) == HAL_OK;
+}
+
+uint32_t Timestamp_Now(void)
+{
+    return TIM2->CNT;
+}
+
+int Timestamp_ImuDrdyInit(void)
+{
+    uint8_t v = LSM6DSL_DRDY_PULSED;
+    if (I2cBus_Transfer(LSM6DSL_ACC_GYRO_I2C_ADDRESS_LOW, LSM6DSL_ACC_GYRO_DRDY_PULSE_CFG_G, 1, &v, 1, 1) != I2C_OK)
+        return 0;
+    v = LSM6DSL_INT1_DRDY_XL;
+    if (I2cBus_Transfer(LSM6DSL_ACC_GYRO_I2C_ADDRESS_LOW, LSM6DSL_ACC_GYRO_INT1_CTRL, 1, &v, 1, 1) != I2C_OK)
+        return 0;
+
+    __HAL_RCC_GPIOD_CLK_ENABLE();
+    GPIO_InitTypeDef gpio = {0};
+    gpio.Pin = LSM6DSL_INT1_EXTI11_Pin;
+    gpio.Mode = GPIO_MODE_IT_RISING;
+    gpio.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(LSM6DSL_INT1_EXTI11_GPIO_Port, &gpio);
+
+    HAL_NVIC_SetPriority(LSM6DSL_INT1_EXTI11_EXTI_IRQn, TIMESTAMP_DRDY_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(LSM6DSL_INT1_EXTI11_EXTI_IRQn);
+    return 1;
+}
+
+void Timestamp_OnImuDrdy(void)
+{
+    drdy_prev_us = drdy_us;
+    drdy_us = TIM2->CNT;
+    drdy_edges++;
+}
+
+uint32_t Timestamp_ImuSampleTime(uint32_t read_us)
+{
+    __disable_irq();
+    uint32_t t = drdy_us, prev = drdy_prev_us;
+    __enable_irq();
+
+    // An edge after the read started belongs to the next sample
+    if ((int32_t)(read_us - t) < 0) t = prev;
+    if (drdy_edges == 0 || read_us - t > TIMESTAMP_DRDY_STALE_US) {
+        drdy_stale++;
+        return read_us;
+    }
+    return t;
+}
+
+void Timestamp_GetStats(TimestampStats_t *st)
+{
+    st->drdy_edges = drdy_edges;
+    st->drdy_stale = drdy_stale;
+}
+
+void Timestamp_AlarmInit(TimestampAlarm_t fn)
+{
+    alarm_fn = fn;
+    // Channel 1 stays in frozen output-compare mode: a match only sets CC1IF
+    __HAL_TIM_DISABLE_IT(&htim2, TIM_IT_CC1);
+    __HAL_TIM_CLEAR_FLAG(&htim2, TIM_FLAG_CC1);
+    HAL_NVIC_SetPriority(TIM2_IRQn, TIMESTAMP_ALARM_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+void Timestamp_SetAlarm(uint32_t at_us)
+{
+    __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_1, at_us);
+    __HAL_TIM_CLEAR_FLAG(&htim2, TIM_FLAG_CC1);
+    __HAL_TIM_ENABLE_IT(&htim2, TIM_IT_CC1);
+    // A compare value the counter has already passed would only match after the wrap
+    if ((int32_t)(at_us - TIM2->CNT) <= 0) htim2.Instance->EGR = TIM_EGR_CC1G;
+}
+
+void Timestamp_CancelAlarm(void)
+{
+    __HAL_TIM_DISABLE_IT(&htim2, TIM_IT_CC1);
+    __HAL_TIM_CLEAR_FLAG(&htim2, TIM_FLAG_CC1);
+}
+
+// ======================= HAL CALLBACKS =========================
+
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance != TIM2) return;
+    __HAL_TIM_DISABLE_IT(&htim2, TIM_IT_CC1);
+    if (alarm_fn) alarm_fn();
+}
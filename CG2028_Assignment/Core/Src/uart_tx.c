@@ -0,0 +1,126 @@
+/******************************************************************************
+  * @file           : uart_tx.c
+  * @brief          : Interrupt-driven USART1 console output from a lock-free TX ring
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * HAL_UART_Transmit(..., HAL_MAX_DELAY) polls TXE for every byte: a 70-byte
+ * status line kept the app thread busy for 6 ms, and a fall banner for
+ * nearly 50 ms, with detection queued behind it. Here the console is an
+ * SPSC ring of characters (spsc_ring.h) drained by the USART1 TXE
+ * interrupt. The app thread formats a message with fmt.h directly into the
+ * ring's free space, then publishes it with one release store of head, so
+ * a print costs only the formatting.
+ *
+ * A message either goes in whole or is dropped whole (and counted): the
+ * log is read line by line (gateway.py looks for its sentinels), and a
+ * half line is worse than a missing one. At 115200 baud the ring drains
+ * in under 180 ms, longer than any burst the firmware prints.
+ */
+#include "main.h"
+#include "uart_tx.h"
+#include "spsc_ring.h"
+#include "timestamp.h"
+#include "no_heap.h"
+
+SPSC_RING(TxRing, char, UART_TX_RING_BYTES)
+
+static TxRing_t ring;
+static volatile uint32_t sent = 0;
+
+// UartTx_WriteMarked: ring position whose character, once out, is stamped
+static volatile uint32_t mark_pos = 0;
+static volatile uint8_t mark_armed = 0;
+static volatile uint8_t mark_done = 0;
+static volatile uint32_t mark_us = 0;
+
+// ======================= PUBLIC API =========================
+
+void UartTx_Init(void)
+{
+    TxRing_Init(&ring);
+    sent = 0;
+    HAL_NVIC_SetPriority(USART1_IRQn, UART_TX_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
+}
+
+void UartTx_Begin(Fmt_t *f)
+{
+    ring.tail_cache = SPSC_LOAD_ACQUIRE(&ring.tail);
+    Fmt_InitRing(f, ring.buf, UART_TX_RING_BYTES, ring.head, ring.tail_cache + UART_TX_RING_BYTES);
+}
+
+void UartTx_Commit(Fmt_t *f)
+{
+    if (f->lost) {
+        ring.overflows += Fmt_Len(f) + f->lost;
+        return;
+    }
+    if (f->pos == f->start) return;
+
+    SPSC_STORE_RELEASE(&ring.head, f->pos);
+    if (f->pos - ring.tail_cache > ring.high_water) ring.high_water = f->pos - ring.tail_cache;
+    // The interrupt switches itself off once the ring is empty
+    SET_BIT(USART1->CR1, USART_CR1_TXEIE_TXFNFIE);
+}
+
+void UartTx_Write(const char *s)
+{
+    Fmt_t f;
+    UartTx_Begin(&f);
+    Fmt_Str(&f, s);
+    UartTx_Commit(&f);
+}
+
+int UartTx_WriteMarked(const char *s)
+{
+    Fmt_t f;
+    UartTx_Begin(&f);
+    Fmt_Str(&f, s);
+    if (f.lost || f.pos == f.start) {
+        UartTx_Commit(&f);
+        return 0;
+    }
+    // Armed before head moves: the interrupt cannot have passed the text yet
+    mark_armed = 0;
+    mark_done = 0;
+    mark_pos = f.pos;
+    mark_armed = 1;
+    UartTx_Commit(&f);
+    return 1;
+}
+
+int UartTx_TakeMark(uint32_t *sent_us)
+{
+    if (!mark_done) return 0;
+    *sent_us = mark_us;
+    mark_done = 0;
+    return 1;
+}
+
+void UartTx_GetStats(UartTxStats_t *st)
+{
+    st->bytes = sent;
+    st->high_water = ring.high_water;
+    st->dropped = ring.overflows;
+}
+
+// ======================= INTERRUPT =========================
+
+RAMFUNC void UartTx_IRQHandler(void)
+{
+    char c;
+    if (!(USART1->ISR & USART_ISR_TXE_TXFNF)) return;
+
+    if (TxRing_Pop(&ring, &c)) {
+        USART1->TDR = (uint8_t)c;
+        sent++;
+        if (mark_armed && sent == mark_pos) {
+            mark_us = Timestamp_Now();
+            mark_armed = 0;
+            mark_done = 1;
+        }
+    } else {
+        CLEAR_BIT(USART1->CR1, USART_CR1_TXEIE_TXFNFIE);
+    }
+}
@@ -0,0 +1,377 @@
+/******************************************************************************
+  * @file           : wifi_async.c
+  * @brief          : Non-blocking AT command pipeline for the ISM43362 (SPI3 DMA)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * The es_wifi driver spins on DRDY and clocks every 16-bit word by hand,
+ * so a single S3/R0 round trip stalls the main loop. This engine runs the
+ * same AT-over-SPI protocol from interrupts instead:
+ *
+ *   WAIT_READY --DRDY--> TX (DMA, nCS low) --TX_DONE--> WAIT_RESP (nCS high)
+ *   WAIT_RESP --DRDY rising--> RX (DMA, one chunk at a time) --terminator--> done
+ *
+ * Commands sit in a ring of WIFI_QUEUE_LEN slots and run strictly in
+ * order. The next one is started from the completion interrupt of the
+ * previous one, so a batch (select socket, set timeout, send) goes out
+ * back to back while the main loop keeps sampling. Completion callbacks
+ * are deferred to WifiAsync_Poll() and run in submission order.
+ *
+ * Response bytes land in an RX ring by DMA; while DRDY stays high the
+ * next chunk is started before the finished one is parsed. The parser is
+ * incremental: it keeps the last 8 bytes and stops at the "\r\n> "
+ * prompt, "\r\nOK\r\n> " meaning success. A binary R0 payload containing
+ * "\r\n> " would end the response early, as with the es_wifi parser.
+ *
+ * Deadlines (command timeout, reset hold) are timer events checked
+ * against HAL_GetTick() in WifiAsync_Poll(), so their resolution is one
+ * main-loop pass. A timed-out transfer is aborted and the next command
+ * starts; WIFI_F_CHAIN commands behind a failure are skipped with the
+ * same result, which lets a caller treat a batch as one operation.
+ *
+ * Builds on Linux against host/wifi_sim.c, which stands in for the
+ * es_wifi_io.c transport and raises the events itself.
+ */
+#include "main.h"
+#include "wifi_async.h"
+#include "es_wifi_io.h"
+
+#include "string.h"
+
+#define F_RESET             0x80    /* internal: hardware reset, no AT text */
+
+typedef enum {
+    ST_IDLE = 0,
+    ST_WAIT_READY,          // waiting for DRDY before clocking the command out
+    ST_TX,
+    ST_WAIT_RESP,           // nCS high, waiting for the DRDY rising edge
+    ST_RX,
+    ST_RESET_HOLD           // RST low until hold_until
+} EngineState_t;
+
+typedef struct {
+    uint8_t    tx[WIFI_TX_MAX];
+    uint16_t   tx_len;
+    uint8_t    flags;
+    uint8_t    result;
+    uint32_t   timeout_ms;
+    WifiDone_t done;
+    void      *ctx;
+    uint8_t    resp[WIFI_RESP_MAX];
+    uint16_t   resp_len;
+} WifiCmd_t;
+
+// Free-running indices: [q_head, q_run) completed, awaiting the callback;
+// q_run is the running command; [q_run, q_tail) queued
+static WifiCmd_t slots[WIFI_QUEUE_LEN];
+static volatile uint32_t q_head = 0;
+static volatile uint32_t q_run = 0;
+static volatile uint32_t q_tail = 0;
+
+static volatile EngineState_t state = ST_IDLE;
+static WifiResult_t last_result = WIFI_OK;
+static uint32_t started_at = 0;
+static uint32_t deadline = 0;
+static uint32_t hold_until = 0;
+
+// DMA fills the ring one chunk at rx_in, the parser consumes from rx_out
+static uint8_t  ring[WIFI_RING_SIZE] __attribute__((aligned(4)));
+static uint32_t rx_in = 0;
+static uint32_t rx_out = 0;
+static int rx_busy = 0;
+static int terminated = 0;
+
+static uint8_t  last8[8];
+static uint32_t seen = 0;
+
+static WifiAsyncStats_t stats;
+
+static const char ok_tail[] = "\r\nOK\r\n> ";
+
+static void Start_Next(void);
+
+// ======================= RESPONSE PARSER =========================
+
+static void Parser_Reset(void)
+{
+    memset(last8, 0, sizeof(last8));
+    seen = 0;
+    rx_in = rx_out = 0;
+    rx_busy = 0;
+    terminated = 0;
+}
+
+// Returns 1 on the "\r\n> " prompt that ends every response
+static int Parse_Byte(WifiCmd_t *c, uint8_t b)
+{
+    if (seen == 0 && b == 0x15) return 0;       // filler ahead of the boot prompt
+    memmove(last8, last8 + 1, sizeof(last8) - 1);
+    last8[7] = b;
+    if (seen < WIFI_RESP_MAX) c->resp[seen] = b;
+    seen++;
+    return seen >= 4 && memcmp(last8 + 4, ok_tail + 4, 4) == 0;
+}
+
+static WifiResult_t Parse_Result(WifiCmd_t *c)
+{
+    uint32_t kept = (seen < WIFI_RESP_MAX) ? seen : WIFI_RESP_MAX;
+
+    if (c->flags & F_RESET) {
+        c->resp_len = 0;
+        return WIFI_OK;
+    }
+    if (seen < 8 || memcmp(last8, ok_tail, 8) != 0) {
+        c->resp_len = (uint16_t)kept;           // "\r\nERROR...", kept for diagnostics
+        return WIFI_ERROR;
+    }
+
+    uint32_t skip = 0, body = seen - 8;
+    if (body >= 2 && c->resp[0] == '\r' && c->resp[1] == '\n') {
+        skip = 2;
+        body -= 2;
+    }
+    if (skip + body > kept) body = kept - skip;
+    memmove(c->resp, c->resp + skip, body);
+    c->resp_len = (uint16_t)body;
+    return WIFI_OK;
+}
+
+// ======================= ENGINE (IRQ CONTEXT OR LOCKED) =========================
+
+static int Due(uint32_t now, uint32_t at)
+{
+    return (int32_t)(now - at) >= 0;
+}
+
+static WifiCmd_t *Running(void)
+{
+    return &slots[q_run % WIFI_QUEUE_LEN];
+}
+
+static void Complete(WifiResult_t res)
+{
+    WifiCmd_t *c = Running();
+    uint32_t took = HAL_GetTick() - started_at;
+
+    c->result = (uint8_t)res;
+    last_result = res;
+    stats.commands++;
+    if (res == WIFI_ERROR) stats.errors++;
+    if (res == WIFI_TIMEOUT) stats.timeouts++;
+    if (res == WIFI_BUS_ERROR) stats.bus_errors++;
+    stats.last_ms = took;
+    if (took > stats.max_ms) stats.max_ms = took;
+
+    q_run++;
+    state = ST_IDLE;
+}
+
+static void Abort_Running(WifiResult_t res)
+{
+    WifiIo_Abort();
+    WifiIo_Select(0);
+    Running()->resp_len = 0;
+    Complete(res);
+    Start_Next();
+}
+
+static void Start_Tx(void)
+{
+    WifiCmd_t *c = Running();
+    state = ST_TX;
+    WifiIo_Select(1);
+    if (WifiIo_StartTx(c->tx, c->tx_len) != 0) Abort_Running(WIFI_BUS_ERROR);
+}
+
+static int Start_Rx(void)
+{
+    if (WifiIo_StartRx(ring + (rx_in % WIFI_RING_SIZE), WIFI_RX_CHUNK) != 0) return 0;
+    rx_busy = 1;
+    state = ST_RX;
+    return 1;
+}
+
+static void Start_Next(void)
+{
+    while (q_run != q_tail) {
+        WifiCmd_t *c = Running();
+        if ((c->flags & WIFI_F_CHAIN) && last_result != WIFI_OK) {
+            c->result = (uint8_t)last_result;
+            c->resp_len = 0;
+            stats.skipped++;
+            q_run++;
+            continue;
+        }
+
+        started_at = HAL_GetTick();
+        deadline = started_at + c->timeout_ms;
+        Parser_Reset();
+
+        if (c->flags & F_RESET) {
+            WifiIo_Select(0);
+            WifiIo_HoldReset(1);
+            hold_until = started_at + WIFI_RESET_HOLD_MS;
+            state = ST_RESET_HOLD;
+            return;
+        }
+        state = ST_WAIT_READY;
+        if (WifiIo_DataReady()) Start_Tx();
+        return;
+    }
+    state = ST_IDLE;
+}
+
+static void Rx_Chunk_Done(void)
+{
+    WifiCmd_t *c = Running();
+
+    rx_busy = 0;
+    rx_in += WIFI_RX_CHUNK;
+    stats.rx_bytes += WIFI_RX_CHUNK;
+
+    // Keep the bus busy while the module still has data; parse behind the DMA
+    if (!terminated && WifiIo_DataReady() && !Start_Rx()) {
+        Abort_Running(WIFI_BUS_ERROR);
+        return;
+    }
+
+    while (rx_out != rx_in && !terminated) {
+        terminated = Parse_Byte(c, ring[rx_out % WIFI_RING_SIZE]);
+        rx_out++;
+    }
+    rx_out = rx_in;                             // after the prompt: 0x15 filler
+    if (rx_busy) return;
+
+    WifiIo_Select(0);
+    if (terminated) {
+        Complete(Parse_Result(c));
+        Start_Next();
+        return;
+    }
+    // DRDY dropped before the prompt: the rest comes in a later burst
+    state = ST_WAIT_RESP;
+}
+
+void WifiAsync_OnEvent(WifiEvent_t ev)
+{
+    switch (state) {
+    case ST_WAIT_READY:
+        if (ev == WIFI_EVT_DRDY) Start_Tx();
+        break;
+
+    case ST_TX:
+        if (ev == WIFI_EVT_TX_DONE) {
+            state = ST_WAIT_RESP;               // before nCS rises: DRDY may follow at once
+            WifiIo_Select(0);
+        } else if (ev == WIFI_EVT_BUS_ERROR) {
+            Abort_Running(WIFI_BUS_ERROR);
+        }
+        break;
+
+    case ST_WAIT_RESP:
+        if (ev == WIFI_EVT_DRDY) {
+            WifiIo_Select(1);
+            if (!Start_Rx()) Abort_Running(WIFI_BUS_ERROR);
+        }
+        break;
+
+    case ST_RX:
+        if (ev == WIFI_EVT_RX_DONE) Rx_Chunk_Done();
+        else if (ev == WIFI_EVT_BUS_ERROR) Abort_Running(WIFI_BUS_ERROR);
+        break;
+
+    default:
+        break;
+    }
+}
+
+// ======================= PUBLIC API =========================
+
+static int Enqueue(const char *cmd, const uint8_t *data, uint16_t data_len,
+                   uint32_t timeout_ms, uint8_t flags, WifiDone_t done, void *ctx)
+{
+    uint32_t n = cmd ? (uint32_t)strlen(cmd) : 0;
+    uint32_t need = cmd ? n + 1 + data_len : 0;
+
+    if (need + (need & 1) > WIFI_TX_MAX) return 0;
+    if (q_tail - q_head >= WIFI_QUEUE_LEN) return 0;
+
+    // Only the main loop moves q_tail, so this slot is ours until it does
+    WifiCmd_t *c = &slots[q_tail % WIFI_QUEUE_LEN];
+    if (cmd) {
+        memcpy(c->tx, cmd, n);
+        c->tx[n++] = '\r';
+        if (data_len) memcpy(c->tx + n, data, data_len);
+        n += data_len;
+        if (n & 1) c->tx[n++] = '\n';           // whole 16-bit frames
+    }
+    c->tx_len = (uint16_t)n;
+    c->flags = flags;
+    c->result = WIFI_OK;
+    c->timeout_ms = timeout_ms;
+    c->done = done;
+    c->ctx = ctx;
+    c->resp_len = 0;
+
+    uint32_t key = WifiIo_Lock();
+    q_tail++;
+    if (q_tail - q_head > stats.max_queued) stats.max_queued = q_tail - q_head;
+    if (state == ST_IDLE) Start_Next();
+    WifiIo_Unlock(key);
+    return 1;
+}
+
+int WifiAsync_Init(void)
+{
+    q_head = q_run = q_tail = 0;
+    state = ST_IDLE;
+    last_result = WIFI_OK;
+    Parser_Reset();
+    memset(&stats, 0, sizeof(stats));
+    return WifiIo_Open() == 0;
+}
+
+int WifiAsync_Submit(const char *cmd, const uint8_t *data, uint16_t data_len,
+                     uint32_t timeout_ms, uint8_t flags, WifiDone_t done, void *ctx)
+{
+    return Enqueue(cmd, data, data_len, timeout_ms, flags & ~F_RESET, done, ctx);
+}
+
+int WifiAsync_SubmitReset(uint32_t timeout_ms, uint8_t flags, WifiDone_t done, void *ctx)
+{
+    return Enqueue(NULL, NULL, 0, timeout_ms, flags | F_RESET, done, ctx);
+}
+
+void WifiAsync_Poll(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t key = WifiIo_Lock();
+    if (state == ST_RESET_HOLD) {
+        if (Due(now, hold_until)) {
+            state = ST_WAIT_RESP;               // boot prompt comes with the first DRDY edge
+            WifiIo_HoldReset(0);
+        }
+    } else if (state != ST_IDLE && Due(now, deadline)) {
+        Abort_Running(WIFI_TIMEOUT);
+    }
+    WifiIo_Unlock(key);
+
+    // Callbacks may submit more work; their slot stays reserved until q_head moves
+    while (q_head != q_run) {
+        WifiCmd_t *c = &slots[q_head % WIFI_QUEUE_LEN];
+        if (c->done) c->done((WifiResult_t)c->result, c->resp, c->resp_len, c->ctx);
+        q_head++;
+    }
+}
+
+uint32_t WifiAsync_Pending(void)
+{
+    return q_tail - q_head;
+}
+
+void WifiAsync_GetStats(WifiAsyncStats_t *st)
+{
+    uint32_t key = WifiIo_Lock();
+    *st = stats;
+    WifiIo_Unlock(key);
+}
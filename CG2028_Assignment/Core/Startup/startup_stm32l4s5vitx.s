@@ -80,6 +80,25 @@ LoopCopyDataInit:
   adds r4, r0, r3
   cmp r4, r1
   bcc CopyDataInit
+
+/* Copy the hot code (.ramfunc) from flash to SRAM2 */
+  ldr r0, =_sramfunc
+  ldr r1, =_eramfunc
+  ldr r2, =_siramfunc
+  movs r3, #0
+  b LoopCopyRamfunc
+
+CopyRamfunc:
+  ldr r4, [r2, r3]
+  str r4, [r0, r3]
+  adds r3, r3, #4
+
+LoopCopyRamfunc:
+  adds r4, r0, r3
+  cmp r4, r1
+  bcc CopyRamfunc
+  dsb
+  isb
   
 /* Zero fill the bss segment. */
   ldr r2, =_sbss
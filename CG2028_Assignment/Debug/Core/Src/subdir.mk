@@ -8,29 +8,107 @@ S_SRCS += \
 ../Core/Src/mov_avg.s 
 
 C_SRCS += \
+../Core/Src/alert_client.c \
+../Core/Src/alert_trace.c \
+../Core/Src/auto_calib.c \
+../Core/Src/baro_fifo.c \
+../Core/Src/blackbox.c \
+../Core/Src/config_store.c \
+../Core/Src/es_wifi_io.c \
+../Core/Src/fall_detect.c \
+../Core/Src/fmt.c \
+../Core/Src/fusion.c \
+../Core/Src/height_drop.c \
+../Core/Src/i2c_bus.c \
+../Core/Src/imu_codec.c \
+../Core/Src/kernel.c \
+../Core/Src/latency_hist.c \
+../Core/Src/loop_monitor.c \
+../Core/Src/mag_heading.c \
 ../Core/Src/main.c \
+../Core/Src/mem.c \
+../Core/Src/nfc_status.c \
+../Core/Src/noise_floor.c \
+../Core/Src/posture.c \
+../Core/Src/qspi_flash.c \
+../Core/Src/sched.c \
 ../Core/Src/stm32l4xx_hal_msp.c \
 ../Core/Src/stm32l4xx_it.c \
 ../Core/Src/sysmem.c \
-../Core/Src/system_stm32l4xx.c 
+../Core/Src/system_stm32l4xx.c \
+../Core/Src/timestamp.c \
+../Core/Src/uart_tx.c \
+../Core/Src/wifi_async.c 
 
 OBJS += \
+./Core/Src/alert_client.o \
+./Core/Src/alert_trace.o \
+./Core/Src/auto_calib.o \
+./Core/Src/baro_fifo.o \
+./Core/Src/blackbox.o \
+./Core/Src/config_store.o \
+./Core/Src/es_wifi_io.o \
+./Core/Src/fall_detect.o \
+./Core/Src/fmt.o \
+./Core/Src/fusion.o \
+./Core/Src/height_drop.o \
+./Core/Src/i2c_bus.o \
+./Core/Src/imu_codec.o \
+./Core/Src/kernel.o \
+./Core/Src/latency_hist.o \
+./Core/Src/loop_monitor.o \
+./Core/Src/mag_heading.o \
 ./Core/Src/main.o \
+./Core/Src/mem.o \
 ./Core/Src/mov_avg.o \
+./Core/Src/nfc_status.o \
+./Core/Src/noise_floor.o \
+./Core/Src/posture.o \
+./Core/Src/qspi_flash.o \
+./Core/Src/sched.o \
 ./Core/Src/stm32l4xx_hal_msp.o \
 ./Core/Src/stm32l4xx_it.o \
 ./Core/Src/sysmem.o \
-./Core/Src/system_stm32l4xx.o 
+./Core/Src/system_stm32l4xx.o \
+./Core/Src/timestamp.o \
+./Core/Src/uart_tx.o \
+./Core/Src/wifi_async.o 
 
 S_DEPS += \
 ./Core/Src/mov_avg.d 
 
 C_DEPS += \
+./Core/Src/alert_client.d \
+./Core/Src/alert_trace.d \
+./Core/Src/auto_calib.d \
+./Core/Src/baro_fifo.d \
+./Core/Src/blackbox.d \
+./Core/Src/config_store.d \
+./Core/Src/es_wifi_io.d \
+./Core/Src/fall_detect.d \
+./Core/Src/fmt.d \
+./Core/Src/fusion.d \
+./Core/Src/height_drop.d \
+./Core/Src/i2c_bus.d \
+./Core/Src/imu_codec.d \
+./Core/Src/kernel.d \
+./Core/Src/latency_hist.d \
+./Core/Src/loop_monitor.d \
+./Core/Src/mag_heading.d \
 ./Core/Src/main.d \
+./Core/Src/mem.d \
+./Core/Src/nfc_status.d \
+./Core/Src/noise_floor.d \
+./Core/Src/posture.d \
+./Core/Src/qspi_flash.d \
+./Core/Src/sched.d \
 ./Core/Src/stm32l4xx_hal_msp.d \
 ./Core/Src/stm32l4xx_it.d \
 ./Core/Src/sysmem.d \
-./Core/Src/system_stm32l4xx.d 
+./Core/Src/system_stm32l4xx.d \
+./Core/Src/timestamp.d \
+./Core/Src/uart_tx.d \
+./Core/Src/wifi_async.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -42,7 +120,7 @@ Core/Src/%.o: ../Core/Src/%.s Core/Src/subdir.mk
 clean: clean-Core-2f-Src
 
 clean-Core-2f-Src:
-	-$(RM) ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/mov_avg.d ./Core/Src/mov_avg.o ./Core/Src/stm32l4xx_hal_msp.cyclo ./Core/Src/stm32l4xx_hal_msp.d ./Core/Src/stm32l4xx_hal_msp.o ./Core/Src/stm32l4xx_hal_msp.su ./Core/Src/stm32l4xx_it.cyclo ./Core/Src/stm32l4xx_it.d ./Core/Src/stm32l4xx_it.o ./Core/Src/stm32l4xx_it.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32l4xx.cyclo ./Core/Src/system_stm32l4xx.d ./Core/Src/system_stm32l4xx.o ./Core/Src/system_stm32l4xx.su
+	-$(RM) ./Core/Src/alert_client.cyclo ./Core/Src/alert_client.d ./Core/Src/alert_client.o ./Core/Src/alert_client.su ./Core/Src/alert_trace.cyclo ./Core/Src/alert_trace.d ./Core/Src/alert_trace.o ./Core/Src/alert_trace.su ./Core/Src/auto_calib.cyclo ./Core/Src/auto_calib.d ./Core/Src/auto_calib.o ./Core/Src/auto_calib.su ./Core/Src/baro_fifo.cyclo ./Core/Src/baro_fifo.d ./Core/Src/baro_fifo.o ./Core/Src/baro_fifo.su ./Core/Src/blackbox.cyclo ./Core/Src/blackbox.d ./Core/Src/blackbox.o ./Core/Src/blackbox.su ./Core/Src/config_store.cyclo ./Core/Src/config_store.d ./Core/Src/config_store.o ./Core/Src/config_store.su ./Core/Src/es_wifi_io.cyclo ./Core/Src/es_wifi_io.d ./Core/Src/es_wifi_io.o ./Core/Src/es_wifi_io.su ./Core/Src/fall_detect.cyclo ./Core/Src/fall_detect.d ./Core/Src/fall_detect.o ./Core/Src/fall_detect.su ./Core/Src/fmt.cyclo ./Core/Src/fmt.d ./Core/Src/fmt.o ./Core/Src/fmt.su ./Core/Src/fusion.cyclo ./Core/Src/fusion.d ./Core/Src/fusion.o ./Core/Src/fusion.su ./Core/Src/height_drop.cyclo ./Core/Src/height_drop.d ./Core/Src/height_drop.o ./Core/Src/height_drop.su ./Core/Src/i2c_bus.cyclo ./Core/Src/i2c_bus.d ./Core/Src/i2c_bus.o ./Core/Src/i2c_bus.su ./Core/Src/imu_codec.cyclo ./Core/Src/imu_codec.d ./Core/Src/imu_codec.o ./Core/Src/imu_codec.su ./Core/Src/kernel.cyclo ./Core/Src/kernel.d ./Core/Src/kernel.o ./Core/Src/kernel.su ./Core/Src/latency_hist.cyclo ./Core/Src/latency_hist.d ./Core/Src/latency_hist.o ./Core/Src/latency_hist.su ./Core/Src/loop_monitor.cyclo ./Core/Src/loop_monitor.d ./Core/Src/loop_monitor.o ./Core/Src/loop_monitor.su ./Core/Src/mag_heading.cyclo ./Core/Src/mag_heading.d ./Core/Src/mag_heading.o ./Core/Src/mag_heading.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/mem.cyclo ./Core/Src/mem.d ./Core/Src/mem.o ./Core/Src/mem.su ./Core/Src/mov_avg.d ./Core/Src/mov_avg.o ./Core/Src/nfc_status.cyclo ./Core/Src/nfc_status.d ./Core/Src/nfc_status.o ./Core/Src/nfc_status.su ./Core/Src/noise_floor.cyclo ./Core/Src/noise_floor.d ./Core/Src/noise_floor.o ./Core/Src/noise_floor.su ./Core/Src/posture.cyclo ./Core/Src/posture.d ./Core/Src/posture.o ./Core/Src/posture.su ./Core/Src/qspi_flash.cyclo ./Core/Src/qspi_flash.d ./Core/Src/qspi_flash.o ./Core/Src/qspi_flash.su ./Core/Src/sched.cyclo ./Core/Src/sched.d ./Core/Src/sched.o ./Core/Src/sched.su ./Core/Src/stm32l4xx_hal_msp.cyclo ./Core/Src/stm32l4xx_hal_msp.d ./Core/Src/stm32l4xx_hal_msp.o ./Core/Src/stm32l4xx_hal_msp.su ./Core/Src/stm32l4xx_it.cyclo ./Core/Src/stm32l4xx_it.d ./Core/Src/stm32l4xx_it.o ./Core/Src/stm32l4xx_it.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32l4xx.cyclo ./Core/Src/system_stm32l4xx.d ./Core/Src/system_stm32l4xx.o ./Core/Src/system_stm32l4xx.su ./Core/Src/timestamp.cyclo ./Core/Src/timestamp.d ./Core/Src/timestamp.o ./Core/Src/timestamp.su ./Core/Src/uart_tx.cyclo ./Core/Src/uart_tx.d ./Core/Src/uart_tx.o ./Core/Src/uart_tx.su ./Core/Src/wifi_async.cyclo ./Core/Src/wifi_async.d ./Core/Src/wifi_async.o ./Core/Src/wifi_async.su
 
 .PHONY: clean-Core-2f-Src
 
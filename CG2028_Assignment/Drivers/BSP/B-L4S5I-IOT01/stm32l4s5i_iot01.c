@@ -18,6 +18,7 @@
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm32l4s5i_iot01.h"
+#include "i2c_bus.h"
 
 /** @defgroup BSP BSP
   * @{
@@ -88,14 +89,11 @@ UART_HandleTypeDef hDiscoUart;
 /** @defgroup STM32L4S5I_IOT01_LOW_LEVEL_Private_FunctionPrototypes LOW LEVEL Private Function Prototypes
   * @{
   */
-static void     I2Cx_MspInit(I2C_HandleTypeDef *i2c_handler);
-static void     I2Cx_MspDeInit(I2C_HandleTypeDef *i2c_handler);
 static void     I2Cx_Init(I2C_HandleTypeDef *i2c_handler);
 static void     I2Cx_DeInit(I2C_HandleTypeDef *i2c_handler);
 static HAL_StatusTypeDef I2Cx_ReadMultiple(I2C_HandleTypeDef *i2c_handler, uint8_t Addr, uint16_t Reg, uint16_t MemAddSize, uint8_t *Buffer, uint16_t Length);
 static HAL_StatusTypeDef I2Cx_WriteMultiple(I2C_HandleTypeDef *i2c_handler, uint8_t Addr, uint16_t Reg, uint16_t MemAddSize, uint8_t *Buffer, uint16_t Length);
 static HAL_StatusTypeDef I2Cx_IsDeviceReady(I2C_HandleTypeDef *i2c_handler, uint16_t DevAddress, uint32_t Trials);
-static void              I2Cx_Error(I2C_HandleTypeDef *i2c_handler, uint8_t Addr);
 
 /* Sensors IO functions */
 void     SENSOR_IO_Init(void);
@@ -344,66 +342,12 @@ void BSP_COM_DeInit(COM_TypeDef COM, UART_HandleTypeDef *huart)
 *******************************************************************************/
 
 /******************************* I2C Routines *********************************/
-/**
-  * @brief  Initializes I2C MSP.
-  * @param  i2c_handler  I2C handler
-  * @retval None
-  */
-static void I2Cx_MspInit(I2C_HandleTypeDef *i2c_handler)
-{
-  GPIO_InitTypeDef  gpio_init_structure;
-
-  /*** Configure the GPIOs ***/
-  /* Enable GPIO clock */
-  DISCOVERY_I2Cx_SCL_SDA_GPIO_CLK_ENABLE();
-
-  /* Configure I2C Tx, Rx as alternate function */
-  gpio_init_structure.Pin = DISCOVERY_I2Cx_SCL_PIN | DISCOVERY_I2Cx_SDA_PIN;
-  gpio_init_structure.Mode = GPIO_MODE_AF_OD;
-  gpio_init_structure.Pull = GPIO_PULLUP;
-  gpio_init_structure.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
-  gpio_init_structure.Alternate = DISCOVERY_I2Cx_SCL_SDA_AF;
-  HAL_GPIO_Init(DISCOVERY_I2Cx_SCL_SDA_GPIO_PORT, &gpio_init_structure);
-
-  HAL_GPIO_Init(DISCOVERY_I2Cx_SCL_SDA_GPIO_PORT, &gpio_init_structure);
-
-  /*** Configure the I2C peripheral ***/
-  /* Enable I2C clock */
-  DISCOVERY_I2Cx_CLK_ENABLE();
-
-  /* Force the I2C peripheral clock reset */
-  DISCOVERY_I2Cx_FORCE_RESET();
-
-  /* Release the I2C peripheral clock reset */
-  DISCOVERY_I2Cx_RELEASE_RESET();
-
-  /* Enable and set I2Cx Interrupt to a lower priority */
-  HAL_NVIC_SetPriority(DISCOVERY_I2Cx_EV_IRQn, 0x0F, 0);
-  HAL_NVIC_EnableIRQ(DISCOVERY_I2Cx_EV_IRQn);
-
-  /* Enable and set I2Cx Interrupt to a lower priority */
-  HAL_NVIC_SetPriority(DISCOVERY_I2Cx_ER_IRQn, 0x0F, 0);
-  HAL_NVIC_EnableIRQ(DISCOVERY_I2Cx_ER_IRQn);
-}
-
-/**
-  * @brief  DeInitializes I2C MSP.
-  * @param  i2c_handler  I2C handler
-  * @retval None
-  */
-static void I2Cx_MspDeInit(I2C_HandleTypeDef *i2c_handler)
-{
-  GPIO_InitTypeDef  gpio_init_structure;
-  
-  /* Configure I2C Tx, Rx as alternate function */
-  gpio_init_structure.Pin = DISCOVERY_I2Cx_SCL_PIN | DISCOVERY_I2Cx_SDA_PIN;
-  HAL_GPIO_DeInit(DISCOVERY_I2Cx_SCL_SDA_GPIO_PORT, gpio_init_structure.Pin);
-  /* Disable GPIO clock */
-  DISCOVERY_I2Cx_SCL_SDA_GPIO_CLK_DISABLE();
-  
-  /* Disable I2C clock */
-  DISCOVERY_I2Cx_CLK_DISABLE();
-}
+/*
+ * All I2C2 traffic goes through the transaction scheduler in i2c_bus.c:
+ * it owns the pins, clock, DMA channels and error recovery, and orders
+ * the jobs of every device on the bus by priority. The routines below
+ * only translate the BSP calls into blocking scheduler jobs.
+ */
 
 /**
   * @brief  Initializes I2C HAL.
@@ -412,22 +356,7 @@ static void I2Cx_MspDeInit(I2C_HandleTypeDef *i2c_handler)
   */
 static void I2Cx_Init(I2C_HandleTypeDef *i2c_handler)
 {
-  /* I2C configuration */
-  i2c_handler->Instance              = DISCOVERY_I2Cx;
-  i2c_handler->Init.Timing           = DISCOVERY_I2Cx_TIMING;
-  i2c_handler->Init.OwnAddress1      = 0;
-  i2c_handler->Init.AddressingMode   = I2C_ADDRESSINGMODE_7BIT;
-  i2c_handler->Init.DualAddressMode  = I2C_DUALADDRESS_DISABLE;
-  i2c_handler->Init.OwnAddress2      = 0;
-  i2c_handler->Init.GeneralCallMode  = I2C_GENERALCALL_DISABLE;
-  i2c_handler->Init.NoStretchMode    = I2C_NOSTRETCH_DISABLE;
-
-  /* Init the I2C */
-  I2Cx_MspInit(i2c_handler);
-  HAL_I2C_Init(i2c_handler);
-  
-  /**Configure Analogue filter */
-  HAL_I2CEx_ConfigAnalogFilter(i2c_handler, I2C_ANALOGFILTER_ENABLE);  
+  I2cBus_Init();
 }
 
 /**
@@ -436,9 +365,8 @@ static void I2Cx_Init(I2C_HandleTypeDef *i2c_handler)
   * @retval None
   */
 static void I2Cx_DeInit(I2C_HandleTypeDef *i2c_handler)
-{  /* DeInit the I2C */
-  I2Cx_MspDeInit(i2c_handler);
-  HAL_I2C_DeInit(i2c_handler); 
+{
+  I2cBus_DeInit();
 }
 
 /**
@@ -453,17 +381,10 @@ static void I2Cx_DeInit(I2C_HandleTypeDef *i2c_handler)
   */
 static HAL_StatusTypeDef I2Cx_ReadMultiple(I2C_HandleTypeDef *i2c_handler, uint8_t Addr, uint16_t Reg, uint16_t MemAddress, uint8_t *Buffer, uint16_t Length)
 {
-  HAL_StatusTypeDef status = HAL_OK;
+  uint8_t reg_size = (MemAddress == I2C_MEMADD_SIZE_16BIT) ? 2 : 1;
 
-  status = HAL_I2C_Mem_Read(i2c_handler, Addr, (uint16_t)Reg, MemAddress, Buffer, Length, 1000);
-
-  /* Check the communication status */
-  if(status != HAL_OK)
-  {
-    /* I2C error occurred */
-    I2Cx_Error(i2c_handler, Addr);
-  }
-  return status;
+  /* Errors are recovered by the scheduler, no bus re-init here */
+  return (I2cBus_Transfer(Addr, Reg, reg_size, Buffer, Length, 0) == I2C_OK) ? HAL_OK : HAL_ERROR;
 }
 
 
@@ -479,17 +400,9 @@ static HAL_StatusTypeDef I2Cx_ReadMultiple(I2C_HandleTypeDef *i2c_handler, uint8
   */
 static HAL_StatusTypeDef I2Cx_WriteMultiple(I2C_HandleTypeDef *i2c_handler, uint8_t Addr, uint16_t Reg, uint16_t MemAddress, uint8_t *Buffer, uint16_t Length)
 {
-  HAL_StatusTypeDef status = HAL_OK;
-
-  status = HAL_I2C_Mem_Write(i2c_handler, Addr, (uint16_t)Reg, MemAddress, Buffer, Length, 1000);
+  uint8_t reg_size = (MemAddress == I2C_MEMADD_SIZE_16BIT) ? 2 : 1;
 
-  /* Check the communication status */
-  if(status != HAL_OK)
-  {
-    /* Re-Initiaize the I2C Bus */
-    I2Cx_Error(i2c_handler, Addr);
-  }
-  return status;
+  return (I2cBus_Transfer(Addr, Reg, reg_size, Buffer, Length, 1) == I2C_OK) ? HAL_OK : HAL_ERROR;
 }
 
 /**
@@ -502,22 +415,7 @@ static HAL_StatusTypeDef I2Cx_WriteMultiple(I2C_HandleTypeDef *i2c_handler, uint
   */
 static HAL_StatusTypeDef I2Cx_IsDeviceReady(I2C_HandleTypeDef *i2c_handler, uint16_t DevAddress, uint32_t Trials)
 { 
-  return (HAL_I2C_IsDeviceReady(i2c_handler, DevAddress, Trials, 1000));
-}
-
-/**
-  * @brief  Manages error callback by re-initializing I2C.
-  * @param  i2c_handler  I2C handler
-  * @param  Addr  I2C Address
-  * @retval None
-  */
-static void I2Cx_Error(I2C_HandleTypeDef *i2c_handler, uint8_t Addr)
-{
-  /* De-initialize the I2C communication bus */
-  HAL_I2C_DeInit(i2c_handler);
-  
-  /* Re-Initialize the I2C communication bus */
-  I2Cx_Init(i2c_handler);
+  return (I2cBus_Probe((uint8_t)DevAddress, Trials) == I2C_OK) ? HAL_OK : HAL_ERROR;
 }
 
 /**
@@ -699,7 +597,7 @@ uint32_t NFC_IO_IsDeviceReady (uint16_t Addr, uint32_t Trials)
     /* Wait until NFC device is ready or timeout occurs */
     do
     {
-        status = HAL_I2C_IsDeviceReady(&hI2cHandler, Addr, Trials, NFC_I2C_TIMEOUT_STD);
+        status = I2Cx_IsDeviceReady(&hI2cHandler, Addr, Trials);
         currenttick = HAL_GetTick();
     } while( ( (currenttick - tickstart) < NFC_I2C_TIMEOUT_MAX) && (status != HAL_OK) );
     
@@ -723,28 +621,13 @@ uint32_t NFC_IO_IsDeviceReady (uint16_t Addr, uint32_t Trials)
   */
 int32_t NFC_IO_WriteReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length) 
 {
-  int32_t ret = -8;
-  uint32_t hal_error = HAL_OK;
-  
-  if (HAL_I2C_Mem_Write(&hI2cHandler, (uint8_t)DevAddr,
-                       (uint16_t)Reg, I2C_MEMADD_SIZE_16BIT,
-                       (uint8_t *)pData, Length, 0x1000) == HAL_OK)
-  {
-    ret = 0;
-  }
-  else
+  I2cResult_t res = I2cBus_Transfer((uint8_t)DevAddr, Reg, 2, pData, Length, 1);
+
+  if (res == I2C_OK)
   {
-    hal_error = HAL_I2C_GetError(&hI2cHandler);
-    if ( hal_error == HAL_I2C_ERROR_AF)
-    {
-      return NFC_I2C_ERROR_NACK;
-    }
-    else
-    {
-      ret =  NFC_I2C_ERROR_PERIPHERAL;
-    }
+    return 0;
   }
-  return ret;
+  return (res == I2C_NACK) ? NFC_I2C_ERROR_NACK : NFC_I2C_ERROR_PERIPHERAL;
 }
 
 /**
@@ -756,28 +639,13 @@ int32_t NFC_IO_WriteReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16
   */
 int32_t  NFC_IO_ReadReg16(uint16_t DevAddr, uint16_t Reg, uint8_t *pData, uint16_t Length) 
 {
-  int32_t ret = -8;
-  uint32_t hal_error = HAL_OK;
- 
-  if (HAL_I2C_Mem_Read(&hI2cHandler, DevAddr, (uint16_t)Reg,
-                       I2C_MEMADD_SIZE_16BIT, pData,
-                       Length, 0x1000) == HAL_OK)
-  {
-    ret = 0;
-  }
-  else
+  I2cResult_t res = I2cBus_Transfer((uint8_t)DevAddr, Reg, 2, pData, Length, 0);
+
+  if (res == I2C_OK)
   {
-    hal_error = HAL_I2C_GetError(&hI2cHandler);
-    if( hal_error == HAL_I2C_ERROR_AF)
-    {
-      return NFC_I2C_ERROR_NACK;
-    }
-    else
-    {
-      ret =  NFC_I2C_ERROR_PERIPHERAL;
-    }
+    return 0;
   }
-  return ret;
+  return (res == I2C_NACK) ? NFC_I2C_ERROR_NACK : NFC_I2C_ERROR_PERIPHERAL;
 }
 
 /**
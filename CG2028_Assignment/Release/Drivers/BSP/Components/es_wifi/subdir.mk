@@ -0,0 +1,27 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+# Toolchain: GNU Tools for STM32 (13.3.rel1)
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../Drivers/BSP/Components/es_wifi/es_wifi.c 
+
+OBJS += \
+./Drivers/BSP/Components/es_wifi/es_wifi.o 
+
+C_DEPS += \
+./Drivers/BSP/Components/es_wifi/es_wifi.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+Drivers/BSP/Components/es_wifi/%.o Drivers/BSP/Components/es_wifi/%.su Drivers/BSP/Components/es_wifi/%.cyclo: ../Drivers/BSP/Components/es_wifi/%.c Drivers/BSP/Components/es_wifi/subdir.mk
+	arm-none-eabi-gcc "$<" -mcpu=cortex-m4 -std=gnu11 -DUSE_HAL_DRIVER -DSTM32L4S5xx -c -I../Core/Inc -I../Drivers/STM32L4xx_HAL_Driver/Inc -I../Drivers/STM32L4xx_HAL_Driver/Inc/Legacy -I../Drivers/CMSIS/Device/ST/STM32L4xx/Include -I../Drivers/CMSIS/Include -Os -ffunction-sections -fdata-sections -Wall -flto -fstack-usage -fcyclomatic-complexity -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" --specs=nano.specs -mfpu=fpv4-sp-d16 -mfloat-abi=hard -mthumb -o "$@"
+
+clean: clean-Drivers-2f-BSP-2f-Components-2f-es_wifi
+
+clean-Drivers-2f-BSP-2f-Components-2f-es_wifi:
+	-$(RM) ./Drivers/BSP/Components/es_wifi/es_wifi.cyclo ./Drivers/BSP/Components/es_wifi/es_wifi.d ./Drivers/BSP/Components/es_wifi/es_wifi.o ./Drivers/BSP/Components/es_wifi/es_wifi.su
+
+.PHONY: clean-Drivers-2f-BSP-2f-Components-2f-es_wifi
+
@@ -0,0 +1,36 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+# Toolchain: GNU Tools for STM32 (13.3.rel1)
+################################################################################
+
+ELF_SRCS := 
+OBJ_SRCS := 
+S_SRCS := 
+C_SRCS := 
+S_UPPER_SRCS := 
+O_SRCS := 
+CYCLO_FILES := 
+SIZE_OUTPUT := 
+OBJDUMP_LIST := 
+SU_FILES := 
+EXECUTABLES := 
+OBJS := 
+MAP_FILES := 
+S_DEPS := 
+S_UPPER_DEPS := 
+C_DEPS := 
+
+# Every subdirectory with source files must be described here
+SUBDIRS := \
+Core/Src \
+Core/Startup \
+Drivers/BSP/B-L4S5I-IOT01 \
+Drivers/BSP/Components/es_wifi \
+Drivers/BSP/Components/hts221 \
+Drivers/BSP/Components/lis3mdl \
+Drivers/BSP/Components/lps22hb \
+Drivers/BSP/Components/lsm6dsl \
+Drivers/BSP/Components/st25dv \
+Drivers/STM32L4xx_HAL_Driver/Src/Legacy \
+Drivers/STM32L4xx_HAL_Driver/Src \
+
@@ -0,0 +1,48 @@
+/******************************************************************************
+  * @file           : mov_avg_check.h
+  * @brief          : Randomised differential check of mov_avg variants against the C reference
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __MOV_AVG_CHECK_H
+#define __MOV_AVG_CHECK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#define MOV_AVG_N_MAX           8       /* N_MAX in mov_avg.s */
+#define MOV_AVG_CHECK_GUARD     4       /* junk words after the window: reads past N show up */
+#define MOV_AVG_CHECK_REPORTS   8       /* mismatches printed in full, the rest only counted */
+
+typedef int (*MovAvgFn_t)(int N, int* accel_buff);
+
+typedef struct {
+    const char *name;
+    MovAvgFn_t  fn;
+} MovAvgVariant_t;
+
+/*
+ * The reference: sum of the N newest samples, wrapping like a 32-bit
+ * register does, divided by N truncating toward zero (SDIV). Defined for
+ * every int input, so overflowing sums compare bit for bit too.
+ */
+int mov_avg_ref(int N, const int* accel_buff);
+
+/*
+ * Runs every variant for every N in 1..MOV_AVG_N_MAX over the edge cases
+ * (int16 and int32 extremes, alternating signs, sums just off a multiple
+ * of N, negative truncation) and random_per_n random windows drawn from
+ * seed, plus a sliding-window stream fed the way Detect_Sample() does.
+ * Prints through printf (semihosting on the board) and returns the
+ * number of mismatches.
+ */
+uint32_t MovAvgCheck_Run(const MovAvgVariant_t *variants, int n_variants,
+                         uint32_t seed, uint32_t random_per_n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MOV_AVG_CHECK_H */
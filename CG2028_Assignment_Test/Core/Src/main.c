@@ -13,13 +13,15 @@
 #include "../../Drivers/BSP/B-L4S5I-IOT01/stm32l4s5i_iot01_accelero.h"
 #include "../../Drivers/BSP/B-L4S5I-IOT01/stm32l4s5i_iot01_tsensor.h"
 #include "stdio.h"
+#include "mov_avg_check.h"
 
 
 extern void initialise_monitor_handles(void);	// for semi-hosting support (printf)
 
 extern int mov_avg(int N, int* accel_buff); // asm implementation
 
-int mov_avg_C(int N, int* accel_buff); // reference C implementation
+#define CHECK_SEED		2028	// randomised windows for MovAvgCheck_Run(), same as host/mov_avg_test
+#define CHECK_RANDOM_PER_N	2000	// per window size; semihosting only prints the mismatches
 
 
 
@@ -35,7 +37,7 @@ int main(void)
 	/*********************************************************/
 
 	int sensor_data_x[16]={1000,1001,1002,1003,1004,1005,1006,1007,1008,1009,1010,1011,1012,1013,1014,1015};
-	int sensor_data_y[16]={1016.1017,1018,1019,1020,1021,1022,1023,1024,1025,1026,1027,1028,1029.1030,1031};
+	int sensor_data_y[16]={1016,1017,1018,1019,1020,1021,1022,1023,1024,1025,1026,1027,1028,1029,1030,1031};
 	int sensor_data_z[16]={1032,1033,1034,1035,1036,1037,1038,1039,1040,1041,1042,1043,1044,1045,1046,1047};
 
 
@@ -67,11 +69,11 @@ int main(void)
 		accel_buff_z[count%4]=sensor_data_z[num]; //acceleration along Z-Axis
 		count++;
 
-		//Call the C functions for the moving filter
+		//Call the C reference for the moving filter (mov_avg_check.c)
 
-		filt_avg_c[0] = mov_avg_C(N,accel_buff_x);
-		filt_avg_c[1] = mov_avg_C(N,accel_buff_y);
-		filt_avg_c[2] = mov_avg_C(N,accel_buff_z);
+		filt_avg_c[0] = mov_avg_ref(N,accel_buff_x);
+		filt_avg_c[1] = mov_avg_ref(N,accel_buff_y);
+		filt_avg_c[2] = mov_avg_ref(N,accel_buff_z);
 
 
 		//Call the assembly functions for the moving filter
@@ -95,6 +97,12 @@ int main(void)
 		num++; //increment the counter for while loop
 	}
 
+	// Every N, edge cases and random windows, bit for bit against the reference
+	static const MovAvgVariant_t variants[] = {
+		{ "mov_avg.s", mov_avg },
+	};
+	if (MovAvgCheck_Run(variants, 1, CHECK_SEED, CHECK_RANDOM_PER_N) != 0) flag=0;
+
 	if (flag==1){
 		printf("Test passed\n");
 	}
@@ -105,18 +113,3 @@ int main(void)
 	printf("Exiting main\n");
 
 }
-
-
-
-int mov_avg_C(int N, int* accel_buff)
-{ 	// The implementation below is inefficient and meant only for verifying your results.
-	int result=0;
-	for(int i=0; i<N;i++)
-	{
-		result+=accel_buff[i];
-	}
-
-	result=result/4;
-
-	return result;
-}
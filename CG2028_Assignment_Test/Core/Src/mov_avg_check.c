@@ -0,0 +1,181 @@
+/******************************************************************************
+  * @file           : mov_avg_check.c
+  * @brief          : Randomised differential check of mov_avg variants against the C reference
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Plain C and printf only, so the same file runs on the board under
+ * semihosting (main.c, against mov_avg.s) and on Linux (host/mov_avg_test.c,
+ * against the firmware mov_avg_C and a C model of the assembly).
+ *
+ * Every window is followed by MOV_AVG_CHECK_GUARD words of fresh junk
+ * before each call: a variant that reads past N gets a wrong answer
+ * instead of a lucky zero. The window itself must come back unchanged.
+ */
+#include "mov_avg_check.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#define STREAM_SAMPLES      1000    /* per N, fed through a ring like Detect_Sample() */
+#define RANDOM_CLASSES      5
+
+static int window[MOV_AVG_N_MAX + MOV_AVG_CHECK_GUARD];
+static uint32_t rng = 1;
+static uint32_t checks = 0;
+static uint32_t mismatches = 0;
+
+static uint32_t Rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+int mov_avg_ref(int N, const int* accel_buff)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < N; i++) sum += (uint32_t)accel_buff[i];
+    return (int32_t)sum / N;
+}
+
+static void Print_Window(int N)
+{
+    printf("[");
+    for (int i = 0; i < N; i++) printf(i ? ", %d" : "%d", window[i]);
+    printf("]\n");
+}
+
+// window[0..N) against every variant
+static void Check_Window(const MovAvgVariant_t *variants, int n_variants, int N, const char *what)
+{
+    int expected = mov_avg_ref(N, window);
+    int saved[MOV_AVG_N_MAX];
+    memcpy(saved, window, (size_t)N * sizeof(int));
+
+    for (int v = 0; v < n_variants; v++) {
+        for (int g = 0; g < MOV_AVG_CHECK_GUARD; g++) window[N + g] = (int)Rand();
+        int got = variants[v].fn(N, window);
+        int clobbered = memcmp(saved, window, (size_t)N * sizeof(int)) != 0;
+        checks++;
+        if (got == expected && !clobbered) continue;
+
+        if (++mismatches <= MOV_AVG_CHECK_REPORTS) {
+            printf("  MISMATCH %s N=%d (%s): got %d, expected %d%s, window ", variants[v].name, N, what,
+                   got, expected, clobbered ? ", window modified" : "");
+            Print_Window(N);
+        }
+        memcpy(window, saved, (size_t)N * sizeof(int));
+    }
+}
+
+static void Fill(int N, int a, int b)
+{
+    for (int i = 0; i < N; i++) window[i] = (i & 1) ? b : a;
+}
+
+static void Check_Edges(const MovAvgVariant_t *variants, int n_variants, int N)
+{
+    static const struct { int a, b; const char *what; } pairs[] = {
+        { 0, 0,                 "zeros" },
+        { 1, 1,                 "ones" },
+        { -1, -1,               "minus ones" },
+        { 1, -1,                "+1/-1" },
+        { -1, 1,                "-1/+1" },
+        { INT16_MAX, INT16_MAX, "int16 max" },
+        { INT16_MIN, INT16_MIN, "int16 min" },
+        { INT16_MAX, INT16_MIN, "int16 max/min" },
+        { INT16_MIN, INT16_MAX, "int16 min/max" },
+        { INT_MAX, INT_MAX,     "int32 max, wraps" },
+        { INT_MIN, INT_MIN,     "int32 min, wraps" },
+        { INT_MAX, INT_MIN,     "int32 max/min" },
+        { INT_MIN, INT_MAX,     "int32 min/max" },
+        { INT_MAX, 1,           "int32 max/+1, wraps" },
+        { INT_MIN, -1,          "int32 min/-1, wraps" },
+    };
+    for (unsigned p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++) {
+        Fill(N, pairs[p].a, pairs[p].b);
+        Check_Window(variants, n_variants, N, pairs[p].what);
+    }
+
+    // Sums just off a multiple of N, both signs: truncation toward zero, not floor
+    for (int r = 1; r < N; r++) {
+        Fill(N, 0, 0);
+        window[0] = r;
+        Check_Window(variants, n_variants, N, "sum 0 + r");
+        window[0] = -r;
+        Check_Window(variants, n_variants, N, "sum 0 - r");
+        Fill(N, -1000, -1000);
+        window[N - 1] -= r;
+        Check_Window(variants, n_variants, N, "sum -1000 N - r");
+    }
+
+    // One large value in each slot: indexing and stride
+    for (int k = 0; k < N; k++) {
+        Fill(N, 0, 0);
+        window[k] = INT16_MIN;
+        Check_Window(variants, n_variants, N, "one-hot int16 min");
+        window[k] = 1 << 30;
+        Check_Window(variants, n_variants, N, "one-hot 2^30");
+    }
+}
+
+static int Random_Value(int cls)
+{
+    static const int extremes[] = { INT16_MIN, INT16_MAX, INT_MIN, INT_MAX, -1, 0, 1 };
+    switch (cls) {
+        case 0:  return (int16_t)Rand();                                    // any int16
+        case 1:  return 1000 + (int)(Rand() % 101) - 50;                    // lying still, 1 g on one axis
+        case 2:  return (int)(Rand() % 7) - 3;                              // noise around zero
+        case 3:  return (int)Rand();                                        // any int32, overflowing sums
+        default: {
+            uint32_t r = Rand() % 8;
+            return r < 7 ? extremes[r] : (int16_t)Rand();                   // extremes mixed in
+        }
+    }
+}
+
+static void Check_Random(const MovAvgVariant_t *variants, int n_variants, int N, uint32_t count)
+{
+    static const char *const what[RANDOM_CLASSES] = {
+        "random int16", "random 1 g", "random small", "random int32", "random extremes"
+    };
+    for (uint32_t n = 0; n < count; n++) {
+        int cls = (int)(n % RANDOM_CLASSES);
+        for (int i = 0; i < N; i++) window[i] = Random_Value(cls);
+        Check_Window(variants, n_variants, N, what[cls]);
+    }
+}
+
+// A random walk through a ring of N, newest sample overwriting the oldest
+static void Check_Stream(const MovAvgVariant_t *variants, int n_variants, int N)
+{
+    int level = 1000;
+    memset(window, 0, sizeof(window));
+    for (int i = 0; i < STREAM_SAMPLES; i++) {
+        level += (int)(Rand() % 201) - 100;
+        if (level > INT16_MAX) level = INT16_MAX;
+        if (level < INT16_MIN) level = INT16_MIN;
+        window[i % N] = level;
+        Check_Window(variants, n_variants, N, "stream");
+    }
+}
+
+uint32_t MovAvgCheck_Run(const MovAvgVariant_t *variants, int n_variants,
+                         uint32_t seed, uint32_t random_per_n)
+{
+    rng = seed ? seed : 1;
+    checks = 0;
+    mismatches = 0;
+
+    printf("mov_avg check: %d variant(s), N = 1..%d, seed %lu\n", n_variants, MOV_AVG_N_MAX, (unsigned long)seed);
+    for (int N = 1; N <= MOV_AVG_N_MAX; N++) {
+        Check_Edges(variants, n_variants, N);
+        Check_Random(variants, n_variants, N, random_per_n);
+        Check_Stream(variants, n_variants, N);
+    }
+    printf("mov_avg check: %lu comparisons, %lu mismatches\n", (unsigned long)checks, (unsigned long)mismatches);
+    return mismatches;
+}
@@ -23,6 +23,9 @@ Test 3: The Recovery (RECOVERY_DEVIATION)
 Action: Lie on your back. Roll around gently (simulating pain/incapacitation) and note the Dev peak. Then, do a strict sit-up to simulate getting up, and note that Dev peak.
 
 Data to record: Set your stillness exit threshold higher than the rolling deviation, but lower than the sit-up deviation.
+
+The main firmware can now run these three tests on-device: hold the blue button for 3s
+(see Core/Src/auto_calib.c). This logger is kept for inspecting raw peaks.
 */
 #include "main.h"
 #include "../../Drivers/BSP/B-L4S5I-IOT01/stm32l4s5i_iot01_accelero.h"
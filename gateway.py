@@ -1,7 +1,10 @@
 import serial
 import requests
+import socket
+import struct
 import time
 import threading
+import json
 
 # --- CONFIGURATION ---
 COM_PORT = 'COM3'      # <<< CHANGE THIS TO YOUR ACTUAL COM PORT
@@ -11,6 +14,14 @@ BOT_TOKEN = '8736583227:AAFGcR8NWgHvw1a3h_mnezfWk5gU_RGZfqc'
 CHAT_ID = '982391689'
 TELEGRAM_URL = f"https://api.telegram.org/bot{BOT_TOKEN}/sendMessage"
 
+# Direct Wi-Fi alerts (firmware alert_client.c, ALERT_SERVER_PORT)
+ALERT_TCP_PORT = 5028
+ALERT_FRAME = struct.Struct('<BBHIhhI')    # magic, type, seq, tick, value0, value1, event_us
+assert ALERT_FRAME.size == 16            # alert_client.h ALERT_FRAME_SIZE
+ALERT_FRAME_MAGIC = 0xA1
+ALERT_ACK_MAGIC = 0xA2
+ALERT_HEARTBEAT = 6                         # AlertType_t: keeps the link up, not an alarm
+
 # The exact Sentinel Value printed by the STM32 FSM transition
 TRIGGER_PHRASE = "___SEND_TELEGRAM_ALERT___"
 DISARM_PHRASE = "--- SYSTEM DISARMED (2 presses) ---"
@@ -18,6 +29,31 @@ ARM_PHRASE = "--- SYSTEM ARMED (2 presses) ---"
 MANUAL_ALARM_PHRASE = "!!! MANUAL ALARM TRIGGERED (3 presses) !!!"
 RESET_ALARM_PHRASE = "--- ALARM RESET (1 press) ---"
 
+# Board stage times printed once the sentinel has left its UART (alert_trace.c)
+TRACE_TAG = "ALERT_TRACE"
+
+# Time-to-alarm log, one JSON object per line; summarised by latency_report.py.
+# "host" is time.monotonic() in seconds, comparable within one session only.
+LATENCY_LOG = 'latency_log.jsonl'
+SESSION = int(time.time())
+log_lock = threading.Lock()
+alert_count = 0
+untraced_alert = None       # last sentinel, until its ALERT_TRACE line comes in
+
+def log_latency(ev, host, **fields):
+    record = {'ev': ev, 'session': SESSION, 'host': host, **fields}
+    with log_lock:
+        with open(LATENCY_LOG, 'a') as f:
+            f.write(json.dumps(record) + '\n')
+
+def parse_trace(line):
+    """'ALERT_TRACE id=3 kind=crash trigger=..' -> {'id': 3, 'kind': 'crash', 'trigger': ..}"""
+    fields = {}
+    for item in line.split()[1:]:
+        key, _, value = item.partition('=')
+        fields[key] = int(value) if value.isdigit() else value
+    return fields
+
 # Independent cooldown timers for each event type
 last_alert_times = {
     'FALL': 0,
@@ -27,8 +63,9 @@ last_alert_times = {
     'RESET': 0
 }
 
-def send_telegram_alert(message="🚨 EMERGENCY! Yao Xiang has fallen! Immediate assistance required!"):
+def send_telegram_alert(message="🚨 EMERGENCY! Yao Xiang has fallen! Immediate assistance required!", alert=None):
     from datetime import datetime
+    start = time.monotonic()
     timestamp = datetime.now().strftime("%Y-%m-%d %H:%M:%S")
     full_message = f"{message}\n⏰ Time: {timestamp}"
     
@@ -40,16 +77,76 @@ def send_telegram_alert(message="🚨 EMERGENCY! Yao Xiang has fallen! Immediate
     try:
         # 5-second timeout ensures the thread dies cleanly if Wi-Fi drops
         response = requests.post(TELEGRAM_URL, json=payload, timeout=5)
+        if alert is not None:
+            log_latency('telegram', time.monotonic(), alert=alert, start=start, status=response.status_code)
         if response.status_code == 200:
             print("\n[GATEWAY] ✅ Telegram alert sent successfully!")
         else:
             print(f"\n[GATEWAY] ❌ Failed to send. Status: {response.status_code}")
     except Exception as e:
+        if alert is not None:
+            log_latency('telegram', time.monotonic(), alert=alert, start=start, status=None)
         print(f"\n[GATEWAY] ❌ Network Error: {e}")
 
+WIFI_MESSAGES = {
+    1: "🚨 EMERGENCY! Yao Xiang has fallen! Immediate assistance required!",
+    2: "🆘 MANUAL PANIC ALARM TRIGGERED BY YAO XIANG! 🆘",
+    3: "Oi, fall detected, but Yao Xiang terminated the alarm!",
+    4: "🛡️ System Armed: Fall Detector is now monitoring.",
+    5: "Oi, Yao Xiang has disabled the detector!",
+}
+
+def tcp_alert_server():
+    """Accepts the board's persistent connection, acks every frame, forwards new ones."""
+    srv = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind(('', ALERT_TCP_PORT))
+    srv.listen(1)
+    print(f"[GATEWAY] ✅ Wi-Fi alerts on TCP port {ALERT_TCP_PORT}")
+    last_seq = None
+    while True:
+        conn, addr = srv.accept()
+        conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        print(f"\n[GATEWAY] 📶 Board connected from {addr[0]}")
+        buf = b''
+        try:
+            while True:
+                data = conn.recv(64)
+                if not data:
+                    break
+                rx = time.monotonic()
+                buf += data
+                while len(buf) >= ALERT_FRAME.size:
+                    magic, kind, seq, tick, v0, v1, event_us = ALERT_FRAME.unpack_from(buf)
+                    buf = buf[ALERT_FRAME.size:]
+                    if magic != ALERT_FRAME_MAGIC:
+                        raise ConnectionError("bad frame")
+                    conn.sendall(bytes([ALERT_ACK_MAGIC, kind, seq & 0xFF, seq >> 8]))
+                    # Resent after a lost ack: already forwarded (tick tells reboots apart)
+                    if (seq, tick) == last_seq:
+                        continue
+                    last_seq = (seq, tick)
+                    # Latency key of this frame, shared with its Telegram record
+                    alert = f"wifi:{tick}:{seq}"
+                    if kind != ALERT_HEARTBEAT:
+                        log_latency('wifi', rx, alert=alert, kind=kind, seq=seq, event_us=event_us)
+                    if kind in WIFI_MESSAGES:
+                        # Board TIM2 time of the sample / button press behind the alert
+                        print(f"\n[GATEWAY] 📶 Alert {kind} seq {seq}, board event at {event_us} us")
+                        msg = WIFI_MESSAGES[kind]
+                        if kind == 1:
+                            msg += f"\n📈 Peak {v0 / 100:.1f} m/s², {v1 / 10:.0f} dps"
+                        threading.Thread(target=send_telegram_alert, args=(msg,), kwargs={'alert': alert},
+                                         daemon=True).start()
+        except (OSError, ConnectionError) as e:
+            print(f"\n[GATEWAY] 📶 Board link lost: {e}")
+        finally:
+            conn.close()
+
 def main():
-    global last_alert_time
+    global last_alert_time, alert_count, untraced_alert
     print("--- CG2028 SENTINEL GATEWAY ---")
+    threading.Thread(target=tcp_alert_server, daemon=True).start()
     
     try:
         ser = serial.Serial(COM_PORT, BAUD_RATE, timeout=0.1)
@@ -59,18 +156,29 @@ def main():
             if ser.in_waiting > 0:
                 try:
                     line = ser.readline().decode('utf-8', errors='ignore').strip()
+                    rx = time.monotonic()
                     if line:
                         current_time = time.time()
                         
                         # Check for the Sentinel Value
                         if line == TRIGGER_PHRASE:
+                            alert_count += 1
+                            untraced_alert = alert_count
+                            sent = False
                             # 10-second debounce specific to real falls
                             if current_time - last_alert_times['FALL'] > 10:
                                 last_alert_times['FALL'] = current_time
                                 print("\n[GATEWAY] ⏱️ Fall alarm engaged. Cooldown activated for 10 seconds...")
                                 
                                 # Fire the API call in a BACKGROUND THREAD
-                                threading.Thread(target=send_telegram_alert, daemon=True).start()
+                                threading.Thread(target=send_telegram_alert, kwargs={'alert': alert_count}, daemon=True).start()
+                                sent = True
+                            log_latency('sentinel', rx, alert=alert_count, forwarded=sent)
+
+                        elif line.startswith(TRACE_TAG + ' '):
+                            # The board only traces its latest sentinel, so that is the one this closes
+                            log_latency('trace', rx, alert=untraced_alert, **parse_trace(line))
+                            untraced_alert = None
                                 
                         elif line == MANUAL_ALARM_PHRASE:
                             # 5-second debounce specific to manual alarm presses
@@ -0,0 +1,406 @@
+/******************************************************************************
+  * @file           : alert_test.c
+  * @brief          : Alert client vs. a local stand-in server, through the module mock
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Usage:  ./alert_test            run the scenarios below, exit 1 on failure
+ *         ./alert_test --serve    only run the stand-in server (prints frames,
+ *                                 acks them) for a board on the same network
+ *         ./alert_test --record f also write the AT traffic to f as a
+ *                                 transcript for replay_test
+ *
+ * The firmware's alert_client.c and wifi_async.c run on top of
+ * wifi_sim.c (SPI/DRDY timing) and wifi_mock.c (AT commands), so every
+ * byte goes through the same AT command sequence as on the board and
+ * ends up on a real TCP socket.
+ *
+ * Scenarios: boot and first delivery; connection dropped before the ack
+ * (retry, server de-duplicates); server down (backoff, then recovery);
+ * queue overflow; AP lost and re-joined; module not answering;
+ * idle heartbeat; a full queue behind a frame in flight giving up
+ * heartbeats and state changes before fall alerts.
+ */
+#include "alert_client.h"
+#include "wifi_mock.h"
+#include "wifi_sim.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// ======================= STAND-IN SERVER =========================
+
+#define MAX_FRAMES  64
+
+typedef struct {
+    uint8_t  type;
+    uint16_t seq;
+    uint32_t tick;
+    int16_t  v0, v1;
+    uint32_t event_us;
+} Frame_t;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static Frame_t frames[MAX_FRAMES];
+static int n_frames = 0;            // unique alerts delivered
+static int n_heartbeats = 0;
+static int n_dupes = 0;
+static int n_conns = 0;
+static int drop_next = 0;           // close the connection instead of acking this many frames
+static int listening = 0;
+static int verbose = 0;
+static int listen_fd = -1;
+static int last_seq = -1;
+
+static void Server_Listen(int on)
+{
+    pthread_mutex_lock(&lock);
+    if (on && listen_fd < 0) {
+        struct sockaddr_in sa;
+        int one = 1;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_port = htons(ALERT_SERVER_PORT);
+        sa.sin_addr.s_addr = htonl(INADDR_ANY);
+        listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (bind(listen_fd, (struct sockaddr *)&sa, sizeof(sa)) != 0 || listen(listen_fd, 4) != 0) {
+            perror("alert server");
+            exit(2);
+        }
+    } else if (!on && listen_fd >= 0) {
+        close(listen_fd);
+        listen_fd = -1;
+    }
+    listening = on;
+    pthread_mutex_unlock(&lock);
+}
+
+// Returns 0 when the connection should be closed
+static int Serve_Frame(int fd, const uint8_t *f)
+{
+    Frame_t fr;
+    fr.type = f[1];
+    fr.seq = (uint16_t)(f[2] | (f[3] << 8));
+    fr.tick = (uint32_t)f[4] | ((uint32_t)f[5] << 8) | ((uint32_t)f[6] << 16) | ((uint32_t)f[7] << 24);
+    fr.v0 = (int16_t)(f[8] | (f[9] << 8));
+    fr.v1 = (int16_t)(f[10] | (f[11] << 8));
+    fr.event_us = (uint32_t)f[12] | ((uint32_t)f[13] << 8) | ((uint32_t)f[14] << 16) | ((uint32_t)f[15] << 24);
+
+    pthread_mutex_lock(&lock);
+    if ((int)fr.seq <= last_seq) {
+        n_dupes++;
+    } else if (fr.type == ALERT_HEARTBEAT) {
+        last_seq = fr.seq;
+        n_heartbeats++;
+    } else {
+        last_seq = fr.seq;
+        if (n_frames < MAX_FRAMES) frames[n_frames] = fr;
+        n_frames++;
+        if (verbose) printf("[server] type %u seq %u tick %u v0 %d v1 %d\n",
+                            fr.type, fr.seq, fr.tick, fr.v0, fr.v1);
+    }
+    int drop = drop_next > 0;
+    if (drop) drop_next--;
+    pthread_mutex_unlock(&lock);
+
+    if (drop) return 0;
+    uint8_t ack[ALERT_ACK_SIZE] = { ALERT_ACK_MAGIC, fr.type, f[2], f[3] };
+    return send(fd, ack, sizeof(ack), MSG_NOSIGNAL) == (ssize_t)sizeof(ack);
+}
+
+static void *Server_Thread(void *arg)
+{
+    (void)arg;
+    int fd = -1;
+    uint8_t buf[ALERT_FRAME_SIZE];
+    uint32_t have = 0;
+
+    for (;;) {
+        pthread_mutex_lock(&lock);
+        int lfd = listen_fd;
+        pthread_mutex_unlock(&lock);
+
+        if (fd < 0) {
+            if (lfd < 0) { usleep(1000); continue; }
+            struct pollfd p = { lfd, POLLIN, 0 };
+            if (poll(&p, 1, 10) <= 0) continue;
+            fd = accept(lfd, NULL, NULL);
+            have = 0;
+            pthread_mutex_lock(&lock);
+            n_conns++;
+            pthread_mutex_unlock(&lock);
+            continue;
+        }
+
+        struct pollfd p = { fd, POLLIN, 0 };
+        if (poll(&p, 1, 10) <= 0) {
+            if (lfd < 0) { close(fd); fd = -1; }        // server "went down"
+            continue;
+        }
+        ssize_t n = recv(fd, buf + have, sizeof(buf) - have, 0);
+        if (n <= 0) { close(fd); fd = -1; continue; }
+        have += (uint32_t)n;
+        if (have < sizeof(buf)) continue;
+        have = 0;
+        if (buf[0] != ALERT_FRAME_MAGIC || !Serve_Frame(fd, buf)) { close(fd); fd = -1; }
+    }
+    return NULL;
+}
+
+// ======================= HELPERS =========================
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+static int Delivered(void)
+{
+    pthread_mutex_lock(&lock);
+    int n = n_frames;
+    pthread_mutex_unlock(&lock);
+    return n;
+}
+
+// Poll until the server has `want` frames (or the client reached `state`)
+static int Run_Until(int want, AlertState_t state, int max_polls)
+{
+    for (int i = 0; i < max_polls; i++) {
+        AlertClient_Poll();
+        if (want >= 0 && Delivered() >= want && AlertClient_GetState() == ALERT_READY) return 1;
+        if (want < 0 && AlertClient_GetState() == state) return 1;
+        usleep(500);
+    }
+    return 0;
+}
+
+// Poll while skipping the virtual clock past every backoff
+static void Run_Time(uint32_t ms, uint32_t step)
+{
+    for (uint32_t t = 0; t < ms; t += step) {
+        Sim_AdvanceMs(step);
+        AlertClient_Poll();
+    }
+}
+
+// ======================= SCENARIOS =========================
+
+static void Test_Boot_And_Deliver(void)
+{
+    printf("boot and first alert\n");
+    CHECK(AlertClient_Init(), "init failed");
+    CHECK(AlertClient_GetState() == ALERT_DOWN, "state %d after init", AlertClient_GetState());
+    CHECK(Run_Until(-1, ALERT_NO_AP, 100), "module reset not completed");
+    CHECK(Run_Until(-1, ALERT_READY, 100), "never connected");
+
+    AlertClient_Publish(ALERT_FALL, 2345, -1200, 0x89ABCDEFUL);
+    CHECK(Run_Until(1, ALERT_READY, 1000), "fall alert not delivered");
+
+    pthread_mutex_lock(&lock);
+    Frame_t f = frames[0];
+    pthread_mutex_unlock(&lock);
+    CHECK(f.type == ALERT_FALL && f.seq == 0 && f.v0 == 2345 && f.v1 == -1200 && f.event_us == 0x89ABCDEFUL,
+          "frame type %u seq %u v0 %d v1 %d event %08x", f.type, f.seq, f.v0, f.v1, f.event_us);
+
+    AlertStats_t st;
+    AlertClient_GetStats(&st);
+    CHECK(st.acked == 1 && st.sends == 1 && st.reconnects == 1, "acked %u sends %u reconnects %u",
+          st.acked, st.sends, st.reconnects);
+    printf("  delivered, publish->ack %u ms\n", st.last_latency_ms);
+}
+
+static void Test_Drop_Before_Ack(void)
+{
+    printf("connection dropped before the ack\n");
+    pthread_mutex_lock(&lock);
+    drop_next = 1;
+    pthread_mutex_unlock(&lock);
+
+    AlertClient_Publish(ALERT_MANUAL, 0, 0, 0);
+    // The server sees the frame then hangs up; the client notices, reconnects and resends
+    Run_Time(ALERT_ACK_TIMEOUT_MS + 4 * ALERT_BACKOFF_MIN_MS, 50);
+    CHECK(Run_Until(2, ALERT_READY, 1000), "not recovered");
+
+    AlertStats_t st;
+    AlertClient_GetStats(&st);
+    pthread_mutex_lock(&lock);
+    int dupes = n_dupes;
+    pthread_mutex_unlock(&lock);
+    CHECK(st.acked == 2 && st.sends >= 3, "acked %u sends %u", st.acked, st.sends);
+    CHECK(st.reconnects == 2, "reconnects %u", st.reconnects);
+    CHECK(dupes == 1, "server saw %d duplicates (want 1)", dupes);
+    CHECK(Delivered() == 2, "delivered %d", Delivered());
+}
+
+static void Test_Server_Down(void)
+{
+    printf("server down, backoff, recovery\n");
+    Server_Listen(0);
+    usleep(30000);                                  // server thread drops the live connection
+
+    AlertStats_t before, st;
+    AlertClient_GetStats(&before);
+    AlertClient_Publish(ALERT_RESET, 0, 0, 0);
+    Run_Time(60000, 100);
+    AlertClient_GetStats(&st);
+
+    // 60 s of doubling backoff from 0.5 s capped at 30 s: only a handful of attempts
+    uint32_t attempts = st.failures - before.failures;
+    CHECK(attempts >= 4 && attempts <= 9, "%u failed attempts in 60 s", attempts);
+    CHECK(AlertClient_GetState() == ALERT_NO_SOCKET, "state %d", AlertClient_GetState());
+    CHECK(Delivered() == 2, "delivered %d while down", Delivered());
+
+    Server_Listen(1);
+    Run_Time(ALERT_BACKOFF_MAX_MS + 1000, 100);
+    CHECK(Run_Until(3, ALERT_READY, 1000), "not delivered after the server came back");
+    printf("  %u failed attempts in 60 s, delivered after restart\n", attempts);
+}
+
+static void Test_Queue_Overflow(void)
+{
+    printf("queue overflow while the server is down\n");
+    Server_Listen(0);
+    usleep(30000);
+    Run_Time(ALERT_ACK_TIMEOUT_MS + 1000, 100);     // let the client notice
+
+    AlertStats_t before, st;
+    AlertClient_GetStats(&before);
+    for (int i = 0; i < ALERT_QUEUE_LEN + 2; i++) AlertClient_Publish(ALERT_FALL, (int16_t)i, 0, 0);
+
+    Server_Listen(1);
+    Run_Time(ALERT_BACKOFF_MAX_MS + 1000, 100);
+    CHECK(Run_Until(3 + ALERT_QUEUE_LEN, ALERT_READY, 5000), "queue not drained");
+    AlertClient_GetStats(&st);
+    CHECK(st.dropped - before.dropped == 2, "dropped %u", st.dropped - before.dropped);
+
+    // Oldest two were dropped: the survivors are values 2..9, in order
+    pthread_mutex_lock(&lock);
+    int in_order = 1;
+    for (int i = 0; i < ALERT_QUEUE_LEN; i++) in_order &= frames[3 + i].v0 == i + 2;
+    pthread_mutex_unlock(&lock);
+    CHECK(in_order, "survivors out of order");
+}
+
+static void Test_Ap_Lost(void)
+{
+    printf("access point lost and re-joined\n");
+    WifiMockStats_t m0, m1;
+    Mock_GetStats(&m0);
+    Mock_SetApUp(0);
+    AlertClient_Publish(ALERT_ARMED, 0, 0, 0);
+    Run_Time(20000, 100);
+    CHECK(AlertClient_GetState() == ALERT_NO_AP, "state %d with the AP down", AlertClient_GetState());
+
+    Mock_SetApUp(1);
+    Run_Time(ALERT_BACKOFF_MAX_MS + 1000, 100);
+    CHECK(Run_Until(4 + ALERT_QUEUE_LEN, ALERT_READY, 1000), "not delivered after re-join");
+    Mock_GetStats(&m1);
+    CHECK(m1.joins == m0.joins + 1, "joins %u -> %u", m0.joins, m1.joins);
+}
+
+static void Test_Module_Gone(void)
+{
+    printf("module stops answering\n");
+    WifiMockStats_t m0, m1;
+    Mock_GetStats(&m0);
+    Sim_SetModulePresent(0);
+    AlertClient_Publish(ALERT_DISARMED, 0, 0, 0);
+    Run_Time(10000, 100);
+    CHECK(AlertClient_GetState() == ALERT_DOWN, "state %d with the module gone", AlertClient_GetState());
+
+    Sim_SetModulePresent(1);
+    Run_Time(ALERT_BACKOFF_MAX_MS + 1000, 100);
+    CHECK(Run_Until(5 + ALERT_QUEUE_LEN, ALERT_READY, 1000), "not delivered after module reset");
+    Mock_GetStats(&m1);
+    CHECK(m1.resets > m0.resets, "module was not re-initialised");
+}
+
+static void Test_Heartbeat(void)
+{
+    printf("idle heartbeat\n");
+    pthread_mutex_lock(&lock);
+    int hb0 = n_heartbeats;
+    pthread_mutex_unlock(&lock);
+
+    Run_Time(ALERT_HEARTBEAT_MS + 100, 100);
+    for (int i = 0; i < 1000 && AlertClient_GetState() != ALERT_READY; i++) { AlertClient_Poll(); usleep(500); }
+
+    pthread_mutex_lock(&lock);
+    int hb = n_heartbeats - hb0;
+    pthread_mutex_unlock(&lock);
+    CHECK(hb == 1, "%d heartbeats after %d ms idle", hb, ALERT_HEARTBEAT_MS + 100);
+}
+
+static void Test_Queue_Priority(void)
+{
+    printf("full queue behind a frame in flight keeps the fall alerts\n");
+    int first = Delivered() + 1;                                // frames[] index of the first fall
+    AlertClient_Publish(ALERT_RESET, 100, 0, 0);
+    CHECK(Run_Until(-1, ALERT_WAIT_ACK, 1000), "reset frame never sent");
+
+    // No polls from here on: the reset stays in flight while the rest queue behind it
+    AlertStats_t before, st;
+    AlertClient_GetStats(&before);
+    AlertClient_Publish(ALERT_HEARTBEAT, 0, 0, 0);
+    for (int i = 1; i < ALERT_QUEUE_LEN - 1; i++) AlertClient_Publish(ALERT_ARMED, (int16_t)i, 0, 0);
+    AlertClient_Publish(ALERT_FALL, 200, 0, 0);                 // displaces the heartbeat
+    AlertClient_Publish(ALERT_FALL, 201, 0, 0);                 // then the oldest state change
+    AlertClient_Publish(ALERT_DISARMED, 7, 0, 0);               // a state change displaces another
+    for (int v = 202; v <= 206; v++) AlertClient_Publish(ALERT_FALL, (int16_t)v, 0, 0);
+    AlertClient_Publish(ALERT_ARMED, 8, 0, 0);                  // only alarms left: this one goes
+    AlertClient_GetStats(&st);
+    CHECK(st.dropped - before.dropped == ALERT_QUEUE_LEN + 1, "dropped %u", st.dropped - before.dropped);
+
+    CHECK(Run_Until(first + 7, ALERT_READY, 5000), "queue not drained");
+    pthread_mutex_lock(&lock);
+    int ok = n_frames == first + 7 && frames[first - 1].type == ALERT_RESET;
+    for (int i = 0; i < 7; i++) ok &= frames[first + i].type == ALERT_FALL && frames[first + i].v0 == 200 + i;
+    pthread_mutex_unlock(&lock);
+    CHECK(ok, "delivered %d frames, falls 200..206 not all there in order", Delivered());
+}
+
+int main(int argc, char **argv)
+{
+    pthread_t th;
+    Server_Listen(1);
+    pthread_create(&th, NULL, Server_Thread, NULL);
+
+    if (argc > 1 && strcmp(argv[1], "--serve") == 0) {
+        verbose = 1;
+        printf("alert server on port %d\n", ALERT_SERVER_PORT);
+        pthread_join(th, NULL);
+        return 0;
+    }
+    if (argc > 1 && strcmp(argv[1], "-v") == 0) Sim_SetTrace(1);
+    if (argc > 2 && strcmp(argv[1], "--record") == 0) Sim_Record(fopen(argv[2], "w"));
+    Sim_SetResponder(Mock_Respond);
+
+    Test_Boot_And_Deliver();
+    Test_Drop_Before_Ack();
+    Test_Server_Down();
+    Test_Queue_Overflow();
+    Test_Ap_Lost();
+    Test_Module_Gone();
+    Test_Heartbeat();
+    Test_Queue_Priority();
+
+    AlertStats_t st;
+    WifiMockStats_t m;
+    AlertClient_GetStats(&st);
+    Mock_GetStats(&m);
+    printf("\npublished %u acked %u sends %u dropped %u reconnects %u failures %u max latency %u ms\n",
+           st.published, st.acked, st.sends, st.dropped, st.reconnects, st.failures, st.max_latency_ms);
+    printf("module: %u AT commands, %u B out, %u B in\n", m.commands, m.bytes_sent, m.bytes_received);
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
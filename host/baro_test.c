@@ -0,0 +1,211 @@
+/******************************************************************************
+  * @file           : baro_test.c
+  * @brief          : Height-drop estimator against recorded pressure traces
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Usage:  ./baro_test [dir]     traces from dir (default: baro_traces)
+ *
+ * Each trace is raw LPS22HB pressure at 75 Hz ("ms raw" per line) with
+ * header lines naming the FSM trigger time and the expected outcome:
+ *
+ *   # trigger 3300
+ *   # expect drop | none
+ *
+ * The replay runs on a 1 ms virtual clock and hands samples over the way
+ * baro_fifo.c does: packed into 5-byte FIFO slots, one burst every
+ * BARO_BATCH_MS. The estimator must reach its verdict inside the FSM's
+ * falling window (falling_timeout_ms, 1500 ms by default).
+ */
+#include "height_drop.h"
+#include "baro_fifo.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SAMPLES         4096
+#define FALLING_WINDOW_MS   1500
+#define SAMPLE_PERIOD_MS    20      /* IMU sample period (config default) */
+#define BUS_BYTE_US_400K    23      /* 9 clocks at 400 kHz, rounded up */
+
+typedef struct {
+    uint32_t ms[MAX_SAMPLES];
+    int32_t  raw[MAX_SAMPLES];
+    uint32_t n;
+    uint32_t trigger;
+    int      expect_drop;
+} Trace_t;
+
+static Trace_t tr;
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+// ======================= HELPERS =========================
+
+static int Load(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+    if (!f) return 0;
+
+    memset(&tr, 0, sizeof(tr));
+    tr.expect_drop = -1;
+    while (fgets(line, sizeof(line), f)) {
+        char word[32];
+        unsigned long a, b;
+        if (sscanf(line, "# trigger %lu", &a) == 1) tr.trigger = (uint32_t)a;
+        else if (sscanf(line, "# expect %31s", word) == 1) tr.expect_drop = strcmp(word, "drop") == 0;
+        else if (line[0] != '#' && sscanf(line, "%lu %lu", &a, &b) == 2 && tr.n < MAX_SAMPLES) {
+            tr.ms[tr.n] = (uint32_t)a;
+            tr.raw[tr.n] = (int32_t)b;
+            tr.n++;
+        }
+    }
+    fclose(f);
+    return tr.n > 0 && tr.trigger > 0 && tr.expect_drop >= 0;
+}
+
+static void Put_Slot(uint8_t *slot, int32_t raw)
+{
+    slot[0] = (uint8_t)raw;
+    slot[1] = (uint8_t)(raw >> 8);
+    slot[2] = (uint8_t)(raw >> 16);
+    slot[3] = 0x10;             // temperature, ignored
+    slot[4] = 0x09;
+}
+
+// Replays one trace; returns ms from the trigger to the verdict, or -1 if none in the window
+static int32_t Replay(int32_t *drop_mm)
+{
+    uint8_t fifo[BARO_FIFO_DEPTH * BARO_SLOT_BYTES];
+    uint32_t next = 0;
+    int32_t verdict = -1;
+    uint32_t end = tr.ms[tr.n - 1];
+
+    HeightDrop_Init();
+    for (uint32_t t = 0; t <= end; t++) {
+        if (t == tr.trigger) HeightDrop_StartEvent(t);
+
+        if (t % BARO_BATCH_MS == 0 || t == end) {
+            uint32_t n = 0;
+            while (next < tr.n && tr.ms[next] <= t) {
+                if (n == BARO_FIFO_DEPTH) {         // stream mode keeps the newest
+                    memmove(fifo, fifo + BARO_SLOT_BYTES, (BARO_FIFO_DEPTH - 1) * BARO_SLOT_BYTES);
+                    n--;
+                }
+                Put_Slot(fifo + n * BARO_SLOT_BYTES, tr.raw[next]);
+                n++;
+                next++;
+            }
+            if (n) HeightDrop_FeedFifo(fifo, n, tr.ms[next - 1]);
+        }
+
+        if (t >= tr.trigger && verdict < 0 && HeightDrop_Seen()) verdict = (int32_t)(t - tr.trigger);
+        if (t == tr.trigger + FALLING_WINDOW_MS) {
+            *drop_mm = HeightDrop_GetDropMm();
+            return verdict;
+        }
+    }
+    *drop_mm = HeightDrop_GetDropMm();
+    return verdict;
+}
+
+// ======================= TESTS =========================
+
+static void Test_Trace(const char *dir, const char *name)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    printf("%s\n", name);
+    if (!Load(path)) {
+        CHECK(0, "cannot parse %s", path);
+        return;
+    }
+
+    int32_t drop_mm = 0;
+    int32_t verdict = Replay(&drop_mm);
+    if (verdict >= 0) printf("  drop %d mm, seen %d ms after the trigger\n", drop_mm, verdict);
+    else printf("  drop %d mm, not seen\n", drop_mm);
+
+    CHECK((verdict >= 0) == tr.expect_drop, "expected %s", tr.expect_drop ? "a height drop" : "no height drop");
+}
+
+static void Test_Fifo_Decode(void)
+{
+    uint8_t slot[BARO_SLOT_BYTES];
+    printf("FIFO slot decode and timestamps\n");
+
+    // Constant pressure: height 0, no drop, whatever the batching
+    HeightDrop_Init();
+    Put_Slot(slot, 4130816);
+    for (uint32_t k = 0; k < 10 * HEIGHT_DECIMATE; k++) HeightDrop_FeedFifo(slot, 1, k * 13);
+    CHECK(HeightDrop_GetHeightMm() == 0, "height %d mm", HeightDrop_GetHeightMm());
+    CHECK(HeightDrop_GetSamples() == 10 * HEIGHT_DECIMATE, "%u samples", HeightDrop_GetSamples());
+
+    // 1 hPa less is ~8.4 m up at 1008 hPa
+    for (uint32_t k = 0; k < 200; k++) {
+        Put_Slot(slot, 4130816 - 4096);
+        HeightDrop_FeedFifo(slot, 1, 1000 + k * 13);
+    }
+    int32_t h = HeightDrop_GetHeightMm();
+    CHECK(h > 8300 && h < 8450, "1 hPa -> %d mm", h);
+
+    // Negative raw values are not pressure and are dropped
+    Put_Slot(slot, -5);
+    HeightDrop_FeedFifo(slot, 1, 5000);
+    CHECK(HeightDrop_GetSamples() == 10 * HEIGHT_DECIMATE + 200, "negative sample taken");
+}
+
+static void Test_Bus_Budget(void)
+{
+    // Same arithmetic as BaroFifo_BusUsPerSecond() at 400 kHz
+    uint32_t bytes = HEIGHT_ODR_HZ * BARO_SLOT_BYTES + (7 * 1000 + BARO_BATCH_MS - 1) / BARO_BATCH_MS;
+    uint32_t us = bytes * BUS_BYTE_US_400K;
+    printf("bus budget\n  %u bytes/s, %u us/s of I2C2 at 400 kHz\n", bytes, us);
+    CHECK(us < SAMPLE_PERIOD_MS * 1000, "barometer costs %u us/s, more than one IMU period", us);
+    CHECK(BARO_BATCH_MS * HEIGHT_ODR_HZ / 1000 < BARO_FIFO_DEPTH, "FIFO overruns between batches");
+}
+
+// ======================= RUNNER =========================
+
+static int Cmp_Names(const void *a, const void *b)
+{
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+int main(int argc, char **argv)
+{
+    const char *dir = argc > 1 ? argv[1] : "baro_traces";
+    char *names[64];
+    int n = 0;
+
+    DIR *d = opendir(dir);
+    if (!d) {
+        printf("no trace directory %s\n", dir);
+        return 1;
+    }
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL && n < 64) {
+        size_t len = strlen(e->d_name);
+        if (len > 4 && strcmp(e->d_name + len - 4, ".csv") == 0) names[n++] = strdup(e->d_name);
+    }
+    closedir(d);
+    qsort(names, (size_t)n, sizeof(names[0]), Cmp_Names);
+
+    Test_Fifo_Decode();
+    Test_Bus_Budget();
+    for (int k = 0; k < n; k++) {
+        Test_Trace(dir, names[k]);
+        free(names[k]);
+    }
+    CHECK(n > 0, "no traces in %s", dir);
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
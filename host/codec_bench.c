@@ -0,0 +1,238 @@
+/******************************************************************************
+  * @file           : codec_bench.c
+  * @brief          : Compression ratio / throughput benchmark for imu_codec (Linux)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Usage:  ./codec_bench [trace ...]
+ *
+ * A trace is either a CSV log (one sample per line, ax,ay,az,gx,gy,gz
+ * and optionally sound and state; non-numeric lines are skipped) or a
+ * .bin file of raw little-endian int16[8] samples. Without arguments a
+ * synthetic 416 Hz trace is generated (standing, walking, a fall, lying
+ * still) so the numbers are reproducible. `make bench` runs the traces in
+ * imu_traces/ and ends with one summary line per trace for the mode the
+ * black box stores (Rice, order 1).
+ *
+ * For every mode (varint/Rice x order 1/2) it encodes with the same
+ * Core/Src/imu_codec.c that runs on the board, decodes with the fast and
+ * the scalar decoders, checks both bit-for-bit, and prints the ratio and
+ * MB/s of raw sample data through each side. The on-board encoder cost is
+ * printed by the firmware itself (DWT cycles, see blackbox.c).
+ */
+#include "imu_codec.h"
+#include "imu_decode.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_BLOCK         256         /* samples per block */
+#define BENCH_MIN_SECONDS   0.2
+
+typedef int16_t Sample_t[IMU_CODEC_CHANNELS];
+
+typedef struct {
+    double ratio, enc_mbs, dec_mbs;
+} Result_t;
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// ======================= TRACES =========================
+
+static Sample_t *Load_Trace(const char *path, size_t *n_out)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    size_t cap = 4096, n = 0;
+    Sample_t *s = malloc(cap * sizeof(Sample_t));
+    size_t plen = strlen(path);
+
+    if (plen > 4 && strcmp(path + plen - 4, ".bin") == 0) {
+        uint8_t raw[2 * IMU_CODEC_CHANNELS];
+        while (fread(raw, 1, sizeof(raw), f) == sizeof(raw)) {
+            if (n == cap) s = realloc(s, (cap *= 2) * sizeof(Sample_t));
+            for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++)
+                s[n][ch] = (int16_t)(raw[2 * ch] | (raw[2 * ch + 1] << 8));
+            n++;
+        }
+    } else {
+        char line[512];
+        while (fgets(line, sizeof(line), f)) {
+            double v[IMU_CODEC_CHANNELS] = { 0 };
+            int got = 0;
+            char *p = line;
+            while (got < IMU_CODEC_CHANNELS) {
+                char *q;
+                double x = strtod(p, &q);
+                if (q == p) break;
+                v[got++] = x;
+                p = q;
+                while (*p == ',' || *p == ' ' || *p == '\t') p++;
+            }
+            if (got < 6) continue;
+            if (n == cap) s = realloc(s, (cap *= 2) * sizeof(Sample_t));
+            for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) s[n][ch] = (int16_t)lrint(v[ch]);
+            n++;
+        }
+    }
+    fclose(f);
+    *n_out = n;
+    return s;
+}
+
+// 60 s at 416 Hz: stand, walk, fall, lie still. mg / dps / ADC counts.
+static Sample_t *Synth_Trace(size_t *n_out)
+{
+    const double fs = 416.0;
+    size_t n = (size_t)(60 * fs);
+    Sample_t *s = malloc(n * sizeof(Sample_t));
+    srand(2028);
+
+    for (size_t i = 0; i < n; i++) {
+        double t = (double)i / fs;
+        double ax = 0, ay = 0, az = 1000, gx = 0, gy = 0, gz = 0, snd = 40;
+        if (t >= 10 && t < 40) {                            // walking, ~1.8 Hz
+            double w = 2 * M_PI * 1.8 * t;
+            az += 250 * sin(w);  ax += 120 * sin(w / 2);
+            gy += 40 * sin(w / 2);  gz += 15 * cos(w);
+            snd += 60 * fabs(sin(w));
+        } else if (t >= 40 && t < 41.5) {                   // fall: freefall, impact, rotation
+            double u = t - 40;
+            if (u < 0.4)      { az = 150; gx = 350 * u / 0.4; }
+            else if (u < 0.5) { az = 3500 * sin(M_PI * (u - 0.4) / 0.1); gx = 350; snd = 3000; }
+            else              { ax = 1000 * (u - 0.5); az = 1000 - ax; gx = 350 * (1.5 - u); snd = 400; }
+        } else if (t >= 41.5) {                             // lying on the side
+            ax = 1000; az = 0;
+        }
+        double v[IMU_CODEC_CHANNELS] = { ax, ay, az, gx, gy, gz, snd, (t >= 40) ? 1 : 0 };
+        double noise[IMU_CODEC_CHANNELS] = { 4, 4, 4, 1.5, 1.5, 1.5, 10, 0 };
+        for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) {
+            double g = ((double)rand() / RAND_MAX + (double)rand() / RAND_MAX - 1.0) * noise[ch];
+            s[i][ch] = (int16_t)lrint(v[ch] + g);
+        }
+    }
+    *n_out = n;
+    return s;
+}
+
+// ======================= BENCH =========================
+
+// Every mode on one trace; *bb gets the black-box mode's numbers
+static int Bench(const char *name, const Sample_t *s, size_t n, Result_t *bb)
+{
+    static const struct { uint8_t flags; const char *label; } modes[] = {
+        { 0,                                 "varint o1" },
+        { IMU_CODEC_ORDER2,                  "varint o2" },
+        { IMU_CODEC_RICE,                    "rice   o1" },
+        { IMU_CODEC_RICE | IMU_CODEC_ORDER2, "rice   o2" },
+    };
+    size_t raw_bytes = n * sizeof(Sample_t);
+    size_t cap = n * IMU_CODEC_MAX_SAMPLE + (n / BENCH_BLOCK + 1) * (IMU_CODEC_HDR_SIZE + 1);
+    uint8_t *enc = malloc(cap);
+    Sample_t *dec = malloc(n * sizeof(Sample_t));
+    int failures = 0;
+
+    printf("\n%s: %zu samples (%.1f KB raw)\n", name, n, raw_bytes / 1024.0);
+    printf("  mode        ratio   enc MB/s   dec MB/s   scalar MB/s\n");
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        ImuEncoder_t e;
+        uint32_t len = 0;
+        int reps = 0;
+        double t0 = Now(), t1;
+        do {
+            ImuCodec_InitEncoder(&e, enc, (uint32_t)cap, modes[m].flags, BENCH_BLOCK);
+            for (size_t i = 0; i < n; i++) ImuCodec_Encode(&e, s[i]);
+            len = ImuCodec_Finish(&e);
+            reps++;
+        } while ((t1 = Now()) - t0 < BENCH_MIN_SECONDS);
+        double enc_mbs = raw_bytes * (double)reps / (t1 - t0) / 1e6;
+
+        reps = 0;
+        long got = 0;
+        t0 = Now();
+        do {
+            got = ImuDecode_Stream(enc, len, dec, (uint32_t)n);
+            reps++;
+        } while ((t1 = Now()) - t0 < BENCH_MIN_SECONDS);
+        double dec_mbs = raw_bytes * (double)reps / (t1 - t0) / 1e6;
+        int ok = (got == (long)n) && memcmp(dec, s, raw_bytes) == 0;
+
+        // Scalar reference, block by block
+        reps = 0;
+        int ok_scalar = 1;
+        t0 = Now();
+        do {
+            const uint8_t *p = enc;
+            uint32_t left = len, used;
+            size_t at = 0;
+            while (left > 0) {
+                int k = ImuDecode_BlockScalar(p, left, dec + at, (uint32_t)(n - at), &used);
+                if (k < 0) { ok_scalar = 0; break; }
+                at += (size_t)k; p += used; left -= used;
+            }
+            if (at != n) ok_scalar = 0;
+            reps++;
+        } while ((t1 = Now()) - t0 < BENCH_MIN_SECONDS);
+        double sc_mbs = raw_bytes * (double)reps / (t1 - t0) / 1e6;
+        ok_scalar = ok_scalar && memcmp(dec, s, raw_bytes) == 0;
+
+        printf("  %s  %6.2fx  %9.1f  %9.1f  %12.1f  %s\n", modes[m].label,
+               len ? (double)raw_bytes / len : 0.0, enc_mbs, dec_mbs, sc_mbs,
+               (ok && ok_scalar) ? "ok" : "MISMATCH");
+        if (!(ok && ok_scalar)) failures++;
+        if (modes[m].flags == IMU_CODEC_RICE) {
+            bb->ratio = len ? (double)raw_bytes / len : 0.0;
+            bb->enc_mbs = enc_mbs;
+            bb->dec_mbs = dec_mbs;
+        }
+    }
+
+    free(enc);
+    free(dec);
+    return failures;
+}
+
+int main(int argc, char **argv)
+{
+    int failures = 0;
+    Result_t bb[argc];
+
+    if (argc < 2) {
+        size_t n;
+        Sample_t *s = Synth_Trace(&n);
+        failures += Bench("synthetic 416 Hz (stand/walk/fall/lie)", s, n, &bb[0]);
+        free(s);
+        return failures ? 1 : 0;
+    }
+    for (int a = 1; a < argc; a++) {
+        size_t n;
+        Sample_t *s = Load_Trace(argv[a], &n);
+        memset(&bb[a], 0, sizeof(bb[a]));
+        if (!s || n == 0) {
+            fprintf(stderr, "%s: no samples\n", argv[a]);
+            failures++;
+            free(s);
+            continue;
+        }
+        failures += Bench(argv[a], s, n, &bb[a]);
+        free(s);
+    }
+
+    printf("\nrice o1 per trace          ratio   enc MB/s   dec MB/s\n");
+    for (int a = 1; a < argc; a++) {
+        const char *base = strrchr(argv[a], '/');
+        printf("  %-24s %6.2fx  %9.1f  %9.1f\n", base ? base + 1 : argv[a], bb[a].ratio, bb[a].enc_mbs,
+               bb[a].dec_mbs);
+    }
+    return failures ? 1 : 0;
+}
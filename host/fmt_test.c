@@ -0,0 +1,302 @@
+/******************************************************************************
+  * @file           : fmt_test.c
+  * @brief          : fmt.c against snprintf: digit-for-digit checks and a speed comparison
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Usage:  ./fmt_test [--bench]
+ *
+ * Every writer is compared with the printf conversion it replaces, on
+ * edge values and a few hundred thousand pseudo-random ones, Fmt_Float
+ * included: it must round exact binary ties to even like printf does.
+ *
+ * --bench times the 500 ms status line both ways. This is glibc, not
+ * newlib-nano; the firmware prints the on-target numbers itself when
+ * built with FMT_BENCH_NEWLIB (main.c).
+ */
+#include "fmt.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define RANDOM_VALUES       200000
+#define BENCH_MIN_SECONDS   0.2
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+static uint32_t rng = 2028;
+
+static uint32_t Rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// ======================= INTEGERS =========================
+
+static void Check_Uint(uint32_t v, int width, char pad)
+{
+    char got[32], want[32];
+    Fmt_t f;
+    Fmt_Init(&f, got, sizeof(got));
+    Fmt_UintPad(&f, v, width, pad);
+    Fmt_End(&f);
+    if (pad == '0') snprintf(want, sizeof(want), "%0*u", width, v);
+    else snprintf(want, sizeof(want), "%*u", width, v);
+    CHECK(strcmp(got, want) == 0, "%u width %d pad '%c': \"%s\", want \"%s\"", v, width, pad, got, want);
+}
+
+static void Check_Int(int32_t v)
+{
+    char got[32], want[32];
+    Fmt_t f;
+    Fmt_Init(&f, got, sizeof(got));
+    Fmt_Int(&f, v);
+    Fmt_End(&f);
+    snprintf(want, sizeof(want), "%d", v);
+    CHECK(strcmp(got, want) == 0, "%d: \"%s\"", v, got);
+}
+
+static void Check_Hex(uint32_t v, int digits)
+{
+    char got[32], want[32];
+    Fmt_t f;
+    Fmt_Init(&f, got, sizeof(got));
+    Fmt_Hex(&f, v, digits);
+    Fmt_End(&f);
+    snprintf(want, sizeof(want), "%0*x", digits, v);
+    CHECK(strcmp(got, want) == 0, "0x%x digits %d: \"%s\", want \"%s\"", v, digits, got, want);
+}
+
+static void Check_Fixed(int32_t v, int decimals)
+{
+    char got[32], want[32];
+    uint32_t scale = 1, m = v < 0 ? 0u - (uint32_t)v : (uint32_t)v;
+    for (int k = 0; k < decimals; k++) scale *= 10;
+    Fmt_t f;
+    Fmt_Init(&f, got, sizeof(got));
+    Fmt_Fixed(&f, v, decimals);
+    Fmt_End(&f);
+    if (decimals) snprintf(want, sizeof(want), "%s%u.%0*u", v < 0 ? "-" : "", m / scale, decimals, m % scale);
+    else snprintf(want, sizeof(want), "%d", v);
+    CHECK(strcmp(got, want) == 0, "%d / 10^%d: \"%s\", want \"%s\"", v, decimals, got, want);
+}
+
+static void Test_Integers(void)
+{
+    printf("integers, padding, hex, fixed point\n");
+    static const uint32_t edges[] = { 0, 1, 9, 10, 99, 100, 999999999, 1000000000, 2147483647u,
+                                      2147483648u, 4294967295u };
+    for (unsigned k = 0; k < sizeof(edges) / sizeof(edges[0]); k++) {
+        Check_Uint(edges[k], 0, ' ');
+        Check_Uint(edges[k], 5, '0');
+        Check_Uint(edges[k], 12, ' ');
+        Check_Int((int32_t)edges[k]);
+        Check_Int(-(int32_t)(edges[k] & 0x7FFFFFFF));
+        Check_Hex(edges[k], 1);
+        Check_Hex(edges[k], 6);
+        for (int d = 0; d <= FMT_MAX_DECIMALS; d++) {
+            Check_Fixed((int32_t)edges[k], d);
+            Check_Fixed(-(int32_t)(edges[k] & 0x7FFFFFFF), d);
+        }
+    }
+    Check_Int(INT32_MIN);
+    Check_Fixed(INT32_MIN, 3);
+
+    for (int k = 0; k < RANDOM_VALUES && failures < 20; k++) {
+        uint32_t v = Rand() >> (Rand() % 32);
+        Check_Uint(v, (int)(Rand() % 12), (Rand() & 1) ? '0' : ' ');
+        Check_Int((int32_t)Rand() >> (Rand() % 32));
+        Check_Hex(v, (int)(Rand() % 9));
+        Check_Fixed((int32_t)Rand() >> (Rand() % 32), (int)(Rand() % (FMT_MAX_DECIMALS + 1)));
+    }
+}
+
+// ======================= FLOATS =========================
+
+static void Check_Float(float v, int decimals)
+{
+    char got[48], want[48];
+    Fmt_t f;
+    if (fabsf(v) >= 4294967296.0f) return;         // saturates, checked below
+    Fmt_Init(&f, got, sizeof(got));
+    Fmt_Float(&f, v, decimals);
+    Fmt_End(&f);
+    snprintf(want, sizeof(want), "%.*f", decimals, (double)v);
+    CHECK(strcmp(got, want) == 0, "%.9g to %d decimals: \"%s\", want \"%s\"", (double)v, decimals, got, want);
+}
+
+static void Test_Floats(void)
+{
+    printf("floats against %%.Nf\n");
+    // Exact binary ties (0.5, 2.5, 0.125, ...), values just either side of them, denormals
+    static const float edges[] = { 0.0f, 0.5f, 1.5f, 2.5f, 0.25f, 0.75f, 0.125f, 0.375f, 0.0625f, 1.0f / 64,
+                                   0.004f, 0.005f, 0.995f, 0.9999999f, 1.0f, 9.8f, 9.81f, 12.345f, 99.995f,
+                                   123.45f, 1e6f, 16777216.0f, 4294967040.0f, 1e-30f, 1e-40f, 1.17549435e-38f };
+    for (unsigned k = 0; k < sizeof(edges) / sizeof(edges[0]); k++) {
+        for (int d = 0; d <= FMT_MAX_DECIMALS; d++) {
+            Check_Float(edges[k], d);
+            Check_Float(-edges[k], d);
+            Check_Float(nextafterf(edges[k], 0.0f), d);
+            Check_Float(nextafterf(edges[k], 1e10f), d);
+        }
+    }
+
+    int n = 0;
+    for (int k = 0; k < RANDOM_VALUES && failures < 20; k++) {
+        // Magnitudes the firmware prints (accel, gyro, angles) and a wider spread
+        uint32_t r = Rand();
+        float v = (k & 1) ? (float)(r % 400000) / 1000.0f
+                          : ldexpf((float)(r & 0xFFFFFF) / 16777216.0f, (int)(Rand() % 40) - 8);
+        if (Rand() & 1) v = -v;
+        Check_Float(v, 1);
+        Check_Float(v, 2);
+        Check_Float(v, (int)(Rand() % (FMT_MAX_DECIMALS + 1)));
+        n += 3;
+    }
+    printf("  %d values\n", n);
+
+    char got[32];
+    Fmt_t f;
+    Fmt_Init(&f, got, sizeof(got));
+    Fmt_Float(&f, NAN, 2);
+    Fmt_Char(&f, ' ');
+    Fmt_Float(&f, -INFINITY, 2);
+    Fmt_Char(&f, ' ');
+    Fmt_Float(&f, 1e20f, 1);
+    Fmt_End(&f);
+    CHECK(strcmp(got, "nan -inf 4294967295.0") == 0, "nan / inf / saturation: \"%s\"", got);
+}
+
+// ======================= TEXT AND BOUNDS =========================
+
+static void Test_Bounds(void)
+{
+    printf("padding, truncation, ring wrap\n");
+    char buf[16];
+    Fmt_t f;
+
+    Fmt_Init(&f, buf, sizeof(buf));
+    Fmt_StrPad(&f, "ALARM", 8);
+    Fmt_Char(&f, '|');
+    Fmt_StrPad(&f, "TOO LONG", 3);
+    Fmt_End(&f);
+    CHECK(strcmp(buf, "ALARM   |TOO LO") == 0 && f.lost == 2, "\"%s\" lost %u", buf, f.lost);
+
+    memset(buf, 'x', sizeof(buf));
+    Fmt_Init(&f, buf, 6);
+    Fmt_Str(&f, "12345678");
+    Fmt_End(&f);
+    CHECK(strcmp(buf, "12345") == 0 && f.lost == 3 && Fmt_Len(&f) == 5 && buf[6] == 'x',
+          "cut to \"%s\", lost %u", buf, f.lost);
+
+    Fmt_Init(&f, buf, 1);
+    Fmt_Uint(&f, 7);
+    CHECK(strcmp(Fmt_End(&f), "") == 0 && f.lost == 1, "one-byte buffer");
+
+    // Ring of 8 with free-running positions about to wrap: 6 free slots from head
+    char ring[8];
+    memset(ring, '.', sizeof(ring));
+    Fmt_InitRing(&f, ring, sizeof(ring), 0xFFFFFFFDUL, 3);
+    Fmt_Str(&f, "abc");
+    Fmt_Hex(&f, 0xde, 2);
+    Fmt_Int(&f, -5);
+    CHECK(memcmp(ring, "de-..abc", 8) == 0, "ring \"%.8s\"", ring);
+    CHECK(f.pos == 3 && Fmt_Len(&f) == 6 && f.lost == 1, "pos 0x%x len %u lost %u",
+          f.pos, Fmt_Len(&f), f.lost);
+}
+
+// ======================= BENCHMARK =========================
+
+static void Status_Fmt(char *line, uint32_t cap, uint32_t sound, float accel, float gyro)
+{
+    Fmt_t f;
+    Fmt_Init(&f, line, cap);
+    Fmt_Str(&f, "Sound:");
+    Fmt_Uint(&f, sound);
+    Fmt_Str(&f, " (floor ");
+    Fmt_Int(&f, 41);
+    Fmt_Str(&f, " dB, loud > ");
+    Fmt_Int(&f, 53);
+    Fmt_Str(&f, " dB) | Accel:");
+    Fmt_Float(&f, accel, 2);
+    Fmt_Str(&f, " | Gyro:");
+    Fmt_Float(&f, gyro, 2);
+    Fmt_Str(&f, "\r\n");
+    Fmt_End(&f);
+}
+
+static void Status_Printf(char *line, uint32_t cap, uint32_t sound, float accel, float gyro)
+{
+    snprintf(line, cap, "Sound:%u (floor %d dB, loud > %d dB) | Accel:%.2f | Gyro:%.2f\r\n",
+             sound, 41, 53, (double)accel, (double)gyro);
+}
+
+static double Time_Per_Line(void (*fn)(char *, uint32_t, uint32_t, float, float))
+{
+    char line[120];
+    volatile char sink = 0;
+    long n = 0;
+    double t0 = Now(), t;
+    do {
+        for (int k = 0; k < 10000; k++, n++) {
+            fn(line, sizeof(line), (uint32_t)k, 9.81f + (float)(k & 63) * 0.37f, (float)(k & 1023) * 0.71f);
+            sink ^= line[20];
+        }
+        t = Now() - t0;
+    } while (t < BENCH_MIN_SECONDS);
+    (void)sink;
+    return t / (double)n * 1e9;
+}
+
+static void Test_Status_Line(int bench)
+{
+    printf("status line, fmt.c vs snprintf\n");
+    char a[120], b[120];
+    for (int k = 0; k < 10000; k++) {
+        uint32_t sound = Rand() % 4096;
+        float accel = (float)(Rand() % 60000) / 1000.0f, gyro = (float)(Rand() % 2000000) / 1000.0f;
+        Status_Fmt(a, sizeof(a), sound, accel, gyro);
+        Status_Printf(b, sizeof(b), sound, accel, gyro);
+        if (strcmp(a, b) != 0) {
+            CHECK(0, "\"%s\" vs \"%s\"", a, b);
+            break;
+        }
+    }
+    if (!bench) return;
+
+    double t_fmt = Time_Per_Line(Status_Fmt);
+    double t_printf = Time_Per_Line(Status_Printf);
+    printf("  fmt.c %.0f ns/line, snprintf %.0f ns/line (%.1fx)\n", t_fmt, t_printf, t_printf / t_fmt);
+}
+
+// ======================= RUNNER =========================
+
+int main(int argc, char **argv)
+{
+    int bench = argc > 1 && strcmp(argv[1], "--bench") == 0;
+
+    Test_Integers();
+    Test_Floats();
+    Test_Bounds();
+    Test_Status_Line(bench);
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
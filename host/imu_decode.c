@@ -0,0 +1,273 @@
+/******************************************************************************
+  * @file           : imu_decode.c
+  * @brief          : Linux-side decoder for the imu_codec block stream
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * One sample is exactly IMU_CODEC_CHANNELS = 8 int16 = one 128-bit
+ * vector, so the fast decoder works a whole sample at a time with GCC
+ * vector extensions (SSE2 on x86-64, NEON on AArch64):
+ *
+ *   - varint: if the next 8 bytes all have the top bit clear (every
+ *     channel fitted in one byte, the usual case) they are widened and
+ *     un-zig-zagged as one vector; otherwise that sample falls back to
+ *     the byte loop.
+ *   - Rice: the unary prefix is read with one count-leading-zeros on a
+ *     64-bit bit window instead of bit by bit.
+ *   - Reconstruction (x += r, or d += r; x += d for order 2) is one or
+ *     two 8-lane adds per sample. int16 lanes wrap modulo 2^16, exactly
+ *     like the encoder's prediction.
+ *
+ * ImuDecode_BlockScalar() is the obvious per-value version, kept as the
+ * reference the benchmark checks the fast path against.
+ */
+#include "imu_decode.h"
+
+#include <string.h>
+
+typedef int16_t  v8i16 __attribute__((vector_size(16)));
+typedef uint16_t v8u16 __attribute__((vector_size(16)));
+typedef uint8_t  v8u8  __attribute__((vector_size(8)));
+
+typedef struct {
+    uint32_t count;
+    uint32_t size;
+    uint8_t  flags;
+} BlockHeader_t;
+
+static int Parse_Header(const uint8_t *in, uint32_t avail, uint32_t max_samples, BlockHeader_t *h)
+{
+    if (avail < IMU_CODEC_HDR_SIZE || in[0] != IMU_CODEC_MAGIC) return 0;
+    h->flags = in[1];
+    h->count = (uint32_t)in[2] | ((uint32_t)in[3] << 8);
+    h->size  = (uint32_t)in[4] | ((uint32_t)in[5] << 8);
+    if (h->count == 0 || h->count > max_samples) return 0;
+    if (h->size < IMU_CODEC_HDR_SIZE || h->size > avail) return 0;
+    return 1;
+}
+
+static void Read_First(const uint8_t *in, int16_t row[IMU_CODEC_CHANNELS])
+{
+    for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) {
+        row[ch] = (int16_t)((uint16_t)in[6 + 2 * ch] | ((uint16_t)in[7 + 2 * ch] << 8));
+    }
+}
+
+// ======================= REFERENCE (SCALAR) =========================
+
+int ImuDecode_BlockScalar(const uint8_t *in, uint32_t avail,
+                          int16_t (*out)[IMU_CODEC_CHANNELS], uint32_t max_samples,
+                          uint32_t *consumed)
+{
+    BlockHeader_t h;
+    if (!Parse_Header(in, avail, max_samples, &h)) return -1;
+
+    const uint8_t *p = in + IMU_CODEC_HDR_SIZE;
+    const uint8_t *end = in + h.size;
+    uint32_t bitpos = 0;                        // Rice: bit offset from p
+
+    int16_t prev[IMU_CODEC_CHANNELS], delta[IMU_CODEC_CHANNELS];
+    uint32_t ra[IMU_CODEC_CHANNELS], rn[IMU_CODEC_CHANNELS];
+    Read_First(in, out[0]);
+    for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) {
+        prev[ch] = out[0][ch];
+        delta[ch] = 0;
+        ra[ch] = IMU_CODEC_RICE_A_INIT;
+        rn[ch] = 1;
+    }
+
+    for (uint32_t t = 1; t < h.count; t++) {
+        for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) {
+            uint16_t zz = 0;
+            if (h.flags & IMU_CODEC_RICE) {
+                uint32_t k = ImuCodec_RiceK(ra[ch], rn[ch]);
+                uint32_t q = 0, nraw;
+                for (;;) {
+                    if (p + (bitpos >> 3) >= end) return -1;
+                    int bit = (p[bitpos >> 3] >> (7 - (bitpos & 7))) & 1;
+                    if (!bit) break;
+                    bitpos++;
+                    if (++q == IMU_CODEC_RICE_ESCAPE) break;
+                }
+                if (q < IMU_CODEC_RICE_ESCAPE) bitpos++;      // the terminating zero
+                nraw = (q < IMU_CODEC_RICE_ESCAPE) ? k : 16;
+                uint32_t v = 0;
+                for (uint32_t b = 0; b < nraw; b++, bitpos++) {
+                    if (p + (bitpos >> 3) >= end) return -1;
+                    v = (v << 1) | ((p[bitpos >> 3] >> (7 - (bitpos & 7))) & 1);
+                }
+                zz = (q < IMU_CODEC_RICE_ESCAPE) ? (uint16_t)((q << k) | v) : (uint16_t)v;
+                ra[ch] += zz;
+                if (++rn[ch] == IMU_CODEC_RICE_N_MAX) { ra[ch] >>= 1; rn[ch] >>= 1; }
+            } else {
+                uint32_t v = 0, shift = 0;
+                for (;;) {
+                    if (p >= end || shift > 14) return -1;
+                    uint8_t b = *p++;
+                    v |= (uint32_t)(b & 0x7F) << shift;
+                    if (!(b & 0x80)) break;
+                    shift += 7;
+                }
+                zz = (uint16_t)v;
+            }
+
+            int16_t pred = prev[ch];
+            if (h.flags & IMU_CODEC_ORDER2) pred = (int16_t)(pred + delta[ch]);
+            int16_t x = (int16_t)(pred + ImuCodec_UnZigZag(zz));
+            delta[ch] = (int16_t)(x - prev[ch]);
+            prev[ch] = x;
+            out[t][ch] = x;
+        }
+    }
+
+    if (h.flags & IMU_CODEC_RICE) p += (bitpos + 7) >> 3;
+    if (p != end) return -1;
+    *consumed = h.size;
+    return (int)h.count;
+}
+
+// ======================= FAST PATH =========================
+
+static inline v8i16 UnZigZag_Vec(v8u16 u)
+{
+    return (v8i16)((u >> 1) ^ (v8u16)(-(v8i16)(u & 1)));
+}
+
+// 64-bit MSB-first bit window over [p, end); reads past end see zeros
+typedef struct {
+    const uint8_t *p;
+    const uint8_t *end;
+    uint64_t buf;
+    uint32_t bits;          // valid bits in buf
+    uint32_t used;          // total bits consumed
+} BitReader_t;
+
+static inline void Br_Refill(BitReader_t *br)
+{
+    while (br->bits <= 56) {
+        uint64_t b = (br->p < br->end) ? *br->p : 0;
+        br->p++;
+        br->buf |= b << (56 - br->bits);
+        br->bits += 8;
+    }
+}
+
+static inline uint32_t Br_Take(BitReader_t *br, uint32_t n)
+{
+    uint32_t v = n ? (uint32_t)(br->buf >> (64 - n)) : 0;
+    br->buf <<= n;
+    br->bits -= n;
+    br->used += n;
+    return v;
+}
+
+static int Decode_Rice(const uint8_t *p, const uint8_t *end, uint32_t count,
+                       int16_t (*out)[IMU_CODEC_CHANNELS])
+{
+    BitReader_t br = { p, end, 0, 0, 0 };
+    uint32_t ra[IMU_CODEC_CHANNELS], rn[IMU_CODEC_CHANNELS];
+    for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) { ra[ch] = IMU_CODEC_RICE_A_INIT; rn[ch] = 1; }
+
+    uint64_t limit = (uint64_t)(end - p) * 8;
+    for (uint32_t t = 1; t < count; t++) {
+        for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) {
+            Br_Refill(&br);                                 // >= 57 bits: enough for one value
+            uint32_t k = ImuCodec_RiceK(ra[ch], rn[ch]);
+            uint32_t q = (uint32_t)__builtin_clzll(~br.buf | 1);   // leading ones
+            uint16_t zz;
+            if (q < IMU_CODEC_RICE_ESCAPE) {
+                Br_Take(&br, q + 1);
+                zz = (uint16_t)((q << k) | Br_Take(&br, k));
+            } else {
+                Br_Take(&br, IMU_CODEC_RICE_ESCAPE);
+                zz = (uint16_t)Br_Take(&br, 16);
+            }
+            if (br.used > limit) return 0;
+            ra[ch] += zz;
+            if (++rn[ch] == IMU_CODEC_RICE_N_MAX) { ra[ch] >>= 1; rn[ch] >>= 1; }
+            out[t][ch] = (int16_t)zz;                       // zig-zag value for now
+        }
+    }
+    return ((br.used + 7) >> 3) == (uint64_t)(end - p);
+}
+
+static int Decode_Varint(const uint8_t *p, const uint8_t *end, uint32_t count,
+                         int16_t (*out)[IMU_CODEC_CHANNELS])
+{
+    for (uint32_t t = 1; t < count; t++) {
+        uint64_t word;
+        if (end - p >= 8 && (memcpy(&word, p, 8), (word & 0x8080808080808080ULL) == 0)) {
+            v8u8 b;
+            memcpy(&b, p, 8);
+            v8u16 zz = __builtin_convertvector(b, v8u16);
+            memcpy(out[t], &zz, sizeof(zz));
+            p += 8;
+            continue;
+        }
+        for (int ch = 0; ch < IMU_CODEC_CHANNELS; ch++) {
+            uint32_t v = 0, shift = 0;
+            for (;;) {
+                if (p >= end || shift > 14) return 0;
+                uint8_t b = *p++;
+                v |= (uint32_t)(b & 0x7F) << shift;
+                if (!(b & 0x80)) break;
+                shift += 7;
+            }
+            out[t][ch] = (int16_t)v;
+        }
+    }
+    return p == end;
+}
+
+int ImuDecode_Block(const uint8_t *in, uint32_t avail,
+                    int16_t (*out)[IMU_CODEC_CHANNELS], uint32_t max_samples,
+                    uint32_t *consumed)
+{
+    BlockHeader_t h;
+    if (!Parse_Header(in, avail, max_samples, &h)) return -1;
+
+    const uint8_t *p = in + IMU_CODEC_HDR_SIZE;
+    const uint8_t *end = in + h.size;
+    int ok = (h.flags & IMU_CODEC_RICE) ? Decode_Rice(p, end, h.count, out)
+                                        : Decode_Varint(p, end, h.count, out);
+    if (!ok) return -1;
+
+    // Rows 1..n-1 hold zig-zag residuals: un-map and integrate, 8 lanes at a time
+    v8i16 x, d = { 0 };
+    Read_First(in, out[0]);
+    memcpy(&x, out[0], sizeof(x));
+    if (h.flags & IMU_CODEC_ORDER2) {
+        for (uint32_t t = 1; t < h.count; t++) {
+            v8u16 zz;
+            memcpy(&zz, out[t], sizeof(zz));
+            d += UnZigZag_Vec(zz);
+            x += d;
+            memcpy(out[t], &x, sizeof(x));
+        }
+    } else {
+        for (uint32_t t = 1; t < h.count; t++) {
+            v8u16 zz;
+            memcpy(&zz, out[t], sizeof(zz));
+            x += UnZigZag_Vec(zz);
+            memcpy(out[t], &x, sizeof(x));
+        }
+    }
+
+    *consumed = h.size;
+    return (int)h.count;
+}
+
+long ImuDecode_Stream(const uint8_t *in, uint32_t len,
+                      int16_t (*out)[IMU_CODEC_CHANNELS], uint32_t max_samples)
+{
+    long total = 0;
+    while (len > 0) {
+        uint32_t used;
+        int n = ImuDecode_Block(in, len, out + total, max_samples - (uint32_t)total, &used);
+        if (n < 0) return -1;
+        total += n;
+        in += used;
+        len -= used;
+    }
+    return total;
+}
@@ -0,0 +1,38 @@
+/******************************************************************************
+  * @file           : imu_decode.h
+  * @brief          : Linux-side decoder for the imu_codec block stream
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __IMU_DECODE_H
+#define __IMU_DECODE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "imu_codec.h"
+
+/*
+ * Decode one block starting at in[0]. Writes up to max_samples rows of
+ * IMU_CODEC_CHANNELS int16 to out and returns the sample count, or -1 on
+ * a malformed/truncated block. *consumed gets the block length in bytes.
+ */
+int ImuDecode_Block(const uint8_t *in, uint32_t avail,
+                    int16_t (*out)[IMU_CODEC_CHANNELS], uint32_t max_samples,
+                    uint32_t *consumed);
+
+/* Straightforward per-value reference decoder, used to cross-check the fast one. */
+int ImuDecode_BlockScalar(const uint8_t *in, uint32_t avail,
+                          int16_t (*out)[IMU_CODEC_CHANNELS], uint32_t max_samples,
+                          uint32_t *consumed);
+
+/* Whole stream (back-to-back blocks); returns total samples or -1. */
+long ImuDecode_Stream(const uint8_t *in, uint32_t len,
+                      int16_t (*out)[IMU_CODEC_CHANNELS], uint32_t max_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IMU_DECODE_H */
@@ -0,0 +1,413 @@
+/******************************************************************************
+  * @file           : kernel_bench.c
+  * @brief          : Per-sample cost of the detection kernels, with a regression check (Linux)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Usage:  ./kernel_bench [--check baseline] [--save baseline] [--tolerance pct]
+ *
+ * Runs the portable per-sample kernels of Detect_Sample() over a
+ * synthetic 10 minute trace at 50 Hz (standing, walking, loud falls,
+ * silent falls with and without recovery) and prints ns/sample and
+ * samples/s for each: the moving average (mov_avg_C, and mov_avg.s when
+ * built for ARM), the accel / gyro magnitudes, the sound-envelope stage
+ * (noise-floor update + loud test on the peak-to-peak value), the posture
+ * filter, the fall FSM step, and the whole chain in firmware order.
+ *
+ * Each kernel is timed BENCH_ROUNDS times and the best round is kept.
+ * --check compares against a saved baseline and exits 1 when a kernel is
+ * more than --tolerance percent (default 25) slower, after up to
+ * BENCH_RETRIES more timings of that kernel; --save writes a baseline.
+ * Baselines only mean something on the machine and compiler that wrote
+ * them: kernel_bench.baseline is the x86-64 gcc -O2 one `make bench`
+ * checks; `make bench-arm` writes kernel_bench_arm.baseline under qemu-arm
+ * on its first run and checks against it after that.
+ *
+ * The on-board numbers are the detect cycles in the minute dump (main.c).
+ */
+#include "fall_detect.h"
+#include "noise_floor.h"
+#include "posture.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define TRACE_HZ            50
+#define TRACE_SECONDS       600
+#define TRACE_SAMPLES       (TRACE_HZ * TRACE_SECONDS)
+#define CYCLE_SAMPLES       (TRACE_HZ * 30)     /* one stand / walk / fall cycle of Synth_Trace() */
+#define MOV_AVG_N           4           /* as Detect_Sample() */
+#define BENCH_MIN_SECONDS   0.02        /* per round */
+#define BENCH_ROUNDS        15
+#define BENCH_RETRIES       3           /* re-timings of a kernel over tolerance before it fails */
+#define BENCH_TOLERANCE     25.0        /* percent slower than the baseline that fails --check */
+#define MAX_KERNELS         16
+
+#ifdef KERNEL_BENCH_ASM
+extern int mov_avg(int N, int* accel_buff);
+#endif
+
+typedef struct {
+    int16_t  accel_mg[3];
+    float    gyro_dps[3];
+    uint32_t sound;                     // peak-to-peak ADC counts over the sound window
+} TraceSample_t;
+
+typedef struct {
+    const char *name;
+    void      (*run)(void);
+    double      ns;                     // best round, per sample
+} Result_t;
+
+static TraceSample_t trace[TRACE_SAMPLES];
+static FallInput_t fsm_in[TRACE_SAMPLES];
+static float accel_ms2[TRACE_SAMPLES][3];
+static ConfigRecord_t cfg;
+static volatile float sink_f;
+static volatile int sink_i;
+
+static Result_t results[MAX_KERNELS];
+static int n_results = 0;
+
+static uint32_t rng = 2028;
+
+static uint32_t Rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+// Roughly triangular noise in [-amp, amp]
+static double Noise(double amp)
+{
+    return ((double)(Rand() & 0xFFFF) + (double)(Rand() & 0xFFFF)) / 65535.0 * amp - amp;
+}
+
+static double Now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// ======================= TRACE =========================
+
+/*
+ * 30 s cycles: 10 s standing, 10 s walking, then a fall. The fall kind
+ * rotates: loud crash, silent fall that gets back up, silent fall that
+ * stays down (every other time with a late crash). mg / dps / ADC counts, as acquisition hands them over. The
+ * runs reset an alarm at the start of the next cycle, like one button
+ * press.
+ */
+static void Synth_Trace(void)
+{
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        double t = (double)i / TRACE_HZ;
+        int cycle = i / CYCLE_SAMPLES;
+        double u = t - cycle * 30.0;
+        double ax = 0, ay = 0, az = 1000, gx = 0, gy = 0, gz = 0, snd = 40;
+
+        if (u >= 10 && u < 20) {                            // walking, ~1.8 Hz
+            double w = 2 * M_PI * 1.8 * u;
+            az += 250 * sin(w);  ax += 120 * sin(w / 2);
+            gy += 40 * sin(w / 2);  gz += 15 * cos(w);
+            snd += 60 * fabs(sin(w));
+        } else if (u >= 20 && u < 21.5) {                   // freefall, impact, rotation
+            double v = u - 20;
+            int loud = cycle % 3 == 0;
+            if (v < 0.4)      { az = 150; gx = 450 * v / 0.4; }
+            else if (v < 0.5) { az = 3500; gx = 450; snd = loud ? 3000 : 80; }
+            else              { ax = 1000 * (v - 0.5); az = 1000 - ax; gx = 450 * (1.5 - v); }
+        } else if (u >= 21.5) {                             // lying on the side...
+            ax = 1000; az = 0;
+            if (cycle % 6 == 5 && u >= 22 && u < 22.1) snd = 3000;   // something knocked over
+            if (cycle % 3 == 1 && u >= 25 && u < 26) {      // ...or pushing up and standing
+                ax = 0; az = 1600 * sin(M_PI * (u - 25)) + 1000;
+            } else if (cycle % 3 == 1 && u >= 26) {
+                ax = 0; az = 1000;
+            }
+        }
+
+        double a[3] = { ax, ay, az }, g[3] = { gx, gy, gz };
+        for (int k = 0; k < 3; k++) {
+            trace[i].accel_mg[k] = (int16_t)lrint(a[k] + Noise(4));
+            trace[i].gyro_dps[k] = (float)(g[k] + Noise(1.5));
+        }
+        trace[i].sound = (uint32_t)lrint(snd + 10 + Noise(10));
+    }
+}
+
+// Moving average, magnitudes, posture and noise floor once, for the kernels timed on their own
+static void Prepare_Inputs(void)
+{
+    int buf[3][MOV_AVG_N] = { { 0 } };
+
+    Posture_Init();
+    NoiseFloor_Init();
+    NoiseFloor_SetMarginDb(cfg.loud_margin_db);
+
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        for (int k = 0; k < 3; k++) {
+            buf[k][i % MOV_AVG_N] = trace[i].accel_mg[k];
+            accel_ms2[i][k] = (float)mov_avg_C(MOV_AVG_N, buf[k]) * (9.8f / 1000.0f);
+        }
+        Posture_Update(trace[i].accel_mg);
+        NoiseFloor_Update(trace[i].sound);
+
+        FallInput_t *in = &fsm_in[i];
+        memset(in, 0, sizeof(*in));
+        in->sample_us = (uint32_t)i * (1000000 / TRACE_HZ);
+        in->total_accel = FallDetect_Magnitude(accel_ms2[i][0], accel_ms2[i][1], accel_ms2[i][2]);
+        in->total_gyro = FallDetect_Magnitude(trace[i].gyro_dps[0], trace[i].gyro_dps[1], trace[i].gyro_dps[2]);
+        in->loud = (uint8_t)NoiseFloor_IsLoud(trace[i].sound);
+        in->posture_delta = (int32_t)(fabsf(accel_ms2[i][0]) > 4.9f ? 900 : 0);   // on the side
+        in->rotation_deg = fabsf(trace[i].gyro_dps[0]) > 200.0f ? 60.0f : 0.0f;
+    }
+}
+
+// ======================= KERNELS =========================
+
+// Three axes pushed and averaged per sample, as Detect_Sample() does
+static void Run_MovAvgC(void)
+{
+    static int buf[3][MOV_AVG_N];
+    int acc = 0;
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        for (int k = 0; k < 3; k++) {
+            buf[k][i % MOV_AVG_N] = trace[i].accel_mg[k];
+            acc += mov_avg_C(MOV_AVG_N, buf[k]);
+        }
+    }
+    sink_i = acc;
+}
+
+#ifdef KERNEL_BENCH_ASM
+static void Run_MovAvgAsm(void)
+{
+    static int buf[3][MOV_AVG_N];
+    int acc = 0;
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        for (int k = 0; k < 3; k++) {
+            buf[k][i % MOV_AVG_N] = trace[i].accel_mg[k];
+            acc += mov_avg(MOV_AVG_N, buf[k]);
+        }
+    }
+    sink_i = acc;
+}
+#endif
+
+static void Run_Magnitude(void)
+{
+    float acc = 0.0f;
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        const float *a = accel_ms2[i], *g = trace[i].gyro_dps;
+        acc += FallDetect_Magnitude(a[0], a[1], a[2]);
+        acc += FallDetect_Magnitude(g[0], g[1], g[2]);
+    }
+    sink_f = acc;
+}
+
+static void Run_SoundFloor(void)
+{
+    int loud = 0;
+    NoiseFloor_Init();
+    NoiseFloor_SetMarginDb(cfg.loud_margin_db);
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        NoiseFloor_Update(trace[i].sound);
+        loud += NoiseFloor_IsLoud(trace[i].sound);
+    }
+    sink_i = loud;
+}
+
+static void Run_Posture(void)
+{
+    Posture_Init();
+    for (int i = 0; i < TRACE_SAMPLES; i++) Posture_Update(trace[i].accel_mg);
+}
+
+static int fsm_events[FALL_EV_STILL + 1];
+
+static void Run_FsmStep(void)
+{
+    FallDetect_t d;
+    int countdown;
+    FallDetect_Init(&d);
+    memset(fsm_events, 0, sizeof(fsm_events));
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        if (i % CYCLE_SAMPLES == 0 && d.state == STATE_CONFIRMED) d.state = STATE_NORMAL;
+        fsm_events[FallDetect_Step(&d, &fsm_in[i], &cfg, &countdown)]++;
+    }
+    sink_i = d.state;
+}
+
+// Everything above in the order Detect_Sample() runs it, reading the posture delta only when it is used
+static void Run_Chain(void)
+{
+    static int buf[3][MOV_AVG_N];
+    FallDetect_t d;
+    int countdown, events = 0;
+
+    FallDetect_Init(&d);
+    Posture_Init();
+    NoiseFloor_Init();
+    NoiseFloor_SetMarginDb(cfg.loud_margin_db);
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        float a[3];
+        for (int k = 0; k < 3; k++) {
+            buf[k][i % MOV_AVG_N] = trace[i].accel_mg[k];
+            a[k] = (float)mov_avg_C(MOV_AVG_N, buf[k]) * (9.8f / 1000.0f);
+        }
+        Posture_Update(trace[i].accel_mg);
+        NoiseFloor_Update(trace[i].sound);
+
+        FallInput_t in = fsm_in[i];
+        in.total_accel = FallDetect_Magnitude(a[0], a[1], a[2]);
+        in.total_gyro = FallDetect_Magnitude(trace[i].gyro_dps[0], trace[i].gyro_dps[1], trace[i].gyro_dps[2]);
+        if (d.state == STATE_STILLNESS_CHECK) in.posture_delta = Posture_GetDelta();
+        if (d.state == STATE_FALLING || d.state == STATE_STILLNESS_CHECK)
+            in.loud = (uint8_t)NoiseFloor_IsLoud(trace[i].sound);
+        if (i % CYCLE_SAMPLES == 0 && d.state == STATE_CONFIRMED) d.state = STATE_NORMAL;
+        if (FallDetect_Step(&d, &in, &cfg, &countdown) == FALL_EV_TRIGGER) Posture_CaptureReference();
+        events += d.state;
+    }
+    sink_i = events;
+}
+
+// ======================= TIMING =========================
+
+static double Time_Best(void (*run)(void))
+{
+    double best = 1e30;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        int passes = 0;
+        double t0 = Now(), t1;
+        do {
+            run();
+            passes++;
+        } while ((t1 = Now()) - t0 < BENCH_MIN_SECONDS);
+        double ns = (t1 - t0) * 1e9 / ((double)passes * TRACE_SAMPLES);
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+static void Bench(const char *name, void (*run)(void))
+{
+    Result_t *r = &results[n_results++];
+    r->name = name;
+    r->run = run;
+    r->ns = Time_Best(run);
+    printf("  %-14s %9.2f %12.2f\n", name, r->ns, 1e3 / r->ns);
+}
+
+// ======================= BASELINES =========================
+
+static int Save_Baseline(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f) { perror(path); return 1; }
+    fprintf(f, "# kernel_bench baseline: best-of-%d ns/sample, rewrite with --save\n", BENCH_ROUNDS);
+    for (int i = 0; i < n_results; i++) fprintf(f, "%-14s %.2f\n", results[i].name, results[i].ns);
+    fclose(f);
+    printf("\nbaseline written to %s\n", path);
+    return 0;
+}
+
+static int Check_Baseline(const char *path, double tolerance)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) { perror(path); return 1; }
+
+    char line[128], name[64];
+    double base[MAX_KERNELS];
+    int found[MAX_KERNELS] = { 0 };
+    while (fgets(line, sizeof(line), f)) {
+        double ns;
+        if (line[0] == '#' || sscanf(line, "%63s %lf", name, &ns) != 2) continue;
+        for (int i = 0; i < n_results; i++) {
+            if (strcmp(results[i].name, name) == 0) { base[i] = ns; found[i] = 1; }
+        }
+    }
+    fclose(f);
+
+    int regressions = 0;
+    printf("\nagainst %s (fail above +%.0f%%):\n", path, tolerance);
+    for (int i = 0; i < n_results; i++) {
+        if (!found[i]) {
+            printf("  %-14s     (no baseline)\n", results[i].name);
+            continue;
+        }
+        // A slow result is timed again before it counts: one busy moment on the host is not a regression
+        for (int retry = 0; retry < BENCH_RETRIES && results[i].ns > base[i] * (1.0 + tolerance / 100.0); retry++) {
+            double ns = Time_Best(results[i].run);
+            if (ns < results[i].ns) results[i].ns = ns;
+        }
+        double change = (results[i].ns / base[i] - 1.0) * 100.0;
+        int bad = change > tolerance;
+        printf("  %-14s %+7.1f%%  %s\n", results[i].name, change, bad ? "REGRESSED" : "ok");
+        regressions += bad;
+    }
+    return regressions ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *check = NULL, *save = NULL;
+    double tolerance = BENCH_TOLERANCE;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--check") == 0 && i + 1 < argc)          check = argv[++i];
+        else if (strcmp(argv[i], "--save") == 0 && i + 1 < argc)      save = argv[++i];
+        else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) tolerance = atof(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [--check baseline] [--save baseline] [--tolerance pct]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    cfg.thresholds.accel_high = 20.0f;          // config_store.c defaults
+    cfg.thresholds.accel_low = 5.0f;
+    cfg.thresholds.gyro = 400.0f;
+    cfg.thresholds.recovery_dev = 4.5f;
+    cfg.falling_timeout_ms = 1500;
+    cfg.stillness_window_ms = 5000;
+    cfg.late_sound_window_ms = 2000;
+    cfg.loud_margin_db = 15;
+
+    Synth_Trace();
+    Prepare_Inputs();
+
+    printf("%d samples (%d s at %d Hz), best of %d rounds\n", TRACE_SAMPLES, TRACE_SECONDS, TRACE_HZ, BENCH_ROUNDS);
+    printf("  kernel         ns/sample    Msamples/s\n");
+    Bench("mov_avg_C", Run_MovAvgC);
+#ifdef KERNEL_BENCH_ASM
+    Bench("mov_avg_asm", Run_MovAvgAsm);
+#endif
+    Bench("magnitude", Run_Magnitude);
+    Bench("sound_floor", Run_SoundFloor);
+    Bench("posture", Run_Posture);
+    Bench("fsm_step", Run_FsmStep);
+    Bench("detect_chain", Run_Chain);
+
+    // A trace that never leaves NORMAL would time only the cheapest branch
+    printf("\nFSM events over the trace: %d triggers, %d crashes, %d silent falls, %d timeouts, "
+           "%d delayed crashes, %d recoveries, %d still\n",
+           fsm_events[FALL_EV_TRIGGER], fsm_events[FALL_EV_CRASH], fsm_events[FALL_EV_SILENT_FALL],
+           fsm_events[FALL_EV_TIMEOUT], fsm_events[FALL_EV_DELAYED_CRASH], fsm_events[FALL_EV_RECOVERED],
+           fsm_events[FALL_EV_STILL]);
+    if (!fsm_events[FALL_EV_SILENT_FALL] || !fsm_events[FALL_EV_RECOVERED] ||
+        !(fsm_events[FALL_EV_CRASH] + fsm_events[FALL_EV_DELAYED_CRASH])) {
+        printf("FAIL: the trace does not reach every FSM state\n");
+        return 1;
+    }
+
+    int rc = 0;
+    if (check) rc = Check_Baseline(check, tolerance);
+    if (save) rc |= Save_Baseline(save);
+    return rc;
+}
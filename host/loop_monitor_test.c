@@ -0,0 +1,171 @@
+/******************************************************************************
+  * @file           : loop_monitor_test.c
+  * @brief          : Sample-loop interval and deadline-miss monitor (loop_monitor.c)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Feeds loop_monitor.c the sample start times Thread_Acquire() would
+ * see: a clean 20 ms grid, stretched intervals, a grid restart, period
+ * changes on arming and alarm, and the TIM2 wrap. Checks the stretch
+ * histogram, the per-state miss counts and the summary lines.
+ */
+#include "loop_monitor.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+static LoopMonitor_t mon;
+static uint32_t now_us;
+
+// One sample dt_us after the previous one, scheduling the next period_us ahead
+static void Step(uint32_t dt_us, uint32_t period_us, FallState_t state)
+{
+    now_us += dt_us;
+    LoopMonitor_Sample(&mon, now_us, period_us, state);
+}
+
+static const char *Line(int n)
+{
+    static char buf[256];
+    Fmt_t f;
+    Fmt_Init(&f, buf, sizeof(buf));
+    LoopMonitor_Format(&mon, n, &f);
+    return Fmt_End(&f);
+}
+
+// ======================= GRID =========================
+
+static void Test_Grid(void)
+{
+    printf("clean grid: no stretch, no misses\n");
+    now_us = 1000;
+    LoopMonitor_Init(&mon, 1000);
+    Step(0, 20000, STATE_NORMAL);
+    CHECK(mon.stretch.count == 0, "first sample counted: %u", mon.stretch.count);
+
+    for (int k = 0; k < 100; k++) Step(20000, 20000, STATE_NORMAL);
+    // Interrupt latency moves a read a few us off the grid and back
+    Step(20007, 20000, STATE_NORMAL);
+    Step(19993, 20000, STATE_NORMAL);
+
+    CHECK(mon.stretch.count == 102 && mon.samples[STATE_NORMAL] == 102, "count %u, NORMAL %u",
+          mon.stretch.count, mon.samples[STATE_NORMAL]);
+    CHECK(mon.stretch.bins[0] == 101 && mon.stretch.bins[3] == 1, "bins 0: %u, 3: %u",
+          mon.stretch.bins[0], mon.stretch.bins[3]);
+    CHECK(mon.misses[STATE_NORMAL] == 0, "misses %u", mon.misses[STATE_NORMAL]);
+    CHECK(mon.min_interval_us == 19993 && mon.max_interval_us == 20007, "interval %u..%u",
+          mon.min_interval_us, mon.max_interval_us);
+}
+
+// ======================= MISSES =========================
+
+static void Test_Misses(void)
+{
+    printf("stretches over the slack are misses of the state they end in\n");
+    now_us = 0;
+    LoopMonitor_Init(&mon, 1000);
+    Step(0, 20000, STATE_NORMAL);
+
+    Step(21000, 20000, STATE_NORMAL);           // exactly the slack: still on time
+    Step(21001, 20000, STATE_NORMAL);
+    Step(30000, 20000, STATE_FALLING);          // a banner held the loop
+    Step(20000, 20000, STATE_FALLING);
+    Step(45000, 20000, STATE_STILLNESS_CHECK);  // a grid restart
+
+    CHECK(mon.misses[STATE_NORMAL] == 1 && mon.samples[STATE_NORMAL] == 2, "NORMAL %u/%u",
+          mon.misses[STATE_NORMAL], mon.samples[STATE_NORMAL]);
+    CHECK(mon.misses[STATE_FALLING] == 1 && mon.worst_us[STATE_FALLING] == 10000, "FALLING %u, worst %u",
+          mon.misses[STATE_FALLING], mon.worst_us[STATE_FALLING]);
+    CHECK(mon.misses[STATE_STILLNESS_CHECK] == 1 && mon.worst_us[STATE_STILLNESS_CHECK] == 25000,
+          "STILLNESS %u, worst %u", mon.misses[STATE_STILLNESS_CHECK], mon.worst_us[STATE_STILLNESS_CHECK]);
+    CHECK(mon.misses[STATE_CONFIRMED] == 0 && mon.samples[STATE_CONFIRMED] == 0, "CONFIRMED %u/%u",
+          mon.misses[STATE_CONFIRMED], mon.samples[STATE_CONFIRMED]);
+    // 1000 us -> [512, 1024), 10000 -> [8192, 16384), 25000 -> the open top bin
+    CHECK(mon.stretch.bins[10] == 2 && mon.stretch.bins[14] == 1 && mon.stretch.bins[LAT_HIST_BINS - 1] == 1,
+          "bins 10: %u, 14: %u, top: %u", mon.stretch.bins[10], mon.stretch.bins[14],
+          mon.stretch.bins[LAT_HIST_BINS - 1]);
+}
+
+// ======================= PERIOD CHANGES =========================
+
+static void Test_Periods(void)
+{
+    printf("each interval is judged by the period scheduled at its start\n");
+    now_us = 0;
+    LoopMonitor_Init(&mon, 1000);
+    Step(0, 500000, STATE_NORMAL);              // disarmed
+    Step(500000, 20000, STATE_NORMAL);          // armed at this sample
+    Step(20000, 20000, STATE_NORMAL);
+    Step(20000, 100000, STATE_CONFIRMED);       // alarm: 100 ms
+    Step(100000, 100000, STATE_CONFIRMED);
+    Step(100500, 20000, STATE_CONFIRMED);       // reset
+    Step(20000, 20000, STATE_NORMAL);
+
+    CHECK(LatencyHist_Percentile(&mon.stretch, 100) == 500, "max stretch %u", mon.stretch.max_us);
+    CHECK(mon.misses[STATE_NORMAL] + mon.misses[STATE_CONFIRMED] == 0, "misses %u + %u",
+          mon.misses[STATE_NORMAL], mon.misses[STATE_CONFIRMED]);
+    CHECK(mon.samples[STATE_CONFIRMED] == 3 && mon.samples[STATE_NORMAL] == 3, "CONFIRMED %u, NORMAL %u",
+          mon.samples[STATE_CONFIRMED], mon.samples[STATE_NORMAL]);
+    CHECK(mon.min_interval_us == 20000 && mon.max_interval_us == 500000, "interval %u..%u",
+          mon.min_interval_us, mon.max_interval_us);
+}
+
+static void Test_Wrap(void)
+{
+    printf("TIM2 wrap between two samples\n");
+    now_us = 0xFFFFFFFFUL - 5000;
+    LoopMonitor_Init(&mon, 1000);
+    Step(0, 20000, STATE_NORMAL);
+    Step(20000, 20000, STATE_NORMAL);
+    Step(22000, 20000, STATE_NORMAL);
+    CHECK(mon.stretch.count == 2 && mon.stretch.bins[0] == 1 && mon.misses[STATE_NORMAL] == 1,
+          "count %u, on time %u, misses %u", mon.stretch.count, mon.stretch.bins[0], mon.misses[STATE_NORMAL]);
+    CHECK(mon.max_interval_us == 22000, "max interval %u", mon.max_interval_us);
+}
+
+// ======================= SUMMARY =========================
+
+static void Test_Format(void)
+{
+    printf("summary lines\n");
+    now_us = 0;
+    LoopMonitor_Init(&mon, 1000);
+    const char *empty = Line(2);
+    CHECK(strcmp(empty, "Deadline miss (> 1000 us late, interval 0..0 us): NORMAL 0/0, FALLING 0/0, "
+                        "STILLNESS 0/0, CONFIRMED 0/0\r\n") == 0, "empty: %s", empty);
+
+    Step(0, 20000, STATE_NORMAL);
+    Step(20000, 20000, STATE_NORMAL);
+    Step(23000, 20000, STATE_FALLING);
+
+    const char *hist = Line(0);
+    CHECK(strcmp(hist, "Interval over period: n 2, min 0, mean 1500, p99 <= 3000, max 3000 us\r\n") == 0,
+          "line 0: %s", hist);
+    const char *bins = Line(1);
+    CHECK(strcmp(bins, "  bins: 1 0 0 0 0 0 0 0 0 0 0 0 1\r\n") == 0, "line 1: %s", bins);
+    const char *miss = Line(2);
+    CHECK(strcmp(miss, "Deadline miss (> 1000 us late, interval 20000..23000 us): NORMAL 0/1, "
+                       "FALLING 1/1 (<= 3000), STILLNESS 0/0, CONFIRMED 0/0\r\n") == 0, "line 2: %s", miss);
+    CHECK(strlen(miss) < 128, "line 2 is %u chars", (unsigned)strlen(miss));
+}
+
+// ======================= RUNNER =========================
+
+int main(void)
+{
+    Test_Grid();
+    Test_Misses();
+    Test_Periods();
+    Test_Wrap();
+    Test_Format();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+/******************************************************************************
+  * @file           : mem_test.c
+  * @brief          : Static arenas and object pools (mem.c)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * mem.c runs here unchanged (interrupt masking compiles to nothing off
+ * target). The checks cover what the firmware relies on: alignment,
+ * exhaustion reported instead of overrun, scratch marks, O(1) pool reuse,
+ * foreign pointers refused, and the usage numbers in the minute dump.
+ */
+#include "mem.h"
+
+#include <stdio.h>
+#include <string.h>
+
+typedef struct {
+    uint8_t  tag;
+    double   value;             // forces 8-byte alignment
+    uint16_t extra[3];
+} Obj_t;
+
+MEM_ARENA(test_arena, 100);
+MEM_POOL(test_pool, Obj_t, 5);
+MEM_POOL(byte_pool, uint8_t, 3);
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+static int Aligned(const void *p)
+{
+    return ((uintptr_t)p % MEM_ALIGN) == 0;
+}
+
+// ======================= ARENA =========================
+
+static void Test_Arena(void)
+{
+    printf("arena: alignment, exhaustion, marks\n");
+    MemArena_Init(&test_arena);
+    CHECK(test_arena.size == 104, "size rounded to %u", test_arena.size);
+
+    uint8_t *a = MemArena_Alloc(&test_arena, 3);
+    uint8_t *b = MemArena_Alloc(&test_arena, 17);
+    CHECK(a && b && Aligned(a) && Aligned(b), "unaligned %p %p", (void *)a, (void *)b);
+    CHECK(b - a == 8, "3 bytes took %d", (int)(b - a));
+    CHECK(test_arena.used == 32, "used %u", test_arena.used);
+
+    uint32_t mark = MemArena_Mark(&test_arena);
+    CHECK(MemArena_Alloc(&test_arena, 72) != NULL, "exact fit refused");
+    CHECK(MemArena_Alloc(&test_arena, 1) == NULL, "allocated past the end");
+    CHECK(test_arena.fails == 1 && test_arena.peak == 104, "fails %u peak %u", test_arena.fails, test_arena.peak);
+
+    MemArena_Release(&test_arena, mark);
+    CHECK(test_arena.used == 32 && test_arena.peak == 104, "after release used %u peak %u",
+          test_arena.used, test_arena.peak);
+    uint8_t *c = MemArena_Alloc(&test_arena, 8);
+    CHECK(c == b + 24, "scratch not reused");
+    CHECK(MemArena_Alloc(&test_arena, 0xFFFFFFFFUL) == NULL, "size overflow accepted");
+}
+
+// ======================= POOL =========================
+
+static void Test_Pool(void)
+{
+    printf("pool: exhaustion, reuse, foreign pointers\n");
+    MemPool_Init(&test_pool);
+    CHECK(test_pool.block_size % MEM_ALIGN == 0 && test_pool.block_size >= sizeof(Obj_t),
+          "block size %u", test_pool.block_size);
+
+    Obj_t *o[6];
+    for (int k = 0; k < 5; k++) {
+        o[k] = MemPool_Alloc(&test_pool);
+        CHECK(o[k] && Aligned(o[k]), "block %d: %p", k, (void *)o[k]);
+        if (o[k]) { memset(o[k], 0xEE, sizeof(Obj_t)); o[k]->tag = (uint8_t)k; }
+    }
+    for (int a = 0; a < 5; a++) {
+        for (int b = a + 1; b < 5; b++) CHECK(o[a] != o[b], "blocks %d and %d alias", a, b);
+    }
+    o[5] = MemPool_Alloc(&test_pool);
+    CHECK(o[5] == NULL && test_pool.fails == 1, "sixth block %p, fails %u", (void *)o[5], test_pool.fails);
+
+    CHECK(MemPool_Free(&test_pool, o[2]), "free refused");
+    CHECK(MemPool_Alloc(&test_pool) == o[2], "freed block not handed out next");
+    for (int k = 0; k < 5; k++) {
+        if (k != 2) CHECK(o[k]->tag == k, "live block %d overwritten by the free list", k);
+    }
+
+    uint8_t outside;
+    CHECK(!MemPool_Free(&test_pool, &outside), "foreign pointer accepted");
+    CHECK(!MemPool_Free(&test_pool, (uint8_t *)o[1] + 4), "interior pointer accepted");
+    CHECK(!MemPool_Free(&test_pool, NULL), "NULL accepted");
+    CHECK(test_pool.in_use == 5 && test_pool.peak == 5, "in use %u peak %u", test_pool.in_use, test_pool.peak);
+
+    // Blocks smaller than a pointer still hold the free-list link
+    MemPool_Init(&byte_pool);
+    CHECK(byte_pool.block_size >= sizeof(void *), "byte pool block %u", byte_pool.block_size);
+    void *x = MemPool_Alloc(&byte_pool), *y = MemPool_Alloc(&byte_pool), *z = MemPool_Alloc(&byte_pool);
+    CHECK(x && y && z && !MemPool_Alloc(&byte_pool), "byte pool count");
+    MemPool_Free(&byte_pool, y);
+    MemPool_Free(&byte_pool, x);
+    CHECK(MemPool_Alloc(&byte_pool) == x && MemPool_Alloc(&byte_pool) == y, "LIFO reuse");
+}
+
+// ======================= REPORT =========================
+
+static void Test_Report(void)
+{
+    printf("usage report\n");
+    MemStats_t st;
+    int n = 0;
+    while (Mem_GetStats(n, &st)) n++;
+    CHECK(n == 3, "%d regions listed", n);
+
+    MemArena_Init(&test_arena);          // re-init must not list it twice
+    CHECK(!Mem_GetStats(3, &st), "region listed twice");
+
+    Mem_GetStats(1, &st);
+    CHECK(st.is_pool && strcmp(st.name, "test_pool") == 0 && st.size == 5 && st.used == 5 && st.fails == 1,
+          "%s pool %u size %u used %u fails %u", st.name, st.is_pool, st.size, st.used, st.fails);
+    Mem_GetStats(0, &st);
+    CHECK(!st.is_pool && strcmp(st.name, "test_arena") == 0 && st.size == 104 && st.used == 0,
+          "%s size %u used %u", st.name, st.size, st.used);
+}
+
+// ======================= RUNNER =========================
+
+int main(void)
+{
+    Test_Arena();
+    Test_Pool();
+    Test_Report();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
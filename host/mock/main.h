@@ -0,0 +1,22 @@
+/******************************************************************************
+  * @file           : main.h
+  * @brief          : Host stand-in for the firmware main.h (HAL tick only)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Put ahead of ../CG2028_Assignment/Core/Inc on the include path when a
+ * firmware module that only needs the HAL tick is built on Linux. The
+ * tick comes from host/wifi_sim.c (or the test itself).
+ */
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include <stdint.h>
+
+uint32_t HAL_GetTick(void);
+void     HAL_Delay(uint32_t ms);
+
+/* No SRAM2 on the host: hot code stays where the compiler puts it */
+#define RAMFUNC
+
+#endif /* __MAIN_H */
@@ -0,0 +1,92 @@
+/******************************************************************************
+  * @file           : mov_avg_test.c
+  * @brief          : mov_avg variants against the C reference, randomised (Linux)
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Usage:  ./mov_avg_test [seed]
+ *
+ * Runs CG2028_Assignment_Test/Core/Src/mov_avg_check.c, the harness the
+ * test project runs on the board against mov_avg.s, over the portable
+ * variants: the firmware mov_avg_C (fall_detect.c) and a C model of
+ * mov_avg.s, instruction for instruction. The default seed keeps runs
+ * reproducible; pass another one (or `random`) to explore.
+ *
+ * The harness checks itself first: three broken averages must be caught,
+ * the old oracle that always divided by 4, a shift that rounds toward
+ * minus infinity and a loop that reads one word past the window.
+ */
+#include "fall_detect.h"
+#include "mov_avg_check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_SEED        2028
+#define RANDOM_PER_N        100000
+
+// mov_avg.s: ADD into r3 for i < N, then SDIV r0, r3, r0
+static int Mov_Avg_Model(int N, int* accel_buff)
+{
+    uint32_t r3 = 0;
+    for (int r2 = 0; r2 < N; r2++) r3 += (uint32_t)accel_buff[r2];
+    return (int32_t)r3 / N;
+}
+
+// What the C oracle in the test project used to be
+static int Mutant_Div4(int N, int* accel_buff)
+{
+    int result = 0;
+    for (int i = 0; i < N; i++) result = (int)((uint32_t)result + (uint32_t)accel_buff[i]);
+    return result / 4;
+}
+
+// Arithmetic shift: right for positive sums, one off for negative ones that do not divide
+static int Mutant_Shift(int N, int* accel_buff)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i < N; i++) sum += (uint32_t)accel_buff[i];
+    if (N == 4) return (int32_t)sum >> 2;
+    return (int32_t)sum / N;
+}
+
+// Off by one in the loop bound: only the junk after the window gives it away
+static int Mutant_Overread(int N, int* accel_buff)
+{
+    uint32_t sum = 0;
+    for (int i = 0; i <= N; i++) sum += (uint32_t)accel_buff[i];
+    return (int32_t)sum / N;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seed = DEFAULT_SEED;
+    if (argc > 1) seed = strcmp(argv[1], "random") == 0 ? (uint32_t)time(NULL) : (uint32_t)strtoul(argv[1], NULL, 0);
+
+    static const MovAvgVariant_t mutants[] = {
+        { "mutant /4",    Mutant_Div4 },
+        { "mutant >> 2",  Mutant_Shift },
+        { "mutant <= N",  Mutant_Overread },
+    };
+    int failures = 0;
+
+    printf("self-test, expect mismatches:\n");
+    for (unsigned m = 0; m < sizeof(mutants) / sizeof(mutants[0]); m++) {
+        if (MovAvgCheck_Run(&mutants[m], 1, seed, 100) == 0) {
+            printf("  FAIL: %s not caught\n", mutants[m].name);
+            failures++;
+        }
+    }
+
+    static const MovAvgVariant_t variants[] = {
+        { "mov_avg_C",    mov_avg_C },
+        { "mov_avg.s model", Mov_Avg_Model },
+    };
+    printf("\nvariants:\n");
+    if (MovAvgCheck_Run(variants, 2, seed, RANDOM_PER_N) != 0) failures++;
+
+    printf(failures ? "\nFAILED\n" : "\nall passed\n");
+    return failures ? 1 : 0;
+}
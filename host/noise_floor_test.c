@@ -0,0 +1,218 @@
+/******************************************************************************
+  * @file           : noise_floor_test.c
+  * @brief          : Adaptive noise floor (noise_floor.c) against recorded ambient-sound traces
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Usage:  ./noise_floor_test [dir]     traces from dir (default: sound_traces)
+ *
+ * Each trace is the Read_Sound_Sensor() envelope at 50 Hz ("ms envelope"
+ * per line) with header lines naming the windows that must be called loud
+ * and the range the floor must end in:
+ *
+ *   # loud 20000 20100         at least one loud sample in [20000, 20100] ms
+ *   # floor 26 30              final floor estimate, dB
+ *
+ * Samples go through NoiseFloor_Update() then NoiseFloor_IsLoud(), the
+ * order Detect_Sample() uses. A loud sample outside every window fails.
+ * The dB conversion, the margin over the floor and the minimum threshold
+ * are checked on their own first.
+ */
+#include "noise_floor.h"
+
+#include <dirent.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_SAMPLES         4096
+#define MAX_WINDOWS         8
+#define TODB_MAX_ERR_Q8     26      /* 0.1 dB: the log2 mantissa approximation */
+
+typedef struct {
+    uint32_t ms[MAX_SAMPLES];
+    uint32_t env[MAX_SAMPLES];
+    uint32_t n;
+    uint32_t loud_from[MAX_WINDOWS], loud_to[MAX_WINDOWS];
+    uint32_t n_loud;
+    int32_t  floor_lo, floor_hi;
+    int      has_floor;
+} Trace_t;
+
+static Trace_t tr;
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+// ======================= HELPERS =========================
+
+static int Load(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+    if (!f) return 0;
+
+    memset(&tr, 0, sizeof(tr));
+    while (fgets(line, sizeof(line), f)) {
+        unsigned long a, b;
+        long lo, hi;
+        if (sscanf(line, "# loud %lu %lu", &a, &b) == 2 && tr.n_loud < MAX_WINDOWS) {
+            tr.loud_from[tr.n_loud] = (uint32_t)a;
+            tr.loud_to[tr.n_loud] = (uint32_t)b;
+            tr.n_loud++;
+        } else if (sscanf(line, "# floor %ld %ld", &lo, &hi) == 2) {
+            tr.floor_lo = (int32_t)lo;
+            tr.floor_hi = (int32_t)hi;
+            tr.has_floor = 1;
+        } else if (line[0] != '#' && sscanf(line, "%lu %lu", &a, &b) == 2 && tr.n < MAX_SAMPLES) {
+            tr.ms[tr.n] = (uint32_t)a;
+            tr.env[tr.n] = (uint32_t)b;
+            tr.n++;
+        }
+    }
+    fclose(f);
+    return tr.n > 0 && tr.has_floor;
+}
+
+// Index of the loud window holding ms, or -1
+static int Window_Of(uint32_t ms)
+{
+    for (uint32_t w = 0; w < tr.n_loud; w++)
+        if (ms >= tr.loud_from[w] && ms <= tr.loud_to[w]) return (int)w;
+    return -1;
+}
+
+// ======================= TESTS =========================
+
+static void Test_ToDb(void)
+{
+    printf("ToDb: 20*log10 over 2 .. 70000\n");
+    int32_t worst = 0;
+    for (uint32_t v = 2; v < 70000; v++) {
+        int32_t want = (int32_t)lround(20.0 * log10((double)v) * 256.0);
+        int32_t err = abs(NoiseFloor_ToDb(v) - want);
+        if (err > worst) worst = err;
+        if (err > TODB_MAX_ERR_Q8 && failures < 20) CHECK(0, "ToDb(%u) = %d, libm %d", v, NoiseFloor_ToDb(v), want);
+    }
+    CHECK(NoiseFloor_ToDb(0) == 0 && NoiseFloor_ToDb(1) == 0, "ToDb(0), ToDb(1) = %d, %d",
+          NoiseFloor_ToDb(0), NoiseFloor_ToDb(1));
+    printf("  worst %.3f dB\n", worst / 256.0);
+}
+
+static void Test_Threshold(void)
+{
+    printf("threshold = floor + margin, not under the minimum\n");
+
+    // Steady 1000 LSB (60 dB): the floor sits in its 1 dB bin, loud starts 15 dB over it
+    NoiseFloor_Init();
+    NoiseFloor_SetMarginDb(NOISE_LOUD_MARGIN_DB);
+    CHECK(NoiseFloor_GetThresholdDb() == NOISE_MIN_THRESHOLD_DB * 256, "before any sample %d",
+          NoiseFloor_GetThresholdDb());
+    NoiseFloor_Update(1000);
+    CHECK(NoiseFloor_GetThresholdDb() > 74 * 256, "after one sample %d", NoiseFloor_GetThresholdDb());
+    for (int i = 0; i < 500; i++) NoiseFloor_Update(1000);
+
+    int32_t floor = NoiseFloor_GetFloorDb();
+    CHECK(floor >= 59 * 256 && floor <= 61 * 256, "floor %d/256 dB", floor);
+    CHECK(floor == NoiseFloor_GetQuantileDb(NOISE_FLOOR_QUANTILE), "running floor %d, histogram %d",
+          floor, NoiseFloor_GetQuantileDb(NOISE_FLOOR_QUANTILE));
+    CHECK(NoiseFloor_GetThresholdDb() == floor + NOISE_LOUD_MARGIN_DB * 256, "threshold %d, floor %d",
+          NoiseFloor_GetThresholdDb(), floor);
+    CHECK(!NoiseFloor_IsLoud(4000) && NoiseFloor_IsLoud(4095 * 2), "loud at +12 / +18 dB: %d %d",
+          NoiseFloor_IsLoud(4000), NoiseFloor_IsLoud(4095 * 2));
+
+    NoiseFloor_SetMarginDb(6);
+    NoiseFloor_Update(1000);
+    CHECK(NoiseFloor_GetThresholdDb() == NoiseFloor_GetFloorDb() + 6 * 256, "margin 6: threshold %d, floor %d",
+          NoiseFloor_GetThresholdDb(), NoiseFloor_GetFloorDb());
+    CHECK(NoiseFloor_IsLoud(4000), "+12 dB not loud at margin 6");
+
+    // A silent room is held at the minimum threshold
+    NoiseFloor_Init();
+    NoiseFloor_SetMarginDb(NOISE_LOUD_MARGIN_DB);
+    for (int i = 0; i < 500; i++) NoiseFloor_Update(3);
+    CHECK(NoiseFloor_GetThresholdDb() == NOISE_MIN_THRESHOLD_DB * 256, "quiet threshold %d",
+          NoiseFloor_GetThresholdDb());
+    CHECK(!NoiseFloor_IsLoud(99) && NoiseFloor_IsLoud(101), "around 100 LSB: %d %d",
+          NoiseFloor_IsLoud(99), NoiseFloor_IsLoud(101));
+}
+
+static void Test_Trace(const char *dir, const char *name)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    printf("%s\n", name);
+    if (!Load(path)) {
+        CHECK(0, "cannot parse %s", path);
+        return;
+    }
+
+    uint32_t hits[MAX_WINDOWS] = {0};
+    uint32_t loud = 0, stray = 0, first_stray = 0;
+    int32_t max_threshold = 0;
+
+    NoiseFloor_Init();
+    NoiseFloor_SetMarginDb(NOISE_LOUD_MARGIN_DB);
+    for (uint32_t i = 0; i < tr.n; i++) {
+        NoiseFloor_Update(tr.env[i]);
+        if (NoiseFloor_GetThresholdDb() > max_threshold) max_threshold = NoiseFloor_GetThresholdDb();
+        if (!NoiseFloor_IsLoud(tr.env[i])) continue;
+
+        loud++;
+        int w = Window_Of(tr.ms[i]);
+        if (w >= 0) hits[w]++;
+        else if (stray++ == 0) first_stray = tr.ms[i];
+    }
+
+    int32_t floor = NoiseFloor_GetFloorDb();
+    printf("  floor %.1f dB, threshold %.1f dB (max %.1f), %u loud samples\n", floor / 256.0,
+           NoiseFloor_GetThresholdDb() / 256.0, max_threshold / 256.0, loud);
+
+    for (uint32_t w = 0; w < tr.n_loud; w++)
+        CHECK(hits[w] > 0, "nothing loud in %u..%u ms", tr.loud_from[w], tr.loud_to[w]);
+    CHECK(stray == 0, "%u loud samples outside the windows, first at %u ms", stray, first_stray);
+    CHECK(floor >= tr.floor_lo * 256 && floor <= tr.floor_hi * 256, "floor %.1f dB, expected %d..%d",
+          floor / 256.0, tr.floor_lo, tr.floor_hi);
+}
+
+// ======================= RUNNER =========================
+
+static int Cmp_Names(const void *a, const void *b)
+{
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+int main(int argc, char **argv)
+{
+    const char *dir = argc > 1 ? argv[1] : "sound_traces";
+    char *names[64];
+    int n = 0;
+
+    DIR *d = opendir(dir);
+    if (!d) {
+        printf("no trace directory %s\n", dir);
+        return 1;
+    }
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL && n < 64) {
+        size_t len = strlen(e->d_name);
+        if (len > 4 && strcmp(e->d_name + len - 4, ".csv") == 0) names[n++] = strdup(e->d_name);
+    }
+    closedir(d);
+    qsort(names, (size_t)n, sizeof(names[0]), Cmp_Names);
+
+    Test_ToDb();
+    Test_Threshold();
+    for (int k = 0; k < n; k++) {
+        Test_Trace(dir, names[k]);
+        free(names[k]);
+    }
+    CHECK(n > 0, "no traces in %s", dir);
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,248 @@
+/******************************************************************************
+  * @file           : posture_test.c
+  * @brief          : Fixed-point posture maths (posture.c) against libm
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * posture.c runs here unchanged. Each integer routine is swept over its
+ * input range and compared with the double-precision libm result:
+ *
+ *   Posture_Isqrt      exact floor(sqrt(v)) over the whole uint64 range
+ *   Posture_Atan2      every 0.1 deg of the circle at radii from 1000 to
+ *                      2^30, all pairs within +-40, random int32 pairs
+ *   Posture_Asin       num/den over [-1, 1] for den up to 2^31 - 1
+ *   Pitch / Roll       random gravity vectors in the +-16 g accel range
+ *   Posture_GetDelta   random pairs of them, fed through Posture_Update()
+ *                      like the sampling loop
+ *
+ * The worst error of each is printed and checked against the bound below.
+ * The low-pass settles to within 1 mg of a held input, so Delta is also
+ * allowed the angle 1 mg per axis can turn the vector by.
+ */
+#include "posture.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Worst-case error allowed, in deci-degrees (the unit posture.c returns) */
+#define ATAN2_MAX_ERR       1.5     /* polynomial ~0.9 plus rounding to 0.1 deg */
+#define ASIN_MAX_ERR        1.5     /* den is scaled up before the root: Atan2 error only */
+#define ANGLE_MAX_ERR       1.5     /* the same, from the gravity estimate */
+
+#define DECI_PER_RAD        (1800.0 / M_PI)
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+static uint64_t rng = 0x2028CAFEF00DULL;
+
+static uint64_t Rand64(void)
+{
+    // xorshift64*: fixed seed, same sequence on every run
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return rng * 0x2545F4914F6CDD1DULL;
+}
+
+static int32_t Rand_Range(int32_t lo, int32_t hi)
+{
+    return (int32_t)(lo + (int64_t)(Rand64() % (uint64_t)((int64_t)hi - lo + 1)));
+}
+
+// Difference of two deci-degree angles, wrapped into [-1800, 1800)
+static double Angle_Err(double got, double want)
+{
+    double d = fmod(got - want + 1800.0, 3600.0);
+    if (d < 0) d += 3600.0;
+    return fabs(d - 1800.0);
+}
+
+// ======================= ISQRT =========================
+
+static int Isqrt_Ok(uint64_t v)
+{
+    uint64_t r = Posture_Isqrt(v);
+    // r^2 <= v < (r+1)^2, the upper test done without overflowing 64 bits
+    return r * r <= v && (r + 1 > 0xFFFFFFFFULL || (r + 1) * (r + 1) > v);
+}
+
+static void Test_Isqrt(void)
+{
+    printf("Isqrt: floor(sqrt(v)) over uint64\n");
+    static const uint64_t edges[] = { 0, 1, 2, 3, 4, 15, 16, 17, 0xFFFFFFFFULL, 0x100000000ULL,
+                                      0xFFFFFFFE00000001ULL, 0xFFFFFFFE00000000ULL, 1ULL << 62,
+                                      (1ULL << 62) - 1, 0xFFFFFFFFFFFFFFFFULL };
+    for (unsigned k = 0; k < sizeof(edges) / sizeof(edges[0]); k++)
+        CHECK(Isqrt_Ok(edges[k]), "Isqrt(%llu) = %u", (unsigned long long)edges[k], Posture_Isqrt(edges[k]));
+
+    int bad = 0;
+    for (uint64_t r = 0; r < 70000; r++) {          // both sides of every square up to 2^32
+        bad += !Isqrt_Ok(r * r) + !Isqrt_Ok(r * r + r) + !Isqrt_Ok(r * r + 2 * r);
+    }
+    for (int i = 0; i < 1000000; i++) {
+        uint64_t v = Rand64() >> (Rand64() % 64);
+        bad += !Isqrt_Ok(v);
+    }
+    CHECK(bad == 0, "%d wrong roots", bad);
+}
+
+// ======================= ATAN2 =========================
+
+static double atan2_worst = 0.0;
+
+static void Atan2_Check(int32_t y, int32_t x)
+{
+    double want = (x == 0 && y == 0) ? 0.0 : atan2((double)y, (double)x) * DECI_PER_RAD;
+    double err = Angle_Err(Posture_Atan2(y, x), want);
+    if (err > atan2_worst) atan2_worst = err;
+    if (err > ATAN2_MAX_ERR && failures < 20)
+        CHECK(0, "Atan2(%d, %d) = %d, libm %.2f", y, x, Posture_Atan2(y, x), want);
+}
+
+static void Test_Atan2(void)
+{
+    printf("Atan2: the whole circle at radii 1000 .. 2^30, small and random pairs\n");
+    static const double radii[] = { 1000.0, 1.0e4, 16000.0, 1.0e6, 1073741823.0 };
+
+    for (unsigned r = 0; r < sizeof(radii) / sizeof(radii[0]); r++) {
+        for (int a = -1800; a < 1800; a++) {
+            double rad = a / DECI_PER_RAD;
+            Atan2_Check((int32_t)lround(radii[r] * sin(rad)), (int32_t)lround(radii[r] * cos(rad)));
+        }
+    }
+    // Small integers: the ratio is exact, only the polynomial and rounding remain
+    for (int32_t y = -40; y <= 40; y++)
+        for (int32_t x = -40; x <= 40; x++) Atan2_Check(y, x);
+    for (int i = 0; i < 1000000; i++)
+        Atan2_Check(Rand_Range(-0x7FFFFFFF, 0x7FFFFFFF), Rand_Range(-0x7FFFFFFF, 0x7FFFFFFF));
+    // INT32_MIN has no positive int32_t: its magnitude must not overflow
+    static const int32_t edges[] = { INT32_MIN, INT32_MIN + 1, -1, 0, 1, INT32_MAX };
+    for (unsigned i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+        for (unsigned j = 0; j < sizeof(edges) / sizeof(edges[0]); j++) Atan2_Check(edges[i], edges[j]);
+
+    CHECK(Posture_Atan2(0, 0) == 0, "Atan2(0, 0) = %d", Posture_Atan2(0, 0));
+    CHECK(Posture_Atan2(0, 5) == 0 && Posture_Atan2(5, 0) == 900 && Posture_Atan2(0, -5) == 1800 &&
+          Posture_Atan2(-5, 0) == -900, "axes %d %d %d %d", Posture_Atan2(0, 5), Posture_Atan2(5, 0),
+          Posture_Atan2(0, -5), Posture_Atan2(-5, 0));
+    printf("  worst %.2f deci-deg (bound %.1f)\n", atan2_worst, ATAN2_MAX_ERR);
+}
+
+// ======================= ASIN =========================
+
+static void Test_Asin(void)
+{
+    printf("Asin: num/den over [-1, 1]\n");
+    double worst = 0.0;
+
+    for (int i = 0; i < 1000000; i++) {
+        int32_t den = (i & 1) ? Rand_Range(1, 20000) : Rand_Range(1, 0x7FFFFFFF);
+        int32_t num = Rand_Range(-den, den);
+        double want = asin((double)num / den) * DECI_PER_RAD;
+        double err = fabs(Posture_Asin(num, den) - want);
+        if (err > worst) worst = err;
+        if (err > ASIN_MAX_ERR && failures < 20)
+            CHECK(0, "Asin(%d, %d) = %d, libm %.2f", num, den, Posture_Asin(num, den), want);
+    }
+    CHECK(Posture_Asin(5, 5) == 900 && Posture_Asin(-5, 5) == -900 && Posture_Asin(0, 5) == 0,
+          "ends %d %d %d", Posture_Asin(5, 5), Posture_Asin(-5, 5), Posture_Asin(0, 5));
+    CHECK(Posture_Asin(7, 5) == 900 && Posture_Asin(1, 0) == 0, "out of range %d %d",
+          Posture_Asin(7, 5), Posture_Asin(1, 0));
+    printf("  worst %.2f deci-deg (bound %.1f)\n", worst, ASIN_MAX_ERR);
+}
+
+// ======================= POSTURE ANGLES =========================
+
+static void Random_Gravity(int16_t g[3])
+{
+    // Any direction, 0.2 .. 16 g: lying, standing, mid-fall and impacts
+    double mag = 200.0 + (double)(Rand64() % 15800);
+    double v[3], n;
+    do {
+        for (int k = 0; k < 3; k++) v[k] = (double)Rand_Range(-10000, 10000);
+        n = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    } while (n < 1000.0);
+    for (int k = 0; k < 3; k++) g[k] = (int16_t)lround(v[k] / n * mag);
+}
+
+// Settle the low-pass on g (it ends within 1 mg per axis)
+static void Hold(const int16_t g[3])
+{
+    for (int i = 0; i < 400; i++) Posture_Update(g);
+}
+
+static void Test_Angles(void)
+{
+    printf("Pitch / Roll / Delta through Posture_Update()\n");
+    double worst_delta = 0.0, worst_pitch = 0.0, worst_roll = 0.0;
+
+    for (int i = 0; i < 20000; i++) {
+        int16_t ref[3], now[3];
+        Random_Gravity(ref);
+        Random_Gravity(now);
+
+        // The first update after Init takes the sample as the gravity estimate exactly
+        Posture_Init();
+        Posture_Update(now);
+        double mag = sqrt((double)now[0] * now[0] + (double)now[1] * now[1] + (double)now[2] * now[2]);
+        double pitch = asin(-now[0] / mag) * DECI_PER_RAD;
+        double roll = atan2((double)now[1], (double)now[2]) * DECI_PER_RAD;
+        double err = fabs(Posture_GetPitch() - pitch);
+        if (err > worst_pitch) worst_pitch = err;
+        if (err > ANGLE_MAX_ERR && failures < 20)
+            CHECK(0, "Pitch (%d %d %d) = %d, libm %.2f", now[0], now[1], now[2], Posture_GetPitch(), pitch);
+        err = Angle_Err(Posture_GetRoll(), roll);
+        if (err > worst_roll) worst_roll = err;
+        if (err > ANGLE_MAX_ERR && failures < 20)
+            CHECK(0, "Roll (%d %d %d) = %d, libm %.2f", now[0], now[1], now[2], Posture_GetRoll(), roll);
+
+        Posture_Init();
+        Posture_Update(ref);
+        Posture_CaptureReference();
+        Hold(now);
+        double dot = 0.0, c[3];
+        c[0] = (double)ref[1] * now[2] - (double)ref[2] * now[1];
+        c[1] = (double)ref[2] * now[0] - (double)ref[0] * now[2];
+        c[2] = (double)ref[0] * now[1] - (double)ref[1] * now[0];
+        for (int k = 0; k < 3; k++) dot += (double)ref[k] * now[k];
+        double want = atan2(sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]), dot) * DECI_PER_RAD;
+        double settle = sqrt(3.0) / mag * DECI_PER_RAD;
+        err = fabs(Posture_GetDelta() - want);
+        if (err - settle > worst_delta) worst_delta = err - settle;
+        if (err > ANGLE_MAX_ERR + settle && failures < 20)
+            CHECK(0, "Delta (%d %d %d) -> (%d %d %d) = %d, libm %.2f", ref[0], ref[1], ref[2],
+                  now[0], now[1], now[2], Posture_GetDelta(), want);
+    }
+
+    // Same posture, and flipped over
+    static const int16_t up[3] = { 0, 0, 1000 }, down[3] = { 0, 0, -1000 };
+    Posture_Init();
+    Hold(up);
+    Posture_CaptureReference();
+    CHECK(Posture_GetDelta() == 0, "unchanged posture: %d", Posture_GetDelta());
+    Hold(down);
+    CHECK(abs(Posture_GetDelta() - 1800) <= 1, "flipped: %d", Posture_GetDelta());
+    Posture_Init();
+    CHECK(Posture_GetDelta() == 0, "no reference: %d", Posture_GetDelta());
+
+    printf("  worst pitch %.2f, roll %.2f, delta %.2f over the settling allowance, deci-deg (bound %.1f)\n",
+           worst_pitch, worst_roll, worst_delta, ANGLE_MAX_ERR);
+}
+
+// ======================= RUNNER =========================
+
+int main(void)
+{
+    Test_Isqrt();
+    Test_Atan2();
+    Test_Asin();
+    Test_Angles();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,226 @@
+/******************************************************************************
+  * @file           : replay_test.c
+  * @brief          : Alert client and Wi-Fi engine against recorded AT transcripts
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Usage:  ./replay_test [dir]     transcripts from dir (default: transcripts)
+ *
+ * Runs on a virtual clock: each main-loop pass is 1 ms, the module's
+ * latencies come from the transcript, so every run is deterministic.
+ * Each scenario runs in a child process to start from fresh firmware
+ * state.
+ *
+ * Besides the outcome, the loop counts how many of its passes ran while
+ * AT traffic was in flight. With the old blocking driver that number was
+ * zero: the loop stood still for the whole join / send / ack round trip.
+ */
+#include "alert_client.h"
+#include "wifi_async.h"
+#include "wifi_replay.h"
+#include "wifi_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const char *dir = "transcripts";
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+// ======================= HELPERS =========================
+
+static int Load(const char *name)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    Sim_UseVirtualClock(1);
+    Sim_SetResponder(Replay_Respond);
+    return Replay_Load(path);
+}
+
+static uint32_t passes = 0;
+static uint32_t overlapped = 0;
+
+// One main-loop pass per virtual millisecond; stops early once done() holds
+static int Run(uint32_t max_ms, int (*done)(void))
+{
+    for (uint32_t t = 0; t < max_ms; t++) {
+        Sim_AdvanceMs(1);
+        AlertClient_Poll();
+        passes++;
+        if (WifiAsync_Pending()) overlapped++;
+        if (done && done()) return 1;
+    }
+    return 0;
+}
+
+static int Is_Ready(void) { return AlertClient_GetState() == ALERT_READY; }
+
+static int Acked_One(void)
+{
+    AlertStats_t st;
+    AlertClient_GetStats(&st);
+    return st.acked == 1 && AlertClient_GetState() == ALERT_READY;
+}
+
+static void Check_Replayed(void)
+{
+    CHECK(Replay_Failures() == 0, "%d commands did not match the transcript", Replay_Failures());
+    CHECK(Replay_Remaining() == 0, "%d exchanges never reached", Replay_Remaining());
+}
+
+// ======================= SCENARIOS =========================
+
+static void Test_Boot_Deliver(void)
+{
+    CHECK(Load("boot_deliver.at"), "transcript");
+    CHECK(AlertClient_Init(), "init failed");
+    CHECK(Run(5000, Is_Ready), "not connected, state %d", AlertClient_GetState());
+    printf("  connected after %u ms, %u of %u loop passes overlapped AT traffic\n",
+           passes, overlapped, passes);
+    CHECK(overlapped >= 1500, "join did not overlap the loop (%u passes)", overlapped);
+
+    AlertClient_Publish(ALERT_FALL, 2345, -1200, 0x0ABCDEF0UL);
+    CHECK(Run(1000, Acked_One), "alert not acked");
+
+    AlertStats_t st;
+    WifiAsyncStats_t ws;
+    AlertClient_GetStats(&st);
+    WifiAsync_GetStats(&ws);
+    CHECK(st.sends == 1 && st.failures == 0, "sends %u failures %u", st.sends, st.failures);
+    printf("  publish->ack %u ms, %u AT commands, slowest %u ms\n",
+           st.last_latency_ms, ws.commands, ws.max_ms);
+    Check_Replayed();
+}
+
+static void Test_Send_Error(void)
+{
+    CHECK(Load("send_error.at"), "transcript");
+    CHECK(AlertClient_Init(), "init failed");
+    CHECK(Run(5000, Is_Ready), "not connected");
+    AlertClient_Publish(ALERT_MANUAL, 0, 0, 0);
+    CHECK(Run(5000, Acked_One), "alert not acked after the failed send");
+
+    AlertStats_t st;
+    AlertClient_GetStats(&st);
+    CHECK(st.sends == 2 && st.failures == 1 && st.reconnects == 2,
+          "sends %u failures %u reconnects %u", st.sends, st.failures, st.reconnects);
+    Check_Replayed();
+}
+
+static void Test_Read_Timeout(void)
+{
+    CHECK(Load("read_timeout.at"), "transcript");
+    CHECK(AlertClient_Init(), "init failed");
+    CHECK(Run(5000, Is_Ready), "not connected");
+    AlertClient_Publish(ALERT_FALL, 10000, 0, 0);
+    CHECK(Run(10000, Acked_One), "alert not acked after the module reset");
+
+    AlertStats_t st;
+    WifiAsyncStats_t ws;
+    AlertClient_GetStats(&st);
+    WifiAsync_GetStats(&ws);
+    CHECK(ws.timeouts == 1, "%u engine timeouts", ws.timeouts);
+    CHECK(st.sends == 2 && st.failures == 1, "sends %u failures %u", st.sends, st.failures);
+    Check_Replayed();
+}
+
+// ---- engine only ----
+
+#define MAX_DONE    8
+
+static int n_done = 0;
+static WifiResult_t done_res[MAX_DONE];
+static char done_text[MAX_DONE][WIFI_RESP_MAX + 1];
+
+static void On_Done(WifiResult_t res, const uint8_t *resp, uint16_t len, void *ctx)
+{
+    (void)ctx;
+    if (n_done == MAX_DONE) return;
+    done_res[n_done] = res;
+    memcpy(done_text[n_done], resp, len);
+    done_text[n_done][len] = '\0';
+    n_done++;
+}
+
+static void Test_Pipeline(void)
+{
+    CHECK(Load("pipeline.at"), "transcript");
+    CHECK(WifiAsync_Init(), "engine init");
+
+    CHECK(WifiAsync_SubmitReset(500, 0, On_Done, NULL), "submit");
+    CHECK(WifiAsync_Submit("I?", NULL, 0, 100, WIFI_F_CHAIN, On_Done, NULL), "submit");
+    CHECK(WifiAsync_Submit("CS", NULL, 0, 100, WIFI_F_CHAIN, On_Done, NULL), "submit");
+    CHECK(WifiAsync_Submit("P0=0", NULL, 0, 100, WIFI_F_CHAIN, On_Done, NULL), "submit");
+    CHECK(WifiAsync_Submit("P6=1", NULL, 0, 100, WIFI_F_CHAIN, On_Done, NULL), "submit");
+
+    // The reset hold is a timer event: one poll to release RST, then
+    // interrupts only. The whole chain must finish without the main loop.
+    Sim_AdvanceMs(WIFI_RESET_HOLD_MS);
+    WifiAsync_Poll();
+    for (int t = 0; t < 100 && (Replay_Remaining() || !Sim_Idle()); t++) {
+        Sim_AdvanceMs(1);
+        Sim_Service();
+    }
+    CHECK(Replay_Remaining() == 0, "%d exchanges left without main-loop help", Replay_Remaining());
+    CHECK(n_done == 0, "callbacks ran from interrupt context");
+
+    WifiAsync_Poll();
+    CHECK(n_done == 5, "%d callbacks", n_done);
+    CHECK(done_res[0] == WIFI_OK && done_res[1] == WIFI_OK && done_res[2] == WIFI_OK,
+          "results %d %d %d", done_res[0], done_res[1], done_res[2]);
+    CHECK(strncmp(done_text[1], "ISM43362-M3G-L44-SPI", 20) == 0 && strlen(done_text[1]) > WIFI_RX_CHUNK,
+          "I? reply \"%s\"", done_text[1]);
+    CHECK(strcmp(done_text[2], "0") == 0, "CS reply \"%s\"", done_text[2]);
+    CHECK(done_res[3] == WIFI_ERROR && done_res[4] == WIFI_ERROR, "P0/P6 results %d %d",
+          done_res[3], done_res[4]);
+
+    WifiAsyncStats_t ws;
+    WifiAsync_GetStats(&ws);
+    CHECK(ws.skipped == 1 && ws.errors == 1, "skipped %u errors %u", ws.skipped, ws.errors);
+    CHECK(WifiAsync_Pending() == 0, "%u still pending", WifiAsync_Pending());
+    Check_Replayed();
+}
+
+// ======================= RUNNER =========================
+
+typedef struct {
+    const char *name;
+    void (*fn)(void);
+} Scenario_t;
+
+static const Scenario_t scenarios[] = {
+    { "boot, join, connect, deliver", Test_Boot_Deliver },
+    { "send error, reconnect, resend", Test_Send_Error },
+    { "module hangs on R0, reset, resend", Test_Read_Timeout },
+    { "engine: chained commands run from interrupts", Test_Pipeline },
+};
+
+int main(int argc, char **argv)
+{
+    int failed = 0;
+    if (argc > 1) dir = argv[1];
+
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        printf("%s\n", scenarios[i].name);
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            scenarios[i].fn();
+            fflush(stdout);
+            _exit(failures ? 1 : 0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) failed++;
+    }
+    printf("%s\n", failed ? "FAILED" : "all passed");
+    return failed ? 1 : 0;
+}
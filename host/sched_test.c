@@ -0,0 +1,315 @@
+/******************************************************************************
+  * @file           : sched_test.c
+  * @brief          : Task scheduler on a simulated microsecond clock
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * sched.c runs here unchanged. The clock is a plain counter: the idle hook
+ * jumps it to the next release, tasks advance it by the time they would
+ * take on the board, and "interrupts" are posts made from the idle hook
+ * at chosen times. Every test checks release times, order and the
+ * per-task accounting against what the firmware relies on.
+ */
+#include "sched.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_LOG             4096
+
+typedef struct {
+    int      task;
+    uint8_t  ev;
+    uint32_t t_us;
+} Run_t;
+
+static uint32_t sim_us;
+static uint32_t idle_calls;
+static uint32_t last_idle_us;
+
+static Run_t runs[MAX_LOG];
+static uint32_t n_runs;
+
+// Per-task behaviour, indexed by task id
+static uint32_t cost_us[SCHED_MAX_TASKS];
+static uint32_t burst_at_run[SCHED_MAX_TASKS];      // 1-based run number that takes burst_us instead
+static uint32_t burst_us[SCHED_MAX_TASKS];
+static uint32_t task_runs[SCHED_MAX_TASKS];
+
+// Interrupt simulation: a post at a given time, made from the idle hook
+static uint32_t isr_at_us;
+static int      isr_task = -1;
+static uint8_t  isr_ev;
+static int      isr_count;
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+// ======================= SIMULATION =========================
+
+static uint32_t Sim_Clock(void)
+{
+    return sim_us;
+}
+
+static void Sim_Idle(uint32_t idle_us)
+{
+    idle_calls++;
+    last_idle_us = idle_us;
+
+    // An interrupt due before the next release wakes the core early
+    if (isr_count > 0 && (int32_t)(isr_at_us - sim_us) <= (int32_t)idle_us) {
+        if ((int32_t)(isr_at_us - sim_us) > 0) sim_us = isr_at_us;
+        Sched_Post(isr_task, isr_ev);
+        isr_count--;
+        return;
+    }
+    sim_us += idle_us == SCHED_IDLE_FOREVER ? 1000 : (idle_us ? idle_us : 1);
+}
+
+static void Log_Run(int task, uint8_t ev)
+{
+    uint32_t n = ++task_runs[task];
+    if (n_runs < MAX_LOG) {
+        runs[n_runs].task = task;
+        runs[n_runs].ev = ev;
+        runs[n_runs].t_us = sim_us;
+        n_runs++;
+    }
+    sim_us += (burst_at_run[task] == n) ? burst_us[task] : cost_us[task];
+}
+
+static void Task0(uint8_t ev) { Log_Run(0, ev); }
+static void Task1(uint8_t ev) { Log_Run(1, ev); }
+static void Task2(uint8_t ev) { Log_Run(2, ev); }
+static void Task3(uint8_t ev) { Log_Run(3, ev); }
+
+static const SchedTask_t fns[] = { Task0, Task1, Task2, Task3 };
+
+static void Reset(uint32_t start_us)
+{
+    sim_us = start_us;
+    idle_calls = 0;
+    n_runs = 0;
+    isr_count = 0;
+    isr_task = -1;
+    memset(cost_us, 0, sizeof(cost_us));
+    memset(burst_at_run, 0, sizeof(burst_at_run));
+    memset(burst_us, 0, sizeof(burst_us));
+    memset(task_runs, 0, sizeof(task_runs));
+    Sched_Init(Sim_Clock, Sim_Idle);
+}
+
+static void Run_For(uint32_t us)
+{
+    uint32_t start = sim_us;
+    while (sim_us - start < us) Sched_RunOnce();
+}
+
+// Start times of task `task`, in order; returns how many
+static uint32_t Starts(int task, uint32_t *out, uint32_t max)
+{
+    uint32_t n = 0;
+    for (uint32_t k = 0; k < n_runs && n < max; k++) {
+        if (runs[k].task == task) out[n++] = runs[k].t_us;
+    }
+    return n;
+}
+
+// ======================= TESTS =========================
+
+static void Test_Rates(void)
+{
+    printf("periodic rates, including periods longer than the wheel\n");
+    Reset(1000000);
+    Sched_AddTask("fast", fns[0], 20, 0);
+    Sched_AddTask("slow", fns[1], 500, 0);
+    Sched_AddTask("long", fns[2], 1000, 0);         // 1000 ticks, ~16 turns of the wheel
+    Run_For(10000000);
+
+    CHECK(task_runs[0] == 500, "20 ms task ran %u times in 10 s", task_runs[0]);
+    CHECK(task_runs[1] == 20, "500 ms task ran %u times", task_runs[1]);
+    CHECK(task_runs[2] == 10, "1000 ms task ran %u times", task_runs[2]);
+
+    uint32_t t[16];
+    uint32_t n = Starts(2, t, 16);
+    for (uint32_t k = 1; k < n; k++) CHECK(t[k] - t[k - 1] == 1000000, "long period %u us", t[k] - t[k - 1]);
+}
+
+static void Test_No_Drift(void)
+{
+    printf("releases stay on the grid under load\n");
+    Reset(0);
+    Sched_AddTask("acq", fns[0], 20, 15000);
+    Sched_AddTask("bg", fns[1], 7, 0);
+    cost_us[0] = 10700;             // sound window + IMU read
+    cost_us[1] = 2300;
+    Run_For(2000000);
+
+    uint32_t t[128];
+    uint32_t n = Starts(0, t, 128);
+    CHECK(n == 100, "%u runs", n);
+    // One 2.3 ms background run can sit in front of a release, never more
+    for (uint32_t k = 0; k < n; k++) {
+        uint32_t off = (t[k] - t[0]) % 20000;
+        CHECK(off <= 2300, "run %u starts %u us after its release", k, off);
+    }
+
+    SchedStats_t st;
+    Sched_GetStats(0, &st);
+    CHECK(st.misses == 0 && st.overruns == 0, "misses %u overruns %u", st.misses, st.overruns);
+    CHECK(st.max_late_us <= 2300, "late %u us", st.max_late_us);
+    CHECK(st.max_exec_us == 10700, "exec %u us", st.max_exec_us);
+}
+
+static void Test_Priority(void)
+{
+    printf("registration order is priority order\n");
+    Reset(0);
+    Sched_AddTask("high", fns[0], 10, 0);
+    Sched_AddTask("low", fns[1], 10, 0);
+    cost_us[1] = 500;
+    Run_For(100000);
+
+    for (uint32_t k = 0; k + 1 < n_runs; k += 2) {
+        CHECK(runs[k].task == 0 && runs[k + 1].task == 1, "run %u: task %d before task %d",
+              k, runs[k].task, runs[k + 1].task);
+    }
+}
+
+static void Test_Overrun(void)
+{
+    printf("overrun and deadline accounting\n");
+    Reset(0);
+    Sched_AddTask("acq", fns[0], 10, 8000);
+    cost_us[0] = 1000;
+    burst_at_run[0] = 3;
+    burst_us[0] = 25000;            // third run blocks for 2.5 periods
+    Run_For(200000);
+
+    SchedStats_t st;
+    Sched_GetStats(0, &st);
+    CHECK(st.misses == 2, "misses %u (the burst and the release it delayed)", st.misses);
+    CHECK(st.overruns == 1, "overruns %u (two releases during the burst, one merged)", st.overruns);
+    CHECK(st.runs + st.overruns == st.releases, "runs %u + overruns %u != releases %u",
+          st.runs, st.overruns, st.releases);
+
+    // Back on the 10 ms grid after the burst
+    uint32_t t[32];
+    uint32_t n = Starts(0, t, 32);
+    CHECK(n > 6 && t[n - 1] % 10000 == t[0] % 10000, "grid lost: %u vs %u", t[n - 1], t[0]);
+}
+
+static void Test_Events(void)
+{
+    printf("events posted from interrupts\n");
+    Reset(0);
+    Sched_AddTask("tick", fns[0], 50, 0);
+    int ev_task = Sched_AddTask("io", fns[1], 0, 2000);
+    isr_task = ev_task;
+    isr_ev = 7;
+    isr_at_us = 12345;
+    isr_count = 1;
+    Run_For(100000);
+
+    uint32_t t[4];
+    CHECK(Starts(1, t, 4) == 1, "event task ran %u times", task_runs[1]);
+    CHECK(t[0] == 12345, "event ran at %u us, posted at 12345", t[0]);
+    for (uint32_t k = 0; k < n_runs; k++) {
+        if (runs[k].task == 1) CHECK(runs[k].ev == 7, "event code %u", runs[k].ev);
+        else CHECK(runs[k].ev == SCHED_EV_TIMER, "timer run with code %u", runs[k].ev);
+    }
+    CHECK(Sched_UntilUs(ev_task) == SCHED_IDLE_FOREVER, "event-only task has a release");
+
+    // A full queue drops, the queued ones run in order, deadlines count from the post
+    for (int k = 0; k < SCHED_QUEUE_LEN + 3; k++) Sched_Post(ev_task, (uint8_t)(10 + k));
+    cost_us[1] = 300;
+    Run_For(10000);
+    SchedStats_t st;
+    Sched_GetStats(ev_task, &st);
+    CHECK(st.dropped == 3, "dropped %u", st.dropped);
+    CHECK(st.runs == 1 + SCHED_QUEUE_LEN, "runs %u", st.runs);
+    CHECK(st.misses == SCHED_QUEUE_LEN - 6, "misses %u (each waits 300 us more)", st.misses);
+    for (uint32_t k = 0, seen = 0; k < n_runs; k++) {
+        if (runs[k].task == 1 && runs[k].ev >= 10) {
+            CHECK(runs[k].ev == 10 + seen, "event %u out of order", runs[k].ev);
+            seen++;
+        }
+    }
+}
+
+static void Test_Set_Period(void)
+{
+    printf("period change from inside the task\n");
+    Reset(0);
+    Sched_AddTask("acq", fns[0], 20, 0);
+    Run_For(100000);
+    uint32_t before = task_runs[0];
+    Sched_SetPeriod(0, 100);        // as the task does on entering CONFIRMED
+    Run_For(1000000);
+
+    uint32_t t[128];
+    uint32_t n = Starts(0, t, 128);
+    CHECK(n == before + 10, "%u runs after the change, expected 10", n - before);
+    for (uint32_t k = before + 1; k < n; k++) CHECK(t[k] - t[k - 1] == 100000, "period %u us", t[k] - t[k - 1]);
+    CHECK(t[before] - t[before - 1] == 100000, "first new period %u us", t[before] - t[before - 1]);
+
+    Sched_SetPeriod(0, 0);
+    uint32_t stopped = task_runs[0];
+    Run_For(500000);
+    CHECK(task_runs[0] == stopped, "stopped task ran");
+}
+
+static void Test_Idle(void)
+{
+    printf("idle hook gets the time to the next release\n");
+    Reset(0);
+    Sched_AddTask("a", fns[0], 20, 0);
+    Sched_AddTask("b", fns[1], 7, 0);
+    cost_us[0] = 1500;
+    Run_For(1);                     // first tick: both released
+    while (Sched_RunOnce()) {}      // a runs 1.5 ms, then b; the next call idles
+
+    // b is next, due at 8 ms (released at 1 ms, period 7 ms); now is 2.5 ms
+    CHECK(last_idle_us == 5500, "idle %u us, expected 5500", last_idle_us);
+    CHECK(sim_us == 8000, "woke at %u us", sim_us);
+    CHECK(Sched_UntilUs(0) == 13000, "20 ms task due in %u us", Sched_UntilUs(0));
+}
+
+static void Test_Clock_Wrap(void)
+{
+    printf("32-bit microsecond clock wrap\n");
+    Reset(0xFFFFFFFFUL - 55000);
+    Sched_AddTask("acq", fns[0], 20, 5000);
+    cost_us[0] = 3000;
+    Run_For(1000000);
+
+    uint32_t t[64];
+    uint32_t n = Starts(0, t, 64);
+    CHECK(n == 50, "%u runs across the wrap", n);
+    for (uint32_t k = 1; k < n; k++) CHECK(t[k] - t[k - 1] == 20000, "period %u us at %08x", t[k] - t[k - 1], t[k]);
+    SchedStats_t st;
+    Sched_GetStats(0, &st);
+    CHECK(st.misses == 0 && st.max_late_us == 0, "misses %u late %u", st.misses, st.max_late_us);
+}
+
+// ======================= RUNNER =========================
+
+int main(void)
+{
+    Test_Rates();
+    Test_No_Drift();
+    Test_Priority();
+    Test_Overrun();
+    Test_Events();
+    Test_Set_Period();
+    Test_Idle();
+    Test_Clock_Wrap();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,192 @@
+/******************************************************************************
+  * @file           : spsc_test.c
+  * @brief          : SPSC ring (spsc_ring.h) unit checks and a two-thread stress test
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * On the board the producer is an interrupt and the consumer the task
+ * loop; here they are two pthreads on different cores, which is the
+ * harsher case: nothing serialises the two sides, so a missing acquire or
+ * release shows up as a torn or stale record.
+ *
+ * Each record carries a sequence number and a checksum of its payload.
+ * The consumer checks that every record is whole and that sequence
+ * numbers only go up by one (lossless run) or skip exactly as many as
+ * the producer counted as overflows (lossy run). Both sides yield when
+ * they cannot progress, so the test also runs on a single core.
+ */
+#include "spsc_ring.h"
+
+#include <pthread.h>
+#include <sched.h>              // the system one: see the Makefile
+#include <stdio.h>
+#include <string.h>
+
+#define STRESS_RECORDS      2000000
+#define BATCH               5
+
+typedef struct {
+    uint32_t seq;
+    uint32_t payload[5];
+    uint32_t check;
+} Record_t;
+
+SPSC_RING(TestRing, Record_t, 8)
+SPSC_RING(ByteRing, uint8_t, 4)
+
+static TestRing_t ring;
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                           \
+        if (!(cond)) { printf("  FAIL %s:%d: ", __FILE__, __LINE__);    \
+                       printf(__VA_ARGS__); printf("\n"); failures++; } \
+    } while (0)
+
+static void Fill(Record_t *r, uint32_t seq)
+{
+    r->seq = seq;
+    r->check = seq;
+    for (int k = 0; k < 5; k++) {
+        r->payload[k] = seq * 2654435761u + (uint32_t)k;
+        r->check ^= r->payload[k];
+    }
+}
+
+static int Whole(const Record_t *r)
+{
+    uint32_t check = r->seq;
+    for (int k = 0; k < 5; k++) check ^= r->payload[k];
+    return check == r->check;
+}
+
+// ======================= SINGLE CONTEXT =========================
+
+static void Test_Basics(void)
+{
+    printf("push / pop / batch / full\n");
+    ByteRing_t b;
+    ByteRing_Init(&b);
+    uint8_t out[8];
+
+    CHECK(ByteRing_Pop(&b, out) == 0, "pop from an empty ring");
+    for (uint8_t k = 0; k < 4; k++) CHECK(ByteRing_Push(&b, &k), "push %u", k);
+    uint8_t x = 9;
+    CHECK(!ByteRing_Push(&b, &x), "push into a full ring");
+    CHECK(b.overflows == 1 && b.high_water == 4, "overflows %u high water %u", b.overflows, b.high_water);
+    CHECK(ByteRing_Count(&b) == 4, "count %u", ByteRing_Count(&b));
+
+    CHECK(ByteRing_PopBatch(&b, out, 3) == 3, "batch of 3");
+    CHECK(out[0] == 0 && out[1] == 1 && out[2] == 2, "batch order %u %u %u", out[0], out[1], out[2]);
+    CHECK(ByteRing_Push(&b, &x), "push after a pop");
+    CHECK(ByteRing_PopBatch(&b, out, 8) == 2 && out[0] == 3 && out[1] == 9, "rest %u %u", out[0], out[1]);
+    CHECK(ByteRing_PopBatch(&b, out, 8) == 0, "empty again");
+}
+
+static void Test_Index_Wrap(void)
+{
+    printf("32-bit index wrap\n");
+    ByteRing_t b;
+    ByteRing_Init(&b);
+    b.head = b.tail = b.tail_cache = b.head_cache = 0xFFFFFFFEUL;
+
+    uint8_t in = 0, out;
+    int ok = 1;
+    for (int k = 0; k < 20; k++) {
+        in = (uint8_t)k;
+        ok &= ByteRing_Push(&b, &in);
+        ok &= ByteRing_Pop(&b, &out) && out == in;
+    }
+    CHECK(ok, "records lost or reordered across the wrap");
+    CHECK(b.head == 18 && b.tail == 18, "head %u tail %u", b.head, b.tail);
+    CHECK(b.overflows == 0 && b.high_water == 1, "overflows %u high water %u", b.overflows, b.high_water);
+}
+
+// ======================= TWO THREADS =========================
+
+static volatile int lossy;
+static volatile uint32_t produced;
+
+static void *Producer(void *arg)
+{
+    Record_t r;
+    (void)arg;
+    for (uint32_t seq = 1; seq <= STRESS_RECORDS; seq++) {
+        Fill(&r, seq);
+        if (lossy) {
+            // An ISR cannot wait: the record is dropped, the next one comes later
+            if (!TestRing_Push(&ring, &r)) sched_yield();
+        } else {
+            while (!TestRing_Push(&ring, &r)) sched_yield();
+        }
+    }
+    __atomic_store_n(&produced, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+static void Stress(int is_lossy)
+{
+    pthread_t th;
+    Record_t batch[BATCH];
+    uint32_t expect = 1, received = 0, torn = 0, gaps = 0, bad_order = 0;
+
+    TestRing_Init(&ring);
+    lossy = is_lossy;
+    produced = 0;
+    pthread_create(&th, NULL, Producer, NULL);
+
+    for (;;) {
+        int done = __atomic_load_n(&produced, __ATOMIC_ACQUIRE);
+        uint32_t n = TestRing_PopBatch(&ring, batch, BATCH);
+        for (uint32_t k = 0; k < n; k++) {
+            if (!Whole(&batch[k])) torn++;
+            if (batch[k].seq < expect) bad_order++;
+            else gaps += batch[k].seq - expect;
+            expect = batch[k].seq + 1;
+        }
+        received += n;
+        if (!n && done) break;
+        if (!n) sched_yield();
+    }
+    pthread_join(th, NULL);
+    gaps += STRESS_RECORDS + 1 - expect;        // dropped after the last record received
+
+    CHECK(torn == 0, "%u torn records", torn);
+    CHECK(bad_order == 0, "%u records out of order", bad_order);
+    CHECK(ring.high_water >= 1 && ring.high_water <= 8, "high water %u", ring.high_water);
+    if (is_lossy) {
+        // Every refused push is a record lost
+        CHECK(received + ring.overflows == STRESS_RECORDS, "received %u + overflows %u != %u",
+              received, ring.overflows, STRESS_RECORDS);
+        CHECK(gaps == ring.overflows, "sequence gaps %u, overflows %u", gaps, ring.overflows);
+        printf("  %u records, %u dropped, high water %u\n", received, ring.overflows, ring.high_water);
+    } else {
+        // Refused pushes are retried
+        CHECK(received == STRESS_RECORDS && gaps == 0, "received %u, gaps %u", received, gaps);
+        printf("  %u records, %u retries, high water %u\n", received, ring.overflows, ring.high_water);
+    }
+}
+
+static void Test_Stress_Lossless(void)
+{
+    printf("two threads, producer waits for room\n");
+    Stress(0);
+}
+
+static void Test_Stress_Lossy(void)
+{
+    printf("two threads, producer drops on full (ISR behaviour)\n");
+    Stress(1);
+}
+
+// ======================= RUNNER =========================
+
+int main(void)
+{
+    Test_Basics();
+    Test_Index_Wrap();
+    Test_Stress_Lossless();
+    Test_Stress_Lossy();
+
+    printf("%s\n", failures ? "FAILED" : "all passed");
+    return failures ? 1 : 0;
+}
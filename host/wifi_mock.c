@@ -0,0 +1,190 @@
+/******************************************************************************
+  * @file           : wifi_mock.c
+  * @brief          : Host (Linux) stand-in for the ISM43362 AT command set
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * A wifi_sim.c responder: executes each AT command against real Linux
+ * sockets and hands back the reply framed like the module does over SPI:
+ *
+ *   "\r\n" <data> "\r\nOK\r\n> "     or     "\r\nERROR\r\n> "
+ *
+ * wifi_sim.c adds the DRDY timing and the 0x15 filler.
+ */
+#define _GNU_SOURCE
+#include "wifi_mock.h"
+#include "wifi_sim.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define MOCK_INFO   "ISM43362-M3G-L44-SPI,C3.5.2.5.STM,v3.5.2,v1.4.0.rc1,v8.2.1,120000000,Inventek eS-WiFi"
+
+#define MOCK_PAYLOAD_MAX    1460
+
+static int ap_up = 1;
+
+static int joined = 0;
+static int sock = -1;
+static uint16_t remote_port = 0;
+static uint8_t remote_ip[4];
+static uint32_t read_len = 0;
+static uint32_t read_timeout_ms = 0;
+
+static uint8_t *resp;
+static uint32_t *resp_len;
+
+static WifiMockStats_t stats;
+
+// ======================= REPLIES =========================
+
+static void Reply(int ok, const void *data, uint32_t len)
+{
+    *resp_len = Sim_Frame(resp, ok, data, len);
+}
+
+static void Reply_Text(const char *s)
+{
+    Reply(1, s, (uint32_t)strlen(s));
+}
+
+static void Close_Socket(void)
+{
+    if (sock >= 0) close(sock);
+    sock = -1;
+}
+
+static int Open_Socket(void)
+{
+    Close_Socket();
+    if (!joined) return 0;
+
+    struct sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family = AF_INET;
+    sa.sin_port = htons(remote_port);
+    memcpy(&sa.sin_addr.s_addr, remote_ip, 4);
+
+    sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) return 0;
+    int one = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    if (connect(sock, (struct sockaddr *)&sa, sizeof(sa)) != 0) {
+        Close_Socket();
+        return 0;
+    }
+    stats.connects++;
+    return 1;
+}
+
+// ======================= AT COMMANDS =========================
+
+static void Execute(const char *cmd, const uint8_t *payload, uint32_t payload_len)
+{
+    stats.commands++;
+    const char *arg = (strlen(cmd) > 3 && cmd[2] == '=') ? cmd + 3 : "";
+
+    if (strcmp(cmd, "I?") == 0) {
+        Reply_Text(MOCK_INFO);
+    } else if (cmd[0] == 'C' && (cmd[1] == '1' || cmd[1] == '2' || cmd[1] == '3')) {
+        Reply_Text("");
+    } else if (strcmp(cmd, "C0") == 0) {
+        joined = ap_up;
+        if (joined) {
+            stats.joins++;
+            Reply_Text("[JOIN   ] mock-ap,192.168.1.50,0,0");
+        } else {
+            Reply(0, NULL, 0);
+        }
+    } else if (strcmp(cmd, "CS") == 0) {
+        Reply_Text((joined && ap_up) ? "1" : "0");
+    } else if (strcmp(cmd, "CD") == 0) {
+        joined = 0;
+        Close_Socket();
+        Reply_Text("");
+    } else if (cmd[0] == 'P') {
+        int ok = 1;
+        if (cmd[1] == '4') remote_port = (uint16_t)atoi(arg);
+        if (cmd[1] == '3') {
+            unsigned a, b, c, d;
+            ok = sscanf(arg, "%u.%u.%u.%u", &a, &b, &c, &d) == 4;
+            remote_ip[0] = (uint8_t)a; remote_ip[1] = (uint8_t)b;
+            remote_ip[2] = (uint8_t)c; remote_ip[3] = (uint8_t)d;
+        }
+        if (cmd[1] == '6') {
+            if (atoi(arg)) ok = ap_up && Open_Socket();
+            else           Close_Socket();
+        }
+        Reply(ok, "", 0);
+    } else if (cmd[0] == 'S' && cmd[1] == '2') {
+        Reply_Text("");
+    } else if (cmd[0] == 'S' && cmd[1] == '3') {
+        int ok = ap_up && sock >= 0 &&
+                 send(sock, payload, payload_len, MSG_NOSIGNAL) == (ssize_t)payload_len;
+        if (ok) stats.bytes_sent += payload_len;
+        Reply(ok, "", 0);
+    } else if (cmd[0] == 'R' && cmd[1] == '1') {
+        read_len = (uint32_t)atoi(arg);
+        Reply_Text("");
+    } else if (cmd[0] == 'R' && cmd[1] == '2') {
+        read_timeout_ms = (uint32_t)atoi(arg);
+        Reply_Text("");
+    } else if (strcmp(cmd, "R0") == 0) {
+        uint8_t data[MOCK_PAYLOAD_MAX];
+        ssize_t n = 0;
+        if (sock < 0 || !ap_up) {
+            Reply(0, NULL, 0);
+        } else {
+            struct pollfd pfd = { sock, POLLIN, 0 };
+            if (poll(&pfd, 1, (int)read_timeout_ms) > 0) {
+                uint32_t want = (read_len && read_len < sizeof(data)) ? read_len : sizeof(data);
+                n = recv(sock, data, want, 0);
+                if (n <= 0) {                   // peer closed
+                    Close_Socket();
+                    Reply(0, NULL, 0);
+                    return;
+                }
+            }
+            stats.bytes_received += (uint32_t)n;
+            Reply(1, data, (uint32_t)n);
+        }
+    } else {
+        Reply_Text("");                         // MR, ZR, ... : accepted, nothing to do
+    }
+}
+
+// ======================= RESPONDER =========================
+
+int Mock_Respond(const char *cmd, const uint8_t *payload, uint32_t payload_len,
+                 uint8_t *out, uint32_t *out_len, uint32_t *latency_ms)
+{
+    resp = out;
+    resp_len = out_len;
+    *latency_ms = 0;
+
+    if (!cmd) {                                 // reset: forget the AP and the socket
+        stats.resets++;
+        joined = 0;
+        Close_Socket();
+        *out_len = Sim_BootPrompt(out);
+        return 1;
+    }
+    Execute(cmd, payload, payload_len);
+    return 1;
+}
+
+// ======================= TEST CONTROLS =========================
+
+void Mock_SetApUp(int up)
+{
+    ap_up = up;
+    if (!up) { joined = 0; Close_Socket(); }
+}
+void Mock_GetStats(WifiMockStats_t *st) { *st = stats; }
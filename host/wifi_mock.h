@@ -0,0 +1,39 @@
+/******************************************************************************
+  * @file           : wifi_mock.h
+  * @brief          : Host (Linux) stand-in for the ISM43362 AT command set
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __WIFI_MOCK_H
+#define __WIFI_MOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * wifi_mock.c answers the AT commands the alert client sends (I?, C0..C3,
+ * CS, P0..P6, S2/S3, R0..R2) the way the module does. Plug it into
+ * wifi_sim.c with Sim_SetResponder(Mock_Respond). TCP sockets are real
+ * Linux sockets, so the firmware talks to a server on this machine.
+ */
+typedef struct {
+    uint32_t commands;          // AT commands executed
+    uint32_t bytes_sent;        // S3 payload bytes
+    uint32_t bytes_received;    // R0 payload bytes
+    uint32_t joins;             // successful C0
+    uint32_t connects;          // successful P6=1
+    uint32_t resets;            // hardware resets
+} WifiMockStats_t;
+
+int  Mock_Respond(const char *cmd, const uint8_t *payload, uint32_t payload_len,
+                  uint8_t *resp, uint32_t *resp_len, uint32_t *latency_ms);
+void Mock_SetApUp(int up);                  // 0: C0 fails
+void Mock_GetStats(WifiMockStats_t *st);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WIFI_MOCK_H */
@@ -0,0 +1,203 @@
+/******************************************************************************
+  * @file           : wifi_replay.c
+  * @brief          : Replays a recorded ISM43362 AT transcript through wifi_sim.c
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * A wifi_sim.c responder that plays the module's side of a transcript
+ * back: each command the firmware clocks in is checked against the next
+ * "> " line and answered with the recorded reply after the recorded
+ * latency. Transcripts come from Sim_Record() (alert_test --record) and
+ * can be trimmed or edited by hand, e.g. to turn timestamps into "??".
+ */
+#include "wifi_replay.h"
+#include "wifi_sim.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_EXCHANGES   128
+#define LINE_MAX_LEN    600
+#define CMD_TEXT_MAX    96
+#define PAYLOAD_MAX     64
+#define BODY_MAX        512
+
+typedef enum { END_OK = 0, END_ERROR, END_BOOT, END_NONE } End_t;
+
+typedef struct {
+    int      line;
+    int      reset;
+    char     cmd[CMD_TEXT_MAX];
+    uint8_t  payload[PAYLOAD_MAX];
+    uint8_t  any[PAYLOAD_MAX];          // 1: "??", matches any byte
+    uint32_t payload_len;
+    uint8_t  body[BODY_MAX];
+    uint32_t body_len;
+    End_t    end;
+    uint32_t latency_ms;
+} Exchange_t;
+
+static Exchange_t script[MAX_EXCHANGES];
+static int n_script = 0;
+static int pos = 0;
+static int failures = 0;
+static const char *script_name = "";
+
+// ======================= PARSER =========================
+
+// Hex bytes separated by blanks; "??" sets any[i] when `any` is given
+static int Parse_Hex(const char *s, uint8_t *out, uint8_t *any, uint32_t max, uint32_t *len)
+{
+    while (*s) {
+        while (*s == ' ' || *s == '\t') s++;
+        if (!*s) break;
+        if (*len >= max) return 0;
+        if (s[0] == '?' && s[1] == '?' && any) {
+            out[*len] = 0;
+            any[*len] = 1;
+        } else {
+            char hex[3] = { s[0], s[1], 0 };
+            char *end;
+            out[*len] = (uint8_t)strtoul(hex, &end, 16);
+            if (end != hex + 2) return 0;
+            if (any) any[*len] = 0;
+        }
+        (*len)++;
+        s += 2;
+    }
+    return 1;
+}
+
+static int Body_Append(Exchange_t *x, const void *p, uint32_t n)
+{
+    if (x->body_len + n > BODY_MAX) return 0;
+    memcpy(x->body + x->body_len, p, n);
+    x->body_len += n;
+    return 1;
+}
+
+int Replay_Load(const char *path)
+{
+    char line[LINE_MAX_LEN];
+    Exchange_t *x = NULL;
+    int lineno = 0, text_lines = 0;
+    FILE *f = fopen(path, "r");
+
+    n_script = pos = failures = 0;
+    script_name = path;
+    if (!f) {
+        fprintf(stderr, "[replay] cannot open %s\n", path);
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0' || line[0] == '#') continue;
+
+        if (line[0] == '>') {
+            if (x || n_script == MAX_EXCHANGES) goto bad;
+            x = &script[n_script];
+            memset(x, 0, sizeof(*x));
+            x->line = lineno;
+            text_lines = 0;
+            const char *text = line + 2;
+            if (strcmp(text, "(reset)") == 0) {
+                x->reset = 1;
+                continue;
+            }
+            char *bar = strstr(line, " |");
+            if (bar) {
+                *bar = '\0';
+                if (!Parse_Hex(bar + 2, x->payload, x->any, PAYLOAD_MAX, &x->payload_len)) goto bad;
+            }
+            if (strlen(text) >= CMD_TEXT_MAX) goto bad;
+            strcpy(x->cmd, text);
+        } else if (line[0] == '<' && line[1] == 'x') {
+            if (!x || !Parse_Hex(line + 2, x->body + x->body_len, NULL, BODY_MAX - x->body_len,
+                                 &x->body_len)) goto bad;
+        } else if (line[0] == '<') {
+            const char *text = line[1] ? line + 2 : "";
+            if (!x) goto bad;
+            if (text_lines++ && !Body_Append(x, "\r\n", 2)) goto bad;
+            if (!Body_Append(x, text, (uint32_t)strlen(text))) goto bad;
+        } else if (line[0] == '=') {
+            char word[8] = "";
+            unsigned ms = 0;
+            if (!x || sscanf(line + 1, "%7s %u", word, &ms) < 1) goto bad;
+            if (strcmp(word, "OK") == 0) x->end = END_OK;
+            else if (strcmp(word, "ERROR") == 0) x->end = END_ERROR;
+            else if (strcmp(word, "BOOT") == 0) x->end = END_BOOT;
+            else if (strcmp(word, "NONE") == 0) x->end = END_NONE;
+            else goto bad;
+            x->latency_ms = ms;
+            n_script++;
+            x = NULL;
+        } else {
+            goto bad;
+        }
+    }
+    fclose(f);
+    if (x) {
+        fprintf(stderr, "[replay] %s:%d: exchange without '=' line\n", path, x->line);
+        return 0;
+    }
+    return 1;
+
+bad:
+    fprintf(stderr, "[replay] %s:%d: cannot parse \"%s\"\n", path, lineno, line);
+    fclose(f);
+    return 0;
+}
+
+// ======================= RESPONDER =========================
+
+static int Matches(const Exchange_t *x, const char *cmd, const uint8_t *payload, uint32_t len)
+{
+    if (x->reset || !cmd) return x->reset && !cmd;
+    if (strcmp(x->cmd, cmd) != 0 || x->payload_len != len) return 0;
+    for (uint32_t i = 0; i < len; i++) {
+        if (!x->any[i] && x->payload[i] != payload[i]) return 0;
+    }
+    return 1;
+}
+
+int Replay_Respond(const char *cmd, const uint8_t *payload, uint32_t payload_len,
+                   uint8_t *resp, uint32_t *resp_len, uint32_t *latency_ms)
+{
+    *latency_ms = 0;
+    if (pos == n_script || !Matches(&script[pos], cmd, payload, payload_len)) {
+        failures++;
+        if (pos == n_script) {
+            fprintf(stderr, "[replay] %s: unexpected \"%s\" after the last exchange\n",
+                    script_name, cmd ? cmd : "(reset)");
+        } else {
+            fprintf(stderr, "[replay] %s:%d: expected \"%s\", got \"%s\"\n", script_name,
+                    script[pos].line, script[pos].reset ? "(reset)" : script[pos].cmd,
+                    cmd ? cmd : "(reset)");
+        }
+        *resp_len = cmd ? Sim_Frame(resp, 0, NULL, 0) : Sim_BootPrompt(resp);
+        return 1;
+    }
+
+    const Exchange_t *x = &script[pos++];
+    *latency_ms = x->latency_ms;
+    switch (x->end) {
+    case END_OK:    *resp_len = Sim_Frame(resp, 1, x->body, x->body_len); return 1;
+    case END_ERROR: *resp_len = Sim_Frame(resp, 0, NULL, 0); return 1;
+    case END_BOOT:  *resp_len = Sim_BootPrompt(resp); return 1;
+    case END_NONE:  return 0;
+    }
+    return 0;
+}
+
+int Replay_Remaining(void)
+{
+    return n_script - pos;
+}
+
+int Replay_Failures(void)
+{
+    return failures;
+}
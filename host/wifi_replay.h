@@ -0,0 +1,40 @@
+/******************************************************************************
+  * @file           : wifi_replay.h
+  * @brief          : Replays a recorded ISM43362 AT transcript through wifi_sim.c
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __WIFI_REPLAY_H
+#define __WIFI_REPLAY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*
+ * Transcript format (what Sim_Record() writes), one exchange per block:
+ *
+ *   > C1=mock-ap                    command as sent, without "\r"
+ *   > S3=0012 | a1 01 00 00 ?? ..   S3 payload in hex, "??" matches any byte
+ *   > (reset)                       RST pulse, answered with the boot prompt
+ *   < text                          reply line(s), joined with "\r\n"
+ *   <x a2 01 00 00                  binary reply bytes
+ *   = OK 800                        OK | ERROR | BOOT | NONE (no answer),
+ *                                   then the module latency in ms (default 0)
+ *
+ * Blank lines and lines starting with '#' are ignored. The firmware's
+ * commands must match in order; a mismatch is counted, reported on
+ * stderr and answered with ERROR.
+ */
+int  Replay_Load(const char *path);         // 0 if the file is missing or malformed
+int  Replay_Respond(const char *cmd, const uint8_t *payload, uint32_t payload_len,
+                    uint8_t *resp, uint32_t *resp_len, uint32_t *latency_ms);
+int  Replay_Remaining(void);                // exchanges not reached yet
+int  Replay_Failures(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WIFI_REPLAY_H */
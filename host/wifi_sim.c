@@ -0,0 +1,415 @@
+/******************************************************************************
+  * @file           : wifi_sim.c
+  * @brief          : Host (Linux) model of the ISM43362 SPI link for wifi_async.c
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+/*
+ * Replaces the DMA half of Core/Src/es_wifi_io.c on Linux. The module is
+ * a small state machine driven by nCS and the transfers the engine starts:
+ *
+ *   READY   DRDY high, waiting for nCS low
+ *   LISTEN  nCS low, command bytes arrive; nCS high hands them to the responder
+ *   BUSY    responder's latency running, DRDY low
+ *   REPLY   DRDY high, reply waiting; nCS low + reads clock it out
+ *   OFF     in reset, silent, or not fitted
+ *
+ * DMA transfers complete "instantly" (an event due now); only module
+ * latencies take time, in HAL_GetTick() milliseconds.
+ */
+#define _GNU_SOURCE
+#include "wifi_sim.h"
+#include "es_wifi_io.h"
+#include "wifi_async.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_EVENTS  16
+#define CMD_MAX     512
+
+typedef enum { MOD_READY = 0, MOD_LISTEN, MOD_BUSY, MOD_REPLY, MOD_OFF } ModState_t;
+typedef enum { EV_TX_DONE = 0, EV_RX_DONE, EV_REPLY_READY, EV_CMD_READY } EvKind_t;
+
+typedef struct {
+    int      used;
+    EvKind_t kind;
+    uint32_t due;
+    uint32_t order;
+} SimEvent_t;
+
+static SimResponder_t responder = NULL;
+static int present = 1;
+static int virtual_clock = 0;
+static uint32_t vclock = 0;
+static uint32_t skew_ms = 0;
+static int trace = 0;
+static FILE *record = NULL;
+
+static ModState_t mod = MOD_OFF;
+static int drdy = 0;
+static int selected = 0;
+static int in_isr = 0;
+static int lock_depth = 0;
+
+static uint8_t  cmd[CMD_MAX];
+static uint32_t cmd_len = 0;
+static uint8_t  resp[SIM_RESP_MAX];
+static uint32_t resp_len = 0;
+static uint32_t resp_pos = 0;
+
+static SimEvent_t events[MAX_EVENTS];
+static uint32_t event_order = 0;
+
+static WifiSimStats_t stats;
+
+// ======================= HAL TICK =========================
+
+uint32_t HAL_GetTick(void)
+{
+    static struct timespec t0;
+    struct timespec ts;
+    if (virtual_clock) return vclock;
+    if (t0.tv_sec == 0 && t0.tv_nsec == 0) clock_gettime(CLOCK_MONOTONIC, &t0);
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    uint64_t ms = (uint64_t)(ts.tv_sec - t0.tv_sec) * 1000 + (ts.tv_nsec - t0.tv_nsec) / 1000000;
+    return (uint32_t)ms + skew_ms;
+}
+
+void HAL_Delay(uint32_t ms)
+{
+    if (virtual_clock) vclock += ms;
+    else usleep(ms * 1000);
+}
+
+// ======================= EVENTS =========================
+
+static void Schedule(EvKind_t kind, uint32_t delay_ms)
+{
+    for (int i = 0; i < MAX_EVENTS; i++) {
+        if (events[i].used) continue;
+        events[i].used = 1;
+        events[i].kind = kind;
+        events[i].due = HAL_GetTick() + delay_ms;
+        events[i].order = event_order++;
+        return;
+    }
+    fprintf(stderr, "[sim] event queue full\n");
+    abort();
+}
+
+static void Cancel(EvKind_t kind)
+{
+    for (int i = 0; i < MAX_EVENTS; i++) {
+        if (events[i].used && events[i].kind == kind) events[i].used = 0;
+    }
+}
+
+static void Cancel_All(void)
+{
+    memset(events, 0, sizeof(events));
+}
+
+void Sim_Service(void)
+{
+    if (in_isr) return;
+    in_isr = 1;
+    for (;;) {
+        uint32_t now = HAL_GetTick();
+        int next = -1;
+        for (int i = 0; i < MAX_EVENTS; i++) {
+            if (!events[i].used || (int32_t)(now - events[i].due) < 0) continue;
+            if (next < 0 || (int32_t)(events[i].due - events[next].due) < 0 ||
+                (events[i].due == events[next].due && events[i].order < events[next].order)) next = i;
+        }
+        if (next < 0) break;
+
+        EvKind_t kind = events[next].kind;
+        events[next].used = 0;
+        stats.events++;
+        switch (kind) {
+        case EV_TX_DONE:
+            WifiAsync_OnEvent(WIFI_EVT_TX_DONE);
+            break;
+        case EV_RX_DONE:
+            WifiAsync_OnEvent(WIFI_EVT_RX_DONE);
+            break;
+        case EV_REPLY_READY:
+            mod = MOD_REPLY;
+            drdy = 1;
+            WifiAsync_OnEvent(WIFI_EVT_DRDY);
+            break;
+        case EV_CMD_READY:
+            mod = MOD_READY;
+            drdy = 1;
+            WifiAsync_OnEvent(WIFI_EVT_DRDY);
+            break;
+        }
+    }
+    in_isr = 0;
+}
+
+int Sim_Idle(void)
+{
+    for (int i = 0; i < MAX_EVENTS; i++) {
+        if (events[i].used) return 0;
+    }
+    return 1;
+}
+
+// ======================= TRANSCRIPT RECORDING =========================
+
+static int Printable(const uint8_t *p, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        if ((p[i] < 0x20 || p[i] > 0x7e) && p[i] != '\r' && p[i] != '\n') return 0;
+    }
+    return 1;
+}
+
+static void Record_Exchange(const char *text, const uint8_t *payload, uint32_t plen,
+                            int answered, uint32_t latency_ms)
+{
+    static const char ok_tail[] = "\r\nOK\r\n> ";
+    const uint32_t tail = sizeof(ok_tail) - 1;
+
+    if (!record) return;
+    if (!text) {
+        fprintf(record, "> (reset)\n");
+    } else {
+        fprintf(record, "> %s", text);
+        if (plen) {
+            fprintf(record, " |");
+            for (uint32_t i = 0; i < plen; i++) fprintf(record, " %02x", payload[i]);
+        }
+        fprintf(record, "\n");
+    }
+    if (!answered) {
+        fprintf(record, "= NONE\n");
+        return;
+    }
+
+    const char *end = "ERROR";
+    if (!text) {
+        end = "BOOT";
+    } else if (resp_len >= tail + 2 && memcmp(resp + resp_len - tail, ok_tail, tail) == 0) {
+        const uint8_t *body = resp + 2;
+        uint32_t n = resp_len - tail - 2;
+        end = "OK";
+        if (n && Printable(body, n)) {
+            uint32_t start = 0;
+            for (uint32_t i = 0; i <= n; i++) {
+                if (i == n || (body[i] == '\r' && i + 1 < n && body[i + 1] == '\n')) {
+                    fprintf(record, "< %.*s\n", (int)(i - start), (const char *)body + start);
+                    start = i + 2;
+                    i++;
+                }
+            }
+        } else if (n) {
+            fprintf(record, "<x");
+            for (uint32_t i = 0; i < n; i++) fprintf(record, " %02x", body[i]);
+            fprintf(record, "\n");
+        }
+    }
+    if (latency_ms) fprintf(record, "= %s %u\n", end, latency_ms);
+    else fprintf(record, "= %s\n", end);
+    fflush(record);
+}
+
+// ======================= MODULE =========================
+
+static void Execute(void)
+{
+    char text[CMD_MAX];
+    const uint8_t *payload = NULL;
+    uint32_t plen = 0, latency = 0, n = 0;
+
+    while (n < cmd_len && cmd[n] != '\r') n++;
+    memcpy(text, cmd, n);
+    text[n] = '\0';
+    if (n + 1 < cmd_len && strncmp(text, "S3=", 3) == 0) {
+        plen = (uint32_t)atoi(text + 3);
+        payload = cmd + n + 1;
+        if (plen > cmd_len - n - 1) plen = cmd_len - n - 1;
+    }
+    stats.commands++;
+    if (trace) fprintf(stderr, "[sim %6u] %s\n", HAL_GetTick(), text);
+
+    resp_len = resp_pos = 0;
+    int answered = responder && responder(text, payload, plen, resp, &resp_len, &latency);
+    Record_Exchange(text, payload, plen, answered, latency);
+    if (!answered) {
+        mod = MOD_OFF;                          // hung until the next reset
+        return;
+    }
+    mod = MOD_BUSY;
+    Schedule(EV_REPLY_READY, latency);
+}
+
+static void Boot(void)
+{
+    uint32_t latency = 0;
+    stats.resets++;
+    if (trace) fprintf(stderr, "[sim %6u] (reset)\n", HAL_GetTick());
+
+    resp_len = resp_pos = 0;
+    int answered = present && responder && responder(NULL, NULL, 0, resp, &resp_len, &latency);
+    Record_Exchange(NULL, NULL, 0, answered, latency);
+    if (!answered) return;
+    mod = MOD_BUSY;
+    Schedule(EV_REPLY_READY, latency);
+}
+
+// ======================= TRANSPORT (es_wifi_io.h) =========================
+
+int WifiIo_Open(void)
+{
+    Cancel_All();
+    mod = present ? MOD_READY : MOD_OFF;
+    drdy = present;
+    selected = 0;
+    return 0;
+}
+
+void WifiIo_Select(int on)
+{
+    if (on == selected) return;
+    selected = on;
+    if (!present) return;
+
+    if (on) {
+        if (mod == MOD_READY) {
+            mod = MOD_LISTEN;
+            drdy = 0;
+            cmd_len = 0;
+        }
+        return;
+    }
+    if (mod == MOD_LISTEN) {
+        if (cmd_len) {
+            Execute();
+        } else {
+            mod = MOD_READY;                    // aborted before any byte
+            drdy = 1;
+        }
+    } else if (mod == MOD_REPLY && resp_pos >= resp_len) {
+        mod = MOD_BUSY;
+        Schedule(EV_CMD_READY, 0);
+    }
+}
+
+int WifiIo_DataReady(void)
+{
+    return present && drdy;
+}
+
+void WifiIo_HoldReset(int on)
+{
+    Cancel(EV_REPLY_READY);
+    Cancel(EV_CMD_READY);
+    drdy = 0;
+    mod = MOD_OFF;
+    if (!on) Boot();
+}
+
+int WifiIo_StartTx(const uint8_t *data, uint16_t len)
+{
+    if (mod == MOD_LISTEN && present) {
+        uint32_t n = (cmd_len + len <= CMD_MAX) ? len : CMD_MAX - cmd_len;
+        memcpy(cmd + cmd_len, data, n);
+        cmd_len += n;
+    }
+    stats.tx_bytes += len;
+    Schedule(EV_TX_DONE, 0);
+    return 0;
+}
+
+int WifiIo_StartRx(uint8_t *data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++) {
+        if (mod == MOD_REPLY && present && resp_pos < resp_len) {
+            data[i] = resp[resp_pos++];
+        } else {
+            data[i] = 0x15;
+            stats.filler_bytes++;
+        }
+    }
+    if (mod == MOD_REPLY && resp_pos >= resp_len) drdy = 0;
+    stats.rx_bytes += len;
+    Schedule(EV_RX_DONE, 0);
+    return 0;
+}
+
+void WifiIo_Abort(void)
+{
+    Cancel(EV_TX_DONE);
+    Cancel(EV_RX_DONE);
+}
+
+// Interrupts "arrive" whenever the main context is about to mask them
+uint32_t WifiIo_Lock(void)
+{
+    if (lock_depth == 0) Sim_Service();
+    lock_depth++;
+    return 0;
+}
+
+void WifiIo_Unlock(uint32_t key)
+{
+    (void)key;
+    lock_depth--;
+}
+
+// ======================= RESPONDER HELPERS =========================
+
+uint32_t Sim_Frame(uint8_t *out, int ok, const void *data, uint32_t len)
+{
+    static const char ok_tail[] = "\r\nOK\r\n> ";
+    static const char err[] = "\r\nERROR\r\n> ";
+    uint32_t n = 0;
+
+    if (!ok) {
+        memcpy(out, err, sizeof(err) - 1);
+        return sizeof(err) - 1;
+    }
+    out[n++] = '\r';
+    out[n++] = '\n';
+    if (len) memcpy(out + n, data, len);
+    n += len;
+    memcpy(out + n, ok_tail, sizeof(ok_tail) - 1);
+    return n + sizeof(ok_tail) - 1;
+}
+
+uint32_t Sim_BootPrompt(uint8_t *out)
+{
+    memcpy(out, "\x15\x15\r\n> ", 6);
+    return 6;
+}
+
+// ======================= TEST CONTROLS =========================
+
+void Sim_SetResponder(SimResponder_t r) { responder = r; }
+
+void Sim_SetModulePresent(int p)
+{
+    present = p;
+    if (!p) {
+        Cancel(EV_REPLY_READY);
+        Cancel(EV_CMD_READY);
+        mod = MOD_OFF;
+        drdy = 0;
+    }
+}
+
+void Sim_UseVirtualClock(int on) { virtual_clock = on; }
+
+void Sim_AdvanceMs(uint32_t ms)
+{
+    if (virtual_clock) vclock += ms;
+    else skew_ms += ms;
+}
+
+void Sim_Record(FILE *f) { record = f; }
+void Sim_SetTrace(int on) { trace = on; }
+void Sim_GetStats(WifiSimStats_t *st) { *st = stats; }
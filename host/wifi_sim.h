@@ -0,0 +1,68 @@
+/******************************************************************************
+  * @file           : wifi_sim.h
+  * @brief          : Host (Linux) model of the ISM43362 SPI link for wifi_async.c
+  * (c) CG2028 Teaching Team
+  ******************************************************************************/
+#ifndef __WIFI_SIM_H
+#define __WIFI_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * wifi_sim.c implements the non-blocking WifiIo_* transport from
+ * es_wifi_io.h plus HAL_GetTick()/HAL_Delay(). It models the module's
+ * side of the wire: DRDY low while a command is clocked in, a rising
+ * edge when the reply is ready, 0x15 filler past the end of it, another
+ * edge when it is ready for the next command, and the boot prompt after
+ * a reset. Events (DMA done, DRDY edges) are queued with a due time and
+ * delivered by Sim_Service(), which also runs whenever the firmware
+ * takes WifiIo_Lock() - the moments where a real interrupt could land.
+ *
+ * What the module answers is up to a responder: host/wifi_mock.c (real
+ * TCP sockets) or host/wifi_replay.c (a recorded AT transcript).
+ */
+
+#define SIM_RESP_MAX    1100
+
+/*
+ * cmd is the AT text without "\r", or NULL for a reset (answer with the
+ * boot prompt). Fill resp with the raw bytes the module clocks out
+ * ("\r\n...\r\nOK\r\n> "), set the delay before DRDY rises, and return 1;
+ * return 0 to stay silent.
+ */
+typedef int (*SimResponder_t)(const char *cmd, const uint8_t *payload, uint32_t payload_len,
+                              uint8_t *resp, uint32_t *resp_len, uint32_t *latency_ms);
+
+typedef struct {
+    uint32_t commands;          // AT commands clocked in
+    uint32_t resets;
+    uint32_t tx_bytes;
+    uint32_t rx_bytes;          // clocked out, filler included
+    uint32_t filler_bytes;
+    uint32_t events;
+} WifiSimStats_t;
+
+void Sim_SetResponder(SimResponder_t r);
+void Sim_SetModulePresent(int present);     // 0: DRDY never rises again
+void Sim_UseVirtualClock(int on);           // 1: HAL_GetTick() only moves with Sim_AdvanceMs()
+void Sim_AdvanceMs(uint32_t ms);
+void Sim_Service(void);                     // deliver every event that is due
+int  Sim_Idle(void);                        // nothing scheduled
+void Sim_Record(FILE *f);                   // append the traffic as a transcript
+void Sim_SetTrace(int on);
+void Sim_GetStats(WifiSimStats_t *st);
+
+/* Framing helpers for responders */
+uint32_t Sim_Frame(uint8_t *resp, int ok, const void *data, uint32_t len);
+uint32_t Sim_BootPrompt(uint8_t *resp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WIFI_SIM_H */
@@ -0,0 +1,157 @@
+"""Time-to-alarm per stage, from the log gateway.py writes (latency_log.jsonl).
+
+Usage:  python latency_report.py [latency_log.jsonl ...]
+
+Board stages come from one ALERT_TRACE line per alarm (alert_trace.c),
+all on the board's TIM2 clock, so they are exact:
+
+  window    trigger sample -> confirming sample  (the FSM waiting for evidence)
+  detect    confirming sample DRDY -> FSM decided (acquisition, app queue, detection)
+  queue     decided -> sentinel in the UART TX ring
+  uart      in the ring -> last character to the USART (ring drain)
+
+Gateway stages are all on the PC's clock:
+
+  spawn     sentinel line read -> Telegram thread started
+  telegram  POST started -> answered
+
+The step between them, UART -> gateway.py read (USB serial, the OS, the
+read loop), crosses clocks. Each alarm gives one pair (board sent_us,
+gateway read time); the smallest difference in a session is taken as
+the fixed offset between the clocks, so "serial" is the delay over the
+fastest alarm of that session, not the absolute latency. The Wi-Fi
+frames (event_us = confirming sample) and the Telegram POSTs they start
+are placed on the same estimate.
+Clock drift (tens of ppm) is ignored.
+"""
+import json
+import sys
+from collections import defaultdict
+
+WRAP = 1 << 32      # TIM2 microseconds wrap after ~71.6 min
+
+BOARD_STAGES = [
+    ('window', 'trigger', 'confirm'),
+    ('detect', 'confirm', 'decided'),
+    ('queue', 'decided', 'queued'),
+    ('uart', 'queued', 'sent'),
+]
+
+
+def us(a, b):
+    """b - a on the board clock, across the TIM2 wrap"""
+    return (b - a) % WRAP
+
+
+def load(paths):
+    records = []
+    for path in paths:
+        with open(path) as f:
+            for n, line in enumerate(f, 1):
+                line = line.strip()
+                if not line:
+                    continue
+                try:
+                    records.append(json.loads(line))
+                except ValueError:
+                    print(f"{path}:{n}: skipped, not JSON", file=sys.stderr)
+    return records
+
+
+def unwrap(board_us, host_hint_us, offset):
+    """Board time on a continuous scale, taking the wrap that lands nearest host_hint_us"""
+    return board_us + round((host_hint_us - offset - board_us) / WRAP) * WRAP
+
+
+def clock_offset(pairs):
+    """Smallest host us - board us over the (host us, board us) pairs of a session"""
+    if not pairs:
+        return None
+    pairs = sorted(pairs)
+    host0, board0 = pairs[0]
+    first = host0 - board0
+    return min(host - unwrap(board, host, first) for host, board in pairs)
+
+
+def on_host(board_us, host_hint_us, offset):
+    """Board time -> host us with the session's offset"""
+    return unwrap(board_us, host_hint_us, offset) + offset
+
+
+def percentile(sorted_vals, p):
+    if not sorted_vals:
+        return float('nan')
+    k = max(0, min(len(sorted_vals) - 1, int(round(p / 100.0 * len(sorted_vals) + 0.5)) - 1))
+    return sorted_vals[k]
+
+
+def print_table(stages):
+    print(f"{'stage':<26}{'n':>5}{'min':>10}{'p50':>10}{'p90':>10}{'p99':>10}{'max':>10}{'mean':>10}   ms")
+    for name, values in stages.items():
+        v = sorted(values)
+        if not v:
+            print(f"{name:<26}{0:>5}")
+            continue
+        row = [v[0], percentile(v, 50), percentile(v, 90), percentile(v, 99), v[-1], sum(v) / len(v)]
+        print(f"{name:<26}{len(v):>5}" + "".join(f"{x / 1000.0:>10.2f}" for x in row))
+
+
+def main(paths):
+    records = load(paths)
+    sessions = defaultdict(list)
+    for r in records:
+        sessions[r.get('session')].append(r)
+
+    stages = {name: [] for name, _, _ in BOARD_STAGES}
+    stages.update({'serial (over fastest)': [], 'spawn': [], 'telegram': [],
+                   'trigger -> telegram': [], 'confirm -> gateway': [], 'confirm -> wifi': [],
+                   'confirm -> wifi telegram': []})
+    kinds = defaultdict(int)
+    untraced = 0
+
+    for recs in sessions.values():
+        sentinels = {r['alert']: r for r in recs if r['ev'] == 'sentinel'}
+        telegrams = {r['alert']: r for r in recs if r['ev'] == 'telegram'}
+        traces = [r for r in recs if r['ev'] == 'trace' and r.get('alert') in sentinels and 'sent' in r]
+        untraced += len(sentinels) - len(traces)
+
+        pairs = [(sentinels[t['alert']]['host'] * 1e6, t['sent']) for t in traces]
+        clock = clock_offset(pairs)
+
+        for t in traces:
+            kinds[t.get('kind', '?')] += 1
+            for name, a, b in BOARD_STAGES:
+                # A press has no sample behind it: trigger, confirm and decided are one stamp
+                if t.get('kind') != 'manual' or name not in ('window', 'detect'):
+                    stages[name].append(us(t[a], t[b]))
+            rx_us = sentinels[t['alert']]['host'] * 1e6
+            serial = rx_us - on_host(t['sent'], rx_us, clock)
+            stages['serial (over fastest)'].append(serial)
+            stages['confirm -> gateway'].append(rx_us - on_host(t['confirm'], rx_us, clock))
+
+            tg = telegrams.get(t['alert'])
+            if tg:
+                stages['spawn'].append((tg['start'] - sentinels[t['alert']]['host']) * 1e6)
+                stages['telegram'].append((tg['host'] - tg['start']) * 1e6)
+                if tg.get('status') == 200:
+                    stages['trigger -> telegram'].append(
+                        us(t['trigger'], t['sent']) + serial + (tg['host'] - sentinels[t['alert']]['host']) * 1e6)
+
+        if clock is not None:
+            for w in (r for r in recs if r['ev'] == 'wifi' and r.get('kind') == 1):
+                rx_us = w['host'] * 1e6
+                stages['confirm -> wifi'].append(rx_us - on_host(w['event_us'], rx_us, clock))
+                tg = telegrams.get(w.get('alert'))
+                if tg and tg.get('status') == 200:
+                    stages['confirm -> wifi telegram'].append(tg['host'] * 1e6 - on_host(w['event_us'], rx_us, clock))
+
+    print(f"{sum(kinds.values())} traced alarms ("
+          + ", ".join(f"{k} {n}" for k, n in sorted(kinds.items())) + f"), {untraced} without a trace, "
+          f"{len(sessions)} gateway session(s)\n")
+    print_table(stages)
+    print("\nserial and the confirm -> stages are relative to the fastest alarm of each session"
+          "\n(see the top of this file); the telegram totals count only alarms Telegram accepted.")
+
+
+if __name__ == '__main__':
+    main(sys.argv[1:] or ['latency_log.jsonl'])